@@ -5,7 +5,6 @@ in vec4 vcolor;
 
 out vec4 color;
 
-uniform float k_time = 0.0;
 uniform float k_internalRadius = 0.1;
 uniform float k_externalRadius = 1.0;
 
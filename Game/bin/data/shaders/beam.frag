@@ -5,7 +5,6 @@ in vec4 vcolor;
 
 out vec4 color;
 
-uniform float k_time = 0.0;
 uniform sampler2D k_sampler0; // beam
 
 void main()
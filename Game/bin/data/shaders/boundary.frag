@@ -4,8 +4,6 @@ in vec2 UV;
 
 out vec4 color;
 
-uniform float k_time = 0;
-
 float rand( vec2 co ) 
 {
 	return fract( sin( dot( co.xy , vec2( 12.9898, 78.233 ) ) ) * 43758.5453 );
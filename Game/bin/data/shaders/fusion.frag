@@ -9,7 +9,6 @@ out vec4 color;
 
 uniform sampler2D k_sampler0;	// energy texture
 uniform float k_health = 1;
-uniform float k_time = 0;
 uniform int k_empActive = 0;
 
 void main()
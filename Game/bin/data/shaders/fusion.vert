@@ -12,7 +12,6 @@ out vec3 viewDir;
 uniform mat4 k_worldViewProj;
 uniform mat4 k_world;
 uniform mat4 k_worldInverseTranspose;
-uniform mat4 k_viewInverse;
 
 void main()
 {
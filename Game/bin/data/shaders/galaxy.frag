@@ -6,7 +6,6 @@ out vec4 color;
 
 uniform float k_screenWidth = 1024.0f;
 uniform float k_screenHeight = 768.0f;
-uniform float k_time = 0.0;
 uniform sampler2D k_sampler0;
 uniform sampler2D lineSampler;
 
@@ -5,9 +5,7 @@ in vec2 UV;
 out vec4 color;
 
 uniform sampler2D k_sampler0;
-uniform vec2 k_resolution;
 uniform vec2 k_direction;
-uniform float k_time;
 
 void main()
 {
@@ -0,0 +1,17 @@
+#version 330 core
+
+layout(location = 0) in vec3 vertexPosition;
+layout(location = 1) in vec2 vertexUV;
+layout(location = 3) in vec4 vertexColor;
+
+out vec2 UV;
+out vec4 vcolor;
+
+uniform mat4 k_worldViewProj;
+
+void main()
+{
+	gl_Position = k_worldViewProj * vec4( vertexPosition, 1 );
+	UV = vertexUV;
+	vcolor = vertexColor;
+}
@@ -2,8 +2,6 @@
 
 out vec4 color;
 
-uniform float k_time = 0.0;
-
 void main()
 {
 	float c = step( 0.5, fract( ( gl_FragCoord.x + gl_FragCoord.y ) / 16.0 + k_time ) );
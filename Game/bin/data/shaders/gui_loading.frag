@@ -5,8 +5,6 @@ in vec2 UV;
 out vec4 color;
 
 uniform sampler2D k_sampler0;
-uniform float k_time = 0.0;
-uniform vec2 k_resolution = vec2( 1440, 900 );
 
 const float pi = 3.14159265359;
 const float triangleScale = 0.816497161855865; // ratio of edge length and height
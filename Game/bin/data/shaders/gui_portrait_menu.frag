@@ -5,8 +5,6 @@ in vec2 UV;
 out vec4 color;
 
 uniform sampler2D k_sampler0;
-uniform float k_time = 0.0;
-uniform vec2 k_resolution = vec2( 1440, 900 );
 
 float rand( vec2 co ) 
 {
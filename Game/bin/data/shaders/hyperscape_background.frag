@@ -4,8 +4,6 @@ in vec2 UV;
 
 out vec3 color;
 
-uniform float k_time = 0.0;
-
 uniform sampler2D k_sampler0;
 uniform sampler2D k_sampler1;
 
@@ -5,8 +5,6 @@ in vec4 vcolor;
 
 out vec4 color;
 
-uniform float k_time = 0.0;
-
 void main()
 {
     float verticalGradient = 1.0 - ( cos( UV.x * 3.145 *2. ) / 2. + 0.5 );
@@ -5,8 +5,6 @@ in vec4 vcolor;
 
 out vec4 color;
 
-uniform float k_time = 0.0;
-
 const float kStarSize = 0.001;
 const float kStarBrightness = 0.5; // Value >= 0.0 and < 4.0
 const vec3 kStarColor = vec3(1.0, 0.7, 0.0);
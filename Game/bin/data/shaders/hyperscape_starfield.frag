@@ -5,8 +5,6 @@ in vec4 vcolor;
 
 out vec4 color;
 
-uniform float k_time = 0.0;
-
 const float kStarSize = 0.1;
 const float kStarBrightness = 0.5; // Value >= 0.0 and < 4.0
 
@@ -6,7 +6,6 @@ in vec4 vcolor;
 out vec4 color;
 
 uniform sampler2D k_sampler0;
-uniform float k_time = 0.0;
 
 float rand( vec2 co ) 
 {
@@ -0,0 +1,57 @@
+#version 330 core
+
+layout(location = 0) in vec2 vertexPosition; // Quad corner, in [-1, 1].
+
+// Per-instance data. Must match ParticleInstance.
+layout(location = 4) in vec4 instancePositionVelocity; // xy: spawn position, zw: velocity
+layout(location = 5) in vec4 instanceTiming; // x: spawn time, y: lifetime, z: scale
+
+out vec2 UV;
+out vec4 vcolor;
+
+uniform mat4 k_worldViewProj;
+uniform float k_particleTime;
+
+// x: number of elements in the atlas, or 0 if the whole texture is used; y: elements per row.
+uniform vec4 k_atlas;
+// xy: size of an atlas element in UV space, zw: size of a texel.
+uniform vec4 k_atlasElementSize;
+
+void main()
+{
+	float age = k_particleTime - instanceTiming.x;
+	float lifetime = instanceTiming.y;
+	if ( age < 0 || age >= lifetime )
+	{
+		// Collapse the quad so nothing gets rasterised.
+		gl_Position = vec4( 0, 0, 0, 1 );
+		UV = vec2( 0 );
+		vcolor = vec4( 0 );
+		return;
+	}
+
+	float fraction = age / lifetime;
+	float remaining = 1 - fraction;
+
+	float halfSize = 60 * instanceTiming.z;
+	vec2 position = instancePositionVelocity.xy + instancePositionVelocity.zw * age + vertexPosition * halfSize;
+	gl_Position = k_worldViewProj * vec4( position, 0, 1 );
+
+	vec2 corner = vertexPosition * 0.5 + 0.5;
+	if ( k_atlas.x > 0 )
+	{
+		float index = clamp( floor( fraction * k_atlas.x ), 0, k_atlas.x - 1 );
+		float row = floor( index / k_atlas.y );
+		float column = index - row * k_atlas.y;
+		vec2 uv1 = vec2( column, row ) * k_atlasElementSize.xy + k_atlasElementSize.zw * 0.5;
+		vec2 uv2 = vec2( column + 1, row + 1 ) * k_atlasElementSize.xy - k_atlasElementSize.zw * 0.5;
+		UV = mix( uv1, uv2, corner );
+	}
+	else
+	{
+		UV = corner;
+	}
+
+	// Particles fade out over the last quarter of their lifetime.
+	vcolor = vec4( 1, 1, 1, min( 1, remaining * 4 ) );
+}
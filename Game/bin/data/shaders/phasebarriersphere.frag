@@ -6,7 +6,6 @@ in vec3 objPosition;
 out vec3 color;
 
 uniform sampler2D k_sampler0;
-uniform float k_time = 0.0;
 uniform vec4 k_a = vec4( 0, 0, 0, 1 );
 uniform vec4 k_clip = vec4( 0, 0, 0, 0 );
 uniform vec4 k_clipForward = vec4( 1, 0, 0, 0 );
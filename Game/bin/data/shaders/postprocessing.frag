@@ -6,7 +6,6 @@ out vec4 color;
 
 uniform sampler2D k_sampler0;
 uniform sampler2D k_sampler1;
-uniform vec2 k_resolution;
 
 uniform bool k_applyBleachBypass = true;
 uniform bool k_applyGlow = true;
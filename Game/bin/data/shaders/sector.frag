@@ -5,8 +5,6 @@ in vec4 vcolor;
 
 out vec4 color;
 
-uniform float k_time = 0.0;
-
 void main()
 {
     color = vcolor;
@@ -5,7 +5,6 @@ in vec2 UV;
 out vec4 color;
 
 uniform sampler2D k_sampler0;
-uniform float k_time = 0.0;
 
 void main()
 {
@@ -8,9 +8,7 @@ uniform vec3 k_coreColor = vec3( 0.8, 0.65, 0.3 );
 uniform vec3 k_coronaColor = vec3( 0.8, 0.35, 0.1 );
 uniform vec2 k_offset = vec2( 0.0, 0.0 );
 uniform float k_distance = 1.0;
-uniform vec2 k_resolution = vec2( 512.0, 512.0 );
 
-uniform float k_time = 0.0f;
 uniform sampler2D k_backgroundSampler;
 uniform sampler2D k_starSampler;
 uniform vec2 k_starUvScale = vec2( 1.0, 1.0 );
@@ -6,7 +6,6 @@ in vec4 vcolor;
 out vec4 color;
 
 uniform sampler2D k_sampler0;
-uniform float k_time = 0;
 uniform bool k_quantum = false;
 uniform float k_shieldStrength = 1;	// Value between 0 and 1
 
@@ -5,34 +5,26 @@ in vec3 objPosition;
 in vec3 normal;
 in vec3 viewDir;
 
+// Per-module values, coming either from uniforms or from the instance data. See shipmodule.vert.
+flat in vec4 primaryPaint;
+flat in vec4 secondaryPaint;
+flat in vec4 overlayColor;
+flat in vec4 emissiveColor;
+flat in vec4 clip;
+flat in vec4 clipForward;
+flat in int clipActive;
+flat in float health;
+flat in float repairEdgeAlpha;
+flat in float repairEdgeOffset;
+flat in int empActive;
+
 out vec4 color;
 
 uniform sampler2D k_sampler0; // diffuse
 uniform sampler2D k_sampler1; // specular
 uniform sampler2D k_sampler2; // paint maps
 uniform sampler2D k_sampler3; // damage map
-uniform float k_repairEdgeAlpha = 0;
-uniform float k_repairEdgeOffset = 0;
 uniform vec4 k_a = vec4( 0, 0, 0, 1 );
-uniform vec4 k_e = vec4( 1, 1, 1, 1 );
-uniform float k_time = 0;
-
-// Primary and secondary paints used by the paint map
-uniform vec4 k_primaryPaint = vec4( 0, 0, 0.75, 1 );
-uniform vec4 k_secondaryPaint = vec4( 0, 0, 0, 1 );
-
-// Damage overlay control - damage becomes more visible as health goes down
-uniform float k_health = 1;
-
-// Clip plane used by the hyperspace jump sequence
-uniform vec4 k_clip = vec4( 0, 0, 0, 0 );
-uniform vec4 k_clipForward = vec4( 1, 0, 0, 0 );
-uniform int k_clipActive = 0;
-
-// Ikeda effect color, used by armour modules. Alpha controls the pattern's intensity.
-uniform vec4 k_overlayColor = vec4( 0, 0, 0, 0 );
-
-uniform int k_empActive = 0;
 
 float random (float x) 
 {
@@ -92,10 +84,10 @@ vec4 ikeda( vec2 uv, float intensity )
 void main()
 {
 	color = vec4( 0, 0, 0, 1 );
-	vec4 objPosWorld = vec4(objPosition - k_clip.xyz, 1.0);
+	vec4 objPosWorld = vec4(objPosition - clip.xyz, 1.0);
 	vec3 lightDir = normalize( vec3( 1, 0.25, 1 ) );
 
-	if ( k_clipActive == 1 && dot( normalize( objPosWorld ), k_clipForward ) > 0 )
+	if ( clipActive == 1 && dot( normalize( objPosWorld ), clipForward ) > 0 )
 	{
 		discard;
 	}
@@ -113,34 +105,34 @@ void main()
 	// Repair edge
 	float lum = (diffuse.r + diffuse.g + diffuse.b) / 3;
 	float repairEdge = 0.0;
-	if (lum > k_repairEdgeOffset && lum < k_repairEdgeOffset + 0.05)
+	if (lum > repairEdgeOffset && lum < repairEdgeOffset + 0.05)
 		repairEdge = 1.0;
-	vec4 repairEdgeColor = vec4(0.373, 0.441, 0.306, 1) * k_repairEdgeAlpha * repairEdge;
+	vec4 repairEdgeColor = vec4(0.373, 0.441, 0.306, 1) * repairEdgeAlpha * repairEdge;
 
 	vec4 paintMask = texture( k_sampler2, UV );
-	vec4 paintPrimary = paintMask.r * k_primaryPaint;
-	vec4 paintSecondary = paintMask.g * k_secondaryPaint;
+	vec4 paintPrimary = paintMask.r * primaryPaint;
+	vec4 paintSecondary = paintMask.g * secondaryPaint;
 	vec4 paintedDiffuse = vec4( Overlay( diffuse.r, paintPrimary.r, paintMask.r * paintMask.a ), Overlay( diffuse.g, paintPrimary.g, paintMask.r * paintMask.a ), Overlay( diffuse.b, paintPrimary.b, paintMask.r * paintMask.a ), 1 );
 	paintedDiffuse = vec4( Overlay( paintedDiffuse.r, paintSecondary.r, paintMask.g * paintMask.a ), Overlay( paintedDiffuse.g, paintSecondary.g, paintMask.g * paintMask.a ), Overlay( paintedDiffuse.b, paintSecondary.b, paintMask.g * paintMask.a ), 1 );
 
 	// The emissive mask is in the k_sampler2's blue channel.
-	vec4 emissive = texture( k_sampler2 , UV).b * k_e;
+	vec4 emissive = texture( k_sampler2 , UV).b * emissiveColor;
 
 	//
-	vec4 ikedaOverlay = vec4( k_overlayColor.rgb, 1 ) * ikeda( UV, k_overlayColor.a );
+	vec4 ikedaOverlay = vec4( overlayColor.rgb, 1 ) * ikeda( UV, overlayColor.a );
 
 	color = clamp( k_a + specular + paintedDiffuse + repairEdgeColor + emissive + ikedaOverlay, 0, 1 );
 
 	// Damage component
 	vec4 damageMap = texture( k_sampler3, UV );
-	if ( damageMap.b >= k_health ) // The damage cutoff layer is in the blue channel
+	if ( damageMap.b >= health ) // The damage cutoff layer is in the blue channel
 	{
 		float glowFactor = abs(cos(k_time * 0.5)) * 0.5 + 0.5;
 		color *= damageMap.r;
 		color = clamp( color + ( 1 - damageMap.r ) * damageMap.g * vec4( 1, 0.4, 0, 1 ) * glowFactor, 0, 1 );
 	}
 
-	if ( k_empActive == 1 )
+	if ( empActive == 1 )
 	{
 		float c = random( vec2( UV.x + k_time, UV.y + k_time ) ) * 0.25;
 		color.g = clamp( color.g + c, 0, 1 );
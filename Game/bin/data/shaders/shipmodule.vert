@@ -4,23 +4,101 @@ layout(location = 0) in vec3 vertexPosition;
 layout(location = 1) in vec2 vertexUV;
 layout(location = 2) in vec3 vertexNormal;
 
+// Per-instance data, only used when k_instanced is set. Must match ModuleInstance.
+layout(location = 4) in mat4 instanceWorld;
+layout(location = 8) in vec4 instancePrimaryPaint;
+layout(location = 9) in vec4 instanceSecondaryPaint;
+layout(location = 10) in vec4 instanceOverlayColor;
+layout(location = 11) in vec4 instanceEmissiveColor;
+layout(location = 12) in vec4 instanceClip; // w: clip active
+layout(location = 13) in vec4 instanceClipForward;
+layout(location = 14) in vec4 instanceState; // health, repair edge alpha, repair edge offset, EMP active
+
 out vec2 UV;
 out vec3 objPosition;
 out vec3 normal;
 out vec3 viewDir;
 
+flat out vec4 primaryPaint;
+flat out vec4 secondaryPaint;
+flat out vec4 overlayColor;
+flat out vec4 emissiveColor;
+flat out vec4 clip;
+flat out vec4 clipForward;
+flat out int clipActive;
+flat out float health;
+flat out float repairEdgeAlpha;
+flat out float repairEdgeOffset;
+flat out int empActive;
+
 uniform mat4 k_worldViewProj;
 uniform mat4 k_world;
 uniform mat4 k_worldInverseTranspose;
-uniform mat4 k_viewInverse;
+
+uniform int k_instanced = 0;
+
+uniform float k_repairEdgeAlpha = 0;
+uniform float k_repairEdgeOffset = 0;
+uniform vec4 k_e = vec4( 1, 1, 1, 1 );
+
+// Primary and secondary paints used by the paint map
+uniform vec4 k_primaryPaint = vec4( 0, 0, 0.75, 1 );
+uniform vec4 k_secondaryPaint = vec4( 0, 0, 0, 1 );
+
+// Damage overlay control - damage becomes more visible as health goes down
+uniform float k_health = 1;
+
+// Clip plane used by the hyperspace jump sequence
+uniform vec4 k_clip = vec4( 0, 0, 0, 0 );
+uniform vec4 k_clipForward = vec4( 1, 0, 0, 0 );
+uniform int k_clipActive = 0;
+
+// Ikeda effect color, used by armour modules. Alpha controls the pattern's intensity.
+uniform vec4 k_overlayColor = vec4( 0, 0, 0, 0 );
+
+uniform int k_empActive = 0;
 
 void main()
 {
-	gl_Position = k_worldViewProj * vec4( vertexPosition, 1 );
-	objPosition = vec4( k_world * vec4( vertexPosition, 1 ) ).xyz;
+	mat4 world = mat4( 1 );
+	if ( k_instanced == 1 )
+	{
+		world = instanceWorld;
+		primaryPaint = instancePrimaryPaint;
+		secondaryPaint = instanceSecondaryPaint;
+		overlayColor = instanceOverlayColor;
+		emissiveColor = instanceEmissiveColor;
+		clip = vec4( instanceClip.xyz, 0 );
+		clipForward = instanceClipForward;
+		clipActive = int( instanceClip.w );
+		health = instanceState.x;
+		repairEdgeAlpha = instanceState.y;
+		repairEdgeOffset = instanceState.z;
+		empActive = int( instanceState.w );
+	}
+	else
+	{
+		primaryPaint = k_primaryPaint;
+		secondaryPaint = k_secondaryPaint;
+		overlayColor = k_overlayColor;
+		emissiveColor = k_e;
+		clip = k_clip;
+		clipForward = k_clipForward;
+		clipActive = k_clipActive;
+		health = k_health;
+		repairEdgeAlpha = k_repairEdgeAlpha;
+		repairEdgeOffset = k_repairEdgeOffset;
+		empActive = k_empActive;
+	}
+
+	// Modules are only ever rotated and translated, so the rotation part of the instance transform is its own inverse transpose.
+	mat3 normalMatrix = mat3( k_worldInverseTranspose ) * mat3( world );
+
+	vec4 worldPosition = world * vec4( vertexPosition, 1 );
+	gl_Position = k_worldViewProj * worldPosition;
+	objPosition = vec4( k_world * worldPosition ).xyz;
 	UV = vertexUV;
-	normal = vec4( k_worldInverseTranspose * vec4( normalize( vertexNormal ), 1 ) ).xyz;
-	vec4 po = vec4( gl_Position.xyz , 1 );
-	vec3 pw = vec4( k_worldInverseTranspose * po ).xyz;
+	normal = normalMatrix * normalize( vertexNormal );
+	vec3 pw = normalMatrix * gl_Position.xyz;
 	viewDir = normalize( vec3( k_viewInverse[0].w, k_viewInverse[1].w, k_viewInverse[2].w ) - pw );
 }
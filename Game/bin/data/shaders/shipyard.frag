@@ -11,7 +11,6 @@ uniform sampler2D k_sampler1; // specular
 uniform sampler2D k_sampler2; // paint maps
 uniform vec4 k_a = vec4( 0, 0, 0, 1 );
 uniform vec4 k_e = vec4( 1, 1, 1, 1 );
-uniform float k_time = 0;
 
 // Primary and secondary paints used by the paint map
 uniform vec4 k_primaryPaint = vec4( 0, 0, 0.75, 1 );
@@ -4,7 +4,6 @@ in vec2 UV;
 
 out vec4 color;
 
-uniform float k_time = 0;
 uniform sampler2D k_sampler0;
 
 void main()
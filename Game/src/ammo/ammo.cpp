@@ -48,8 +48,14 @@ Ammo::Ammo()
 
 void Ammo::Create( Weapon* pWeapon, float additionalRotation /* = 0.0f */ )
 {
+    // Ammo is pooled by the AmmoManager, so every field which can change during the lifetime of a
+    // shot must be reset here.
     m_pOwner = pWeapon;
     m_IsAlive = true;
+    m_IsGlowSource = false;
+    m_DiesOnHit = true;
+    m_Intercepted = false;
+    m_HitFraction = 1.0f;
     m_AdditionalRotation = additionalRotation;
     m_Angle = pWeapon->GetAngle() + m_AdditionalRotation;
 
@@ -17,10 +17,11 @@
 
 #include <genesis.h>
 #include <logger.h>
-#include <physics/raytestresult.h>
+#include <physics/rayquery.h>
 #include <physics/rigidbody.h>
 #include <physics/shape.h>
 #include <physics/simulation.h>
+#include <profiling/profiler.h>
 #include <resources/resourcemodel.h>
 #include <resources/resourcesound.h>
 #include <sound/soundinstance.h>
@@ -32,7 +33,6 @@
 #include "ammo/beam.h"
 #include "ammo/lance.h"
 #include "ammo/missile.h"
-#include "ammo/projectile.h"
 #include "ammo/rocket.h"
 #include "ammo/torpedo.h"
 #include "hexterminate.h"
@@ -45,239 +45,294 @@ namespace Hexterminate
 {
 
 AmmoManager::AmmoManager()
-    : m_Idx( 0 )
 {
-    const size_t sInitialCapacity = 1024u;
-    m_Ammo.resize( sInitialCapacity );
-    for ( int i = 0; i < sInitialCapacity; ++i )
-    {
-        m_Ammo[ i ] = nullptr;
-    }
+    m_Pools[ static_cast<size_t>( WeaponSystem::Missile ) ] = std::make_unique<AmmoPool<Missile>>();
+    m_Pools[ static_cast<size_t>( WeaponSystem::Rocket ) ] = std::make_unique<AmmoPool<Rocket>>();
+    m_Pools[ static_cast<size_t>( WeaponSystem::Torpedo ) ] = std::make_unique<AmmoPool<Torpedo>>();
+    m_Pools[ static_cast<size_t>( WeaponSystem::Ion ) ] = std::make_unique<AmmoPool<Beam>>();
+    m_Pools[ static_cast<size_t>( WeaponSystem::Lance ) ] = std::make_unique<AmmoPool<Lance>>();
+    m_Pools[ static_cast<size_t>( WeaponSystem::Antiproton ) ] = std::make_unique<AmmoPool<Antiproton>>();
 
-    m_RayTestResults.reserve( 64 );
+    const size_t sInitialCapacity = 1024u;
+    m_RayQueries.reserve( sInitialCapacity );
+    m_RayQueryAmmo.reserve( sInitialCapacity );
 };
 
 AmmoManager::~AmmoManager()
 {
-    for ( int i = 0; i < m_Ammo.size(); ++i )
-    {
-        delete m_Ammo[ i ];
-    }
 }
 
-AmmoHandle AmmoManager::GetFreeAmmo()
+AmmoHandle AmmoManager::Create( Weapon* pWeapon, float additionalRotation /* = 0.0f */ )
 {
-    AmmoHandle handle = InvalidAmmoHandle;
-
-    const AmmoSizeType bufferSize = static_cast<AmmoSizeType>( m_Ammo.size() );
-    const AmmoSizeType minIdx = m_Idx;
-    const AmmoSizeType maxIdx = m_Idx + bufferSize;
-    for ( AmmoHandle i = minIdx; i < maxIdx; i++ )
+    WeaponSystem weaponSystem = pWeapon->GetInfo()->GetSystem();
+    if ( weaponSystem == WeaponSystem::Projectile )
     {
-        const AmmoHandle idx = i % bufferSize;
-        if ( m_Ammo[ idx ] == nullptr || !m_Ammo[ idx ]->IsAlive() )
-        {
-            if ( m_Ammo[ idx ] && !m_Ammo[ idx ]->IsAlive() )
-            {
-                delete m_Ammo[ idx ];
-                m_Ammo[ idx ] = nullptr;
-            }
-
-            m_Idx = idx;
-            return idx;
-        }
+        m_Projectiles.Add( pWeapon, additionalRotation );
+        return InvalidAmmoHandle;
     }
 
-    // If we get here, we've been through the full buffer and failed to find an empty slot.
-    AmmoSizeType newBufferSize = bufferSize * 2;
-    Genesis::FrameWork::GetLogger()->LogInfo( "AmmoManager buffer full, extended from %d to %d.", bufferSize, newBufferSize );
-    m_Ammo.resize( newBufferSize );
-
-    for ( AmmoSizeType idx = bufferSize; idx < newBufferSize; idx++ )
+    const size_t poolIndex = static_cast<size_t>( weaponSystem );
+    if ( poolIndex >= m_Pools.size() || m_Pools[ poolIndex ] == nullptr )
     {
-        m_Ammo[ idx ] = nullptr;
+        SDL_assert_release( false ); // Not implemented!
+        return InvalidAmmoHandle;
     }
 
-    m_Idx = bufferSize;
-    return static_cast<AmmoHandle>( bufferSize );
+    uint32_t slot = 0;
+    Ammo* pAmmo = m_Pools[ poolIndex ]->Acquire( slot );
+    SDL_assert( slot <= static_cast<uint32_t>( sAmmoHandleSlotMask ) );
+    pAmmo->Create( pWeapon, additionalRotation );
+    return static_cast<AmmoHandle>( ( poolIndex << sAmmoHandleSlotBits ) | slot );
 }
 
-AmmoHandle AmmoManager::Create( Weapon* pWeapon, float additionalRotation /* = 0.0f */ )
+void AmmoManager::Update( float delta )
 {
-    AmmoHandle handle = GetFreeAmmo();
+    GENESIS_PROFILE_ZONE( "AmmoManager::Update" );
 
-    WeaponSystem weaponSystem = pWeapon->GetInfo()->GetSystem();
-    if ( weaponSystem == WeaponSystem::Projectile )
-    {
-        m_Ammo[ handle ] = new Projectile();
-    }
-    else if ( weaponSystem == WeaponSystem::Missile )
+    if ( g_pGame->IsPaused() )
     {
-        m_Ammo[ handle ] = new Missile();
+        return;
     }
-    else if ( weaponSystem == WeaponSystem::Rocket )
+
+    for ( auto& pPool : m_Pools )
     {
-        m_Ammo[ handle ] = new Rocket();
+        if ( pPool != nullptr )
+        {
+            for ( Ammo* pAmmo : pPool->GetAlive() )
+            {
+                if ( pAmmo->IsAlive() )
+                {
+                    pAmmo->Update( delta );
+                }
+            }
+        }
     }
-    else if ( weaponSystem == WeaponSystem::Torpedo )
+    m_Projectiles.Update( delta );
+    m_Projectiles.Compact();
+
+    m_RayQueries.clear();
+    m_RayQueryAmmo.clear();
+    for ( auto& pPool : m_Pools )
     {
-        m_Ammo[ handle ] = new Torpedo();
+        if ( pPool != nullptr )
+        {
+            for ( Ammo* pAmmo : pPool->GetAlive() )
+            {
+                if ( pAmmo->IsAlive() == false )
+                {
+                    continue;
+                }
+                else if ( pAmmo->WasIntercepted() )
+                {
+                    CreateHitEffect( pAmmo->GetSource(), glm::vec3( 1.0f, 0.0f, 0.0f ), pAmmo->GetOwner() );
+                    pAmmo->Kill();
+                    continue;
+                }
+
+                m_RayQueries.push_back( { pAmmo->GetSource(), pAmmo->GetDestination() } );
+                m_RayQueryAmmo.push_back( pAmmo );
+            }
+        }
     }
-    else if ( weaponSystem == WeaponSystem::Ion )
+
+    const size_t projectileCount = m_Projectiles.GetCount();
+    for ( size_t i = 0; i < projectileCount; ++i )
     {
-        m_Ammo[ handle ] = new Beam();
+        m_RayQueries.push_back( { m_Projectiles.GetSource( i ), m_Projectiles.GetDestination( i ) } );
     }
-    else if ( weaponSystem == WeaponSystem::Lance )
+
+    g_pGame->GetPhysicsSimulation()->RayTestBatch( m_RayQueries, m_RayQueryResults );
+
+    const size_t ammoQueryCount = m_RayQueryAmmo.size();
+    for ( size_t queryIndex = 0; queryIndex < ammoQueryCount; ++queryIndex )
     {
-        m_Ammo[ handle ] = new Lance();
+        ProcessAmmoHits( queryIndex, m_RayQueryAmmo[ queryIndex ], delta );
     }
-    else if ( weaponSystem == WeaponSystem::Antiproton )
+
+    for ( size_t projectileIndex = 0; projectileIndex < projectileCount; ++projectileIndex )
     {
-        m_Ammo[ handle ] = new Antiproton();
+        ProcessProjectileHits( ammoQueryCount + projectileIndex, projectileIndex, delta );
     }
-    else
+
+    for ( auto& pPool : m_Pools )
     {
-        SDL_assert_release( false ); // Not implemented!
+        if ( pPool != nullptr )
+        {
+            pPool->Compact();
+        }
     }
-
-    m_Ammo[ handle ]->Create( pWeapon, additionalRotation );
-    return handle;
+    m_Projectiles.Compact();
 }
 
-void AmmoManager::Update( float delta )
+void AmmoManager::ProcessAmmoHits( size_t queryIndex, Ammo* pAmmo, float delta )
 {
-    if ( g_pGame->IsPaused() )
+    // Damage dealt by an earlier query can destroy a ship and take its ammo with it.
+    if ( pAmmo->IsAlive() == false )
     {
         return;
     }
 
-    for ( Ammo* pAmmo : m_Ammo )
+    const Genesis::Physics::RayQueryHit* pHits = m_RayQueryResults.GetHits( queryIndex );
+    const size_t hitCount = m_RayQueryResults.GetHitCount( queryIndex );
+    for ( size_t hitIndex = 0; hitIndex < hitCount; ++hitIndex )
     {
-        if ( pAmmo && pAmmo->IsAlive() )
+        const Genesis::Physics::RayQueryHit& result = pHits[ hitIndex ];
+        Weapon* pOwnerWeapon = pAmmo->GetOwner();
+        const HitResult hitResult = ResolveHit( result, pOwnerWeapon, pAmmo->GetSource(), pAmmo->GetDestination(), pAmmo, delta );
+        if ( hitResult == HitResult::Ignored )
         {
-            pAmmo->Update( delta );
+            continue;
         }
-    }
 
-    Genesis::Physics::Simulation* pPhysicsSimulation = g_pGame->GetPhysicsSimulation();
-    for ( Ammo* pAmmo : m_Ammo )
-    {
-        if ( pAmmo != nullptr && pAmmo->IsAlive() )
+        pAmmo->SetHitFraction( result.fraction );
+
+        if ( pAmmo->GetDiesOnHit() )
         {
-            if ( pAmmo->WasIntercepted() )
-            {
-                CreateHitEffect( pAmmo->GetSource(), glm::vec3( 1.0f, 0.0f, 0.0f ), pAmmo->GetOwner() );
-                pAmmo->Kill();
-                continue;
-            }
+            OnKilledByHit( pOwnerWeapon );
+            pAmmo->Kill();
+        }
 
-            pPhysicsSimulation->RayTest( pAmmo->GetSource(), pAmmo->GetDestination(), m_RayTestResults );
+        if ( hitResult == HitResult::HitAndStop )
+        {
+            break;
+        }
+    }
+}
 
-            for ( auto& result : m_RayTestResults )
-            {
-                // If we've collided with a compound shape (the only shape that has child shapes) then the child
-                // shape is the one that has relevant collision info.
-                Genesis::Physics::ShapeSharedPtr pShape = !result.GetChildShape().expired() ? result.GetChildShape().lock() : result.GetShape().lock();
-                SDL_assert( pShape != nullptr );
-
-                // Only collide with hostile ships.
-                ShipCollisionInfo* pCollisionInfo = reinterpret_cast<ShipCollisionInfo*>( pShape->GetUserData() );
-                if ( pCollisionInfo == nullptr )
-                {
-                    continue;
-                }
+void AmmoManager::ProcessProjectileHits( size_t queryIndex, size_t projectileIndex, float delta )
+{
+    if ( m_Projectiles.IsAlive( projectileIndex ) == false )
+    {
+        return;
+    }
 
-                Ship* pShip = pCollisionInfo->GetShip();
-                Weapon* pOwnerWeapon = pAmmo->GetOwner();
-                Ship* pOwnerShip = pOwnerWeapon->GetOwner();
-                if ( Faction::sIsEnemyOf( pShip->GetFaction(), pOwnerShip->GetFaction() ) == false )
-                {
-                    continue;
-                }
+    const Genesis::Physics::RayQueryHit* pHits = m_RayQueryResults.GetHits( queryIndex );
+    const size_t hitCount = m_RayQueryResults.GetHitCount( queryIndex );
+    for ( size_t hitIndex = 0; hitIndex < hitCount; ++hitIndex )
+    {
+        Weapon* pOwnerWeapon = m_Projectiles.GetOwner( projectileIndex );
+        const HitResult hitResult = ResolveHit( pHits[ hitIndex ], pOwnerWeapon, m_Projectiles.GetSource( projectileIndex ), m_Projectiles.GetDestination( projectileIndex ), nullptr, delta );
+        if ( hitResult == HitResult::Ignored )
+        {
+            continue;
+        }
 
-                if ( pCollisionInfo->GetType() == ShipCollisionType::Shield && pAmmo->CanBypassShields() )
-                {
-                    continue;
-                }
+        // Projectiles always die on hit.
+        OnKilledByHit( pOwnerWeapon );
+        m_Projectiles.Kill( projectileIndex );
 
-                const glm::vec3 hitPosition = glm::mix( pAmmo->GetSource(), pAmmo->GetDestination(), result.GetFraction() );
-                CreateHitEffect( hitPosition, result.GetNormal(), pAmmo->GetOwner() );
+        if ( hitResult == HitResult::HitAndStop )
+        {
+            break;
+        }
+    }
+}
 
-                bool stopProcessing = false;
-                if ( pCollisionInfo->GetType() == ShipCollisionType::Module )
-                {
-                    Module* pModule = pCollisionInfo->GetModule();
-                    int slotX, slotY;
-                    pModule->GetHexGridSlot( slotX, slotY );
-                    pShip->DamageModule( pOwnerWeapon, pCollisionInfo->GetModule(), delta );
-                    stopProcessing = true;
-                }
-                else if ( pCollisionInfo->GetType() == ShipCollisionType::Shield )
-                {
-                    if ( pOwnerWeapon->GetInfo()->GetSystem() == WeaponSystem::Antiproton )
-                    {
-                        AddonQuantumStateAlternator* pAlternator = pShip->GetQuantumStateAlternator();
-                        Antiproton* pAntiprotonAmmo = static_cast<Antiproton*>( pAmmo );
-                        if ( pAlternator == nullptr || pAlternator->GetQuantumState() != pAntiprotonAmmo->GetQuantumState() )
-                        {
-                            continue;
-                        }
-                        else
-                        {
-                            stopProcessing = true;
-                        }
-                    }
-                    else
-                    {
-                        pShip->DamageShield( pOwnerWeapon, delta, hitPosition );
-                        stopProcessing = true;
-                    }
-                }
-                else if ( pCollisionInfo->GetType() == ShipCollisionType::PhaseBarrier )
-                {
-                    stopProcessing = true;
-                }
+AmmoManager::HitResult AmmoManager::ResolveHit( const Genesis::Physics::RayQueryHit& result, Weapon* pOwnerWeapon, const glm::vec3& source, const glm::vec3& destination, Ammo* pAmmo, float delta )
+{
+    // If we've collided with a compound shape (the only shape that has child shapes) then the child
+    // shape is the one that has relevant collision info.
+    Genesis::Physics::Shape* pShape = ( result.pChildShape != nullptr ) ? result.pChildShape : result.pShape;
+    SDL_assert( pShape != nullptr );
+
+    // Only collide with hostile ships.
+    ShipCollisionInfo* pCollisionInfo = reinterpret_cast<ShipCollisionInfo*>( pShape->GetUserData() );
+    if ( pCollisionInfo == nullptr )
+    {
+        return HitResult::Ignored;
+    }
 
-                pAmmo->SetHitFraction( result.GetFraction() );
+    Ship* pShip = pCollisionInfo->GetShip();
+    Ship* pOwnerShip = pOwnerWeapon->GetOwner();
+    if ( Faction::sIsEnemyOf( pShip->GetFaction(), pOwnerShip->GetFaction() ) == false )
+    {
+        return HitResult::Ignored;
+    }
 
-                if ( pAmmo->GetDiesOnHit() )
-                {
-                    if ( pOwnerWeapon->GetInfo()->GetDamageType() == DamageType::Kinetic && pOwnerShip->HasPerk( Perk::Siegebreaker ) )
-                    {
-                        pAmmo->GetOwner()->AddSiegebreakerStack();
-                    }
+    if ( pCollisionInfo->GetType() == ShipCollisionType::Shield && pAmmo != nullptr && pAmmo->CanBypassShields() )
+    {
+        return HitResult::Ignored;
+    }
 
-                    pAmmo->Kill();
-                }
+    const glm::vec3 hitPosition = glm::mix( source, destination, result.fraction );
+    CreateHitEffect( hitPosition, result.normal, pOwnerWeapon );
 
-                if ( stopProcessing )
-                {
-                    break;
-                }
+    HitResult hitResult = HitResult::Hit;
+    if ( pCollisionInfo->GetType() == ShipCollisionType::Module )
+    {
+        pShip->DamageModule( pOwnerWeapon, pCollisionInfo->GetModule(), delta );
+        hitResult = HitResult::HitAndStop;
+    }
+    else if ( pCollisionInfo->GetType() == ShipCollisionType::Shield )
+    {
+        if ( pOwnerWeapon->GetInfo()->GetSystem() == WeaponSystem::Antiproton )
+        {
+            AddonQuantumStateAlternator* pAlternator = pShip->GetQuantumStateAlternator();
+            Antiproton* pAntiprotonAmmo = static_cast<Antiproton*>( pAmmo );
+            if ( pAlternator == nullptr || pAlternator->GetQuantumState() != pAntiprotonAmmo->GetQuantumState() )
+            {
+                return HitResult::Ignored;
+            }
+            else
+            {
+                hitResult = HitResult::HitAndStop;
             }
         }
+        else
+        {
+            pShip->DamageShield( pOwnerWeapon, delta, hitPosition );
+            hitResult = HitResult::HitAndStop;
+        }
+    }
+    else if ( pCollisionInfo->GetType() == ShipCollisionType::PhaseBarrier )
+    {
+        hitResult = HitResult::HitAndStop;
+    }
+
+    return hitResult;
+}
+
+void AmmoManager::OnKilledByHit( Weapon* pOwnerWeapon )
+{
+    if ( pOwnerWeapon->GetInfo()->GetDamageType() == DamageType::Kinetic && pOwnerWeapon->GetOwner()->HasPerk( Perk::Siegebreaker ) )
+    {
+        pOwnerWeapon->AddSiegebreakerStack();
     }
 }
 
 void AmmoManager::Render()
 {
     Genesis::FrameWork::GetRenderSystem()->SetRenderTarget( Genesis::RenderTargetId::Glow );
-    for ( Ammo* pAmmo : m_Ammo )
+    for ( auto& pPool : m_Pools )
     {
-        if ( pAmmo && pAmmo->IsAlive() && pAmmo->IsGlowSource() )
+        if ( pPool != nullptr )
         {
-            pAmmo->Render();
+            for ( Ammo* pAmmo : pPool->GetAlive() )
+            {
+                if ( pAmmo->IsAlive() && pAmmo->IsGlowSource() )
+                {
+                    pAmmo->Render();
+                }
+            }
         }
     }
+    m_Projectiles.Render();
 
     Genesis::FrameWork::GetRenderSystem()->SetRenderTarget( Genesis::RenderTargetId::Default );
-    for ( Ammo* pAmmo : m_Ammo )
+    for ( auto& pPool : m_Pools )
     {
-        if ( pAmmo && pAmmo->IsAlive() )
+        if ( pPool != nullptr )
         {
-            pAmmo->Render();
+            for ( Ammo* pAmmo : pPool->GetAlive() )
+            {
+                if ( pAmmo->IsAlive() )
+                {
+                    pAmmo->Render();
+                }
+            }
         }
     }
+    m_Projectiles.Render();
 }
 
 void AmmoManager::CreateHitEffect( const glm::vec3& position, const glm::vec3& hitNormal, Weapon* pWeapon )
@@ -338,11 +393,16 @@ void AmmoManager::PlayHitSFX( const glm::vec3& position, Weapon* pWeapon )
 
 void AmmoManager::GetInterceptables( AmmoVector& vec ) const
 {
-    for ( Ammo* pAmmo : m_Ammo )
+    // Only missiles can be intercepted.
+    static const WeaponSystem sInterceptableSystems[] = { WeaponSystem::Missile, WeaponSystem::Rocket, WeaponSystem::Torpedo };
+    for ( WeaponSystem weaponSystem : sInterceptableSystems )
     {
-        if ( pAmmo != nullptr && pAmmo->IsAlive() && pAmmo->CanBeIntercepted() && pAmmo->WasIntercepted() == false )
+        for ( Ammo* pAmmo : m_Pools[ static_cast<size_t>( weaponSystem ) ]->GetAlive() )
         {
-            vec.push_back( pAmmo );
+            if ( pAmmo->IsAlive() && pAmmo->CanBeIntercepted() && pAmmo->WasIntercepted() == false )
+            {
+                vec.push_back( pAmmo );
+            }
         }
     }
 }
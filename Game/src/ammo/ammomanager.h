@@ -17,13 +17,19 @@
 
 #pragma once
 
+#include <array>
 #include <genesis.h>
-#include <physics/raytestresult.h>
+#include <memory>
+#include <physics/rayquery.h>
 #include <physics/simulation.h>
 #include <resourcemanager.h>
 #include <scene/sceneobject.h>
 #include <vector>
 
+#include "ammo/ammopool.h"
+#include "ammo/projectilepool.h"
+#include "ship/moduleinfo.h"
+
 namespace Genesis
 {
 class ResourceModel;
@@ -35,14 +41,15 @@ namespace Hexterminate
 class Ammo;
 class Weapon;
 
-using AmmoVector = std::vector<Ammo*>;
+// A handle identifies the pool in the top byte and the slot within the pool in the remaining bits.
 using AmmoHandle = int32_t;
 static const AmmoHandle InvalidAmmoHandle = -1;
 
 ///////////////////////////////////////////////////////////////////////////////
 // AmmoManager
-// Circular buffer containing all bullets, missiles, beams, etc flying around
-// in space.
+// Contains all bullets, missiles, beams, etc flying around in space, with a
+// pool for each weapon system. Projectiles live in a ProjectilePool and are
+// not individually addressable, so creating one returns InvalidAmmoHandle.
 ///////////////////////////////////////////////////////////////////////////////
 
 class AmmoManager : public Genesis::SceneObject
@@ -61,23 +68,43 @@ public:
     Ammo* Get( AmmoHandle handle ) const;
 
 private:
-    using AmmoSizeType = AmmoHandle;
+    enum class HitResult
+    {
+        Ignored,
+        Hit,
+        HitAndStop
+    };
+
+    void ProcessAmmoHits( size_t queryIndex, Ammo* pAmmo, float delta );
+    void ProcessProjectileHits( size_t queryIndex, size_t projectileIndex, float delta );
+
+    // pAmmo is null for projectiles, which are not Ammo objects.
+    HitResult ResolveHit( const Genesis::Physics::RayQueryHit& result, Weapon* pOwnerWeapon, const glm::vec3& source, const glm::vec3& destination, Ammo* pAmmo, float delta );
+    void OnKilledByHit( Weapon* pOwnerWeapon );
 
-    AmmoHandle GetFreeAmmo();
     void CreateHitEffect( const glm::vec3& position, const glm::vec3& hitNormal, Weapon* pWeapon );
     void PlayHitSFX( const glm::vec3& position, Weapon* pWeapon );
 
-    AmmoSizeType m_Idx;
-    AmmoVector m_Ammo;
-    Genesis::Physics::RayTestResultVector m_RayTestResults;
+    static const int sAmmoHandleSlotBits = 24;
+    static const AmmoHandle sAmmoHandleSlotMask = ( 1 << sAmmoHandleSlotBits ) - 1;
+
+    std::array<std::unique_ptr<AmmoPoolBase>, static_cast<size_t>( WeaponSystem::Count )> m_Pools;
+    ProjectilePool m_Projectiles;
+
+    // The ray queries for all live ammo are batched. The first m_RayQueryAmmo.size() queries were issued
+    // by m_RayQueryAmmo[i], and the remaining ones by the projectile with the same index in m_Projectiles.
+    Genesis::Physics::RayQueryVector m_RayQueries;
+    AmmoVector m_RayQueryAmmo;
+    Genesis::Physics::RayQueryResults m_RayQueryResults;
 };
 
 inline Ammo* AmmoManager::Get( AmmoHandle handle ) const
 {
     SDL_assert( handle != InvalidAmmoHandle );
     SDL_assert( handle >= 0 );
-    SDL_assert( handle < m_Ammo.size() );
-    return m_Ammo[ handle ];
+    const size_t poolIndex = static_cast<size_t>( handle >> sAmmoHandleSlotBits );
+    SDL_assert( poolIndex < m_Pools.size() && m_Pools[ poolIndex ] != nullptr );
+    return m_Pools[ poolIndex ]->Get( static_cast<uint32_t>( handle & sAmmoHandleSlotMask ) );
 }
 
 } // namespace Hexterminate
\ No newline at end of file
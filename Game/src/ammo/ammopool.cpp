@@ -0,0 +1,62 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Hexterminate.
+//
+// Hexterminate is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Hexterminate is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hexterminate. If not, see <http://www.gnu.org/licenses/>.
+
+#include "ammo/ammo.h"
+#include "ammo/ammopool.h"
+
+namespace Hexterminate
+{
+
+Ammo* AmmoPoolBase::Acquire( uint32_t& slot )
+{
+    if ( m_FreeSlots.empty() )
+    {
+        Grow();
+    }
+
+    slot = m_FreeSlots.back();
+    m_FreeSlots.pop_back();
+
+    Ammo* pAmmo = m_Slots[ slot ];
+    m_Alive.push_back( pAmmo );
+    m_AliveSlots.push_back( slot );
+    return pAmmo;
+}
+
+void AmmoPoolBase::Compact()
+{
+    size_t count = m_Alive.size();
+    for ( size_t i = 0; i < count; )
+    {
+        if ( m_Alive[ i ]->IsAlive() )
+        {
+            i++;
+        }
+        else
+        {
+            m_FreeSlots.push_back( m_AliveSlots[ i ] );
+            count--;
+            m_Alive[ i ] = m_Alive[ count ];
+            m_AliveSlots[ i ] = m_AliveSlots[ count ];
+        }
+    }
+
+    m_Alive.resize( count );
+    m_AliveSlots.resize( count );
+}
+
+} // namespace Hexterminate
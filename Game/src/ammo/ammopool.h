@@ -0,0 +1,109 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Hexterminate.
+//
+// Hexterminate is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Hexterminate is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hexterminate. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <SDL.h>
+
+namespace Hexterminate
+{
+
+class Ammo;
+
+using AmmoVector = std::vector<Ammo*>;
+
+static const uint32_t sAmmoPoolChunkSize = 128u;
+
+///////////////////////////////////////////////////////////////////////////////
+// AmmoPoolBase
+// Fixed slots of ammo of a single type, together with a dense list of the
+// ones currently in flight. Slots never move once allocated, so a slot index
+// can be handed out as part of an AmmoHandle. Dead ammo stays in the alive
+// list until the next Compact(), at which point its slot becomes free again.
+///////////////////////////////////////////////////////////////////////////////
+
+class AmmoPoolBase
+{
+public:
+    virtual ~AmmoPoolBase() {}
+
+    Ammo* Acquire( uint32_t& slot );
+    Ammo* Get( uint32_t slot ) const;
+    const AmmoVector& GetAlive() const;
+    void Compact();
+
+protected:
+    virtual void Grow() = 0;
+
+    AmmoVector m_Slots;
+    AmmoVector m_Alive;
+    std::vector<uint32_t> m_AliveSlots;
+    std::vector<uint32_t> m_FreeSlots;
+};
+
+inline Ammo* AmmoPoolBase::Get( uint32_t slot ) const
+{
+    SDL_assert( slot < m_Slots.size() );
+    return m_Slots[ slot ];
+}
+
+inline const AmmoVector& AmmoPoolBase::GetAlive() const
+{
+    return m_Alive;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// AmmoPool
+// The ammo objects are allocated in chunks and reused, so once a pool has
+// grown to the number of shots a battle needs, firing doesn't allocate.
+///////////////////////////////////////////////////////////////////////////////
+
+template <typename T> class AmmoPool : public AmmoPoolBase
+{
+protected:
+    virtual void Grow() override;
+
+private:
+    std::vector<std::unique_ptr<T[]>> m_Chunks;
+};
+
+template <typename T> void AmmoPool<T>::Grow()
+{
+    m_Chunks.push_back( std::make_unique<T[]>( sAmmoPoolChunkSize ) );
+    T* pChunk = m_Chunks.back().get();
+
+    const uint32_t firstSlot = static_cast<uint32_t>( m_Slots.size() );
+    for ( uint32_t i = 0; i < sAmmoPoolChunkSize; ++i )
+    {
+        m_Slots.push_back( &pChunk[ i ] );
+    }
+
+    // Free slots are taken from the back, so the lowest slots get used first.
+    for ( uint32_t i = sAmmoPoolChunkSize; i > 0; --i )
+    {
+        m_FreeSlots.push_back( firstSlot + i - 1 );
+    }
+
+    m_Alive.reserve( m_Slots.size() );
+    m_AliveSlots.reserve( m_Slots.size() );
+}
+
+} // namespace Hexterminate
@@ -54,13 +54,11 @@ void Antiproton::Create( Weapon* pWeapon, float additionalRotation /* = 0.0f */
 
     Ammo::Create( pWeapon, additionalRotation );
 
-    m_IsGlowSource = false;
-    m_DiesOnHit = true;
-
     float muzzleflashScale = pWeapon->GetInfo()->GetMuzzleflashScale();
     g_pGame->GetCurrentSector()->GetMuzzleflashManager()->Add(
         MuzzleflashData( pWeapon, m_MuzzleOffset, 0, gRand( muzzleflashScale * 0.8f, muzzleflashScale * 1.2f ), gRand( 0.075f, 0.125f ) ) );
 
+    m_QuantumState = QuantumState::Black;
     AddonQuantumStateAlternator* pAlternator = pWeapon->GetOwner()->GetQuantumStateAlternator();
     if ( pAlternator != nullptr )
     {
@@ -72,7 +70,10 @@ void Antiproton::Create( Weapon* pWeapon, float additionalRotation /* = 0.0f */
         }
     }
 
-    m_pVertexBuffer = new VertexBuffer( GeometryType::Triangle, VBO_POSITION | VBO_UV | VBO_COLOR );
+    if ( m_pVertexBuffer == nullptr )
+    {
+        m_pVertexBuffer = new VertexBuffer( GeometryType::Triangle, VBO_POSITION | VBO_UV | VBO_COLOR );
+    }
 
     if ( m_pShader == nullptr )
     {
@@ -63,7 +63,10 @@ void Beam::SetupBeam()
 {
     using namespace Genesis;
 
-    m_pBeamVertexBuffer = new VertexBuffer( GeometryType::Triangle, VBO_POSITION | VBO_UV | VBO_COLOR );
+    if ( m_pBeamVertexBuffer == nullptr )
+    {
+        m_pBeamVertexBuffer = new VertexBuffer( GeometryType::Triangle, VBO_POSITION | VBO_UV | VBO_COLOR );
+    }
 
     if ( m_pShader == nullptr )
     {
@@ -79,7 +82,10 @@ void Beam::SetupBeamFlare()
 {
     using namespace Genesis;
 
-    m_pFlareVertexBuffer = new VertexBuffer( GeometryType::Triangle, VBO_POSITION | VBO_UV | VBO_COLOR );
+    if ( m_pFlareVertexBuffer == nullptr )
+    {
+        m_pFlareVertexBuffer = new VertexBuffer( GeometryType::Triangle, VBO_POSITION | VBO_UV | VBO_COLOR );
+    }
 
     if ( m_pFlareShader == nullptr )
     {
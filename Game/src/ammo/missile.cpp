@@ -23,6 +23,7 @@
 #include "ammo/missile.h"
 #include "hexterminate.h"
 #include "sector/sector.h"
+#include "sector/spatialindex.h"
 #include "ship/ship.h"
 #include "ship/weapon.h"
 #include "sprite/sprite.h"
@@ -71,6 +72,9 @@ void Missile::Create( Weapon* pWeapon, float additionalRotation /* = 0.0f */ )
 {
     Ammo::Create( pWeapon, additionalRotation );
 
+    m_LaunchTimer = 0.0f;
+    m_SwarmTimer = (float)( rand() % 314 ) / 100.0f;
+
     m_pModel = (Genesis::ResourceModel*)Genesis::FrameWork::GetResourceManager()->GetResource( GetResourceName() );
     m_pModel->SetFlipAxis( false );
 
@@ -89,31 +93,11 @@ Trail* Missile::CreateTrail() const
 
 Ship* Missile::FindClosestShip( const glm::vec3& position )
 {
-    const ShipList& ships = g_pGame->GetCurrentSector()->GetShipList();
-    float closestDistance = FLT_MAX;
-    Ship* pClosestTarget = nullptr;
-    for ( auto& pShip : ships )
-    {
-        // Don't target friendly ships
-        if ( Faction::sIsEnemyOf( pShip->GetFaction(), m_pOwner->GetOwner()->GetFaction() ) == false )
-            continue;
-
-        // Or dead ships...
-        if ( pShip->IsTerminating() || pShip->IsDestroyed() )
-            continue;
-
-        // Or ships that are having their bridge removed (because they are in edit mode!)
-        if ( pShip->GetTowerModule() == nullptr )
-            continue;
-
-        float distance = glm::distance( pShip->GetTowerPosition(), position );
-        if ( distance < closestDistance )
-        {
-            closestDistance = distance;
-            pClosestTarget = pShip;
-        }
-    }
-    return pClosestTarget;
+    const SpatialIndex* pSpatialIndex = g_pGame->GetCurrentSector()->GetSpatialIndex();
+    return pSpatialIndex->FindClosestHostileShip( glm::vec2( position.x, position.y ), m_pOwner->GetOwner()->GetFaction(), FLT_MAX, []( const Ship* pShip ) {
+        // Don't target dead ships, or ships that are having their bridge removed (because they are in edit mode!)
+        return pShip->IsTerminating() == false && pShip->IsDestroyed() == false && pShip->GetTowerModule() != nullptr;
+    } );
 }
 
 void Missile::Update( float delta )
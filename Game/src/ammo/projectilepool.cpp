@@ -0,0 +1,162 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Hexterminate.
+//
+// Hexterminate is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Hexterminate is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hexterminate. If not, see <http://www.gnu.org/licenses/>.
+
+#include <glm/gtc/matrix_access.hpp>
+
+#include <math/constants.h>
+#include <rendersystem.h>
+#include <resources/resourcemodel.h>
+
+#include "ammo/projectilepool.h"
+#include "hexterminate.h"
+#include "misc/mathaux.h"
+#include "muzzleflash/muzzleflashmanager.h"
+#include "sector/sector.h"
+#include "ship/weapon.h"
+
+namespace Hexterminate
+{
+
+ProjectilePool::ProjectilePool()
+    : m_pModel( nullptr )
+{
+    const size_t sInitialCapacity = 512u;
+    m_Source.reserve( sInitialCapacity );
+    m_Direction.reserve( sInitialCapacity );
+    m_Speed.reserve( sInitialCapacity );
+    m_Range.reserve( sInitialCapacity );
+    m_RayLength.reserve( sInitialCapacity );
+    m_Angle.reserve( sInitialCapacity );
+    m_Owner.reserve( sInitialCapacity );
+    m_Alive.reserve( sInitialCapacity );
+}
+
+void ProjectilePool::Add( Weapon* pWeapon, float additionalRotation /* = 0.0f */ )
+{
+    if ( m_pModel == nullptr )
+    {
+        m_pModel = (Genesis::ResourceModel*)Genesis::FrameWork::GetResourceManager()->GetResource( "data/models/ammo/projectile.tmf" );
+        m_pModel->SetFlipAxis( false );
+    }
+
+    const glm::vec3 muzzleOffset = pWeapon->GetMuzzleOffset();
+    pWeapon->MarkMuzzleAsUsed();
+    const glm::mat4x4 weaponTransform = pWeapon->GetWorldTransform() * glm::translate( muzzleOffset );
+
+    glm::vec3 weaponPosition( glm::column( weaponTransform, 3 ) );
+    glm::vec3 weaponForward( glm::column( weaponTransform, 1 ) );
+    Math::RotateVector( weaponForward, Genesis::kDegToRad * additionalRotation );
+
+    WeaponInfo* pInfo = pWeapon->GetInfo();
+    m_Source.push_back( weaponPosition );
+    m_Direction.push_back( weaponForward );
+    m_Speed.push_back( pInfo->GetSpeed() );
+    m_Range.push_back( pInfo->GetRange( pWeapon->GetOwner() ) );
+    m_RayLength.push_back( pInfo->GetRayLength() );
+    m_Angle.push_back( pWeapon->GetAngle() + additionalRotation );
+    m_Owner.push_back( pWeapon );
+    m_Alive.push_back( 1 );
+
+    const float muzzleflashScale = pInfo->GetMuzzleflashScale();
+    g_pGame->GetCurrentSector()->GetMuzzleflashManager()->Add(
+        MuzzleflashData( pWeapon, muzzleOffset, 0, gRand( muzzleflashScale * 0.8f, muzzleflashScale * 1.2f ), gRand( 0.075f, 0.125f ) ) );
+}
+
+void ProjectilePool::Update( float delta )
+{
+    const size_t count = GetCount();
+    for ( size_t i = 0; i < count; ++i )
+    {
+        if ( m_Alive[ i ] == 0 )
+        {
+            continue;
+        }
+
+        if ( m_Range[ i ] <= 0.0f )
+        {
+            m_Alive[ i ] = 0;
+            m_Owner[ i ]->ResetSiegebreakerStacks();
+        }
+        else
+        {
+            const float distance = m_Speed[ i ] * delta;
+            m_Source[ i ] += m_Direction[ i ] * distance;
+            m_Range[ i ] -= distance;
+        }
+    }
+}
+
+void ProjectilePool::Render()
+{
+    using namespace glm;
+    using namespace Genesis;
+
+    const size_t count = GetCount();
+    if ( count == 0 )
+    {
+        return;
+    }
+
+    FrameWork::GetRenderSystem()->SetBlendMode( BlendMode::Add );
+
+    for ( size_t i = 0; i < count; ++i )
+    {
+        if ( m_Alive[ i ] != 0 )
+        {
+            const mat4 translation = translate( m_Source[ i ] );
+            const mat4 rotation = rotate( mat4( 1.0f ), -m_Angle[ i ] + 180.0f * Genesis::kDegToRad, vec3( 0.0f, 0.0f, 1.0f ) );
+            const mat4 scaling = scale( glm::vec3( 8.0f, m_RayLength[ i ], 1.0f ) );
+            m_pModel->Render( translation * rotation * scaling );
+        }
+    }
+
+    FrameWork::GetRenderSystem()->SetBlendMode( BlendMode::Disabled );
+}
+
+void ProjectilePool::Compact()
+{
+    size_t count = GetCount();
+    for ( size_t i = 0; i < count; )
+    {
+        if ( m_Alive[ i ] != 0 )
+        {
+            i++;
+            continue;
+        }
+
+        count--;
+        m_Source[ i ] = m_Source[ count ];
+        m_Direction[ i ] = m_Direction[ count ];
+        m_Speed[ i ] = m_Speed[ count ];
+        m_Range[ i ] = m_Range[ count ];
+        m_RayLength[ i ] = m_RayLength[ count ];
+        m_Angle[ i ] = m_Angle[ count ];
+        m_Owner[ i ] = m_Owner[ count ];
+        m_Alive[ i ] = m_Alive[ count ];
+    }
+
+    m_Source.resize( count );
+    m_Direction.resize( count );
+    m_Speed.resize( count );
+    m_Range.resize( count );
+    m_RayLength.resize( count );
+    m_Angle.resize( count );
+    m_Owner.resize( count );
+    m_Alive.resize( count );
+}
+
+} // namespace Hexterminate
@@ -0,0 +1,105 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Hexterminate.
+//
+// Hexterminate is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Hexterminate is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hexterminate. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+namespace Genesis
+{
+class ResourceModel;
+}
+
+namespace Hexterminate
+{
+
+class Weapon;
+
+///////////////////////////////////////////////////////////////////////////////
+// ProjectilePool
+// Projectiles are by far the most numerous type of ammo, and all they do is
+// fly in a straight line until they hit something or run out of range. They
+// are stored as parallel arrays rather than as Ammo objects, so updating,
+// collecting ray queries and rendering them walks contiguous memory.
+// Projectiles are swap-removed on Compact(), so indices are only stable
+// between two calls to it.
+///////////////////////////////////////////////////////////////////////////////
+
+class ProjectilePool
+{
+public:
+    ProjectilePool();
+
+    void Add( Weapon* pWeapon, float additionalRotation = 0.0f );
+    void Update( float delta );
+    void Render();
+    void Kill( size_t index );
+    void Compact();
+
+    size_t GetCount() const;
+    bool IsAlive( size_t index ) const;
+    const glm::vec3& GetSource( size_t index ) const;
+    glm::vec3 GetDestination( size_t index ) const;
+    Weapon* GetOwner( size_t index ) const;
+
+private:
+    std::vector<glm::vec3> m_Source;
+    std::vector<glm::vec3> m_Direction;
+    std::vector<float> m_Speed;
+    std::vector<float> m_Range;
+    std::vector<float> m_RayLength;
+    std::vector<float> m_Angle;
+    std::vector<Weapon*> m_Owner;
+    std::vector<uint8_t> m_Alive;
+
+    Genesis::ResourceModel* m_pModel;
+};
+
+inline size_t ProjectilePool::GetCount() const
+{
+    return m_Source.size();
+}
+
+inline bool ProjectilePool::IsAlive( size_t index ) const
+{
+    return m_Alive[ index ] != 0;
+}
+
+inline void ProjectilePool::Kill( size_t index )
+{
+    m_Alive[ index ] = 0;
+}
+
+inline const glm::vec3& ProjectilePool::GetSource( size_t index ) const
+{
+    return m_Source[ index ];
+}
+
+inline glm::vec3 ProjectilePool::GetDestination( size_t index ) const
+{
+    return m_Source[ index ] + m_Direction[ index ] * m_RayLength[ index ];
+}
+
+inline Weapon* ProjectilePool::GetOwner( size_t index ) const
+{
+    return m_Owner[ index ];
+}
+
+} // namespace Hexterminate
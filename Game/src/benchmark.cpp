@@ -0,0 +1,212 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Hexterminate.
+//
+// Hexterminate is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Hexterminate is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hexterminate. If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include <genesis.h>
+#include <logger.h>
+#include <profiling/profiler.h>
+
+#include "benchmark.h"
+#include "faction/faction.h"
+#include "fleet/fleet.h"
+#include "hexterminate.h"
+#include "sector/sector.h"
+#include "sector/sectorinfo.h"
+#include "ship/shipinfo.h"
+
+namespace Hexterminate
+{
+
+// Zones which are recorded more than once per tick (such as Ship::Update, once per ship) are summed together.
+const std::array<const char*, Benchmark::sTrackedZoneCount> Benchmark::sTrackedZones = {
+    "TaskManager::Update",
+    "Ship::Update",
+    "ControllerAI::Update",
+    "AmmoManager::Update",
+    "ParticleManager::Update",
+    "Physics::Simulation::Step"
+};
+
+Benchmark::Benchmark( Genesis::CommandLineParameters* pParameters )
+    : HeadlessSimulation( pParameters )
+    , m_WarmupTicks( 120 )
+    , m_ShipsA( 16 )
+    , m_TemplateA( "lancer" )
+    , m_ShipsB( 16 )
+    , m_TemplateB( "pirate_gunship_2" )
+    , m_FactionB( "Pirate" )
+{
+    std::string value;
+    if ( pParameters->GetParameterValue( "--warmup", value ) )
+    {
+        m_WarmupTicks = static_cast<unsigned int>( std::max( 0, atoi( value.c_str() ) ) );
+    }
+
+    if ( pParameters->GetParameterValue( "--ships-a", value ) )
+    {
+        m_ShipsA = static_cast<unsigned int>( std::max( 0, atoi( value.c_str() ) ) );
+    }
+
+    if ( pParameters->GetParameterValue( "--ships-b", value ) )
+    {
+        m_ShipsB = static_cast<unsigned int>( std::max( 0, atoi( value.c_str() ) ) );
+    }
+
+    pParameters->GetParameterValue( "--template-a", m_TemplateA );
+    pParameters->GetParameterValue( "--template-b", m_TemplateB );
+    pParameters->GetParameterValue( "--faction-b", m_FactionB );
+
+    // --ticks is the number of ticks which are recorded, so the warm up comes on top of it.
+    const unsigned int recordedTicks = m_Ticks;
+    m_Ticks += m_WarmupTicks;
+
+    for ( auto& samples : m_Samples )
+    {
+        samples.reserve( recordedTicks );
+    }
+}
+
+void Benchmark::PrepareSector( SectorInfo* pSectorInfo )
+{
+    // No regional fleet, contesting fleets, reinforcement waves or events: the fleets are spawned by the benchmark.
+    pSectorInfo->SetProceduralSpawning( false );
+}
+
+void Benchmark::PopulateSector( Sector* pSector )
+{
+    SDL_assert( pSector != nullptr );
+
+    Faction* pFactionB = g_pGame->GetFaction( m_FactionB );
+    if ( pFactionB == nullptr )
+    {
+        Genesis::FrameWork::GetLogger()->LogWarning( "Benchmark couldn't find faction '%s'.", m_FactionB.c_str() );
+        return;
+    }
+
+    SpawnFleet( pSector, g_pGame->GetFaction( FactionId::Empire ), m_TemplateA, m_ShipsA );
+    SpawnFleet( pSector, pFactionB, m_TemplateB, m_ShipsB );
+
+    Genesis::FrameWork::GetLogger()->LogInfo( "Benchmark: %u x '%s' (Empire) vs %u x '%s' (%s), %u warm up ticks.",
+        m_ShipsA, m_TemplateA.c_str(), m_ShipsB, m_TemplateB.c_str(), m_FactionB.c_str(), m_WarmupTicks );
+}
+
+bool Benchmark::SpawnFleet( Sector* pSector, Faction* pFaction, const std::string& shipTemplate, unsigned int count )
+{
+    if ( count == 0 )
+    {
+        return true;
+    }
+
+    const ShipInfo* pShipInfo = g_pGame->GetShipInfoManager()->Get( pFaction, shipTemplate );
+    if ( pShipInfo == nullptr )
+    {
+        Genesis::FrameWork::GetLogger()->LogWarning( "Benchmark couldn't find ship '%s' for faction '%s'.", shipTemplate.c_str(), pFaction->GetName().c_str() );
+        return false;
+    }
+
+    FleetSharedPtr pFleet = std::make_shared<Fleet>();
+    pFleet->Initialise( pFaction, pSector->GetSectorInfo() );
+    for ( unsigned int i = 0; i < count; ++i )
+    {
+        pFleet->AddShip( pShipInfo );
+    }
+
+    pSector->Reinforce( pFleet, true );
+    m_Fleets.push_back( pFleet );
+    return true;
+}
+
+void Benchmark::GatherZones( unsigned int tick )
+{
+    HeadlessSimulation::GatherZones( tick );
+
+    if ( tick < m_WarmupTicks )
+    {
+        return;
+    }
+
+    // The profiler gathers zones once per tick, at the same point of each tick, so every frame's worth of zones
+    // contains exactly one run of each task even if it straddles two calls to TaskManager::Update().
+    std::array<float, sTrackedZoneCount> tickMs;
+    tickMs.fill( 0.0f );
+    for ( const Genesis::Profiling::Zone& zone : Genesis::FrameWork::GetProfiler()->GetLastFrameZones() )
+    {
+        for ( size_t i = 0; i < sTrackedZoneCount; ++i )
+        {
+            if ( strcmp( zone.pName, sTrackedZones[ i ] ) == 0 )
+            {
+                tickMs[ i ] += static_cast<float>( zone.duration ) / 1000.0f;
+                break;
+            }
+        }
+    }
+
+    for ( size_t i = 0; i < sTrackedZoneCount; ++i )
+    {
+        m_Samples[ i ].push_back( tickMs[ i ] );
+    }
+}
+
+void Benchmark::Report( double elapsedSeconds ) const
+{
+    HeadlessSimulation::Report( elapsedSeconds );
+
+    Genesis::Logger* pLogger = Genesis::FrameWork::GetLogger();
+    if ( m_Samples[ 0 ].empty() )
+    {
+        pLogger->LogWarning( "Benchmark stopped during its %u warm up ticks, so no latency was recorded.", m_WarmupTicks );
+        return;
+    }
+
+    pLogger->LogInfo( "Benchmark latency per tick, over %zu ticks (ms):", m_Samples[ 0 ].size() );
+    pLogger->LogInfo( "%-32s %10s %10s %10s %10s %10s", "Zone", "Mean", "p50", "p90", "p99", "Max" );
+
+    for ( size_t i = 0; i < sTrackedZoneCount; ++i )
+    {
+        std::vector<float> samples( m_Samples[ i ] );
+        if ( samples.empty() )
+        {
+            continue;
+        }
+
+        std::sort( samples.begin(), samples.end() );
+        auto percentile = [ &samples ]( float p ) {
+            const size_t rank = static_cast<size_t>( std::ceil( p * static_cast<float>( samples.size() ) ) );
+            return samples[ std::clamp<size_t>( rank, 1, samples.size() ) - 1 ];
+        };
+
+        double total = 0.0;
+        for ( float sample : samples )
+        {
+            total += sample;
+        }
+
+        pLogger->LogInfo( "%-32s %10.3f %10.3f %10.3f %10.3f %10.3f",
+            sTrackedZones[ i ],
+            total / static_cast<double>( samples.size() ),
+            percentile( 0.5f ),
+            percentile( 0.9f ),
+            percentile( 0.99f ),
+            samples.back() );
+    }
+}
+
+} // namespace Hexterminate
@@ -0,0 +1,75 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Hexterminate.
+//
+// Hexterminate is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Hexterminate is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hexterminate. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "fleet/fleet.fwd.h"
+#include "headlesssimulation.h"
+
+namespace Hexterminate
+{
+
+class Faction;
+
+///////////////////////////////////////////////////////////////////////////////
+// Benchmark
+// A canned sector battle between two fleets made of a single ship template
+// each, used to catch performance regressions. The sector's own fleets and
+// events are disabled so that only the benchmark's fleets (and the player's
+// ship) take part. After a warm up, the time spent in each tracked zone is
+// recorded every tick for --ticks ticks and reported as percentiles. In
+// addition to the HeadlessSimulation parameters, it recognises:
+//   --warmup <n>       Ticks to run before recording, on top of --ticks (default 120).
+//   --ships-a <n>      Number of Imperial ships (default 16).
+//   --template-a <s>   Imperial ship template (default "lancer").
+//   --ships-b <n>      Number of hostile ships (default 16).
+//   --template-b <s>   Hostile ship template (default "pirate_gunship_2").
+//   --faction-b <s>    Hostile faction (default "Pirate").
+///////////////////////////////////////////////////////////////////////////////
+
+class Benchmark : public HeadlessSimulation
+{
+public:
+    Benchmark( Genesis::CommandLineParameters* pParameters );
+
+protected:
+    virtual void PrepareSector( SectorInfo* pSectorInfo ) override;
+    virtual void PopulateSector( Sector* pSector ) override;
+    virtual void GatherZones( unsigned int tick ) override;
+    virtual void Report( double elapsedSeconds ) const override;
+
+private:
+    bool SpawnFleet( Sector* pSector, Faction* pFaction, const std::string& shipTemplate, unsigned int count );
+
+    static const size_t sTrackedZoneCount = 6;
+    static const std::array<const char*, sTrackedZoneCount> sTrackedZones;
+
+    unsigned int m_WarmupTicks;
+    unsigned int m_ShipsA;
+    std::string m_TemplateA;
+    unsigned int m_ShipsB;
+    std::string m_TemplateB;
+    std::string m_FactionB;
+    FleetList m_Fleets;
+    std::array<std::vector<float>, sTrackedZoneCount> m_Samples; // Milliseconds spent in each tracked zone, per tick.
+};
+
+} // namespace Hexterminate
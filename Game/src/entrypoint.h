@@ -1,4 +1,4 @@
-// Copyright 2014 Pedro Nunes
+// Copyright 2026 Pedro Nunes
 //
 // This file is part of Hexterminate.
 //
@@ -17,34 +17,27 @@
 
 #pragma once
 
-#include "ammo/ammo.h"
+#include <memory>
 
 namespace Genesis
 {
-class ResourceModel;
+class CommandLineParameters;
 }
 
 namespace Hexterminate
 {
 
-class Weapon;
+class HeadlessSimulation;
 
 ///////////////////////////////////////////////////////////////////////////////
-// Projectile
+// Everything which differs between the game and the benchmark executables.
+// Both are linked from the same objects, with each executable providing its
+// own implementation from the entrypoint folder.
 ///////////////////////////////////////////////////////////////////////////////
 
-class Projectile : public Ammo
-{
-public:
-    Projectile();
-    virtual ~Projectile(){};
-
-    virtual void Create( Weapon* pWeapon, float additionalRotation = 0.0f ) override;
-    virtual void Update( float delta ) override;
-    virtual void Render() override;
+// True if the executable never opens a window, regardless of its parameters.
+bool IsHeadlessExecutable();
 
-private:
-    Genesis::ResourceModel* m_pModel;
-};
+std::unique_ptr<HeadlessSimulation> CreateHeadlessSimulation( Genesis::CommandLineParameters* pParameters );
 
 } // namespace Hexterminate
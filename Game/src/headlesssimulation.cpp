@@ -0,0 +1,208 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Hexterminate.
+//
+// Hexterminate is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Hexterminate is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hexterminate. If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+#include <genesis.h>
+#include <logger.h>
+#include <profiling/profiler.h>
+#include <taskmanager.h>
+
+#include "faction/faction.h"
+#include "fleet/fleet.h"
+#include "globals.h"
+#include "headlesssimulation.h"
+#include "hexterminate.h"
+#include "misc/random.h"
+#include "misc/randomshuffle.h"
+#include "sector/galaxy.h"
+#include "sector/galaxycreationinfo.h"
+#include "sector/sectorinfo.h"
+#include "ship/ship.h"
+#include "ship/shipinfo.h"
+
+namespace Hexterminate
+{
+
+HeadlessSimulation::HeadlessSimulation( Genesis::CommandLineParameters* pParameters )
+    : m_Ticks( 3600 )
+    , m_Timestep( 1.0f / 60.0f )
+    , m_Seed( 1 )
+{
+    std::string value;
+    if ( pParameters->GetParameterValue( "--ticks", value ) )
+    {
+        m_Ticks = static_cast<unsigned int>( std::max( 1, atoi( value.c_str() ) ) );
+    }
+
+    if ( pParameters->GetParameterValue( "--tick-rate", value ) )
+    {
+        m_Timestep = 1.0f / std::max( 1.0f, static_cast<float>( atof( value.c_str() ) ) );
+    }
+
+    if ( pParameters->GetParameterValue( "--seed", value ) )
+    {
+        m_Seed = static_cast<unsigned int>( strtoul( value.c_str(), nullptr, 10 ) );
+    }
+
+    pParameters->GetParameterValue( "--sector", m_SectorName );
+}
+
+int HeadlessSimulation::Run()
+{
+    using namespace Genesis;
+    Logger* pLogger = FrameWork::GetLogger();
+
+    // Everything which is randomised is seeded here, so runs with the same parameters play out the same way.
+    // Tasks which run concurrently can still interleave differently, so this is as close as it gets rather
+    // than bit-for-bit reproducible.
+    Random::Initialise( m_Seed );
+    RandomShuffle::Initialise( m_Seed );
+    srand( m_Seed );
+
+    // Every update runs exactly one tick of the simulation.
+    TaskManager* pTaskManager = FrameWork::GetTaskManager();
+    pTaskManager->SetFixedTimeStep( m_Timestep );
+
+    if ( StartGame() == false )
+    {
+        return -1;
+    }
+
+    pLogger->LogInfo( "Headless simulation: %u ticks at %.1f Hz, seed %u.", m_Ticks, 1.0f / m_Timestep, m_Seed );
+
+    m_ZoneTotals.clear();
+    unsigned int tick = 0;
+    const auto start = std::chrono::high_resolution_clock::now();
+    for ( ; tick < m_Ticks; ++tick )
+    {
+        if ( pTaskManager->IsRunning() == false || g_pGame->IsQuitRequested() )
+        {
+            break;
+        }
+
+        pTaskManager->Update( m_Timestep );
+        GatherZones( tick );
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+    if ( tick < m_Ticks )
+    {
+        pLogger->LogWarning( "Headless simulation stopped early, after %u ticks.", tick );
+    }
+
+    m_Ticks = tick;
+    Report( elapsed.count() );
+    return 0;
+}
+
+bool HeadlessSimulation::StartGame()
+{
+    Genesis::Logger* pLogger = Genesis::FrameWork::GetLogger();
+    const std::string shipTemplate( "phalanx" );
+    const ShipInfo* pShipInfo = g_pGame->GetShipInfoManager()->Get( g_pGame->GetPlayerFaction(), shipTemplate );
+    if ( pShipInfo == nullptr )
+    {
+        pLogger->LogWarning( "Headless simulation couldn't find ship '%s' for the player faction.", shipTemplate.c_str() );
+        return false;
+    }
+
+    ShipCustomisationData customisationData( pShipInfo->GetModuleInfoHexGrid() );
+    customisationData.m_CaptainName = "Headless";
+    customisationData.m_ShipName = "Headless";
+
+    g_pGame->SetGameMode( GameMode::Campaign );
+    g_pGame->StartNewLegacyGame( customisationData, shipTemplate, false, GalaxyCreationInfo( GalaxyCreationInfo::CreationMode::Campaign ) );
+
+    SectorInfo* pSectorInfo = FindSector();
+    FleetSharedPtr pPlayerFleet = g_pGame->GetPlayerFleet().lock();
+    if ( pSectorInfo == nullptr || pPlayerFleet == nullptr )
+    {
+        pLogger->LogWarning( "Headless simulation couldn't find a sector to fight in." );
+        return false;
+    }
+
+    // Place the player's fleet in the sector directly, as the sector contests whichever fleets are in it.
+    int x, y;
+    pSectorInfo->GetCoordinates( x, y );
+    pPlayerFleet->SetPosition( ( (float)x + 0.5f ) / NumSectorsX, ( (float)y + 0.5f ) / NumSectorsY );
+    pPlayerFleet->SetDestinationSector( pSectorInfo );
+
+    PrepareSector( pSectorInfo );
+
+    pLogger->LogInfo( "Headless simulation entering sector '%s'.", pSectorInfo->GetName().c_str() );
+    g_pGame->EnterSector( pSectorInfo );
+
+    PopulateSector( g_pGame->GetCurrentSector() );
+    return true;
+}
+
+SectorInfo* HeadlessSimulation::FindSector() const
+{
+    if ( m_SectorName.empty() )
+    {
+        const SectorInfoVector& sectors = g_pGame->GetFaction( FactionId::Pirate )->GetControlledSectors();
+        return sectors.empty() ? nullptr : sectors.front();
+    }
+
+    Galaxy* pGalaxy = g_pGame->GetGalaxy();
+    for ( int x = 0; x < NumSectorsX; ++x )
+    {
+        for ( int y = 0; y < NumSectorsY; ++y )
+        {
+            SectorInfo* pSectorInfo = pGalaxy->GetSectorInfo( x, y );
+            if ( pSectorInfo != nullptr && pSectorInfo->GetName() == m_SectorName )
+            {
+                return pSectorInfo;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void HeadlessSimulation::GatherZones( unsigned int tick )
+{
+    for ( const Genesis::Profiling::Zone& zone : Genesis::FrameWork::GetProfiler()->GetLastFrameZones() )
+    {
+        ZoneTotal& zoneTotal = m_ZoneTotals[ zone.pName ];
+        zoneTotal.totalMs += static_cast<double>( zone.duration ) / 1000.0;
+        zoneTotal.calls++;
+    }
+}
+
+void HeadlessSimulation::Report( double elapsedSeconds ) const
+{
+    Genesis::Logger* pLogger = Genesis::FrameWork::GetLogger();
+    pLogger->LogInfo( "Headless simulation took %.3fs: %.1f ticks/s, %.1fx real time.",
+        elapsedSeconds,
+        elapsedSeconds > 0.0 ? m_Ticks / elapsedSeconds : 0.0,
+        elapsedSeconds > 0.0 ? m_Ticks * m_Timestep / elapsedSeconds : 0.0 );
+
+    std::vector<std::pair<const char*, ZoneTotal>> zones( m_ZoneTotals.begin(), m_ZoneTotals.end() );
+    std::sort( zones.begin(), zones.end(), []( const auto& a, const auto& b ) { return a.second.totalMs > b.second.totalMs; } );
+
+    pLogger->LogInfo( "%-32s %12s %12s %10s", "Zone", "Total (ms)", "ms/tick", "Calls" );
+    for ( const auto& zone : zones )
+    {
+        pLogger->LogInfo( "%-32s %12.2f %12.4f %10u", zone.first, zone.second.totalMs, m_Ticks > 0 ? zone.second.totalMs / m_Ticks : 0.0, zone.second.calls );
+    }
+}
+
+} // namespace Hexterminate
@@ -0,0 +1,76 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Hexterminate.
+//
+// Hexterminate is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Hexterminate is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hexterminate. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+namespace Genesis
+{
+class CommandLineParameters;
+}
+
+namespace Hexterminate
+{
+
+class Sector;
+class SectorInfo;
+
+///////////////////////////////////////////////////////////////////////////////
+// HeadlessSimulation
+// Drives a sector battle without a window, GPU or audio device, stepping the
+// task manager by a fixed timestep for a given number of ticks. Once done, the
+// time spent in each profiled zone is written to the log, so the results can
+// be compared between runs. Recognised parameters:
+//   --ticks <n>        Number of ticks to simulate (default 3600).
+//   --tick-rate <hz>   Ticks per simulated second (default 60).
+//   --seed <n>         Seed for the random number generators (default 1).
+//   --sector <name>    Sector to fight in. Defaults to the first Pirate sector.
+///////////////////////////////////////////////////////////////////////////////
+
+class HeadlessSimulation
+{
+public:
+    HeadlessSimulation( Genesis::CommandLineParameters* pParameters );
+    virtual ~HeadlessSimulation() {}
+    int Run();
+
+protected:
+    virtual void PrepareSector( SectorInfo* pSectorInfo ) {} // Called before entering the sector.
+    virtual void PopulateSector( Sector* pSector ) {} // Called once the sector has been entered.
+    virtual void GatherZones( unsigned int tick );
+    virtual void Report( double elapsedSeconds ) const;
+
+    unsigned int m_Ticks;
+    float m_Timestep;
+    unsigned int m_Seed;
+    std::string m_SectorName;
+
+private:
+    bool StartGame();
+    SectorInfo* FindSector() const;
+
+    struct ZoneTotal
+    {
+        double totalMs;
+        unsigned int calls;
+    };
+    std::unordered_map<const char*, ZoneTotal> m_ZoneTotals;
+};
+
+} // namespace Hexterminate
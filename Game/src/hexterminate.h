@@ -174,6 +174,7 @@ public:
     ~Game();
     void Initialise();
     Genesis::TaskStatus Update( float delta );
+    Genesis::TaskStatus FixedUpdate( float delta );
 
     Genesis::Physics::Simulation* GetPhysicsSimulation() const;
     Sector* GetCurrentSector() const;
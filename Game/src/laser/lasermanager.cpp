@@ -15,8 +15,9 @@
 // You should have received a copy of the GNU General Public License
 // along with Hexterminate. If not, see <http://www.gnu.org/licenses/>.
 
+#include <profiling/profiler.h>
 #include <shadercache.h>
-#include <vertexbuffer.h>
+#include <streamingvertexbuffer.h>
 
 #include "laser/lasermanager.h"
 
@@ -29,6 +30,9 @@ LaserManager::LaserManager()
     : m_pTexture( nullptr )
     , m_pShader( nullptr )
     , m_pVertexBuffer( nullptr )
+    , m_FirstVertex( 0 )
+    , m_VertexCount( 0 )
+    , m_LasersTick( 0 )
 {
     using namespace Genesis;
 
@@ -36,7 +40,7 @@ LaserManager::LaserManager()
 
     m_pTexture = (Genesis::ResourceImage*)Genesis::FrameWork::GetResourceManager()->GetResource( "data/images/laser.png" );
 
-    m_pVertexBuffer = new VertexBuffer( GeometryType::Triangle, VBO_POSITION | VBO_UV | VBO_COLOR );
+    m_pVertexBuffer = new StreamingVertexBuffer( GeometryType::Triangle, VBO_POSITION | VBO_UV | VBO_COLOR, sLaserManagerCapacity * 6 );
     m_pShader = FrameWork::GetRenderSystem()->GetShaderCache()->Load( "laser" );
     ShaderUniform* pSampler = m_pShader->RegisterUniform( "k_sampler0", ShaderUniformType::Texture );
     pSampler->Set( m_pTexture, GL_TEXTURE0 );
@@ -49,23 +53,32 @@ LaserManager::~LaserManager()
 
 void LaserManager::Update( float delta )
 {
-    // VB-TODO
+    GENESIS_PROFILE_ZONE( "LaserManager::Update" );
 
     using namespace Genesis;
 
+    DiscardStaleLasers();
+    m_VertexCount = 0;
+
     const size_t lasersCount = m_Lasers.size();
     if ( lasersCount == 0 )
     {
         return;
     }
 
-    PositionData posData;
-    UVData uvData;
-    ColorData colorData;
+    const uint32_t vertexCount = static_cast<uint32_t>( lasersCount * 6 );
+    StreamingVertex* pVertex = m_pVertexBuffer->Map( vertexCount, m_FirstVertex );
+    if ( pVertex == nullptr )
+    {
+        return;
+    }
 
-    posData.reserve( lasersCount * 6 );
-    uvData.reserve( lasersCount * 6 );
-    colorData.reserve( lasersCount * 6 );
+    auto addVertex = [ &pVertex ]( float x, float y, float z, float u, float v, const glm::vec4& color ) {
+        pVertex->position = glm::vec3( x, y, z );
+        pVertex->uv = glm::vec2( u, v );
+        pVertex->color = color;
+        pVertex++;
+    };
 
     for ( auto& laser : m_Lasers )
     {
@@ -74,67 +87,51 @@ void LaserManager::Update( float delta )
         const glm::vec3& dst = laser.GetDestination();
         glm::vec3 dir = glm::normalize( dst - src );
         glm::vec3 perp( -dir.y * halfWidth, dir.x * halfWidth, 0.0f );
-
-        posData.emplace_back( src.x + perp.x, src.y + perp.y, src.z ); // 0
-        posData.emplace_back( src.x - perp.x, src.y - perp.y, src.z ); // 1
-        posData.emplace_back( dst.x - perp.x, dst.y - perp.y, dst.z ); // 2
-        posData.emplace_back( src.x + perp.x, src.y + perp.y, src.z ); // 0
-        posData.emplace_back( dst.x - perp.x, dst.y - perp.y, dst.z ); // 2
-        posData.emplace_back( dst.x + perp.x, dst.y + perp.y, dst.z ); // 3
-
-        uvData.emplace_back( 1.0f, 0.0f ); // 0
-        uvData.emplace_back( 0.0f, 0.0f ); // 1
-        uvData.emplace_back( 0.0f, 1.0f ); // 2
-        uvData.emplace_back( 1.0f, 0.0f ); // 0
-        uvData.emplace_back( 0.0f, 1.0f ); // 2
-        uvData.emplace_back( 1.0f, 1.0f ); // 3
-
         const glm::vec4 color = laser.GetColor().glm();
-        for ( int i = 0; i < 6; ++i )
-        {
-            colorData.push_back( color );
-        }
+
+        addVertex( src.x + perp.x, src.y + perp.y, src.z, 1.0f, 0.0f, color ); // 0
+        addVertex( src.x - perp.x, src.y - perp.y, src.z, 0.0f, 0.0f, color ); // 1
+        addVertex( dst.x - perp.x, dst.y - perp.y, dst.z, 0.0f, 1.0f, color ); // 2
+        addVertex( src.x + perp.x, src.y + perp.y, src.z, 1.0f, 0.0f, color ); // 0
+        addVertex( dst.x - perp.x, dst.y - perp.y, dst.z, 0.0f, 1.0f, color ); // 2
+        addVertex( dst.x + perp.x, dst.y + perp.y, dst.z, 1.0f, 1.0f, color ); // 3
     }
 
-    m_pVertexBuffer->CopyPositions( posData );
-    m_pVertexBuffer->CopyUVs( uvData );
-    m_pVertexBuffer->CopyColors( colorData );
+    m_pVertexBuffer->Unmap( vertexCount );
+    m_VertexCount = vertexCount;
 }
 
 void LaserManager::Render()
 {
     using namespace Genesis;
 
-    const size_t lasersCount = m_Lasers.size();
-    if ( lasersCount == 0 )
+    if ( m_VertexCount == 0 )
     {
         return;
     }
 
-    const size_t verticesCount = lasersCount * 6;
-
     RenderSystem* pRenderSystem = FrameWork::GetRenderSystem();
     pRenderSystem->SetBlendMode( BlendMode::Add );
 
     m_pShader->Use();
 
     pRenderSystem->SetRenderTarget( RenderTargetId::Glow );
-    m_pVertexBuffer->Draw( static_cast<uint32_t>( verticesCount ) );
+    m_pVertexBuffer->Draw( m_FirstVertex, m_VertexCount );
 
     pRenderSystem->SetRenderTarget( RenderTargetId::Default );
-    m_pVertexBuffer->Draw( static_cast<uint32_t>( verticesCount ) );
+    m_pVertexBuffer->Draw( m_FirstVertex, m_VertexCount );
 
     pRenderSystem->SetBlendMode( BlendMode::Disabled );
-
-    m_Lasers.clear();
 }
 
 void LaserManager::AddLaser( const Laser& laser )
 {
+    DiscardStaleLasers();
+
     const size_t numLasers = m_Lasers.size();
     if ( numLasers == sLaserManagerCapacity )
     {
-        Genesis::FrameWork::GetLogger()->LogWarning( "Unable to add laser, manager at capacity (%d)", sLaserManagerCapacity );
+        Genesis::FrameWork::GetLogger()->LogWarning( Genesis::LogCategory::Gameplay, "Unable to add laser, manager at capacity (%d)", sLaserManagerCapacity );
     }
     else
     {
@@ -142,4 +139,16 @@ void LaserManager::AddLaser( const Laser& laser )
     }
 }
 
+// Lasers are added every simulation tick and kept until the next one, so they are
+// drawn in every frame no matter how many ticks it ran.
+void LaserManager::DiscardStaleLasers()
+{
+    const uint64_t tick = Genesis::FrameWork::GetTaskManager()->GetFixedTickCount();
+    if ( m_LasersTick != tick )
+    {
+        m_Lasers.clear();
+        m_LasersTick = tick;
+    }
+}
+
 } // namespace Hexterminate
\ No newline at end of file
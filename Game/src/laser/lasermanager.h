@@ -22,12 +22,13 @@
 #include <rendersystem.h>
 #include <resourcemanager.h>
 #include <scene/sceneobject.h>
+#include <taskmanager.h>
 #include <vector>
 
 namespace Genesis
 {
 class ResourceImage;
-class VertexBuffer;
+class StreamingVertexBuffer;
 } // namespace Genesis
 
 namespace Hexterminate
@@ -54,11 +55,16 @@ public:
     void AddLaser( const Laser& laser );
 
 private:
+    void DiscardStaleLasers();
+
     LaserVector m_Lasers;
+    uint64_t m_LasersTick;
 
     Genesis::ResourceImage* m_pTexture;
     Genesis::Shader* m_pShader;
-    Genesis::VertexBuffer* m_pVertexBuffer;
+    Genesis::StreamingVertexBuffer* m_pVertexBuffer;
+    uint32_t m_FirstVertex;
+    uint32_t m_VertexCount;
 };
 
 } // namespace Hexterminate
\ No newline at end of file
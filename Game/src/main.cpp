@@ -22,6 +22,7 @@
 #endif
 
 #include <algorithm>
+#include <chrono>
 #include <iomanip>
 #include <sstream>
 #include <string>
@@ -54,6 +55,7 @@
 #include <xml.h>
 
 #include "achievements.h"
+#include "entrypoint.h"
 #include "faction/empirefaction.h"
 #include "faction/faction.h"
 #include "faction/irianifaction.h"
@@ -61,6 +63,7 @@
 #include "faction/piratefaction.h"
 #include "fleet/fleet.h"
 #include "fleet/fleetrep.h"
+#include "headlesssimulation.h"
 #include "hexterminate.h"
 #include "hyperscape/hyperscape.h"
 #include "menus/console.h"
@@ -156,6 +159,7 @@ Game::Game()
 
     TaskManager* taskManager = FrameWork::GetTaskManager();
     taskManager->AddTask( "GameLoop", this, (TaskFunc)&Game::Update, TaskPriority::GameLogic );
+    taskManager->AddTask( "GameLoopFixed", this, (TaskFunc)&Game::FixedUpdate, TaskPriority::GameLogic, TaskAccess(), TaskRate::Fixed );
 
     for ( int i = 0; i < (int)FactionId::Count; ++i )
     {
@@ -246,6 +250,13 @@ void Game::Initialise()
     m_pShipInfoManager->Initialise();
 
     m_pPhysicsSimulation = new Genesis::Physics::Simulation();
+    Genesis::FrameWork::GetTaskManager()->AddTask(
+        "PhysicsStep",
+        m_pPhysicsSimulation,
+        (Genesis::TaskFunc)&Genesis::Physics::Simulation::Step,
+        Genesis::TaskPriority::Physics,
+        Genesis::TaskAccess(),
+        Genesis::TaskRate::Fixed );
     Genesis::FrameWork::GetTaskManager()->AddTask(
         "Physics",
         m_pPhysicsSimulation,
@@ -265,7 +276,7 @@ void Game::Initialise()
     ShaderTweaksDebugWindow::Register();
 
     using namespace Genesis;
-    if ( FrameWork::GetCommandLineParameters()->HasParameter( "--no-intro" ) == false )
+    if ( FrameWork::IsHeadless() == false && FrameWork::GetCommandLineParameters()->HasParameter( "--no-intro" ) == false )
     {
         ResourceVideo* pWingsOfSteelVideo = (ResourceVideo*)FrameWork::GetResourceManager()->GetResource( "data/videos/WingsOfSteel.ivf" );
         pWingsOfSteelVideo->SetSkippable( true );
@@ -296,7 +307,16 @@ void Game::Initialise()
     m_pUIEditor = std::make_unique<UI::Editor>();
     LoadUIDesigns();
 
-    SetState( GameState::Intro );
+    if ( FrameWork::IsHeadless() )
+    {
+        // There is no intro, menu or save game storage when running headless. Resources are loaded on demand
+        // and it is up to the HeadlessSimulation to start a game in the galaxy.
+        m_pGalaxy = new Galaxy();
+    }
+    else
+    {
+        SetState( GameState::Intro );
+    }
 }
 
 SaveGameStorage* Game::GetSaveGameStorage() const
@@ -456,6 +476,17 @@ Genesis::TaskStatus Game::Update( float delta )
     return Genesis::TaskStatus::Continue;
 }
 
+// Runs once per simulation tick, after the physics have been stepped and the ships updated.
+Genesis::TaskStatus Game::FixedUpdate( float delta )
+{
+    if ( m_pSector )
+    {
+        m_pSector->FixedUpdate( delta );
+    }
+
+    return Genesis::TaskStatus::Continue;
+}
+
 void Game::StartNewLegacyGame( const ShipCustomisationData& customisationData, const std::string& companionShipTemplate, bool tutorialEnabled, const GalaxyCreationInfo& galaxyCreationInfo )
 {
     SDL_assert( GetPlayer() == nullptr );
@@ -464,7 +495,10 @@ void Game::StartNewLegacyGame( const ShipCustomisationData& customisationData, c
 
     m_FirstTimeInCombat = true;
     m_pPlayer = new Player( customisationData, companionShipTemplate );
-    m_pMainMenu->Show( false );
+    if ( m_pMainMenu != nullptr )
+    {
+        m_pMainMenu->Show( false );
+    }
     m_pGalaxy->Create( galaxyCreationInfo );
 
     SetPlayedTime( 0.0f );
@@ -1372,53 +1406,56 @@ void Game::LoaderThreadMain()
     SDL_GL_MakeCurrent( pWindow->GetSDLWindow(), pWindow->GetSDLThreadGLContext() );
 
     using namespace Genesis;
+    ResourceManager* pResourceManager = FrameWork::GetResourceManager();
     ShaderCache* pShaderCache = FrameWork::GetRenderSystem()->GetShaderCache();
-    std::filesystem::path shadersPath( "data/shaders" );
-    for ( const auto& entry : std::filesystem::recursive_directory_iterator( shadersPath ) )
+    std::vector<std::string> shaderFiles;
+    pResourceManager->ListFiles( "data/shaders", true, shaderFiles );
+    for ( const auto& shaderFile : shaderFiles )
     {
-        if ( entry.path().extension() == ".vert" )
+        const std::filesystem::path shaderPath( shaderFile );
+        if ( shaderPath.extension() == ".vert" )
         {
-            pShaderCache->Load( ToString( entry.path().stem() ) );
+            pShaderCache->Load( ToString( shaderPath.stem() ) );
         }
     }
 
-    ResourceManager* pResourceManager = FrameWork::GetResourceManager();
+    std::vector<std::string> dataFiles;
+    dataFiles.reserve( 1024 );
+    pResourceManager->ListFiles( "data", true, dataFiles );
+
     std::vector<std::string> filesToLoad;
     filesToLoad.reserve( 512 );
-    std::filesystem::path dataPath( "data" );
-    for ( const auto& entry : std::filesystem::recursive_directory_iterator( dataPath ) )
+    for ( const auto& entryPath : dataFiles )
     {
-        const std::string entryPath = ToString( entry.path().c_str() );
-        if ( entry.is_regular_file() && pResourceManager->CanLoadResource( entryPath ) )
+        if ( pResourceManager->CanLoadResource( entryPath ) )
         {
             filesToLoad.push_back( entryPath );
         }
     }
     maximumProgress += filesToLoad.size();
 
+    // Resources are decoded in parallel on the JobSystem, while this thread uploads them through its GL context.
+    // ProcessUploads() only returns false once the GPU has finished with every upload, so the main thread's
+    // context can use the resources as soon as we are done.
+    std::vector<ResourceFuture> futures;
+    futures.reserve( filesToLoad.size() );
     for ( const auto& entryPath : filesToLoad )
     {
-        pResourceManager->GetResource( entryPath );
-        m_pLoadingScreen->SetProgress( ++currentProgress, maximumProgress );
+        futures.push_back( pResourceManager->GetResourceAsync( entryPath ) );
     }
 
-    // Ensure all GPU commands are complete so our render context can use the resources
-    // this thread has loaded.
-    const GLsync fenceId = glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
-    const GLuint64 timeout = 5000000000; // 5 second timeout
-    while ( true )
+    static const size_t sMaxUploadsPerBatch = 8;
+    size_t firstPendingFuture = 0;
+    while ( pResourceManager->ProcessUploads( sMaxUploadsPerBatch ) )
     {
-        GLenum result = glClientWaitSync( fenceId, GL_SYNC_FLUSH_COMMANDS_BIT, timeout );
-        if ( result == GL_WAIT_FAILED )
-        {
-            Genesis::FrameWork::GetLogger()->LogError( "glClientWaitSync failed: GL_WAIT_FAILED." );
-            exit( -1 );
-        }
-        else if ( result != GL_TIMEOUT_EXPIRED )
+        while ( firstPendingFuture < futures.size() && futures[ firstPendingFuture ].wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready )
         {
-            break;
+            firstPendingFuture++;
         }
+        m_pLoadingScreen->SetProgress( currentProgress + firstPendingFuture, maximumProgress );
     }
+    currentProgress += futures.size();
+    m_pLoadingScreen->SetProgress( currentProgress, maximumProgress );
 
     Genesis::FrameWork::GetLogger()->LogInfo( "All resources loaded." );
 
@@ -1559,25 +1596,53 @@ void Game::LoadUIDesign( UIDesignId id, const std::filesystem::path& designPath
 int Main( Genesis::CommandLineParameters* parameters )
 {
     using namespace Genesis;
-    FrameWork::Initialize();
+    const bool headless = IsHeadlessExecutable() || parameters->HasParameter( "--headless" ) || parameters->HasParameter( "--cook" );
+    FrameWork::Initialize( headless );
+
+    // Cooking only needs the framework. It writes a pack from the loose files in data/ and quits.
+    // The pack is written to "--cook <path>" if given, or to data.pak, which is mounted by any later runs.
+    if ( parameters->HasParameter( "--cook" ) )
+    {
+        std::string packFilename;
+        if ( parameters->GetParameterValue( "--cook", packFilename ) == false || packFilename.empty() || packFilename.rfind( "--", 0 ) == 0 )
+        {
+            packFilename = "data.pak";
+        }
 
-    FrameWork::CreateWindowGL(
-        "HEXTERMINATE",
-        Configuration::GetScreenWidth(),
-        Configuration::GetScreenHeight(),
-        Configuration::GetMultiSampleSamples() );
+        const bool cooked = FrameWork::GetResourceManager()->CookPack( "data", packFilename );
+        delete parameters;
+        FrameWork::Shutdown();
+        return cooked ? 0 : -1;
+    }
+
+    if ( headless == false )
+    {
+        FrameWork::CreateWindowGL(
+            "HEXTERMINATE",
+            Configuration::GetScreenWidth(),
+            Configuration::GetScreenHeight(),
+            Configuration::GetMultiSampleSamples() );
+    }
 
     TaskManager* taskManager = FrameWork::GetTaskManager();
 
     g_pGame = new Game();
     g_pGame->Initialise();
 
-    while ( taskManager->IsRunning() && g_pGame->IsQuitRequested() == false )
+    int result = 0;
+    if ( headless )
     {
-        taskManager->Update();
+        result = CreateHeadlessSimulation( parameters )->Run();
     }
+    else
+    {
+        while ( taskManager->IsRunning() && g_pGame->IsQuitRequested() == false )
+        {
+            taskManager->Update();
+        }
 
-    Configuration::Save();
+        Configuration::Save();
+    }
 
     delete g_pGame;
     g_pGame = nullptr;
@@ -1585,7 +1650,7 @@ int Main( Genesis::CommandLineParameters* parameters )
     delete parameters;
     FrameWork::Shutdown();
 
-    return 0;
+    return result;
 }
 
 } // namespace Hexterminate
@@ -163,7 +163,6 @@ void FleetWindow::PopulateFleetShips()
         fsi.pReturnButton = std::make_shared<UI::Button>( "Return button", []( std::any userData ) {} );
         fsi.pBackground->Add( fsi.pReturnButton );
         fsi.pUnavailableIcon = std::make_shared<UI::Image>( "Unavailable icon" );
-        fsi.pUnavailableIcon->SetShader( "gui_textured" );
         fsi.pUnavailableIcon->SetColor( 1.0f, 0.0f, 0.0f, 1.0f );
         fsi.pBackground->Add( fsi.pUnavailableIcon );
         fsi.pUnavailableText = std::make_shared<UI::Text>( "Unavailable text" );
@@ -218,12 +217,10 @@ void FleetWindow::PopulateRequisitionShips()
             rsi.pDefenseText = std::make_shared<UI::Text>( "Defense text" );
             rsi.pTextPanel->Add( rsi.pDefenseText );
             rsi.pInfluenceIcon = std::make_shared<UI::Image>( "Influence icon" );
-            rsi.pInfluenceIcon->SetShader( "gui_textured" );
             rsi.pTextPanel->Add( rsi.pInfluenceIcon );
             rsi.pInfluenceText = std::make_shared<UI::Text>( "Influence text" );
             rsi.pTextPanel->Add( rsi.pInfluenceText );
             rsi.pPerkIcon = std::make_shared<UI::Image>( "Perk icon" );
-            rsi.pPerkIcon->SetShader( "gui_textured" );
             rsi.pTextPanel->Add( rsi.pPerkIcon );
             rsi.pPerkText = std::make_shared<UI::Text>( "Perk text" );
             rsi.pTextPanel->Add( rsi.pPerkText );
@@ -301,11 +298,12 @@ void FleetWindow::RefreshRequisitionShips()
     {
         if ( CanRequisitionShip( rsi.pShipInfo ) )
         {
-            rsi.pBackground->SetShader( "gui_textured" );
+            rsi.pBackground->SetShader( "" );
             rsi.pRequisitionButton->Enable( true );
         }
         else
         {
+            // Greyscale isn't something the GUI draw list can do, so only these backgrounds break its batching.
             rsi.pBackground->SetShader( "gui_textured_greyscale" );
             rsi.pRequisitionButton->Enable( false );
         }
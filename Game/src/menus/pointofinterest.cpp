@@ -19,11 +19,7 @@
 
 #include <configuration.h>
 #include <genesis.h>
-#include <rendersystem.h>
 #include <resources/resourceimage.h>
-#include <shader.h>
-#include <shadercache.h>
-#include <vertexbuffer.h>
 
 namespace Hexterminate
 {
@@ -34,8 +30,6 @@ namespace Hexterminate
 
 PointOfInterest::PointOfInterest()
     : m_pDynamicEnd( nullptr )
-    , m_pShader( nullptr )
-    , m_pVertexBuffer( nullptr )
 {
     using namespace Genesis;
 
@@ -44,14 +38,10 @@ PointOfInterest::PointOfInterest()
     SetSize(
         static_cast<float>( Genesis::Configuration::GetScreenWidth() ),
         static_cast<float>( Genesis::Configuration::GetScreenHeight() ) );
-
-    m_pVertexBuffer = new VertexBuffer( GeometryType::Line, VBO_POSITION | VBO_UV | VBO_COLOR );
-    m_pShader = FrameWork::GetRenderSystem()->GetShaderCache()->Load( "untextured_vertex_colored" );
 }
 
 PointOfInterest::~PointOfInterest()
 {
-    delete m_pVertexBuffer;
 }
 
 void PointOfInterest::Render()
@@ -62,19 +52,8 @@ void PointOfInterest::Render()
 
     const glm::vec2& end = ( m_pDynamicEnd ? m_pDynamicEnd->GetPointOfInterestEnd() : m_StaticEnd );
 
-    PositionData posData;
-    posData.push_back( glm::vec3( m_Start.x, m_Start.y, 0.0f ) );
-    posData.push_back( glm::vec3( end.x, end.y, 0.0f ) );
-
-    ColorData colorData;
-    colorData.push_back( m_Color.glm() );
-    colorData.push_back( m_Color.glm() );
-
-    m_pVertexBuffer->CopyPositions( posData );
-    m_pVertexBuffer->CopyColors( colorData );
-
-    m_pShader->Use();
-    m_pVertexBuffer->Draw();
+    const glm::vec3 line[ 2 ] = { glm::vec3( m_Start.x, m_Start.y, 0.0f ), glm::vec3( end.x, end.y, 0.0f ) };
+    Gui::GuiManager::GetDrawList()->AddLines( line, 2, m_Color.glm() );
 }
 
 } // namespace Hexterminate
\ No newline at end of file
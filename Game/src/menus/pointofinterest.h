@@ -21,12 +21,6 @@
 #include <gui/gui.h>
 #include <rendersystem.h>
 
-namespace Genesis
-{
-class Shader;
-class VertexBuffer;
-} // namespace Genesis
-
 namespace Hexterminate
 {
 
@@ -80,9 +74,6 @@ private:
     glm::vec2 m_StaticEnd;
     PointOfInterestTarget* m_pDynamicEnd;
 
-    Genesis::Shader* m_pShader;
-    Genesis::VertexBuffer* m_pVertexBuffer;
-
     Genesis::Color m_Color;
 };
 
@@ -123,6 +123,9 @@ void Radar::Render()
 
     if ( m_QuadCount > 0 )
     {
+        // The radar's atlas quads are drawn directly, so everything batched so far has to go first.
+        Gui::GuiManager::GetDrawList()->Flush();
+
         FrameWork::GetRenderSystem()->SetBlendMode( BlendMode::Blend );
 
         m_pShader->Use();
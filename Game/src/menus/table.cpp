@@ -17,10 +17,6 @@
 
 #include <genesis.h>
 #include <gui/gui.h>
-#include <rendersystem.h>
-#include <shader.h>
-#include <shadercache.h>
-#include <vertexbuffer.h>
 
 #include "menus/eva.h"
 #include "menus/table.h"
@@ -37,8 +33,6 @@ Table::Table()
     : m_PositionsDirty( false )
     , m_ContentsDirty( false )
     , m_MousePressedToken( Genesis::InputManager::sInvalidInputCallbackToken )
-    , m_pShader( nullptr )
-    , m_pVertexBuffer( nullptr )
 {
     using namespace Genesis;
 
@@ -47,9 +41,6 @@ Table::Table()
     SDL_assert( m_RowHeight > 0.0f );
 
     m_MousePressedToken = FrameWork::GetInputManager()->AddMouseCallback( std::bind( &Table::OnMousePressedCallback, this ), MouseButton::Left, ButtonState::Pressed );
-
-    m_pShader = FrameWork::GetRenderSystem()->GetShaderCache()->Load( "untextured_vertex_colored" );
-    m_pVertexBuffer = new VertexBuffer( GeometryType::Triangle, VBO_POSITION | VBO_COLOR );
 }
 
 Table::~Table()
@@ -60,8 +51,6 @@ Table::~Table()
     }
 
     Genesis::FrameWork::GetInputManager()->RemoveMouseCallback( m_MousePressedToken );
-
-    delete m_pVertexBuffer;
 }
 
 void Table::Render()
@@ -82,36 +71,12 @@ void Table::Render()
     glm::vec2 pos = GetPositionAbsolute();
     glm::vec4 color[ 2 ] = { TABLE_COLOR_ROW_1, TABLE_COLOR_ROW_2 };
 
-    PositionData posData;
-    ColorData colorData;
-
-    const size_t numVertices = maxRows * 6;
-    posData.reserve( numVertices );
-    colorData.reserve( numVertices );
-
+    Gui::GuiDrawList* pDrawList = Gui::GuiManager::GetDrawList();
     for ( size_t i = 0; i < maxRows; ++i )
     {
-        const float y1 = pos.y + i * m_RowHeight;
-        const float y2 = y1 + m_RowHeight;
-        posData.emplace_back( pos.x, y1, 0.0f ); // 0
-        posData.emplace_back( pos.x, y2, 0.0f ); // 1
-        posData.emplace_back( pos.x + mSize.x, y2, 0.0f ); // 2
-        posData.emplace_back( pos.x, y1, 0.0f ); // 0
-        posData.emplace_back( pos.x + mSize.x, y2, 0.0f ); // 2
-        posData.emplace_back( pos.x + mSize.x, y1, 0.0f ); // 3
-
-        const glm::vec4& rowColor = color[ i % 2 ];
-        for ( int j = 0; j < 6; ++j )
-        {
-            colorData.push_back( rowColor );
-        }
+        pDrawList->AddQuad( glm::vec2( pos.x, pos.y + i * m_RowHeight ), glm::vec2( mSize.x, m_RowHeight ), color[ i % 2 ] );
     }
 
-    m_pVertexBuffer->CopyPositions( posData );
-    m_pVertexBuffer->CopyColors( colorData );
-    m_pShader->Use();
-    m_pVertexBuffer->Draw( static_cast<uint32_t>( numVertices ) );
-
     Gui::GuiElement::Render();
 }
 
@@ -22,12 +22,6 @@
 
 #include <gui/gui.h>
 
-namespace Genesis
-{
-class Shader;
-class VertexBuffer;
-} // namespace Genesis
-
 namespace Hexterminate
 {
 
@@ -74,9 +68,6 @@ private:
     float m_RowHeight;
 
     Genesis::InputCallbackToken m_MousePressedToken;
-
-    Genesis::Shader* m_pShader;
-    Genesis::VertexBuffer* m_pVertexBuffer;
 };
 
 inline size_t Table::GetRowCount() const
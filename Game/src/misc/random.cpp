@@ -32,7 +32,11 @@ std::default_random_engine Random::m_Engine = std::default_random_engine();
 
 void Random::Initialise()
 {
-    const unsigned int seed = static_cast<unsigned int>( std::chrono::system_clock::now().time_since_epoch().count() );
+    Initialise( static_cast<unsigned int>( std::chrono::system_clock::now().time_since_epoch().count() ) );
+}
+
+void Random::Initialise( unsigned int seed )
+{
     m_Engine = std::default_random_engine( seed );
 }
 
@@ -31,6 +31,7 @@ class Random
 {
 public:
     static void Initialise();
+    static void Initialise( unsigned int seed ); // For reproducible runs.
 
     static uint32_t Next(); // Returns a value between 0 and 2^32-1.
     static uint32_t Next( uint32_t max ); // Returns a value between 0 and max - 1.
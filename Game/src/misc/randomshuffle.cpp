@@ -26,7 +26,11 @@ std::default_random_engine RandomShuffle::m_Engine = std::default_random_engine(
 
 void RandomShuffle::Initialise()
 {
-    const unsigned int seed = static_cast<unsigned int>( std::chrono::system_clock::now().time_since_epoch().count() );
+    Initialise( static_cast<unsigned int>( std::chrono::system_clock::now().time_since_epoch().count() ) );
+}
+
+void RandomShuffle::Initialise( unsigned int seed )
+{
     m_Engine = std::default_random_engine( seed );
 }
 
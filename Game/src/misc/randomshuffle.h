@@ -27,6 +27,7 @@ class RandomShuffle
 {
 public:
     static void Initialise();
+    static void Initialise( unsigned int seed ); // For reproducible runs.
 
     template <class RandomIt>
     static void Shuffle( RandomIt first, RandomIt last )
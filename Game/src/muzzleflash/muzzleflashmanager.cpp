@@ -16,6 +16,7 @@
 // along with Hexterminate. If not, see <http://www.gnu.org/licenses/>.
 
 #include <memory.h>
+#include <profiling/profiler.h>
 
 #include "hexterminate.h"
 #include "muzzleflash/muzzleflashmanager.h"
@@ -34,6 +35,8 @@ MuzzleflashManager::~MuzzleflashManager()
 
 void MuzzleflashManager::Update( float delta )
 {
+    GENESIS_PROFILE_ZONE( "MuzzleflashManager::Update" );
+
     if ( g_pGame->IsPaused() == false )
     {
         for ( auto& data : m_Muzzleflashes )
@@ -16,7 +16,6 @@
 // along with Hexterminate. If not, see <http://www.gnu.org/licenses/>.
 
 #include "particles/particle.h"
-#include <math/misc.h>
 
 namespace Hexterminate
 {
@@ -28,25 +27,20 @@ Particle::Particle()
 
 void Particle::Reset()
 {
-    m_InitialLifetime = 0.0f;
+    m_SpawnPosition = glm::vec3( 0.0f );
+    m_Velocity = glm::vec3( 0.0f );
+    m_SpawnTime = 0.0f;
     m_Lifetime = 0.0f;
-    m_Position = glm::vec3( 0.0f );
     m_Scale = 1.0f;
-    m_Velocity = glm::vec3( 0.0f );
-    m_Alpha = 1.0f;
 }
 
-void Particle::Update( float delta )
+void Particle::Spawn( const glm::vec3& position, const glm::vec3& velocity, float spawnTime, float lifetime, float scale )
 {
-    m_Lifetime = gMax( 0.0f, m_Lifetime - delta );
-
-    m_Position += m_Velocity * delta;
-
-    float r = gClamp<float>( m_Lifetime / m_InitialLifetime, 0.0f, 1.0f );
-    if ( r > 0.25f )
-        m_Alpha = 1.0f;
-    else
-        m_Alpha = r * 4.0f;
+    m_SpawnPosition = position;
+    m_Velocity = velocity;
+    m_SpawnTime = spawnTime;
+    m_Lifetime = lifetime;
+    m_Scale = scale;
 }
 
 } // namespace Hexterminate
\ No newline at end of file
@@ -24,6 +24,9 @@ namespace Hexterminate
 
 ///////////////////////////////////////////////////////////////////////////////
 // Particle
+// A particle never changes after being spawned: its position, atlas frame
+// and alpha at any point are derived from when and where it was spawned,
+// which is what the particle shader does.
 ///////////////////////////////////////////////////////////////////////////////
 
 class Particle
@@ -33,85 +36,51 @@ public:
     ~Particle(){};
 
     void Reset();
+    void Spawn( const glm::vec3& position, const glm::vec3& velocity, float spawnTime, float lifetime, float scale );
 
-    const glm::vec3& GetPosition() const;
-    void SetPosition( const glm::vec3& position );
-    void SetLifetime( float value );
-    void SetScale( float value );
-    bool IsAlive() const;
-    void SetVelocity( const glm::vec3& velocity );
-    void SetAlpha( float value );
-
-    void Update( float delta );
-
-    float GetCurrentLifetime() const;
-    float GetInitialLifetime() const;
+    bool IsAlive( float time ) const;
+    const glm::vec3& GetSpawnPosition() const;
+    const glm::vec3& GetVelocity() const;
+    float GetSpawnTime() const;
+    float GetLifetime() const;
     float GetScale() const;
-    float GetAlpha() const;
 
 private:
-    glm::vec3 m_Position;
+    glm::vec3 m_SpawnPosition;
     glm::vec3 m_Velocity;
+    float m_SpawnTime;
     float m_Lifetime;
-    float m_InitialLifetime;
     float m_Scale;
-    float m_Alpha;
 };
 
-inline const glm::vec3& Particle::GetPosition() const
+inline bool Particle::IsAlive( float time ) const
 {
-    return m_Position;
+    return time < m_SpawnTime + m_Lifetime;
 }
 
-inline void Particle::SetPosition( const glm::vec3& position )
+inline const glm::vec3& Particle::GetSpawnPosition() const
 {
-    m_Position = position;
+    return m_SpawnPosition;
 }
 
-inline void Particle::SetLifetime( float value )
+inline const glm::vec3& Particle::GetVelocity() const
 {
-    m_Lifetime = value;
-    m_InitialLifetime = value;
+    return m_Velocity;
 }
 
-inline bool Particle::IsAlive() const
+inline float Particle::GetSpawnTime() const
 {
-    return m_Lifetime > 0.0f;
+    return m_SpawnTime;
 }
 
-inline float Particle::GetCurrentLifetime() const
+inline float Particle::GetLifetime() const
 {
     return m_Lifetime;
 }
 
-inline float Particle::GetInitialLifetime() const
-{
-    return m_InitialLifetime;
-}
-
 inline float Particle::GetScale() const
 {
     return m_Scale;
 }
 
-inline void Particle::SetScale( float value )
-{
-    m_Scale = value;
-}
-
-inline void Particle::SetVelocity( const glm::vec3& velocity )
-{
-    m_Velocity = velocity;
-}
-
-inline float Particle::GetAlpha() const
-{
-    return m_Alpha;
-}
-
-inline void Particle::SetAlpha( float value )
-{
-    m_Alpha = value;
-}
-
 } // namespace Hexterminate
@@ -53,6 +53,8 @@ void ParticleEmitter::Reset()
     m_MinLifetime = 1.0f;
     m_MaxLifetime = 1.0f;
     m_Velocity = glm::vec3( 0.0f );
+    m_Time = 0.0f;
+    m_LastDeathTime = 0.0f;
 }
 
 void ParticleEmitter::Stop()
@@ -60,13 +62,16 @@ void ParticleEmitter::Stop()
     m_ParticlesToSpawn = 0;
 }
 
-void ParticleEmitter::Update( float delta )
+void ParticleEmitter::Update( float delta, float time )
 {
+    m_Time = time;
     m_EmissionTimer += delta;
     while ( ( m_ParticlesToSpawn > 0 || m_ParticlesToSpawn == sInfiniteParticles ) && m_EmissionTimer > m_EmissionDelay )
     {
         m_EmissionTimer -= m_EmissionDelay;
-        CreateParticle();
+
+        // Whatever is left in the timer is how long ago in this frame the particle should have been spawned.
+        CreateParticle( time - m_EmissionTimer );
 
         if ( m_ParticlesToSpawn != sInfiniteParticles )
         {
@@ -74,25 +79,16 @@ void ParticleEmitter::Update( float delta )
         }
     }
 
-    int aliveParticles = 0;
-    for ( auto& particle : m_Particles )
-    {
-        if ( particle.IsAlive() )
-        {
-            particle.Update( delta );
-            aliveParticles++;
-        }
-    }
-    m_Active = ( aliveParticles != 0 || m_ParticlesToSpawn > 0 || m_ParticlesToSpawn == sInfiniteParticles );
+    // Particles don't need updating, so the emitter only has to know when the last one will expire.
+    m_Active = ( time < m_LastDeathTime || m_ParticlesToSpawn > 0 || m_ParticlesToSpawn == sInfiniteParticles );
 }
 
-void ParticleEmitter::CreateParticle()
+void ParticleEmitter::CreateParticle( float spawnTime )
 {
+    const float lifetime = gRand( m_MinLifetime, m_MaxLifetime );
     Particle* pParticle = GetAvailableParticle();
-    pParticle->SetLifetime( gRand( m_MinLifetime, m_MaxLifetime ) );
-    pParticle->SetPosition( m_Position );
-    pParticle->SetScale( gRand( m_MinScale, m_MaxScale ) );
-    pParticle->SetVelocity( m_Velocity );
+    pParticle->Spawn( m_Position, m_Velocity, spawnTime, lifetime, gRand( m_MinScale, m_MaxScale ) );
+    m_LastDeathTime = gMax( m_LastDeathTime, spawnTime + lifetime );
 }
 
 Particle* ParticleEmitter::GetAvailableParticle()
@@ -100,7 +96,7 @@ Particle* ParticleEmitter::GetAvailableParticle()
     size_t numEmitters = m_Particles.size();
     for ( size_t i = m_Idx; i < numEmitters; ++i )
     {
-        if ( m_Particles[ i ].IsAlive() == false )
+        if ( m_Particles[ i ].IsAlive( m_Time ) == false )
         {
             m_Idx = i;
             m_Particles[ i ].Reset();
@@ -110,7 +106,7 @@ Particle* ParticleEmitter::GetAvailableParticle()
 
     for ( size_t i = 0; i < m_Idx; ++i )
     {
-        if ( m_Particles[ i ].IsAlive() == false )
+        if ( m_Particles[ i ].IsAlive( m_Time ) == false )
         {
             m_Idx = i;
             m_Particles[ i ].Reset();
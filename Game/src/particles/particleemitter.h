@@ -68,7 +68,10 @@ public:
     Genesis::ResourceImage* GetTexture() const;
     const ParticleVector& GetParticles() const;
 
-    void Update( float delta );
+    const glm::vec3& GetPosition() const;
+
+    // Time is the particle manager's clock, against which particles are spawned.
+    void Update( float delta, float time );
     bool IsActive() const;
 
     const Genesis::Gui::Atlas* GetAtlas() const;
@@ -76,7 +79,7 @@ public:
     static const std::string& GetRandomExplosion();
 
 private:
-    void CreateParticle();
+    void CreateParticle( float spawnTime );
     Particle* GetAvailableParticle();
 
     ParticleVector m_Particles;
@@ -93,6 +96,8 @@ private:
     float m_MinLifetime;
     float m_MaxLifetime;
     glm::vec3 m_Velocity;
+    float m_Time;
+    float m_LastDeathTime;
 
     Genesis::Gui::Atlas m_Atlas;
     Genesis::BlendMode m_BlendMode;
@@ -124,6 +129,11 @@ inline void ParticleEmitter::SetPosition( const glm::vec3& position )
     m_Position = position;
 }
 
+inline const glm::vec3& ParticleEmitter::GetPosition() const
+{
+    return m_Position;
+}
+
 inline void ParticleEmitter::SetBlendMode( Genesis::BlendMode mode )
 {
     m_BlendMode = mode;
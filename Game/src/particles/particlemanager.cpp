@@ -17,6 +17,7 @@
 
 #ifdef _DEBUG
 #include "hexterminate.h"
+#include <profiling/profiler.h>
 #include <render/debugrender.h>
 #include <sstream>
 #endif
@@ -37,6 +38,7 @@ ParticleManager::ParticleManager()
         m_Emitters[ i ].Reset();
     }
     m_Idx = 0;
+    m_Time = 0.0f;
 }
 
 ParticleManager::~ParticleManager()
@@ -45,16 +47,26 @@ ParticleManager::~ParticleManager()
 
 void ParticleManager::Update( float delta )
 {
+    GENESIS_PROFILE_ZONE( "ParticleManager::Update" );
+
+    m_Time += delta;
+
     int activeEmitters = 0;
     for ( auto& emitter : m_Emitters )
     {
         if ( emitter.IsActive() )
         {
-            emitter.Update( delta );
+            emitter.Update( delta, m_Time );
             activeEmitters++;
         }
     }
 
+    // Particles are positioned relative to this clock on the GPU, so keep it small to avoid losing precision.
+    if ( activeEmitters == 0 )
+    {
+        m_Time = 0.0f;
+    }
+
     //#ifdef _DEBUG
     //	glm::vec3 color = ( activeEmitters < sMaxEmitters ) ? glm::vec3( 0.0f, 1.0f, 0.0f ) : glm::vec3( 1.0f, 0.0f, 0.0f );
     //	std::stringstream ss;
@@ -40,10 +40,12 @@ public:
     ParticleEmitter* GetAvailableEmitter();
 
     const ParticleEmitterVector& GetEmitters() const;
+    float GetTime() const;
 
 private:
     ParticleEmitterVector m_Emitters;
     size_t m_Idx;
+    float m_Time;
 };
 
 inline const ParticleEmitterVector& ParticleManager::GetEmitters() const
@@ -51,4 +53,9 @@ inline const ParticleEmitterVector& ParticleManager::GetEmitters() const
     return m_Emitters;
 }
 
+inline float ParticleManager::GetTime() const
+{
+    return m_Time;
+}
+
 } // namespace Hexterminate
@@ -16,12 +16,14 @@
 // along with Hexterminate. If not, see <http://www.gnu.org/licenses/>.
 
 #include <algorithm>
+#include <cmath>
 
 #include <genesis.h>
 #include <math/misc.h>
 #include <rendersystem.h>
 #include <resources/resourceimage.h>
 #include <shaderuniform.h>
+#include <vertexbuffer.h>
 
 #include "particles/particleemitter.h"
 #include "particles/particlemanager.h"
@@ -31,16 +33,29 @@
 namespace Hexterminate
 {
 
-bool ParticleSort( const Particle* pA, const Particle* pB )
+static bool EmitterSort( const ParticleEmitter* pA, const ParticleEmitter* pB )
 {
     return pA->GetPosition().z < pB->GetPosition().z;
 }
 
 ParticleManagerRep::ParticleManagerRep( ParticleManager* pParticleManager )
     : m_pParticleManager( pParticleManager )
+    , m_Time( 0.0f )
 {
-    m_pPass[ 0 ] = new ParticlePass( Genesis::BlendMode::Add, "textured_vertex_colored", true );
-    m_pPass[ 1 ] = new ParticlePass( Genesis::BlendMode::Blend, "textured_vertex_colored", false );
+    m_pPass[ 0 ] = new ParticlePass( Genesis::BlendMode::Add, "particle", true );
+    m_pPass[ 1 ] = new ParticlePass( Genesis::BlendMode::Blend, "particle", false );
+
+    // Every particle is an instance of this quad, which the shader positions and scales.
+    m_pQuad = std::make_unique<Genesis::VertexBuffer>( Genesis::GeometryType::Triangle, Genesis::VBO_POSITION | Genesis::VB_2D );
+    const float corners[] = {
+        -1.0f, -1.0f,
+        1.0f, -1.0f,
+        -1.0f, 1.0f,
+        1.0f, -1.0f,
+        1.0f, 1.0f,
+        -1.0f, 1.0f
+    };
+    m_pQuad->CopyData( corners, 12, Genesis::VBO_POSITION );
 }
 
 ParticleManagerRep::~ParticleManagerRep()
@@ -60,6 +75,8 @@ void ParticleManagerRep::Update( float delta )
         return;
     }
 
+    m_Time = m_pParticleManager->GetTime();
+
     for ( int i = 0; i < sNumParticlePasses; ++i )
     {
         ParticlePass* pPass = m_pPass[ i ];
@@ -78,107 +95,62 @@ void ParticleManagerRep::Update( float delta )
             if ( pTexture == nullptr )
                 continue;
 
-            int index = FindIndexForTexture( pPass, pTexture->GetTexture() );
-            pPass->m_Data[ index ].pAtlas = emitter.GetAtlas(); // TODO: this is wrong, should be passed as a parameter to FindIndexForTexture
-
-            const ParticleVector& particles = emitter.GetParticles();
-            for ( auto& particle : particles )
-            {
-                if ( particle.IsAlive() )
-                {
-                    pPass->m_Data[ index ].particles.push_back( &particle );
-                }
-            }
+            ParticleRenderData& renderData = FindRenderData( pPass, pTexture );
+            renderData.pAtlas = emitter.GetAtlas(); // TODO: this is wrong, should be passed as a parameter to FindRenderData
+            renderData.emitters.push_back( &emitter );
         }
 
-        pPass->m_PositionData.clear();
-        pPass->m_UVData.clear();
-        pPass->m_ColorData.clear();
-
+        // Particles only need to be ordered when they are alpha blended, and since all the particles in
+        // an emitter share the same depth it is enough to sort the emitters.
+        pPass->m_Instances.clear();
         for ( auto& particleRenderData : pPass->m_Data )
         {
-            std::sort( particleRenderData.particles.begin(), particleRenderData.particles.end(), ParticleSort );
+            if ( pPass->m_BlendMode != Genesis::BlendMode::Add )
+            {
+                std::sort( particleRenderData.emitters.begin(), particleRenderData.emitters.end(), EmitterSort );
+            }
 
-            for ( auto& particle : particleRenderData.particles )
+            particleRenderData.firstInstance = static_cast<uint32_t>( pPass->m_Instances.size() );
+            for ( const ParticleEmitter* pEmitter : particleRenderData.emitters )
             {
-                AddQuad( particleRenderData.pAtlas, particle, pPass->m_PositionData, pPass->m_UVData, pPass->m_ColorData );
+                for ( const Particle& particle : pEmitter->GetParticles() )
+                {
+                    if ( particle.IsAlive( m_Time ) )
+                    {
+                        const glm::vec3& position = particle.GetSpawnPosition();
+                        const glm::vec3& velocity = particle.GetVelocity();
+                        pPass->m_Instances.push_back( {
+                            glm::vec4( position.x, position.y, velocity.x, velocity.y ),
+                            glm::vec4( particle.GetSpawnTime(), particle.GetLifetime(), particle.GetScale(), 0.0f ) } );
+                    }
+                }
             }
+            particleRenderData.instanceCount = static_cast<uint32_t>( pPass->m_Instances.size() ) - particleRenderData.firstInstance;
         }
 
-        if ( pPass->m_PositionData.empty() == false )
-        {
-            pPass->m_pVertexBuffer->CopyPositions( pPass->m_PositionData );
-            pPass->m_pVertexBuffer->CopyUVs( pPass->m_UVData );
-            pPass->m_pVertexBuffer->CopyColors( pPass->m_ColorData );
-        }
+        pPass->m_pInstanceBuffer->CopyData( reinterpret_cast<const float*>( pPass->m_Instances.data() ), pPass->m_Instances.size() );
     }
 }
 
-int ParticleManagerRep::FindIndexForTexture( ParticlePass* pPass, int id )
+ParticleRenderData& ParticleManagerRep::FindRenderData( ParticlePass* pPass, Genesis::ResourceImage* pTexture )
 {
-    int i = 0;
-    for ( ; i < (int)pPass->m_Data.size(); ++i )
+    const int id = pTexture->GetTexture();
+    for ( auto& renderData : pPass->m_Data )
     {
-        if ( pPass->m_Data[ i ].textureId == id )
+        if ( renderData.textureId == id )
         {
-            return i;
+            return renderData;
         }
     }
 
     ParticleRenderData prd;
     prd.textureId = id;
+    prd.pTexture = pTexture;
     prd.pAtlas = nullptr;
+    prd.firstInstance = 0;
+    prd.instanceCount = 0;
     pPass->m_Data.push_back( prd );
-    return i;
-}
-
-void ParticleManagerRep::AddQuad( const Genesis::Gui::Atlas* pAtlas, const Particle* pParticle, Genesis::PositionData& vertices, Genesis::UVData& uvs, Genesis::ColorData& colors )
-{
-    float u1, u2, v1, v2;
-    if ( pAtlas->GetElementCount() > 0 )
-    {
-        float fraction = 1.0f - pParticle->GetCurrentLifetime() / pParticle->GetInitialLifetime();
-        int atlasIndex = gClamp<int>( (int)( fraction * pAtlas->GetElementCount() ), 0, pAtlas->GetElementCount() - 1 );
-
-        const Genesis::Gui::AtlasElement& atlasElement = pAtlas->GetElement( atlasIndex );
-        u1 = atlasElement.GetU1();
-        v1 = atlasElement.GetV1();
-        u2 = atlasElement.GetU2();
-        v2 = atlasElement.GetV2();
-    }
-    else
-    {
-        u1 = 0.0f;
-        v1 = 0.0f;
-        u2 = 1.0f;
-        v2 = 1.0f;
-    }
-
-    const glm::vec3& position = pParticle->GetPosition();
-    const float x = position.x;
-    const float y = position.y;
-    const float halfSize = 60.0f * pParticle->GetScale();
-
-    vertices.push_back( glm::vec3( x - halfSize, y - halfSize, 0.0f ) );
-    vertices.push_back( glm::vec3( x + halfSize, y - halfSize, 0.0f ) );
-    vertices.push_back( glm::vec3( x - halfSize, y + halfSize, 0.0f ) );
-    vertices.push_back( glm::vec3( x + halfSize, y - halfSize, 0.0f ) );
-    vertices.push_back( glm::vec3( x + halfSize, y + halfSize, 0.0f ) );
-    vertices.push_back( glm::vec3( x - halfSize, y + halfSize, 0.0f ) );
-
-    uvs.push_back( glm::vec2( u1, v1 ) );
-    uvs.push_back( glm::vec2( u2, v1 ) );
-    uvs.push_back( glm::vec2( u1, v2 ) );
-    uvs.push_back( glm::vec2( u2, v1 ) );
-    uvs.push_back( glm::vec2( u2, v2 ) );
-    uvs.push_back( glm::vec2( u1, v2 ) );
-
-    const float alpha = pParticle->GetAlpha();
-    glm::vec4 color( 1.0f, 1.0f, 1.0f, alpha );
-    for ( int i = 0; i < 6; ++i )
-    {
-        colors.push_back( color );
-    }
+    return pPass->m_Data.back();
 }
 
 void ParticleManagerRep::Render()
@@ -191,29 +163,21 @@ void ParticleManagerRep::Render()
 
     for ( int i = 0; i < sNumParticlePasses; ++i )
     {
-        uint32_t startIdx = 0;
-        uint32_t endIdx = 0;
-
         ParticlePass* pPass = m_pPass[ i ];
         for ( const ParticleRenderData& particleRenderData : pPass->m_Data )
         {
-            const uint32_t numParticles = static_cast<uint32_t>( particleRenderData.particles.size() );
-            if ( numParticles > 0 )
+            if ( particleRenderData.instanceCount > 0 )
             {
                 pRenderSystem->SetBlendMode( pPass->m_BlendMode );
 
-                endIdx += numParticles * 6;
-
                 if ( pPass->m_GlowEnabled )
                 {
                     pRenderSystem->SetRenderTarget( Genesis::RenderTargetId::Glow );
-                    RenderGeometry( pPass, particleRenderData, startIdx, endIdx );
+                    RenderGeometry( pPass, particleRenderData );
                 }
 
                 pRenderSystem->SetRenderTarget( Genesis::RenderTargetId::Default );
-                RenderGeometry( pPass, particleRenderData, startIdx, endIdx );
-
-                startIdx += numParticles * 6;
+                RenderGeometry( pPass, particleRenderData );
             }
         }
     }
@@ -221,14 +185,31 @@ void ParticleManagerRep::Render()
     pRenderSystem->SetBlendMode( BlendMode::Disabled );
 }
 
-void ParticleManagerRep::RenderGeometry( ParticlePass* pPass, const ParticleRenderData& particleRenderData, unsigned int startIdx, unsigned int endIdx )
+void ParticleManagerRep::RenderGeometry( ParticlePass* pPass, const ParticleRenderData& particleRenderData )
 {
-    SDL_assert( endIdx > startIdx );
-    const unsigned int numVertices = endIdx - startIdx;
+    // The atlas is laid out in rows of equally sized elements, see ParticleEmitter::SetTextureAtlas().
+    Genesis::ResourceImage* pTexture = particleRenderData.pTexture;
+    const float textureWidth = static_cast<float>( pTexture->GetWidth() );
+    const float textureHeight = static_cast<float>( pTexture->GetHeight() );
+    const Genesis::Gui::Atlas* pAtlas = particleRenderData.pAtlas;
+    const int elementCount = ( pAtlas == nullptr ) ? 0 : pAtlas->GetElementCount();
+    if ( elementCount > 0 )
+    {
+        const Genesis::Gui::AtlasElement& element = pAtlas->GetElement( 0 );
+        const float columns = floorf( textureWidth / element.GetWidth() );
+        pPass->m_pAtlasUniform->Set( glm::vec4( static_cast<float>( elementCount ), columns, 0.0f, 0.0f ) );
+        pPass->m_pAtlasElementSizeUniform->Set( glm::vec4( element.GetWidth() / textureWidth, element.GetHeight() / textureHeight, 1.0f / textureWidth, 1.0f / textureHeight ) );
+    }
+    else
+    {
+        pPass->m_pAtlasUniform->Set( glm::vec4( 0.0f ) );
+        pPass->m_pAtlasElementSizeUniform->Set( glm::vec4( 1.0f, 1.0f, 0.0f, 0.0f ) );
+    }
 
-    pPass->m_pSamplerUniform->Set( particleRenderData.pAtlas->GetSource(), GL_TEXTURE0 );
+    pPass->m_pTimeUniform->Set( m_Time );
+    pPass->m_pSamplerUniform->Set( pTexture, GL_TEXTURE0 );
     pPass->m_pShader->Use();
-    pPass->m_pVertexBuffer->Draw( startIdx, numVertices );
+    m_pQuad->DrawInstanced( *pPass->m_pInstanceBuffer, particleRenderData.firstInstance, particleRenderData.instanceCount );
 }
 
-} // namespace Hexterminate
\ No newline at end of file
+} // namespace Hexterminate
@@ -17,16 +17,16 @@
 
 #pragma once
 
+#include <memory>
+
 #include "particles/particlepass.h"
 #include <rendersystem.h>
 #include <scene/sceneobject.h>
 
 namespace Genesis
 {
-namespace Gui
-{
-    class Atlas;
-}
+class ResourceImage;
+class VertexBuffer;
 } // namespace Genesis
 
 namespace Hexterminate
@@ -34,12 +34,15 @@ namespace Hexterminate
 
 class ParticleManager;
 class ParticlePass;
-class Particle;
 
 static const int sNumParticlePasses = 2;
 
 ///////////////////////////////////////////////////////////////////////////////
 // ParticleManagerRep
+// Particles are drawn as instanced quads, with the particle shader working
+// out their position, atlas frame and alpha from when they were spawned.
+// All the CPU does each frame is gather the live particles of every active
+// emitter into an instance buffer per pass, grouped by texture.
 ///////////////////////////////////////////////////////////////////////////////
 
 class ParticleManagerRep : public Genesis::SceneObject
@@ -52,12 +55,12 @@ public:
     void Render() override;
 
 private:
-    int FindIndexForTexture( ParticlePass* pPass, int id );
-    void AddQuad( const Genesis::Gui::Atlas* pAtlas, const Particle* pParticle, Genesis::PositionData& vertices, Genesis::UVData& uvs, Genesis::ColorData& colors );
-    void RenderGeometry( ParticlePass* pPass, const ParticleRenderData& particleRenderData, unsigned int startIdx, unsigned int endIdx );
-    Genesis::Shader* GetShader( Genesis::BlendMode blendMode, int textureId );
+    ParticleRenderData& FindRenderData( ParticlePass* pPass, Genesis::ResourceImage* pTexture );
+    void RenderGeometry( ParticlePass* pPass, const ParticleRenderData& particleRenderData );
     ParticleManager* m_pParticleManager;
     ParticlePass* m_pPass[ 2 ];
+    std::unique_ptr<Genesis::VertexBuffer> m_pQuad;
+    float m_Time;
 };
 
 inline void ParticleManagerRep::SetParticleManager( ParticleManager* pParticleManager )
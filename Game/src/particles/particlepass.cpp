@@ -16,6 +16,7 @@
 // along with Hexterminate. If not, see <http://www.gnu.org/licenses/>.
 
 #include <genesis.h>
+#include <instancebuffer.h>
 #include <memory.h>
 #include <rendersystem.h>
 #include <resources/resourceimage.h>
@@ -33,19 +34,23 @@ ParticlePass::ParticlePass( Genesis::BlendMode blendMode, const std::string& sha
     , m_BlendMode( blendMode )
     , m_pShader( nullptr )
     , m_pSamplerUniform( nullptr )
-    , m_pVertexBuffer( nullptr )
+    , m_pTimeUniform( nullptr )
+    , m_pAtlasUniform( nullptr )
+    , m_pAtlasElementSizeUniform( nullptr )
 {
     using namespace Genesis;
 
     RenderSystem* pRenderSystem = FrameWork::GetRenderSystem();
     m_pShader = pRenderSystem->GetShaderCache()->Load( shader );
     m_pSamplerUniform = m_pShader->RegisterUniform( "k_sampler0", ShaderUniformType::Texture );
-    m_pVertexBuffer = new VertexBuffer( GeometryType::Triangle, VBO_POSITION | VBO_UV | VBO_COLOR );
+    m_pTimeUniform = m_pShader->RegisterUniform( "k_particleTime", ShaderUniformType::Float );
+    m_pAtlasUniform = m_pShader->RegisterUniform( "k_atlas", ShaderUniformType::FloatVector4 );
+    m_pAtlasElementSizeUniform = m_pShader->RegisterUniform( "k_atlasElementSize", ShaderUniformType::FloatVector4 );
+    m_pInstanceBuffer = std::make_unique<InstanceBuffer>( sParticleInstanceFirstAttribute, sParticleInstanceVectors );
 }
 
 ParticlePass::~ParticlePass()
 {
-    delete m_pVertexBuffer;
 }
 
 } // namespace Hexterminate
\ No newline at end of file
@@ -19,8 +19,10 @@
 
 #include <vector>
 
+#include <glm/vec4.hpp>
+
+#include <instancebuffer.h>
 #include <rendersystem.h>
-#include <vertexbuffer.h>
 
 #include "particles/particleemitter.h"
 
@@ -31,6 +33,7 @@ namespace Gui
     class Atlas;
 }
 
+class ResourceImage;
 class Shader;
 class ShaderUniform;
 } // namespace Genesis
@@ -38,17 +41,31 @@ class ShaderUniform;
 namespace Hexterminate
 {
 
-class Particle;
 class ParticleManager;
 class ParticleEmitter;
 
-typedef std::vector<const Particle*> ParticlePointerVector;
+// Per-instance data read by the particle shader. The layout must match the instance attributes in particle.vert.
+struct ParticleInstance
+{
+    glm::vec4 positionVelocity; // xy: spawn position, zw: velocity.
+    glm::vec4 timing; // x: spawn time, y: lifetime, z: scale.
+};
+
+static const unsigned int sParticleInstanceFirstAttribute = 4;
+static const unsigned int sParticleInstanceVectors = sizeof( ParticleInstance ) / sizeof( glm::vec4 );
+static_assert( sizeof( ParticleInstance ) == sParticleInstanceVectors * sizeof( glm::vec4 ) );
+
+typedef std::vector<const ParticleEmitter*> ParticleEmitterPointerVector;
 
+// All the emitters in a pass sharing a texture, drawn as instances [firstInstance, firstInstance + instanceCount).
 struct ParticleRenderData
 {
     int textureId;
+    Genesis::ResourceImage* pTexture;
     const Genesis::Gui::Atlas* pAtlas;
-    ParticlePointerVector particles;
+    ParticleEmitterPointerVector emitters;
+    uint32_t firstInstance;
+    uint32_t instanceCount;
 };
 
 typedef std::vector<ParticleRenderData> EmitterRenderData;
@@ -64,11 +81,12 @@ public:
     Genesis::BlendMode m_BlendMode;
     Genesis::Shader* m_pShader;
     Genesis::ShaderUniform* m_pSamplerUniform;
+    Genesis::ShaderUniform* m_pTimeUniform;
+    Genesis::ShaderUniform* m_pAtlasUniform;
+    Genesis::ShaderUniform* m_pAtlasElementSizeUniform;
 
-    Genesis::VertexBuffer* m_pVertexBuffer;
-    Genesis::PositionData m_PositionData;
-    Genesis::UVData m_UVData;
-    Genesis::ColorData m_ColorData;
+    Genesis::InstanceBufferUniquePtr m_pInstanceBuffer;
+    std::vector<ParticleInstance> m_Instances;
 
     EmitterRenderData m_Data;
 };
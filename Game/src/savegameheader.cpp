@@ -15,6 +15,9 @@
 // You should have received a copy of the GNU General Public License
 // along with Hexterminate. If not, see <http://www.gnu.org/licenses/>.
 
+#include <sstream>
+#include <string_view>
+
 #include "savegameheader.h"
 #include "xmlaux.h"
 #include <xml.h>
@@ -22,6 +25,55 @@
 namespace Hexterminate
 {
 
+static const char* sHeaderIndexId = "HexterminateSaveHeader";
+static const int sHeaderIndexVersion = 1;
+
+// Names are stored in hex, so they can't contain anything which would end the comment or split the fields.
+// The prefix means that even an empty name is written as a field.
+static std::string EncodeIndexString( const std::string& value )
+{
+    static const char* sDigits = "0123456789abcdef";
+    std::string encoded = "x";
+    encoded.reserve( 1 + value.size() * 2 );
+    for ( char c : value )
+    {
+        const unsigned char byte = static_cast<unsigned char>( c );
+        encoded += sDigits[ byte >> 4 ];
+        encoded += sDigits[ byte & 0xF ];
+    }
+    return encoded;
+}
+
+static bool DecodeIndexString( const std::string& encoded, std::string& value )
+{
+    if ( encoded.empty() || encoded[ 0 ] != 'x' || encoded.size() % 2 == 0 )
+    {
+        return false;
+    }
+
+    auto decodeDigit = []( char c ) -> int {
+        if ( c >= '0' && c <= '9' )
+            return c - '0';
+        else if ( c >= 'a' && c <= 'f' )
+            return c - 'a' + 10;
+        else
+            return -1;
+    };
+
+    value.clear();
+    for ( size_t i = 1; i < encoded.size(); i += 2 )
+    {
+        const int high = decodeDigit( encoded[ i ] );
+        const int low = decodeDigit( encoded[ i + 1 ] );
+        if ( high < 0 || low < 0 )
+        {
+            return false;
+        }
+        value += static_cast<char>( ( high << 4 ) | low );
+    }
+    return true;
+}
+
 SaveGameHeader::SaveGameHeader( const std::filesystem::path& filename )
     : m_Filename( filename )
     , m_PlayedTime( 0.0f )
@@ -69,4 +121,65 @@ bool SaveGameHeader::Read( tinyxml2::XMLDocument& xmlDoc )
     return ( m_Error == SaveGameHeaderError::NoError );
 }
 
-} // namespace Hexterminate
\ No newline at end of file
+// The index has to be at the very start of the file, so it must be written once the rest of the document has been created.
+void SaveGameHeader::WriteIndex( tinyxml2::XMLDocument& xmlDoc ) const
+{
+    std::stringstream ss;
+    ss.precision( 9 );
+    ss << sHeaderIndexId << " " << sHeaderIndexVersion << " " << ( m_Alive ? 1 : 0 ) << " " << static_cast<int>( m_Difficulty ) << " " << static_cast<int>( m_GameMode ) << " " << m_PlayedTime << " " << EncodeIndexString( m_CaptainName ) << " " << EncodeIndexString( m_ShipName );
+    xmlDoc.InsertFirstChild( xmlDoc.NewComment( ss.str().c_str() ) );
+}
+
+bool SaveGameHeader::ReadIndex( const char* pData, size_t size )
+{
+    std::string_view data( pData, std::min( size, sSaveGameHeaderIndexMaxSize ) );
+    const std::string prefix = std::string( "<!--" ) + sHeaderIndexId + " ";
+    if ( data.substr( 0, prefix.size() ) != prefix )
+    {
+        return false;
+    }
+
+    const size_t end = data.find( "-->" );
+    if ( end == std::string_view::npos )
+    {
+        return false;
+    }
+
+    std::istringstream ss( std::string( data.substr( 4, end - 4 ) ) );
+    std::string id;
+    int version = 0;
+    int alive = 0;
+    int difficulty = 0;
+    int gameMode = 0;
+    float playedTime = 0.0f;
+    std::string captainName;
+    std::string shipName;
+    if ( !( ss >> id >> version ) || version != sHeaderIndexVersion )
+    {
+        return false;
+    }
+
+    if ( !( ss >> alive >> difficulty >> gameMode >> playedTime >> captainName >> shipName ) )
+    {
+        return false;
+    }
+
+    if ( difficulty < 0 || difficulty > static_cast<int>( Difficulty::Hardcore ) || gameMode < 0 || gameMode > static_cast<int>( GameMode::Hyperscape ) )
+    {
+        return false;
+    }
+
+    if ( DecodeIndexString( captainName, m_CaptainName ) == false || DecodeIndexString( shipName, m_ShipName ) == false )
+    {
+        return false;
+    }
+
+    m_Alive = ( alive != 0 );
+    m_Difficulty = static_cast<Difficulty>( difficulty );
+    m_GameMode = static_cast<GameMode>( gameMode );
+    m_PlayedTime = playedTime;
+    m_Error = SaveGameHeaderError::NoError;
+    return true;
+}
+
+} // namespace Hexterminate
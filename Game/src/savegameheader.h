@@ -40,12 +40,18 @@ enum class SaveGameHeaderError
     Unknown // shouldn't really happen, in case a system call returns an unexpected value
 };
 
+// Save games start with a comment containing a copy of the header, so the load menu can be populated by reading
+// just the start of each file rather than parsing all of them. Saves which predate it are still read in full.
+static const size_t sSaveGameHeaderIndexMaxSize = 4096;
+
 class SaveGameHeader
 {
 public:
     SaveGameHeader( const std::filesystem::path& filename );
 
     bool Read( tinyxml2::XMLDocument& xmlDoc );
+    bool ReadIndex( const char* pData, size_t size ); // Only needs the first sSaveGameHeaderIndexMaxSize bytes of the file.
+    void WriteIndex( tinyxml2::XMLDocument& xmlDoc ) const;
     inline bool IsValid() const { return m_Error == SaveGameHeaderError::NoError; }
     inline SaveGameHeaderError GetError() const { return m_Error; }
 
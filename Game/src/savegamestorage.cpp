@@ -20,6 +20,7 @@
 #endif
 
 #include <algorithm>
+#include <array>
 #include <filesystem>
 #include <sstream>
 
@@ -257,11 +258,18 @@ int SaveGameStorage::sXmlReadThreadMain( void* pData )
         auto pStorageFile = *it;
         if ( pStorageFile->pSaveGameHeader == nullptr )
         {
-            tinyxml2::XMLDocument xmlDoc;
-            pSaveGameStorage->XmlRead( pStorageFile->filename, xmlDoc );
-
             SaveGameHeaderSharedPtr pSaveGameHeader = std::make_shared<SaveGameHeader>( pStorageFile->filename );
-            if ( pSaveGameHeader->Read( xmlDoc ) )
+            bool headerRead = pSaveGameStorage->ReadHeaderIndex( pStorageFile->filename, *pSaveGameHeader );
+
+            // Older saves don't have a header index, so the whole file needs to be parsed.
+            if ( headerRead == false )
+            {
+                tinyxml2::XMLDocument xmlDoc;
+                pSaveGameStorage->XmlRead( pStorageFile->filename, xmlDoc );
+                headerRead = pSaveGameHeader->Read( xmlDoc );
+            }
+
+            if ( headerRead )
             {
                 pStorageFile->pSaveGameHeader = pSaveGameHeader;
                 it++;
@@ -339,6 +347,52 @@ bool SaveGameStorage::XmlRead( const std::filesystem::path& filename, tinyxml2::
     return true;
 }
 
+// Reads only the start of the file, where the header index is.
+bool SaveGameStorage::ReadHeaderIndex( const std::filesystem::path& filename, SaveGameHeader& saveGameHeader )
+{
+    std::array<char, sSaveGameHeaderIndexMaxSize> data;
+
+#if USE_STEAM
+    if ( m_CloudStorageActive )
+    {
+        std::string steamFilename = ToString( filename );
+        const int fileSize = m_pSteamRemoteStorage->GetFileSize( steamFilename.c_str() );
+        if ( fileSize <= 0 )
+        {
+            return false;
+        }
+
+        const int bytesToRead = std::min( fileSize, static_cast<int>( data.size() ) );
+        const int steamBytesRead = m_pSteamRemoteStorage->FileRead( steamFilename.c_str(), data.data(), bytesToRead );
+        if ( steamBytesRead != bytesToRead )
+        {
+            return false;
+        }
+
+        return saveGameHeader.ReadIndex( data.data(), static_cast<size_t>( steamBytesRead ) );
+    }
+#endif // USE_STEAM
+
+    FILE* fp = nullptr;
+#ifdef _WIN32
+    if ( _wfopen_s( &fp, filename.c_str(), L"rb" ) != 0 )
+    {
+        return false;
+    }
+#else
+    fp = fopen( filename.c_str(), "rb" );
+    if ( fp == nullptr )
+    {
+        return false;
+    }
+#endif
+
+    const size_t bytesRead = fread( data.data(), sizeof( char ), data.size(), fp );
+    fclose( fp );
+
+    return saveGameHeader.ReadIndex( data.data(), bytesRead );
+}
+
 void SaveGameStorage::UpdateStorageFiles( const std::filesystem::path& filename, tinyxml2::XMLDocument& xmlDoc )
 {
     std::shared_ptr<StorageFile> pActiveStorageFile = nullptr;
@@ -386,6 +440,12 @@ void SaveGameStorage::CreateSaveGameData( tinyxml2::XMLDocument& xmlDoc, bool ki
     }
 
     SDL_assert( result );
+
+    SaveGameHeader saveGameHeader( GetSaveGameFileName() );
+    if ( saveGameHeader.Read( xmlDoc ) )
+    {
+        saveGameHeader.WriteIndex( xmlDoc );
+    }
 }
 
 std::filesystem::path SaveGameStorage::GetSaveGameFileName() const
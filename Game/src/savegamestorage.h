@@ -44,6 +44,7 @@ private:
     std::filesystem::path GetSaveGameFileName( const std::string& captainName, const std::string& shipName ) const;
     static int sXmlReadThreadMain( void* pData );
     bool XmlRead( const std::filesystem::path& filename, tinyxml2::XMLDocument& xmlDoc );
+    bool ReadHeaderIndex( const std::filesystem::path& filename, SaveGameHeader& saveGameHeader );
     bool CreateSaveGameFolder( const std::filesystem::path& folder );
     void CreateSaveGameData( tinyxml2::XMLDocument& xmlDoc, bool killSave );
     bool SaveToLocalStorage( tinyxml2::XMLDocument& xmlDoc, const std::filesystem::path& fullPath );
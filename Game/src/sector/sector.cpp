@@ -20,6 +20,7 @@
 #include <inputmanager.h>
 #include <logger.h>
 #include <math/misc.h>
+#include <profiling/profiler.h>
 #include <render/debugrender.h>
 #include <resources/resourceplaylist.h>
 #include <scene/layer.h>
@@ -65,10 +66,12 @@
 #include "sector/dust.h"
 #include "sector/sectorcamera.h"
 #include "sector/sectorspawner.h"
+#include "sector/spatialindex.h"
 #include "sector/starinfo.h"
 #include "ship/collisionmasks.h"
 #include "ship/damagetracker.h"
 #include "ship/hyperspacecore.h"
+#include "ship/modulerenderer.h"
 #include "ship/ship.h"
 #include "ship/shipinfo.h"
 #include "shipyard/shipyard.h"
@@ -94,6 +97,7 @@ Sector::Sector( SectorInfo* pSectorInfo )
     , m_pBackground( nullptr )
     , m_pDust( nullptr )
     , m_pBoundary( nullptr )
+    , m_pModuleRenderer( nullptr )
     , m_pAmmoManager( nullptr )
     , m_pLaserManager( nullptr )
     , m_pSpriteManager( nullptr )
@@ -137,6 +141,7 @@ Sector::Sector( SectorInfo* pSectorInfo )
 
     m_pShipTweaks = std::make_unique<ShipTweaks>();
     m_pSectorSpawner = std::make_unique<SectorSpawner>();
+    m_pSpatialIndex = std::make_unique<SpatialIndex>();
 }
 
 Sector::~Sector()
@@ -209,10 +214,14 @@ bool Sector::Initialise()
     m_pBoundary = new Boundary();
     m_pShipLayer->AddSceneObject( m_pBoundary );
 
+    // Ships are added to the layer later, so all the modules are rendered before any ship renders its weapons and shields.
+    m_pModuleRenderer = new ModuleRenderer();
+    m_pShipLayer->AddSceneObject( m_pModuleRenderer );
+
     m_pPhysicsLayer->AddSceneObject( Genesis::FrameWork::GetDebugRender(), false );
 
     m_pAmmoManager = new AmmoManager();
-    m_pAmmoLayer->AddSceneObject( m_pAmmoManager );
+    m_pAmmoLayer->AddSceneObject( m_pAmmoManager, true, true );
 
     m_pLaserManager = new LaserManager();
     m_pAmmoLayer->AddSceneObject( m_pLaserManager );
@@ -346,6 +355,9 @@ bool Sector::Initialise()
 
     DamageTrackerDebugWindow::Register();
 
+    // Ships spawned by the sector may need to acquire targets before the first update.
+    m_pSpatialIndex->Rebuild( m_ShipList, m_pAmmoManager );
+
     return true;
 }
 
@@ -427,12 +439,13 @@ void Sector::SelectPlaylist()
 
 void Sector::Update( float delta )
 {
+    GENESIS_PROFILE_ZONE( "Sector::Update" );
+
 #ifdef _DEBUG
     m_pShipTweaks->Update( delta );
 #endif
 
     m_pTrailManager->Update( delta );
-    m_pAmmoManager->Update( delta );
     m_pLaserManager->Update( delta );
     m_pSpriteManager->Update( delta );
     m_pParticleManager->Update( delta );
@@ -451,8 +464,6 @@ void Sector::Update( float delta )
         m_pFleetStatus->Update();
     }
 
-    DeleteRemovedShips();
-
     Ship* pPlayerShip = g_pGame->GetPlayer()->GetShip();
     if ( pPlayerShip != nullptr && pPlayerShip->GetDockingState() == DockingState::Undocked && !pPlayerShip->GetHyperspaceCore()->IsCharging() && !pPlayerShip->GetHyperspaceCore()->IsJumping() )
     {
@@ -470,12 +481,25 @@ void Sector::Update( float delta )
     UpdateReinforcements( delta );
     UpdateSectorResolution();
 
+    DamageTrackerDebugWindow::Update();
+}
+
+// Everything which affects the outcome of a battle runs here, once per simulation tick.
+void Sector::FixedUpdate( float delta )
+{
+    GENESIS_PROFILE_ZONE( "Sector::FixedUpdate" );
+
+    m_pAmmoManager->Update( delta );
+
+    DeleteRemovedShips();
+
+    // Ships have already been updated this tick, so the index is up to date for whoever queries it next tick.
+    m_pSpatialIndex->Rebuild( m_ShipList, m_pAmmoManager );
+
     for ( auto& pFleetCommand : m_FleetCommands )
     {
         pFleetCommand->Update();
     }
-
-    DamageTrackerDebugWindow::Update();
 }
 
 void Sector::UpdateComponents( float delta )
@@ -802,7 +826,7 @@ void Sector::ReinforceImmediate( FleetSharedPtr pFleet, ShipVector* pSpawnedShip
 void Sector::AddShip( Ship* pShip )
 {
     m_ShipList.push_back( pShip );
-    m_pShipLayer->AddSceneObject( pShip, true );
+    m_pShipLayer->AddSceneObject( pShip, true, true );
 
     // If non-Imperial ships arrive after victory, then the victory has to be rescinded
     if ( m_IsPlayerVictorious && pShip->GetFaction() != g_pGame->GetFaction( FactionId::Empire ) )
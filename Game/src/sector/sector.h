@@ -64,11 +64,14 @@ class SectorEvent;
 class LootWindow;
 class FleetCommand;
 class Boundary;
+class ModuleRenderer;
+class SpatialIndex;
 
 using HotbarUniquePtr = std::unique_ptr<Hotbar>;
 using FleetStatusUniquePtr = std::unique_ptr<FleetStatus>;
 using FleetCommandUniquePtr = std::unique_ptr<FleetCommand>;
 using FleetCommandVector = std::vector<FleetCommandUniquePtr>;
+using SpatialIndexUniquePtr = std::unique_ptr<SpatialIndex>;
 
 static const int LAYER_BACKGROUND = 1;
 static const int LAYER_SHIP = 1 << 1;
@@ -90,6 +93,7 @@ public:
     Sector( SectorInfo* pSectorInfo );
     virtual ~Sector();
     virtual void Update( float fDelta );
+    void FixedUpdate( float delta );
 
     bool Initialise();
 
@@ -104,6 +108,7 @@ public:
     Background* GetBackground() const;
     ShipTweaks* GetShipTweaks() const;
     SectorCamera* GetCamera() const;
+    const SpatialIndex* GetSpatialIndex() const;
 
     void AddShip( Ship* pShip );
     void RemoveShip( Ship* pShip );
@@ -146,6 +151,7 @@ protected:
     Background* m_pBackground;
     Dust* m_pDust;
     Boundary* m_pBoundary;
+    ModuleRenderer* m_pModuleRenderer;
     ShipList m_ShipList;
     ShipList m_ShipsToRemove;
     ParticleManager* m_pParticleManager;
@@ -189,6 +195,7 @@ protected:
     ShipTweaksUniquePtr m_pShipTweaks;
 
     SectorSpawnerUniquePtr m_pSectorSpawner;
+    SpatialIndexUniquePtr m_pSpatialIndex;
 
     FleetList m_PendingImperialReinforcements;
     FleetList m_PendingHostileReinforcements;
@@ -250,6 +257,11 @@ inline bool Sector::IsPlayerVictorious() const
     return m_IsPlayerVictorious;
 }
 
+inline const SpatialIndex* Sector::GetSpatialIndex() const
+{
+    return m_pSpatialIndex.get();
+}
+
 inline Background* Sector::GetBackground() const
 {
     return m_pBackground;
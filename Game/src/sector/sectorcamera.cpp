@@ -88,22 +88,28 @@ void SectorCamera::Update( float delta )
     {
         // Otherwise, anchor the camera on the centre of the player ship but allow it to pan up to a
         // certain range away from it.
+        // There's no window (and no mouse to pan with) when running headless.
         glm::vec3 shipCentre = pShip->GetCentre( TransformSpace::World );
-        Genesis::InputManager* inputManager = Genesis::FrameWork::GetInputManager();
-        const glm::vec2& mousePosition = inputManager->GetMousePosition();
-
-        glm::vec2 offset(
-            ( mousePosition.x - Genesis::FrameWork::GetWindow()->GetWidth() / 2.0f ),
-            ( -mousePosition.y + Genesis::FrameWork::GetWindow()->GetHeight() / 2.0f ) );
-        float len = glm::length( offset );
-
+        glm::vec2 offset( 0.0f );
         float offsetFactor = 0.0f;
-        if ( len > 0.0f )
+        Genesis::Window* pWindow = Genesis::FrameWork::GetWindow();
+        if ( pWindow != nullptr )
         {
-            offset = glm::normalize( offset );
-            offsetFactor = len / ( Genesis::FrameWork::GetWindow()->GetWidth() / 2.0f );
-            if ( offsetFactor > 1.0f )
-                offsetFactor = 1.0f;
+            Genesis::InputManager* inputManager = Genesis::FrameWork::GetInputManager();
+            const glm::vec2& mousePosition = inputManager->GetMousePosition();
+
+            offset = glm::vec2(
+                ( mousePosition.x - pWindow->GetWidth() / 2.0f ),
+                ( -mousePosition.y + pWindow->GetHeight() / 2.0f ) );
+            float len = glm::length( offset );
+
+            if ( len > 0.0f )
+            {
+                offset = glm::normalize( offset );
+                offsetFactor = len / ( pWindow->GetWidth() / 2.0f );
+                if ( offsetFactor > 1.0f )
+                    offsetFactor = 1.0f;
+            }
         }
 
         // Scale the offset so that the ship always remains visible, even across multiple zoom settings.
@@ -0,0 +1,88 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Hexterminate.
+//
+// Hexterminate is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Hexterminate is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hexterminate. If not, see <http://www.gnu.org/licenses/>.
+
+#include "sector/spatialindex.h"
+
+#include "ammo/ammo.h"
+#include "ammo/ammomanager.h"
+#include "faction/faction.h"
+#include "ship/ship.h"
+#include "ship/weapon.h"
+
+namespace Hexterminate
+{
+
+SpatialIndex::SpatialIndex()
+    : m_Ships( sSpatialIndexCellSize )
+    , m_Interceptables( sSpatialIndexCellSize )
+{
+}
+
+void SpatialIndex::Rebuild( const ShipList& ships, const AmmoManager* pAmmoManager )
+{
+    m_Ships.Clear();
+    for ( Ship* pShip : ships )
+    {
+        // Ships without a tower can't be targeted.
+        if ( pShip->GetTowerModule() != nullptr )
+        {
+            const glm::vec3& position = pShip->GetTowerPosition();
+            m_Ships.Add( pShip, pShip->GetFaction(), glm::vec2( position.x, position.y ) );
+        }
+    }
+    m_Ships.Build();
+
+    m_Interceptables.Clear();
+    if ( pAmmoManager != nullptr )
+    {
+        m_AmmoScratch.clear();
+        pAmmoManager->GetInterceptables( m_AmmoScratch );
+        for ( Ammo* pAmmo : m_AmmoScratch )
+        {
+            const glm::vec3& position = pAmmo->GetSource();
+            m_Interceptables.Add( pAmmo, pAmmo->GetOwner()->GetOwner()->GetFaction(), glm::vec2( position.x, position.y ) );
+        }
+    }
+    m_Interceptables.Build();
+}
+
+Ship* SpatialIndex::FindClosestHostileShip( const glm::vec2& position, Faction* pFaction, float maxDistance /* = FLT_MAX */, const ShipFilter& filter /* = nullptr */ ) const
+{
+    return m_Ships.FindClosest( position, maxDistance, [ pFaction, &filter ]( const SpatialGrid<Ship>::Entry& entry ) {
+        return Faction::sIsEnemyOf( entry.pFaction, pFaction ) && ( filter == nullptr || filter( entry.pObject ) );
+    } );
+}
+
+void SpatialIndex::GetShipsInRadius( const glm::vec2& position, float radius, Faction* pHostileTo, std::vector<Ship*>& ships ) const
+{
+    m_Ships.ForEachInRadius( position, radius, [ pHostileTo, &ships ]( const SpatialGrid<Ship>::Entry& entry ) {
+        if ( pHostileTo == nullptr || Faction::sIsEnemyOf( entry.pFaction, pHostileTo ) )
+        {
+            ships.push_back( entry.pObject );
+        }
+    } );
+}
+
+Ammo* SpatialIndex::FindClosestInterceptable( const glm::vec2& position, Faction* pFaction, float maxDistance ) const
+{
+    // The ammo may have been destroyed or intercepted since the index was built.
+    return m_Interceptables.FindClosest( position, maxDistance, [ pFaction ]( const SpatialGrid<Ammo>::Entry& entry ) {
+        return Faction::sIsEnemyOf( pFaction, entry.pFaction ) && entry.pObject->IsAlive() && entry.pObject->WasIntercepted() == false;
+    } );
+}
+
+} // namespace Hexterminate
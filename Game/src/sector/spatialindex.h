@@ -0,0 +1,284 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Hexterminate.
+//
+// Hexterminate is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Hexterminate is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hexterminate. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "ship/ship.fwd.h"
+
+namespace Hexterminate
+{
+
+class Ammo;
+class AmmoManager;
+class Faction;
+
+// The playable area is 10000 units across, so this gives a 10x10 grid which is also
+// comparable to weapon ranges.
+static const float sSpatialIndexCellSize = 1000.0f;
+
+///////////////////////////////////////////////////////////////////////////////
+// SpatialGrid
+// A uniform grid of objects, rebuilt from scratch whenever the objects move.
+// The entries are sorted by cell so that every occupied cell is a contiguous
+// range, which keeps queries cache friendly and rebuilding allocation free
+// once the grid has grown to the number of objects in the sector.
+///////////////////////////////////////////////////////////////////////////////
+
+template <typename T> class SpatialGrid
+{
+public:
+    struct Entry
+    {
+        T* pObject;
+        Faction* pFaction;
+        glm::vec2 position;
+        uint64_t cell;
+    };
+
+    using Filter = std::function<bool( const Entry& )>;
+
+    SpatialGrid( float cellSize );
+
+    void Clear();
+    void Add( T* pObject, Faction* pFaction, const glm::vec2& position );
+    void Build();
+
+    // Calls func for every entry within radius of the position.
+    template <typename Func> void ForEachInRadius( const glm::vec2& position, float radius, Func func ) const;
+
+    // Returns the closest object within maxDistance which passes the filter, or nullptr.
+    T* FindClosest( const glm::vec2& position, float maxDistance, const Filter& filter ) const;
+
+private:
+    struct CellRange
+    {
+        uint32_t begin;
+        uint32_t end;
+    };
+
+    int GetCellCoordinate( float value ) const;
+    static uint64_t GetCellKey( int x, int y );
+    template <typename Func> void ForEachInCell( int x, int y, Func func ) const;
+
+    float m_CellSize;
+    std::vector<Entry> m_Entries;
+    std::unordered_map<uint64_t, CellRange> m_Cells;
+    int m_MinX;
+    int m_MinY;
+    int m_MaxX;
+    int m_MaxY;
+};
+
+template <typename T> SpatialGrid<T>::SpatialGrid( float cellSize )
+    : m_CellSize( cellSize )
+    , m_MinX( 0 )
+    , m_MinY( 0 )
+    , m_MaxX( -1 )
+    , m_MaxY( -1 )
+{
+}
+
+template <typename T> void SpatialGrid<T>::Clear()
+{
+    m_Entries.clear();
+    m_Cells.clear();
+    m_MinX = m_MinY = 0;
+    m_MaxX = m_MaxY = -1;
+}
+
+template <typename T> void SpatialGrid<T>::Add( T* pObject, Faction* pFaction, const glm::vec2& position )
+{
+    const int x = GetCellCoordinate( position.x );
+    const int y = GetCellCoordinate( position.y );
+    if ( m_Entries.empty() )
+    {
+        m_MinX = m_MaxX = x;
+        m_MinY = m_MaxY = y;
+    }
+    else
+    {
+        m_MinX = std::min( m_MinX, x );
+        m_MinY = std::min( m_MinY, y );
+        m_MaxX = std::max( m_MaxX, x );
+        m_MaxY = std::max( m_MaxY, y );
+    }
+
+    m_Entries.push_back( { pObject, pFaction, position, GetCellKey( x, y ) } );
+}
+
+template <typename T> void SpatialGrid<T>::Build()
+{
+    std::sort( m_Entries.begin(), m_Entries.end(), []( const Entry& a, const Entry& b ) { return a.cell < b.cell; } );
+
+    const uint32_t count = static_cast<uint32_t>( m_Entries.size() );
+    for ( uint32_t begin = 0; begin < count; )
+    {
+        uint32_t end = begin + 1;
+        while ( end < count && m_Entries[ end ].cell == m_Entries[ begin ].cell )
+        {
+            end++;
+        }
+        m_Cells[ m_Entries[ begin ].cell ] = { begin, end };
+        begin = end;
+    }
+}
+
+template <typename T> template <typename Func> void SpatialGrid<T>::ForEachInRadius( const glm::vec2& position, float radius, Func func ) const
+{
+    const int x1 = std::max( GetCellCoordinate( position.x - radius ), m_MinX );
+    const int y1 = std::max( GetCellCoordinate( position.y - radius ), m_MinY );
+    const int x2 = std::min( GetCellCoordinate( position.x + radius ), m_MaxX );
+    const int y2 = std::min( GetCellCoordinate( position.y + radius ), m_MaxY );
+    const float radiusSquared = radius * radius;
+
+    for ( int y = y1; y <= y2; ++y )
+    {
+        for ( int x = x1; x <= x2; ++x )
+        {
+            ForEachInCell( x, y, [ & ]( const Entry& entry ) {
+                const glm::vec2 offset = entry.position - position;
+                if ( offset.x * offset.x + offset.y * offset.y <= radiusSquared )
+                {
+                    func( entry );
+                }
+            } );
+        }
+    }
+}
+
+// Searches outwards from the position's cell one ring of cells at a time. Every cell in ring n is at least
+// n - 1 cells away, so once that is further than the closest object found so far the search can stop.
+template <typename T> T* SpatialGrid<T>::FindClosest( const glm::vec2& position, float maxDistance, const Filter& filter ) const
+{
+    if ( m_Entries.empty() )
+    {
+        return nullptr;
+    }
+
+    const int originX = GetCellCoordinate( position.x );
+    const int originY = GetCellCoordinate( position.y );
+    const int maxRing = std::max( { std::abs( m_MinX - originX ), std::abs( m_MaxX - originX ), std::abs( m_MinY - originY ), std::abs( m_MaxY - originY ) } );
+
+    T* pClosest = nullptr;
+    float closestDistance = maxDistance;
+    auto visit = [ & ]( const Entry& entry ) {
+        const glm::vec2 offset = entry.position - position;
+        const float distance = sqrtf( offset.x * offset.x + offset.y * offset.y );
+        if ( distance <= closestDistance && filter( entry ) )
+        {
+            closestDistance = distance;
+            pClosest = entry.pObject;
+        }
+    };
+
+    for ( int ring = 0; ring <= maxRing; ++ring )
+    {
+        if ( ring > 0 && static_cast<float>( ring - 1 ) * m_CellSize > closestDistance )
+        {
+            break;
+        }
+
+        for ( int i = -ring; i <= ring; ++i )
+        {
+            ForEachInCell( originX + i, originY - ring, visit );
+            if ( ring > 0 )
+            {
+                ForEachInCell( originX + i, originY + ring, visit );
+            }
+        }
+
+        for ( int i = -ring + 1; i <= ring - 1; ++i )
+        {
+            ForEachInCell( originX - ring, originY + i, visit );
+            ForEachInCell( originX + ring, originY + i, visit );
+        }
+    }
+
+    return pClosest;
+}
+
+template <typename T> int SpatialGrid<T>::GetCellCoordinate( float value ) const
+{
+    return static_cast<int>( floorf( value / m_CellSize ) );
+}
+
+template <typename T> uint64_t SpatialGrid<T>::GetCellKey( int x, int y )
+{
+    return ( static_cast<uint64_t>( static_cast<uint32_t>( x ) ) << 32 ) | static_cast<uint32_t>( y );
+}
+
+template <typename T> template <typename Func> void SpatialGrid<T>::ForEachInCell( int x, int y, Func func ) const
+{
+    if ( x < m_MinX || x > m_MaxX || y < m_MinY || y > m_MaxY )
+    {
+        return;
+    }
+
+    auto it = m_Cells.find( GetCellKey( x, y ) );
+    if ( it != m_Cells.end() )
+    {
+        for ( uint32_t i = it->second.begin; i < it->second.end; ++i )
+        {
+            func( m_Entries[ i ] );
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// SpatialIndex
+// Indexes the sector's ships and interceptable ammo by position, so that
+// targeting doesn't need to go through every ship for every AI ship. It is
+// rebuilt once per frame by the sector, which means positions can be up to
+// a frame out of date.
+///////////////////////////////////////////////////////////////////////////////
+
+class SpatialIndex
+{
+public:
+    using ShipFilter = std::function<bool( const Ship* )>;
+
+    SpatialIndex();
+
+    void Rebuild( const ShipList& ships, const AmmoManager* pAmmoManager );
+
+    // Closest ship hostile to the faction within maxDistance of the position, which also passes the filter if there is one.
+    Ship* FindClosestHostileShip( const glm::vec2& position, Faction* pFaction, float maxDistance = FLT_MAX, const ShipFilter& filter = nullptr ) const;
+
+    // Every ship within radius of the position. If pHostileTo isn't null, only ships hostile to that faction are returned.
+    void GetShipsInRadius( const glm::vec2& position, float radius, Faction* pHostileTo, std::vector<Ship*>& ships ) const;
+
+    // Closest missile fired by a faction hostile to pFaction which can still be intercepted.
+    Ammo* FindClosestInterceptable( const glm::vec2& position, Faction* pFaction, float maxDistance ) const;
+
+private:
+    SpatialGrid<Ship> m_Ships;
+    SpatialGrid<Ammo> m_Interceptables;
+    std::vector<Ammo*> m_AmmoScratch;
+};
+
+} // namespace Hexterminate
@@ -23,6 +23,7 @@
 #include "laser/laser.h"
 #include "laser/lasermanager.h"
 #include "sector/sector.h"
+#include "sector/spatialindex.h"
 
 #include <genesis.h>
 #include <resources/resourcesound.h>
@@ -90,43 +91,14 @@ bool AddonMissileInterceptor::CanIntercept() const
 
 Ammo* AddonMissileInterceptor::FindClosestMissile() const
 {
-    AmmoVector vec;
-    vec.reserve( 128 );
-
     Sector* pCurrentSector = g_pGame->GetCurrentSector();
     if ( pCurrentSector == nullptr )
         return nullptr;
 
-    AmmoManager* pAmmoManager = pCurrentSector->GetAmmoManager();
-    pAmmoManager->GetInterceptables( vec );
-
-    Ammo* pClosestMissile = nullptr;
-    float closestDistance = FLT_MAX;
-
-    glm::vec3 moduleWorldPos = m_pModule->GetWorldPosition();
-    Faction* pShipFaction = m_pModule->GetOwner()->GetFaction();
-    Faction* pMissileFaction = nullptr;
-    float distance = 0.0f;
-
-    for ( auto& pAmmo : vec )
-    {
-        pMissileFaction = pAmmo->GetOwner()->GetOwner()->GetFaction();
-        if ( Faction::sIsEnemyOf( pShipFaction, pMissileFaction ) )
-        {
-            distance = glm::distance( pAmmo->GetSource(), moduleWorldPos );
-            if ( distance < closestDistance )
-            {
-                pClosestMissile = pAmmo;
-                closestDistance = distance;
-            }
-        }
-    }
-
     const float maxDistance = 400.0f;
-    if ( closestDistance > maxDistance )
-        return nullptr;
-    else
-        return pClosestMissile;
+    const glm::vec3 moduleWorldPos = m_pModule->GetWorldPosition();
+    Faction* pShipFaction = m_pModule->GetOwner()->GetFaction();
+    return pCurrentSector->GetSpatialIndex()->FindClosestInterceptable( glm::vec2( moduleWorldPos.x, moduleWorldPos.y ), pShipFaction, maxDistance );
 }
 
 void AddonMissileInterceptor::InterceptMissile( Ammo* pMissile )
@@ -19,6 +19,7 @@
 #include "menus/shiptweaks.h"
 #include "player.h"
 #include "sector/sector.h"
+#include "sector/spatialindex.h"
 #include "ship/hyperspacecore.h"
 #include "ship/ship.h"
 #include "ship/controller/controllerai.h"
@@ -28,6 +29,7 @@
 #include <physics/rigidbody.h>
 #include <physics/shape.h>
 #include <physics/simulation.h>
+#include <profiling/profiler.h>
 #include <render/debugrender.h>
 
 // clang-format off
@@ -59,6 +61,8 @@ ControllerAI::ControllerAI( Ship* pShip )
 
 void ControllerAI::Update( float delta )
 {
+    GENESIS_PROFILE_ZONE( "ControllerAI::Update" );
+
     ManageAddons( delta );
     AcquireTarget( delta );
     FireControl();
@@ -135,27 +139,18 @@ void ControllerAI::AcquireTarget( float delta )
     if ( m_pTargetShip != nullptr && m_pTargetShip->IsTerminating() == false && m_pTargetShip->IsDestroyed() == false && m_TargetTimer > 0.0f )
         return;
 
-    m_pTargetShip = nullptr;
-
-    float minDistance = FLT_MAX;
-    for ( auto& pShip : g_pGame->GetCurrentSector()->GetShipList() )
-    {
-        if ( Faction::sIsEnemyOf( pShip->GetFaction(), GetShip()->GetFaction() ) == false )
-            continue;
-        else if ( pShip->GetTowerModule() == nullptr || pShip->GetTowerModule()->GetHealth() <= 0.0f )
-            continue;
+    const glm::vec3& position = GetShip()->GetTowerPosition();
+    const SpatialIndex* pSpatialIndex = g_pGame->GetCurrentSector()->GetSpatialIndex();
+    m_pTargetShip = pSpatialIndex->FindClosestHostileShip( glm::vec2( position.x, position.y ), GetShip()->GetFaction(), FLT_MAX, []( const Ship* pShip ) {
+        if ( pShip->GetTowerModule() == nullptr || pShip->GetTowerModule()->GetHealth() <= 0.0f )
+            return false;
         else if ( pShip->GetDockingState() != DockingState::Undocked )
-            continue;
+            return false;
         else if ( pShip->GetHyperspaceCore() != nullptr && pShip->GetHyperspaceCore()->IsJumping() )
-            continue;
-
-        float distance = glm::distance( GetShip()->GetTowerPosition(), pShip->GetTowerPosition() );
-        if ( distance < minDistance )
-        {
-            minDistance = distance;
-            m_pTargetShip = pShip;
-        }
-    }
+            return false;
+        else
+            return true;
+    } );
 
     m_TargetTimer = gRand( 3.5f, 5.0f );
 }
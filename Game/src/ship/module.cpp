@@ -161,6 +161,8 @@ void Module::Render( const glm::mat4& modelTransform, bool drawOutline )
     {
         m_pModel->Render( modelTransform );
     }
+
+    RenderAttachments( modelTransform );
 }
 
 void Module::Destroy()
@@ -421,9 +423,8 @@ void WeaponModule::Update( float delta )
     }
 }
 
-void WeaponModule::Render( const glm::mat4& modelTransform, bool drawOutline )
+void WeaponModule::RenderAttachments( const glm::mat4& modelTransform )
 {
-    Module::Render( modelTransform, drawOutline );
     GetWeapon()->Render( modelTransform );
 }
 
@@ -928,10 +929,8 @@ void AddonModule::Update( float delta )
     }
 }
 
-void AddonModule::Render( const glm::mat4& modelTransform, bool drawOutline )
+void AddonModule::RenderAttachments( const glm::mat4& modelTransform )
 {
-    Module::Render( modelTransform, drawOutline );
-
     if ( m_pAddon != nullptr )
     {
         m_pAddon->Render( modelTransform );
@@ -96,6 +96,7 @@ public:
     virtual void UpdateShipyard( float delta );
     virtual void Render() override;
     virtual void Render( const glm::mat4& modelTransform, bool drawOutline );
+    virtual void RenderAttachments( const glm::mat4& modelTransform ) {} // Anything rendered on top of the module itself, such as weapons.
     bool ShouldRender() const;
 
     inline ModuleInfo* GetModuleInfo() const { return m_pInfo; }
@@ -216,7 +217,7 @@ public:
 
     virtual void Initialise( Ship* pShip ) override;
     virtual void Update( float delta ) override;
-    virtual void Render( const glm::mat4& modelTransform, bool drawOutline ) override;
+    virtual void RenderAttachments( const glm::mat4& modelTransform ) override;
 
     static constexpr ModuleType GetType() { return ModuleType::Weapon; }
 
@@ -366,7 +367,7 @@ public:
     virtual ~AddonModule();
 
     virtual void Update( float delta ) override;
-    virtual void Render( const glm::mat4& modelTransform, bool drawOutline ) override;
+    virtual void RenderAttachments( const glm::mat4& modelTransform ) override;
 
     static constexpr ModuleType GetType() { return ModuleType::Addon; }
 
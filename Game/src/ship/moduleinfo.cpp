@@ -22,6 +22,7 @@
 #include <genesis.h>
 #include <logger.h>
 #include <math/misc.h>
+#include <resourcemanager.h>
 #include <resources/resourcesound.h>
 #include <xml.h>
 
@@ -67,25 +68,37 @@ ModuleInfoManager::ModuleInfoManager()
     using namespace tinyxml2;
 
     // Run through all the files in data/xml/modules and load all the modules that are listed
-    for ( const auto& moduleFile : std::filesystem::directory_iterator( "data/xml/modules" ) )
+    Genesis::ResourceManager* pResourceManager = Genesis::FrameWork::GetResourceManager();
+    std::vector<std::string> moduleFiles;
+    pResourceManager->ListFiles( "data/xml/modules", false, moduleFiles );
+    for ( const std::string& moduleFilename : moduleFiles )
     {
-        if ( moduleFile.path().extension() != ".xml" )
+        const std::filesystem::path modulePath( moduleFilename );
+        if ( modulePath.extension() != ".xml" )
         {
             continue;
         }
 
         FILE* fp = nullptr;
+        tinyxml2::XMLDocument doc;
+        XMLError fileLoaded = XML_SUCCESS;
 
+        const Genesis::ResourcePackEntry* pEntry = pResourceManager->FindPackEntry( moduleFilename );
+        if ( pEntry != nullptr )
+        {
+            fileLoaded = doc.Parse( reinterpret_cast<const char*>( pEntry->pData ), pEntry->size );
+        }
+        else
+        {
 #ifdef _WIN32
-        errno_t err = _wfopen_s( &fp, moduleFile.path().c_str(), L"rb" );
-        SDL_assert_release( err == 0 );
+            errno_t err = _wfopen_s( &fp, modulePath.c_str(), L"rb" );
+            SDL_assert_release( err == 0 );
 #else
-        fp = fopen( moduleFile.path().c_str(), "rb" );
-        SDL_assert_release( fp != nullptr );
+            fp = fopen( modulePath.c_str(), "rb" );
+            SDL_assert_release( fp != nullptr );
 #endif
-
-        tinyxml2::XMLDocument doc;
-        XMLError fileLoaded = doc.LoadFile( fp );
+            fileLoaded = doc.LoadFile( fp );
+        }
         SDL_assert_release( fileLoaded == XML_SUCCESS );
 
         XMLElement* pRootElement = doc.FirstChildElement();
@@ -109,7 +122,10 @@ ModuleInfoManager::ModuleInfoManager()
             m_Modules.insert( std::pair<std::string, ModuleInfo*>( pModule->GetName(), pModule ) );
         }
 
-        fclose( fp );
+        if ( fp != nullptr )
+        {
+            fclose( fp );
+        }
     }
 }
 
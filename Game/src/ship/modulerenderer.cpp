@@ -0,0 +1,166 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Hexterminate.
+//
+// Hexterminate is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Hexterminate is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hexterminate. If not, see <http://www.gnu.org/licenses/>.
+
+#include <genesis.h>
+#include <physics/rigidbody.h>
+#include <profiling/profiler.h>
+#include <rendersystem.h>
+#include <resources/resourcemodel.h>
+#include <shader.h>
+
+#include "hexterminate.h"
+#include "sector/background.h"
+#include "sector/sector.h"
+#include "ship/module.h"
+#include "ship/modulerenderer.h"
+#include "ship/ship.h"
+#include "ship/shipshaderuniforms.h"
+
+namespace Hexterminate
+{
+
+ModuleRenderer::ModuleRenderer()
+{
+    m_pUniforms = std::make_unique<ShipShaderUniforms>();
+    m_pInstanceBuffer = std::make_unique<Genesis::InstanceBuffer>( sModuleInstanceFirstAttribute, sModuleInstanceVectors );
+}
+
+ModuleRenderer::~ModuleRenderer()
+{
+}
+
+void ModuleRenderer::Update( float delta )
+{
+    Genesis::SceneObject::Update( delta );
+}
+
+void ModuleRenderer::Render()
+{
+    GENESIS_PROFILE_ZONE( "ModuleRenderer::Render" );
+
+    Sector* pSector = g_pGame->GetCurrentSector();
+    if ( pSector == nullptr )
+    {
+        return;
+    }
+
+    GatherInstances();
+    if ( m_InstanceData.empty() )
+    {
+        return;
+    }
+
+    m_pInstanceBuffer->CopyData( reinterpret_cast<const float*>( m_InstanceData.data() ), m_InstanceData.size() );
+
+    glEnable( GL_DEPTH_TEST );
+    glEnable( GL_STENCIL_TEST );
+    glStencilOp( GL_KEEP, GL_KEEP, GL_REPLACE );
+    glStencilFunc( GL_ALWAYS, 1, 0xFF );
+    glStencilMask( 0xFF );
+
+    m_pUniforms->Set( ShipShaderUniform::AmbientColor, pSector->GetBackground()->GetAmbientColor() );
+
+    for ( ModelGroup& group : m_Groups )
+    {
+        const uint32_t instanceCount = static_cast<uint32_t>( group.instances.size() );
+        if ( instanceCount == 0 )
+        {
+            continue;
+        }
+        else if ( group.isInstanced )
+        {
+            m_pUniforms->Set( ShipShaderUniform::Instanced, 1 );
+            group.pModel->RenderInstanced( *m_pInstanceBuffer, group.firstInstance, instanceCount );
+        }
+        else
+        {
+            m_pUniforms->Set( ShipShaderUniform::Instanced, 0 );
+            for ( const ModuleInstance& instance : group.instances )
+            {
+                m_pUniforms->Set( instance );
+                group.pModel->Render( instance.world );
+            }
+        }
+    }
+
+    m_pUniforms->Set( ShipShaderUniform::Instanced, 0 );
+
+    glDisable( GL_STENCIL_TEST );
+    glDisable( GL_DEPTH_TEST );
+}
+
+void ModuleRenderer::GatherInstances()
+{
+    for ( ModelGroup& group : m_Groups )
+    {
+        group.instances.clear();
+    }
+
+    for ( Ship* pShip : g_pGame->GetCurrentSector()->GetShipList() )
+    {
+        if ( pShip->IsTerminating() || pShip->IsVisible() == false || pShip->GetRigidBody() == nullptr )
+        {
+            continue;
+        }
+
+        const glm::mat4 shipTransform = pShip->GetRigidBody()->GetWorldTransform();
+        for ( Module* pModule : pShip->GetModules() )
+        {
+            if ( pModule->ShouldRender() )
+            {
+                ModelGroup& group = GetGroup( pModule->GetModel() );
+                group.instances.emplace_back();
+                pShip->GetModuleInstance( pModule, shipTransform * glm::translate( pModule->GetLocalPosition() ), group.instances.back() );
+            }
+        }
+    }
+
+    // All the groups share a single instance buffer, each one drawing from its own range.
+    m_InstanceData.clear();
+    for ( ModelGroup& group : m_Groups )
+    {
+        group.firstInstance = static_cast<uint32_t>( m_InstanceData.size() );
+        m_InstanceData.insert( m_InstanceData.end(), group.instances.begin(), group.instances.end() );
+    }
+}
+
+ModuleRenderer::ModelGroup& ModuleRenderer::GetGroup( Genesis::ResourceModel* pModel )
+{
+    auto it = m_GroupIndices.find( pModel );
+    if ( it != m_GroupIndices.end() )
+    {
+        return m_Groups[ it->second ];
+    }
+
+    m_GroupIndices[ pModel ] = m_Groups.size();
+    m_Groups.push_back( { pModel, CanInstance( pModel ), {}, 0 } );
+    return m_Groups.back();
+}
+
+bool ModuleRenderer::CanInstance( Genesis::ResourceModel* pModel ) const
+{
+    for ( Genesis::Material* pMaterial : pModel->GetMaterials() )
+    {
+        if ( pMaterial->shader != m_pUniforms->GetShader() )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace Hexterminate
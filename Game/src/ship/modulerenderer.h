@@ -0,0 +1,97 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Hexterminate.
+//
+// Hexterminate is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Hexterminate is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hexterminate. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+#include <instancebuffer.h>
+#include <scene/sceneobject.h>
+
+namespace Genesis
+{
+class ResourceModel;
+}
+
+namespace Hexterminate
+{
+
+class ShipShaderUniforms;
+
+// Per-instance data read by the shipmodule shader when k_instanced is set.
+// The layout must match the instance attributes in shipmodule.vert.
+struct ModuleInstance
+{
+    glm::mat4 world;
+    glm::vec4 primaryPaint;
+    glm::vec4 secondaryPaint;
+    glm::vec4 overlayColor;
+    glm::vec4 emissiveColor;
+    glm::vec4 clip; // w: 1 if the clip plane is active.
+    glm::vec4 clipForward;
+    glm::vec4 state; // x: health ratio, y: repair edge alpha, z: repair edge offset, w: 1 if EMPed.
+};
+
+static const unsigned int sModuleInstanceFirstAttribute = 4;
+static const unsigned int sModuleInstanceVectors = sizeof( ModuleInstance ) / sizeof( glm::vec4 );
+static_assert( sizeof( ModuleInstance ) == sModuleInstanceVectors * sizeof( glm::vec4 ) );
+
+///////////////////////////////////////////////////////////////////////////////
+// ModuleRenderer
+// Renders the modules of every ship in the sector. Modules are grouped by
+// model and each group is drawn with a single instanced draw call per
+// object in the model, rather than setting up the shader for every module.
+// Models using any shader other than shipmodule fall back to one draw per
+// module. Weapons, addons, outlines and shields are still rendered by each
+// ship.
+///////////////////////////////////////////////////////////////////////////////
+
+class ModuleRenderer : public Genesis::SceneObject
+{
+public:
+    ModuleRenderer();
+    virtual ~ModuleRenderer() override;
+
+    virtual void Update( float delta ) override;
+    virtual void Render() override;
+
+private:
+    struct ModelGroup
+    {
+        Genesis::ResourceModel* pModel;
+        bool isInstanced;
+        std::vector<ModuleInstance> instances;
+        uint32_t firstInstance;
+    };
+
+    void GatherInstances();
+    ModelGroup& GetGroup( Genesis::ResourceModel* pModel );
+    bool CanInstance( Genesis::ResourceModel* pModel ) const;
+
+    std::unique_ptr<ShipShaderUniforms> m_pUniforms;
+    std::vector<ModelGroup> m_Groups;
+    std::unordered_map<Genesis::ResourceModel*, size_t> m_GroupIndices;
+    std::vector<ModuleInstance> m_InstanceData;
+    Genesis::InstanceBufferUniquePtr m_pInstanceBuffer;
+};
+
+} // namespace Hexterminate
@@ -27,6 +27,7 @@
 #include <physics/rigidbody.h>
 #include <physics/shape.h>
 #include <physics/simulation.h>
+#include <profiling/profiler.h>
 #include <render/debugrender.h>
 #include <resources/resourcemodel.h>
 #include <resources/resourcesound.h>
@@ -62,6 +63,7 @@
 #include "ship/hyperspacecore.h"
 #include "ship/hyperspacegate.h"
 #include "ship/inventory.h"
+#include "ship/modulerenderer.h"
 #include "ship/shield.h"
 #include "ship/ship.h"
 #include "ship/shipinfo.h"
@@ -156,11 +158,6 @@ Ship::~Ship()
     }
 
     delete m_pUniforms;
-
-    if ( m_CollisionCallbackHandle != Genesis::Physics::InvalidCollisionCallbackHandle && g_pGame != nullptr )
-    {
-        g_pGame->GetPhysicsSimulation()->UnregisterCollisionCallback( m_CollisionCallbackHandle );
-    }
 }
 
 void Ship::SetInitialisationParameters( Faction* pFaction, FleetWeakPtr pFleetWeakPtr, const ShipCustomisationData& shipCustomisationData, const ShipSpawnData& shipSpawnData, const ShipInfo* pShipInfo )
@@ -197,7 +194,15 @@ void Ship::SetInitialisationParameters( Faction* pFaction, FleetWeakPtr pFleetWe
 
 void Ship::OnModulesChanged()
 {
-    CreateRigidBody();
+    if ( m_pRigidBody == nullptr )
+    {
+        CreateRigidBody();
+    }
+    else
+    {
+        UpdateRigidBody();
+    }
+
     CalculateNavigationStats();
 
     // Forces recalculation of the gate's bounding box, so it matches with this ship's new shape
@@ -265,6 +270,12 @@ ModuleInfo* Ship::RemoveModule( int x, int y )
         moduleByType.erase( std::remove( moduleByType.begin(), moduleByType.end(), pModule ), moduleByType.end() );
         m_AllModulesDirty = true;
 
+        if ( m_pCompoundShape != nullptr && pModule->GetPhysicsShape() != nullptr )
+        {
+            m_pCompoundShape->RemoveChildShape( pModule->GetPhysicsShape() );
+        }
+
+        ModuleInfo* pModuleInfo = pModule->GetModuleInfo();
         delete pModule;
         m_ModuleHexGrid.Set( x, y, nullptr );
 
@@ -273,7 +284,7 @@ ModuleInfo* Ship::RemoveModule( int x, int y )
             OnModulesChanged();
         }
 
-        return pModule->GetModuleInfo();
+        return pModuleInfo;
     }
     else
     {
@@ -321,10 +332,6 @@ void Ship::Initialize()
     const glm::vec3 startPosition = m_pRigidBody->GetPosition();
     m_pEngineSound = FrameWork::GetSoundManager()->CreateSoundInstance( pEngineSoundResource, Genesis::Sound::SoundBus::Type::SFX, startPosition, 50.0f );
 
-    using namespace std::placeholders;
-    auto collisionCallbackFn = std::bind( &Ship::OnCollision, this, _1, _2, _3, _4, _5 );
-    m_CollisionCallbackHandle = g_pGame->GetPhysicsSimulation()->RegisterCollisionCallback( collisionCallbackFn );
-
     InitializeReactors();
 }
 
@@ -444,34 +451,7 @@ void Ship::CreateRigidBody()
     // The ship has a single compound shape which will contain shapes for each individual module.
     m_pCompoundShape = std::make_shared<CompoundShape>();
 
-    // Calculate the ship's mass and centre of mass.
-    m_CentreOfMass = glm::vec3( 0.0f );
-    float mass = 0.0f;
-
-    int x1, y1, x2, y2;
-    m_ModuleHexGrid.GetBoundingBox( x1, y1, x2, y2 );
-    for ( int x = x1; x <= x2; ++x )
-    {
-        for ( int y = y1; y <= y2; ++y )
-        {
-            Module* pModule = m_ModuleHexGrid.Get( x, y );
-            if ( pModule != nullptr )
-            {
-                // We need to calculate the centre of mass of the overall ship, using
-                // the position and mass of the individual modules.
-                // Armour modifies the base module weight by a multiplier value.
-                float moduleMass = BaseModuleMass;
-                if ( pModule->GetModuleInfo()->GetType() == ModuleType::Armour )
-                {
-                    moduleMass *= ( (ArmourInfo*)( pModule->GetModuleInfo() ) )->GetMassMultiplier( this );
-                }
-
-                glm::vec3 modulePos = pModule->GetLocalPosition();
-                m_CentreOfMass += modulePos * moduleMass;
-                mass += moduleMass;
-            }
-        }
-    }
+    const float mass = CalculateMassProperties( m_CentreOfMass );
 
     // Don't create a rigid body if we have no mass (presumably because this ship has no modules).
     if ( mass <= 0.0f )
@@ -479,41 +459,14 @@ void Ship::CreateRigidBody()
         return;
     }
 
-    // Finish calculating centre of mass
-    m_CentreOfMass /= mass;
-
     // Create the actual physics shapes, as they have to be offset by the centre of mass.
     for ( auto& pModule : GetModules() )
     {
-        CylinderShapeSharedPtr pShape = std::make_shared<CylinderShape>( CylinderShapeAxis::Z, sModuleWidth, sModuleWidth, 40.0f );
-        pShape->SetUserData( pModule->GetCollisionInfo() );
-
-        glm::vec3 modulePos = pModule->GetLocalPosition();
-        m_pCompoundShape->AddChildShape( pShape, glm::translate( modulePos - m_CentreOfMass ) );
-        pModule->SetPhysicsShape( pShape );
+        AddModulePhysicsShape( pModule );
     }
 
     CalculateBoundingBox();
-
-    // If we have a shield, we want an additional shape. The shield needs to know the shape index for damage handling purposes.
-    if ( GetModules<ShieldModule>().empty() == false )
-    {
-        m_pShield = new Shield( this );
-    }
-
-    if ( m_pShield != nullptr )
-    {
-        glm::vec3 bbCentre(
-            m_BoundingBoxTopLeft.x + ( m_BoundingBoxBottomRight.x - m_BoundingBoxTopLeft.x ) / 2.0f,
-            m_BoundingBoxTopLeft.y + ( m_BoundingBoxBottomRight.y - m_BoundingBoxTopLeft.y ) / 2.0f,
-            0.0f );
-
-        const float extraRadius = 20.0f; // So the shield is a bit larger than the actual ship
-        const float radiusX = abs( ( m_BoundingBoxBottomRight.x - m_BoundingBoxTopLeft.x ) ) / 2.0f + extraRadius;
-        const float radiusY = abs( ( m_BoundingBoxBottomRight.y - m_BoundingBoxTopLeft.y ) ) / 2.0f + extraRadius;
-
-        m_pShield->InitialisePhysics( bbCentre, radiusX, radiusY );
-    }
+    RebuildShield();
 
     // This is needed so the ship's rigid body doesn't shift back and forth while it is being edited in the shipyard.
     if ( usingOldCentreOfMass )
@@ -534,6 +487,11 @@ void Ship::CreateRigidBody()
 
     g_pGame->GetPhysicsSimulation()->Add( m_pRigidBody );
 
+    // The callback is tied to this rigid body, so it only receives the collisions this ship is involved in.
+    using namespace std::placeholders;
+    auto collisionCallbackFn = std::bind( &Ship::OnCollision, this, _1, _2, _3, _4, _5 );
+    m_CollisionCallbackHandle = g_pGame->GetPhysicsSimulation()->RegisterCollisionCallback( m_pRigidBody, collisionCallbackFn );
+
     // The ship can only move in the XY plane and can only rotate around the Z axis.
     m_pRigidBody->SetLinearFactor( glm::vec3( 1.0f, 1.0f, 0.0f ) );
     m_pRigidBody->SetAngularFactor( glm::vec3( 0.0f, 0.0f, 1.0f ) );
@@ -546,6 +504,120 @@ void Ship::CreateRigidBody()
     }
 }
 
+// Called when modules have been added or removed from a ship which already has a rigid body.
+// Only the affected child shapes are added or removed: the remaining ones are shifted to account
+// for the new centre of mass and the rigid body's mass is updated in place.
+void Ship::UpdateRigidBody()
+{
+    SDL_assert( m_pRigidBody != nullptr );
+
+    glm::vec3 centreOfMass;
+    const float mass = CalculateMassProperties( centreOfMass );
+    if ( mass <= 0.0f )
+    {
+        DestroyRigidBody();
+        return;
+    }
+
+    const glm::vec3 oldCentreOfMass = m_CentreOfMass;
+    m_CentreOfMass = centreOfMass;
+    m_pCompoundShape->TranslateChildren( oldCentreOfMass - m_CentreOfMass );
+
+    // Removed modules have already taken their shapes out of the compound shape, so only new modules need one.
+    for ( auto& pModule : GetModules() )
+    {
+        if ( pModule->GetPhysicsShape() == nullptr )
+        {
+            AddModulePhysicsShape( pModule );
+        }
+    }
+
+    m_pRigidBody->SetMassProperties( static_cast<int>( mass ), m_CentreOfMass );
+
+    // The rigid body's origin is its centre of mass, so it needs to move with it for the modules to stay in place.
+    glm::mat4x4 worldTransform = m_pRigidBody->GetWorldTransform();
+    worldTransform[ 3 ] += worldTransform * glm::vec4( m_CentreOfMass - oldCentreOfMass, 0.0f );
+    m_pRigidBody->SetWorldTransform( worldTransform );
+
+    CalculateBoundingBox();
+    RebuildShield();
+
+    TowerModule* pTowerModule = GetTowerModule();
+    if ( pTowerModule != nullptr )
+    {
+        glm::vec3 moduleLocalPos = pTowerModule->GetLocalPosition();
+        m_TowerPosition = glm::vec3( worldTransform * glm::vec4( moduleLocalPos, 1.0f ) );
+    }
+}
+
+// Calculates the ship's mass and centre of mass, using the position and mass of the individual modules.
+float Ship::CalculateMassProperties( glm::vec3& centreOfMass )
+{
+    centreOfMass = glm::vec3( 0.0f );
+    float mass = 0.0f;
+
+    for ( auto& pModule : GetModules() )
+    {
+        // Armour modifies the base module weight by a multiplier value.
+        float moduleMass = BaseModuleMass;
+        if ( pModule->GetModuleInfo()->GetType() == ModuleType::Armour )
+        {
+            moduleMass *= ( (ArmourInfo*)( pModule->GetModuleInfo() ) )->GetMassMultiplier( this );
+        }
+
+        centreOfMass += pModule->GetLocalPosition() * moduleMass;
+        mass += moduleMass;
+    }
+
+    if ( mass > 0.0f )
+    {
+        centreOfMass /= mass;
+    }
+
+    return mass;
+}
+
+// All modules have the same collision geometry, so a single Bullet shape is shared between them.
+// Each module still gets its own Shape, as that is what carries the module's collision info.
+void Ship::AddModulePhysicsShape( Module* pModule )
+{
+    using namespace Genesis::Physics;
+
+    static CylinderShapeSharedPtr sModuleShape = std::make_shared<CylinderShape>( CylinderShapeAxis::Z, sModuleWidth, sModuleWidth, 40.0f );
+
+    CylinderShapeSharedPtr pShape = std::make_shared<CylinderShape>( sModuleShape );
+    pShape->SetUserData( pModule->GetCollisionInfo() );
+
+    glm::vec3 modulePos = pModule->GetLocalPosition();
+    m_pCompoundShape->AddChildShape( pShape, glm::translate( modulePos - m_CentreOfMass ) );
+    pModule->SetPhysicsShape( pShape );
+}
+
+// If we have a shield, we want an additional shape, sized to fit the ship's bounding box.
+void Ship::RebuildShield()
+{
+    delete m_pShield;
+    m_pShield = nullptr;
+
+    if ( GetModules<ShieldModule>().empty() )
+    {
+        return;
+    }
+
+    m_pShield = new Shield( this );
+
+    glm::vec3 bbCentre(
+        m_BoundingBoxTopLeft.x + ( m_BoundingBoxBottomRight.x - m_BoundingBoxTopLeft.x ) / 2.0f,
+        m_BoundingBoxTopLeft.y + ( m_BoundingBoxBottomRight.y - m_BoundingBoxTopLeft.y ) / 2.0f,
+        0.0f );
+
+    const float extraRadius = 20.0f; // So the shield is a bit larger than the actual ship
+    const float radiusX = abs( ( m_BoundingBoxBottomRight.x - m_BoundingBoxTopLeft.x ) ) / 2.0f + extraRadius;
+    const float radiusY = abs( ( m_BoundingBoxBottomRight.y - m_BoundingBoxTopLeft.y ) ) / 2.0f + extraRadius;
+
+    m_pShield->InitialisePhysics( bbCentre, radiusX, radiusY );
+}
+
 void Ship::DestroyRigidBody()
 {
     if ( g_pGame && g_pGame->GetPhysicsSimulation() )
@@ -558,6 +630,9 @@ void Ship::DestroyRigidBody()
 
         if ( m_pRigidBody )
         {
+            g_pGame->GetPhysicsSimulation()->UnregisterCollisionCallback( m_CollisionCallbackHandle );
+            m_CollisionCallbackHandle = Genesis::Physics::InvalidCollisionCallbackHandle;
+
             g_pGame->GetPhysicsSimulation()->Remove( m_pRigidBody );
             delete m_pRigidBody;
             m_pRigidBody = nullptr;
@@ -572,6 +647,8 @@ void Ship::DestroyRigidBody()
 
 void Ship::Update( float delta )
 {
+    GENESIS_PROFILE_ZONE( "Ship::Update" );
+
     // It is still possible for the ship to be updated once after the sector is deleted
     if ( g_pGame->GetCurrentSector() == nullptr )
     {
@@ -1009,7 +1086,9 @@ void Ship::Render()
         GetHyperspaceCore()->GetHyperspaceGate()->Render( modelTransform );
     }
 
-    RenderModuleHexGrid( modelTransform );
+    // The modules themselves have already been drawn by the sector's ModuleRenderer.
+    RenderModuleAttachments( modelTransform );
+    RenderModuleHexGridOutline( modelTransform );
 
     if ( m_pShield != nullptr )
     {
@@ -1019,32 +1098,20 @@ void Ship::Render()
     glDisable( GL_DEPTH_TEST );
 }
 
-void Ship::RenderModuleHexGrid( const glm::mat4& modelTransform )
+void Ship::RenderModuleAttachments( const glm::mat4& modelTransform )
 {
-    glEnable( GL_STENCIL_TEST );
-    glStencilOp( GL_KEEP, GL_KEEP, GL_REPLACE );
-    glStencilFunc( GL_ALWAYS, 1, 0xFF );
-    glStencilMask( 0xFF );
-
-    glm::vec3 moduleLocalPos;
-    for ( auto& pModule : GetModules() )
+    for ( ModuleType moduleType : { ModuleType::Weapon, ModuleType::Addon } )
     {
-        if ( pModule->ShouldRender() )
+        for ( auto& pModule : GetModules( moduleType ) )
         {
-            for ( Genesis::Material* pMaterial : pModule->GetModel()->GetMaterials() )
+            if ( pModule->ShouldRender() )
             {
-                SetSharedShaderParameters( pModule, pMaterial );
+                SetSharedShaderParameters( pModule );
+                const glm::mat4 worldTransform = modelTransform * glm::translate( pModule->GetLocalPosition() );
+                pModule->RenderAttachments( worldTransform );
             }
-
-            moduleLocalPos = pModule->GetLocalPosition();
-            glm::mat4 worldTransform = modelTransform * glm::translate( moduleLocalPos );
-            pModule->Render( worldTransform, false );
         }
     }
-
-    RenderModuleHexGridOutline( modelTransform );
-
-    glDisable( GL_STENCIL_TEST );
 }
 
 void Ship::RenderModuleHexGridOutline( const glm::mat4& modelTransform )
@@ -1057,6 +1124,8 @@ void Ship::RenderModuleHexGridOutline( const glm::mat4& modelTransform )
 
     glm::vec3 moduleLocalPos;
     glDisable( GL_DEPTH_TEST );
+    glEnable( GL_STENCIL_TEST );
+    glStencilOp( GL_KEEP, GL_KEEP, GL_REPLACE );
     glStencilFunc( GL_NOTEQUAL, 1, 0xFF );
     glStencilMask( 0x00 );
 
@@ -1073,89 +1142,87 @@ void Ship::RenderModuleHexGridOutline( const glm::mat4& modelTransform )
     glEnable( GL_DEPTH_TEST );
     glStencilFunc( GL_ALWAYS, 1, 0xFF );
     glStencilMask( 0xFF );
+    glDisable( GL_STENCIL_TEST );
 }
 
-void Ship::SetSharedShaderParameters( Module* pModule, Genesis::Material* pMaterial )
+void Ship::GetModuleInstance( Module* pModule, const glm::mat4& moduleTransform, ModuleInstance& instance )
 {
-    using namespace Genesis;
+    instance.world = moduleTransform;
 
-    if ( pMaterial->shader == m_pUniforms->GetShader() )
-    {
-        const Color& primaryColor = IsFlagship() ? GetFaction()->GetColor( FactionColorId::PrimaryFlagship ) : GetFaction()->GetColor( FactionColorId::Primary );
-        m_pUniforms->Set( ShipShaderUniform::PrimaryPaint, primaryColor.glm() );
+    const Genesis::Color& primaryColor = IsFlagship() ? GetFaction()->GetColor( FactionColorId::PrimaryFlagship ) : GetFaction()->GetColor( FactionColorId::Primary );
+    instance.primaryPaint = primaryColor.glm();
 
-        const Color& secondaryColor = IsFlagship() ? GetFaction()->GetColor( FactionColorId::SecondaryFlagship ) : GetFaction()->GetColor( FactionColorId::Secondary );
-        m_pUniforms->Set( ShipShaderUniform::SecondaryPaint, secondaryColor.glm() );
+    const Genesis::Color& secondaryColor = IsFlagship() ? GetFaction()->GetColor( FactionColorId::SecondaryFlagship ) : GetFaction()->GetColor( FactionColorId::Secondary );
+    instance.secondaryPaint = secondaryColor.glm();
 
-        const float healthRatio = pModule->GetHealth() / pModule->GetModuleInfo()->GetHealth( this );
-        m_pUniforms->Set( ShipShaderUniform::Health, healthRatio );
+    const float healthRatio = pModule->GetHealth() / pModule->GetModuleInfo()->GetHealth( this );
+    const float repairEdgeAlpha = pModule->IsDestroyed() ? 0.0f : ( m_RepairTimer > 0.0f ? 1.0f : 0.0f );
+    const float repairEdgeOffset = pModule->IsDestroyed() ? 0.0f : ( m_RepairTimer / RepairDuration ) * 0.4f;
+    const float empActive = pModule->IsEMPed() ? 1.0f : 0.0f;
+    instance.state = glm::vec4( healthRatio, repairEdgeAlpha, repairEdgeOffset, empActive );
 
-        const float repairEdgeAlpha = pModule->IsDestroyed() ? 0.0f : ( m_RepairTimer > 0.0f ? 1.0f : 0.0f );
-        m_pUniforms->Set( ShipShaderUniform::RepairEdgeAlpha, repairEdgeAlpha );
-
-        const float repairEdgeOffset = pModule->IsDestroyed() ? 0.0f : ( m_RepairTimer / RepairDuration ) * 0.4f;
-        m_pUniforms->Set( ShipShaderUniform::RepairEdgeOffset, repairEdgeOffset );
-
-        const int isJumping = ( m_pHyperspaceCore != nullptr && m_pHyperspaceCore->IsJumping() ) ? 1 : 0;
-        m_pUniforms->Set( ShipShaderUniform::ClipActive, isJumping );
-
-        if ( isJumping )
-        {
-            glm::vec3 hyperspaceClipPosition( m_pHyperspaceCore->GetHyperspaceGate()->GetGatePosition() );
-            m_pUniforms->Set( ShipShaderUniform::Clip, glm::vec4( hyperspaceClipPosition, 0.0f ) );
-
-            glm::vec4 hyperspaceClipDirection = glm::column( GetRigidBody()->GetWorldTransform(), 1 );
-            m_pUniforms->Set( ShipShaderUniform::ClipForward, hyperspaceClipDirection );
-        }
-
-        const Background* pBackground = g_pGame->GetCurrentSector()->GetBackground();
-        const glm::vec4& ambient = pBackground->GetAmbientColor();
-        m_pUniforms->Set( ShipShaderUniform::AmbientColor, ambient );
-
-        const Genesis::Color& emissive = GetFaction()->GetColor( FactionColorId::Glow );
-        m_pUniforms->Set( ShipShaderUniform::EmissiveColor, emissive.glm() );
+    if ( m_pHyperspaceCore != nullptr && m_pHyperspaceCore->IsJumping() )
+    {
+        glm::vec3 hyperspaceClipPosition( m_pHyperspaceCore->GetHyperspaceGate()->GetGatePosition() );
+        instance.clip = glm::vec4( hyperspaceClipPosition, 1.0f );
+        instance.clipForward = glm::column( GetRigidBody()->GetWorldTransform(), 1 );
+    }
+    else
+    {
+        instance.clip = glm::vec4( 0.0f );
+        instance.clipForward = glm::vec4( 0.0f );
+    }
 
-        const float assemblyPercentage = pModule->GetAssemblyPercentage();
-        ModuleType moduleType = pModule->GetModuleInfo()->GetType();
-        if ( assemblyPercentage < 1.0f )
-        {
-            const float intensity = 1.0f - assemblyPercentage;
-            glm::vec4 overlayColor( 0.0f, 1.0f, 1.0f, intensity );
-            m_pUniforms->Set( ShipShaderUniform::OverlayColor, overlayColor );
-        }
-        else if ( moduleType == ModuleType::Armour )
-        {
-            ArmourModule* pArmourModule = (ArmourModule*)pModule;
-            m_pUniforms->Set( ShipShaderUniform::OverlayColor, pArmourModule->GetOverlayColor() );
-        }
-        else if ( moduleType == ModuleType::Tower )
+    const ModuleType moduleType = pModule->GetModuleInfo()->GetType();
+    if ( moduleType == ModuleType::Reactor )
+    {
+        ReactorInfo* pReactorInfo = static_cast<ReactorInfo*>( pModule->GetModuleInfo() );
+        if ( pReactorInfo->GetVariant() == ReactorVariant::Unstable )
         {
-            TowerModule* pTowerModule = (TowerModule*)pModule;
-            m_pUniforms->Set( ShipShaderUniform::OverlayColor, pTowerModule->GetOverlayColor( this ) );
+            instance.emissiveColor = glm::vec4( 1.0f, 0.3f, 0.0f, 1.0f );
         }
         else
         {
-            m_pUniforms->Set( ShipShaderUniform::OverlayColor, glm::vec4( 0.0f ) );
-        }
-
-        if ( moduleType == ModuleType::Reactor )
-        {
-            ReactorInfo* pReactorInfo = static_cast<ReactorInfo*>( pModule->GetModuleInfo() );
-            if ( pReactorInfo->GetVariant() == ReactorVariant::Unstable )
-            {
-                m_pUniforms->Set( ShipShaderUniform::EmissiveColor, glm::vec4( 1.0f, 0.3f, 0.0f, 1.0f ) );
-            }
-            else
-            {
-                m_pUniforms->Set( ShipShaderUniform::EmissiveColor, glm::vec4( 0.0f, 1.0f, 1.0f, 1.0f ) );
-            }
+            instance.emissiveColor = glm::vec4( 0.0f, 1.0f, 1.0f, 1.0f );
         }
+    }
+    else
+    {
+        instance.emissiveColor = GetFaction()->GetColor( FactionColorId::Glow ).glm();
+    }
 
-        const int empActive = pModule->IsEMPed() ? 1 : 0;
-        m_pUniforms->Set( ShipShaderUniform::EMPActive, empActive );
+    const float assemblyPercentage = pModule->GetAssemblyPercentage();
+    if ( assemblyPercentage < 1.0f )
+    {
+        const float intensity = 1.0f - assemblyPercentage;
+        instance.overlayColor = glm::vec4( 0.0f, 1.0f, 1.0f, intensity );
+    }
+    else if ( moduleType == ModuleType::Armour )
+    {
+        ArmourModule* pArmourModule = (ArmourModule*)pModule;
+        instance.overlayColor = pArmourModule->GetOverlayColor();
+    }
+    else if ( moduleType == ModuleType::Tower )
+    {
+        TowerModule* pTowerModule = (TowerModule*)pModule;
+        instance.overlayColor = pTowerModule->GetOverlayColor( this );
+    }
+    else
+    {
+        instance.overlayColor = glm::vec4( 0.0f );
     }
 }
 
+void Ship::SetSharedShaderParameters( Module* pModule )
+{
+    ModuleInstance instance;
+    GetModuleInstance( pModule, glm::mat4( 1.0f ), instance );
+    m_pUniforms->Set( instance );
+
+    const Background* pBackground = g_pGame->GetCurrentSector()->GetBackground();
+    m_pUniforms->Set( ShipShaderUniform::AmbientColor, pBackground->GetAmbientColor() );
+}
+
 bool Ship::ConsumeEnergy( float quantity )
 {
     if ( m_Energy - quantity >= 0.0f )
@@ -1311,15 +1378,11 @@ void Ship::CalculateRammingDamage( const Ship* pRammingShip, const Ship* pRammed
 void Ship::OnCollision(
     Genesis::Physics::RigidBody* pRigidBodyA,
     Genesis::Physics::RigidBody* pRigidBodyB,
-    Genesis::Physics::ShapeWeakPtr pShapeA,
-    Genesis::Physics::ShapeWeakPtr pShapeB,
+    Genesis::Physics::Shape* pShapeA,
+    Genesis::Physics::Shape* pShapeB,
     const glm::vec3& hitPosition )
 {
-    // Is this collision relevant to us?
-    if ( pRigidBodyA != GetRigidBody() && pRigidBodyB != GetRigidBody() )
-    {
-        return;
-    }
+    SDL_assert( pRigidBodyA == GetRigidBody() || pRigidBodyB == GetRigidBody() );
 
     // We receive no collision damage if we are in the shipyard
     if ( GetDockingState() != DockingState::Undocked )
@@ -1339,16 +1402,16 @@ void Ship::OnCollision(
         return;
     }
 
-    const Genesis::Physics::ShapeWeakPtr pOtherShape = ( pRigidBodyA == GetRigidBody() ) ? pShapeB : pShapeA;
-    const Genesis::Physics::ShapeWeakPtr pOurShape = ( pRigidBodyA == GetRigidBody() ) ? pShapeA : pShapeB;
-    auto extractModuleFn = []( const Genesis::Physics::ShapeWeakPtr pShape ) -> Module* {
-        if ( pShape.expired() )
+    Genesis::Physics::Shape* pOtherShape = ( pRigidBodyA == GetRigidBody() ) ? pShapeB : pShapeA;
+    Genesis::Physics::Shape* pOurShape = ( pRigidBodyA == GetRigidBody() ) ? pShapeA : pShapeB;
+    auto extractModuleFn = []( Genesis::Physics::Shape* pShape ) -> Module* {
+        if ( pShape == nullptr )
         {
             return nullptr;
         }
         else
         {
-            ShipCollisionInfo* pShipCollisionInfo = reinterpret_cast<ShipCollisionInfo*>( pShape.lock()->GetUserData() );
+            ShipCollisionInfo* pShipCollisionInfo = reinterpret_cast<ShipCollisionInfo*>( pShape->GetUserData() );
             SDL_assert( pShipCollisionInfo->GetType() == ShipCollisionType::Module );
             return pShipCollisionInfo->GetModule();
         }
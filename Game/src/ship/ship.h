@@ -62,6 +62,7 @@ class DestructionSequence;
 class Inventory;
 class Faction;
 class HyperspaceCore;
+struct ModuleInstance;
 class ShipInfo;
 class ShipShaderUniforms;
 class Shipyard;
@@ -194,7 +195,7 @@ public:
     void DamageModule( WeaponSystem weaponSystem, DamageType damageType, float damageAmount, int burst, Ship* pDealtBy, Module* pModule, float delta );
     void DamageShield( Weapon* pWeapon, float delta, const glm::vec3& hitPosition ); // Damages the Shield.
     void DamageShield( WeaponSystem weaponSystem, DamageType damageType, float damageAmount, int burst, Ship* pDealtBy, float delta, const glm::vec3& hitPosition );
-    void OnCollision( Genesis::Physics::RigidBody* pRigidBodyA, Genesis::Physics::RigidBody* pRigidBodyB, Genesis::Physics::ShapeWeakPtr pShapeA, Genesis::Physics::ShapeWeakPtr pShapeB, const glm::vec3& hitPosition );
+    void OnCollision( Genesis::Physics::RigidBody* pRigidBodyA, Genesis::Physics::RigidBody* pRigidBodyB, Genesis::Physics::Shape* pShapeA, Genesis::Physics::Shape* pShapeB, const glm::vec3& hitPosition );
 
     inline TowerModule* GetTowerModule() const; // Should always be valid unless we are editing the ship. Also, by design, a Ship can only have one TowerModule.
     inline const glm::vec3& GetTowerPosition() const; // The Tower's world position. Use this for targetting, as this is the most important part of a ship.
@@ -234,6 +235,8 @@ public:
     bool IsTerminating() const;
 
     ShipShaderUniforms* GetShipShaderUniforms() const;
+    void GetModuleInstance( Module* pModule, const glm::mat4& moduleTransform, ModuleInstance& instance );
+    bool IsVisible() const;
     void GetBoundingBox( glm::vec3& topLeft, glm::vec3& bottomRight ) const;
     const ShipInfo* GetShipInfo() const;
     bool HasPerk( Perk perk ) const;
@@ -272,7 +275,7 @@ protected:
     void ApplyDodge( float& dodgeTimer, float enginePower );
     void ApplyStrafe( float enginePower );
     void CreateDefaultController();
-    void RenderModuleHexGrid( const glm::mat4& modelTransform );
+    void RenderModuleAttachments( const glm::mat4& modelTransform );
     void RenderModuleHexGridOutline( const glm::mat4& modelTransform );
     void UpdateReactors( float delta );
     void UpdateRepair( float delta );
@@ -290,15 +293,16 @@ protected:
     void SwitchController( ControllerUniquePtr&& pController );
 
     void CreateRigidBody();
+    void UpdateRigidBody();
     void DestroyRigidBody();
+    float CalculateMassProperties( glm::vec3& centreOfMass );
+    void AddModulePhysicsShape( Module* pModule );
     void RebuildShield();
 
-    void SetSharedShaderParameters( Module* pModule, Genesis::Material* pMaterial );
+    void SetSharedShaderParameters( Module* pModule );
     void CalculateBoundingBox();
     void CalculateRammingDamage( const Ship* pRammingShip, const Ship* pRammedShip, const ModuleInfo* pRammingModuleInfo, float& damageToRammingShip, float& damageToRammedShip );
 
-    bool IsVisible() const;
-
     void PlayDestructionSequence();
     void OnFlagshipDestroyed();
 
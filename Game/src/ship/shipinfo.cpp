@@ -18,10 +18,13 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <vector>
 
 #include <genesis.h>
 #include <logger.h>
+#include <resourcemanager.h>
 #include <xml.h>
 
 #include "fleet/fleet.h"
@@ -71,21 +74,23 @@ void ShipInfoManager::Initialise()
         // by the directory_iterator is not guaranteed and XML files reference SHP files which
         // have to be loaded first.
         std::filesystem::path factionPath = basePath / ToLower( pFaction->GetName() );
-        for ( const auto& filename : std::filesystem::directory_iterator( factionPath ) )
+        std::vector<std::string> filenames;
+        Genesis::FrameWork::GetResourceManager()->ListFiles( factionPath.string(), false, filenames );
+        for ( const auto& filename : filenames )
         {
-            const std::filesystem::path& extension = filename.path().extension();
-            if ( extension == ".shp" )
+            const std::filesystem::path path( filename );
+            if ( path.extension() == ".shp" )
             {
-                SerialiseHexGrid( pFaction, filename );
+                SerialiseHexGrid( pFaction, path );
             }
         }
 
-        for ( const auto& filename : std::filesystem::directory_iterator( factionPath ) )
+        for ( const auto& filename : filenames )
         {
-            const std::filesystem::path& extension = filename.path().extension();
-            if ( extension == ".xml" )
+            const std::filesystem::path path( filename );
+            if ( path.extension() == ".xml" )
             {
-                SerialiseXml( pFaction, filename );
+                SerialiseXml( pFaction, path );
             }
         }
     }
@@ -98,9 +103,23 @@ void ShipInfoManager::SerialiseHexGrid( const Faction* pFaction, const std::file
 
     ModuleInfoManager* pModuleInfoManager = g_pGame->GetModuleInfoManager();
     std::string line;
-    std::ifstream fs( filename );
     std::string name = ToString( filename.stem() );
-    if ( fs.is_open() )
+
+    // Cooked templates are read from the pack through a copy, as they are only a few lines long.
+    std::ifstream file;
+    std::istringstream packedFile;
+    const Genesis::ResourcePackEntry* pEntry = Genesis::FrameWork::GetResourceManager()->FindPackEntry( filename.string() );
+    if ( pEntry != nullptr )
+    {
+        packedFile.str( std::string( reinterpret_cast<const char*>( pEntry->pData ), pEntry->size ) );
+    }
+    else
+    {
+        file.open( filename );
+    }
+
+    std::istream& fs = ( pEntry != nullptr ) ? static_cast<std::istream&>( packedFile ) : static_cast<std::istream&>( file );
+    if ( pEntry != nullptr || file.is_open() )
     {
         ModuleInfoHexGrid* pHexGrid = new ModuleInfoHexGrid();
 
@@ -122,7 +141,6 @@ void ShipInfoManager::SerialiseHexGrid( const Faction* pFaction, const std::file
                 pHexGrid->Set( x, y, pModuleInfo );
             }
         }
-        fs.close();
 
         m_Data[ (int)pFaction->GetFactionId() ].push_back( new ShipInfo( name, pHexGrid ) );
 
@@ -148,34 +166,46 @@ void ShipInfoManager::SerialiseXml( const Faction* pFaction, const std::filesyst
         return;
     }
 
-    FILE* fp = nullptr;
-
-#ifdef _WIN32
-    errno_t err = _wfopen_s( &fp, filename.c_str(), L"rb" );
-    if ( err != 0 )
+    tinyxml2::XMLDocument doc;
+    const Genesis::ResourcePackEntry* pEntry = Genesis::FrameWork::GetResourceManager()->FindPackEntry( filename.string() );
+    if ( pEntry != nullptr )
     {
-        char errorMessage[ 256 ];
-        strerror_s( errorMessage, 256, err );
-        Genesis::FrameWork::GetLogger()->LogWarning( "Couldn't open file '%s': %s", filename.c_str(), errorMessage );
-        return;
+        if ( doc.Parse( reinterpret_cast<const char*>( pEntry->pData ), pEntry->size ) != XML_SUCCESS )
+        {
+            return;
+        }
     }
-#else
-    fp = fopen( filename.c_str(), "rb" );
-    if ( fp == nullptr )
+    else
     {
-        Genesis::FrameWork::GetLogger()->LogError( "Couldn't open file '%s'.", filename.c_str() );
-        return;
-    }
+        FILE* fp = nullptr;
+
+#ifdef _WIN32
+        errno_t err = _wfopen_s( &fp, filename.c_str(), L"rb" );
+        if ( err != 0 )
+        {
+            char errorMessage[ 256 ];
+            strerror_s( errorMessage, 256, err );
+            Genesis::FrameWork::GetLogger()->LogWarning( "Couldn't open file '%s': %s", filename.c_str(), errorMessage );
+            return;
+        }
+#else
+        fp = fopen( filename.c_str(), "rb" );
+        if ( fp == nullptr )
+        {
+            Genesis::FrameWork::GetLogger()->LogError( "Couldn't open file '%s'.", filename.c_str() );
+            return;
+        }
 #endif
 
-    tinyxml2::XMLDocument doc;
-    if ( doc.LoadFile( fp ) != XML_SUCCESS )
-    {
+        const XMLError result = doc.LoadFile( fp );
 #ifdef _WIN32
         _Analysis_assume_( fp != nullptr );
 #endif
         fclose( fp );
-        return;
+        if ( result != XML_SUCCESS )
+        {
+            return;
+        }
     }
 
     std::string displayName;
@@ -205,11 +235,6 @@ void ShipInfoManager::SerialiseXml( const Faction* pFaction, const std::filesyst
     pShipInfo->SetWeaponsText( weaponsText );
     pShipInfo->SetCost( cost );
     pShipInfo->SetTier( tier );
-
-#ifdef _WIN32
-    _Analysis_assume_( fp != nullptr );
-#endif
-    fclose( fp );
 }
 
 const ShipInfo* ShipInfoManager::Get( const Faction* pFaction, const std::string& shipName ) const
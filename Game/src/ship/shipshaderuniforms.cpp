@@ -21,6 +21,7 @@
 #include <shadercache.h>
 #include <shaderuniform.h>
 
+#include "ship/modulerenderer.h"
 #include "shipshaderuniforms.h"
 
 namespace Hexterminate
@@ -45,6 +46,7 @@ ShipShaderUniforms::ShipShaderUniforms()
     m_Uniforms[ (int)ShipShaderUniform::EmissiveColor ] = m_pShader->RegisterUniform( "k_e", ShaderUniformType::FloatVector4, false );
     m_Uniforms[ (int)ShipShaderUniform::OverlayColor ] = m_pShader->RegisterUniform( "k_overlayColor", ShaderUniformType::FloatVector4, false );
     m_Uniforms[ (int)ShipShaderUniform::EMPActive ] = m_pShader->RegisterUniform( "k_empActive", ShaderUniformType::Integer, false );
+    m_Uniforms[ (int)ShipShaderUniform::Instanced ] = m_pShader->RegisterUniform( "k_instanced", ShaderUniformType::Integer, false );
     m_Uniforms[ (int)ShipShaderUniform::DiffuseMap ] = m_pShader->RegisterUniform( "k_sampler0", ShaderUniformType::Texture );
     m_Uniforms[ (int)ShipShaderUniform::SpecularMap ] = m_pShader->RegisterUniform( "k_sampler1", ShaderUniformType::Texture );
     m_Uniforms[ (int)ShipShaderUniform::PaintMap ] = m_pShader->RegisterUniform( "k_sampler2", ShaderUniformType::Texture );
@@ -87,6 +89,21 @@ void ShipShaderUniforms::Set( ShipShaderUniform shipShaderUniform, Genesis::Reso
     }
 }
 
+void ShipShaderUniforms::Set( const ModuleInstance& instance )
+{
+    Set( ShipShaderUniform::PrimaryPaint, instance.primaryPaint );
+    Set( ShipShaderUniform::SecondaryPaint, instance.secondaryPaint );
+    Set( ShipShaderUniform::OverlayColor, instance.overlayColor );
+    Set( ShipShaderUniform::EmissiveColor, instance.emissiveColor );
+    Set( ShipShaderUniform::Clip, glm::vec4( glm::vec3( instance.clip ), 0.0f ) );
+    Set( ShipShaderUniform::ClipForward, instance.clipForward );
+    Set( ShipShaderUniform::ClipActive, instance.clip.w > 0.0f ? 1 : 0 );
+    Set( ShipShaderUniform::Health, instance.state.x );
+    Set( ShipShaderUniform::RepairEdgeAlpha, instance.state.y );
+    Set( ShipShaderUniform::RepairEdgeOffset, instance.state.z );
+    Set( ShipShaderUniform::EMPActive, instance.state.w > 0.0f ? 1 : 0 );
+}
+
 GLenum ShipShaderUniforms::UniformToGL( ShipShaderUniform uniform ) const
 {
     SDL_assert( uniform >= ShipShaderUniform::DiffuseMap && uniform <= ShipShaderUniform::DamageMap );
@@ -49,6 +49,7 @@ enum class ShipShaderUniform
     EmissiveColor,
     OverlayColor,
     EMPActive,
+    Instanced,
     DiffuseMap,
     SpecularMap,
     PaintMap,
@@ -56,6 +57,8 @@ enum class ShipShaderUniform
     Count
 };
 
+struct ModuleInstance;
+
 class ShipShaderUniforms
 {
 public:
@@ -68,6 +71,9 @@ public:
     void Set( ShipShaderUniform shipShaderUniform, const glm::vec4& value );
     void Set( ShipShaderUniform shipShaderUniform, Genesis::ResourceImage* pTexture );
 
+    // Sets every per-module uniform from the instance, for modules which aren't rendered with instancing.
+    void Set( const ModuleInstance& instance );
+
     Genesis::ShaderUniform* Get( ShipShaderUniform shipShaderUniform ) const;
 
 private:
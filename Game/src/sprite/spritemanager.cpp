@@ -31,6 +31,7 @@ SpriteManager::SpriteManager()
     : m_pTexture( nullptr )
     , m_pShader( nullptr )
     , m_pVertexBuffer( nullptr )
+    , m_SpritesTick( 0 )
 {
     using namespace Genesis;
 
@@ -54,6 +55,12 @@ void SpriteManager::Update( float delta )
 {
     using namespace Genesis;
 
+    // While the game is paused, nothing adds sprites but the existing ones are still drawn.
+    if ( g_pGame->IsPaused() == false )
+    {
+        DiscardStaleSprites();
+    }
+
     if ( m_Sprites.empty() )
     {
         return;
@@ -114,17 +121,25 @@ void SpriteManager::Render()
     m_pShader->Use();
     m_pVertexBuffer->Draw( static_cast<uint32_t>( m_Sprites.size() * 6 ) );
 
-    if ( g_pGame->IsPaused() == false )
-    {
-        m_Sprites.clear();
-    }
-
     FrameWork::GetRenderSystem()->SetBlendMode( BlendMode::Disabled );
 }
 
 void SpriteManager::AddSprite( const Sprite& Sprite )
 {
+    DiscardStaleSprites();
     m_Sprites.push_back( Sprite );
 }
 
+// Sprites are added every simulation tick and kept until the next one, so they are
+// drawn in every frame no matter how many ticks it ran.
+void SpriteManager::DiscardStaleSprites()
+{
+    const uint64_t tick = Genesis::FrameWork::GetTaskManager()->GetFixedTickCount();
+    if ( m_SpritesTick != tick )
+    {
+        m_Sprites.clear();
+        m_SpritesTick = tick;
+    }
+}
+
 } // namespace Hexterminate
\ No newline at end of file
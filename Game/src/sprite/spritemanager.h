@@ -22,6 +22,7 @@
 #include <rendersystem.h>
 #include <resourcemanager.h>
 #include <scene/sceneobject.h>
+#include <taskmanager.h>
 #include <vector>
 
 namespace Genesis
@@ -52,7 +53,10 @@ public:
     void AddSprite( const Sprite& Sprite );
 
 private:
+    void DiscardStaleSprites();
+
     SpriteVector m_Sprites;
+    uint64_t m_SpritesTick;
 
     Genesis::ResourceImage* m_pTexture;
     Genesis::Shader* m_pShader;
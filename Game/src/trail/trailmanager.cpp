@@ -16,6 +16,7 @@
 // along with Hexterminate. If not, see <http://www.gnu.org/licenses/>.
 
 #include <memory.h>
+#include <profiling/profiler.h>
 
 #include "hexterminate.h"
 #include "trail/trail.h"
@@ -38,6 +39,8 @@ TrailManager::~TrailManager()
 
 void TrailManager::Update( float delta )
 {
+    GENESIS_PROFILE_ZONE( "TrailManager::Update" );
+
     if ( g_pGame->IsPaused() == false )
     {
         for ( auto& pTrail : m_Trails )
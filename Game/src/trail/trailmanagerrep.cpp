@@ -15,6 +15,8 @@
 // You should have received a copy of the GNU General Public License
 // along with Hexterminate. If not, see <http://www.gnu.org/licenses/>.
 
+#include <algorithm>
+
 #include "trail/trailmanagerrep.h"
 #include "hexterminate.h"
 #include "menus/shiptweaks.h"
@@ -28,6 +30,7 @@
 #include <shader.h>
 #include <shadercache.h>
 #include <shaderuniform.h>
+#include <streamingvertexbuffer.h>
 
 namespace Hexterminate
 {
@@ -39,6 +42,7 @@ TrailManagerRep::TrailManagerRep( TrailManager* pTrailManager )
     : m_pTrailManager( pTrailManager )
     , m_pShader( nullptr )
     , m_pVertexBuffer( nullptr )
+    , m_FirstVertex( 0 )
     , m_NumVertices( 0 )
 {
     using namespace Genesis;
@@ -49,7 +53,7 @@ TrailManagerRep::TrailManagerRep( TrailManager* pTrailManager )
     ShaderUniform* pDiffuseSamplerUniform = m_pShader->RegisterUniform( "k_sampler0", ShaderUniformType::Texture );
     pDiffuseSamplerUniform->Set( pTexture, GL_TEXTURE0 );
 
-    m_pVertexBuffer = new VertexBuffer( GeometryType::Triangle, VBO_POSITION | VBO_UV | VBO_COLOR );
+    m_pVertexBuffer = new StreamingVertexBuffer( GeometryType::Triangle, VBO_POSITION | VBO_UV | VBO_COLOR, sTrailMaxVertices );
 }
 
 TrailManagerRep::~TrailManagerRep()
@@ -63,17 +67,37 @@ void TrailManagerRep::Update( float delta )
 
     SceneObject::Update( delta );
 
-    PositionData posData;
-    UVData uvData;
-    ColorData colorData;
-    posData.reserve( 512 );
-    uvData.reserve( 512 );
-    colorData.reserve( 512 );
+    m_NumVertices = 0;
 
+    // Every segment of every trail produces at most one quad.
     const TrailList& trails = m_pTrailManager->GetTrails();
+    uint32_t maxVertices = 0;
+    for ( auto& pTrail : trails )
+    {
+        const size_t pointCount = pTrail->GetData().size();
+        if ( pointCount >= 2 )
+        {
+            maxVertices += static_cast<uint32_t>( ( pointCount - 1 ) * sNumBaseIndices );
+        }
+    }
+
+    maxVertices = std::min( maxVertices, m_pVertexBuffer->GetMaxVerticesPerFrame() );
+    if ( maxVertices == 0 )
+    {
+        return;
+    }
+
+    StreamingVertex* pVertices = m_pVertexBuffer->Map( maxVertices, m_FirstVertex );
+    if ( pVertices == nullptr )
+    {
+        return;
+    }
+
+    const bool drawDebugLines = g_pGame->GetCurrentSector()->GetShipTweaks()->GetDrawTrails();
+    uint32_t vertexCount = 0;
     glm::vec3 p1, p2, d;
     glm::vec3 v[ 4 ];
-    Genesis::VboFloat3 vf;
+    glm::vec3 lastPosition;
     for ( auto& pTrail : trails )
     {
         const TrailPointDataList& data = pTrail->GetData();
@@ -85,6 +109,11 @@ void TrailManagerRep::Update( float delta )
         bool useLast = true;
         for ( TrailPointDataList::const_iterator it = data.begin(), nextIt = data.begin(), endIt = data.end(); ++nextIt != endIt; ++it )
         {
+            if ( vertexCount + sNumBaseIndices > maxVertices )
+            {
+                break;
+            }
+
             p1 = it->GetPosition();
             p2 = nextIt->GetPosition();
             d = p2 - p1;
@@ -112,48 +141,34 @@ void TrailManagerRep::Update( float delta )
             v[ 1 ] = p2 + d;
             v[ 2 ] = p2 - d;
 
-            posData.push_back( v[ 0 ] );
-            posData.push_back( v[ 1 ] );
-            posData.push_back( v[ 2 ] );
-            posData.push_back( v[ 0 ] );
-            posData.push_back( v[ 2 ] );
-            posData.push_back( v[ 3 ] );
-
-            PushBackUVs( uvData );
-            PushBackColors( colorData, pTrail->GetColor(), pTrail->GetInitialWidth(), it->GetWidth(), nextIt->GetWidth() );
-
-            useLast = true;
-        }
-    }
+            const float a1 = it->GetWidth() / pTrail->GetInitialWidth();
+            const float a2 = nextIt->GetWidth() / pTrail->GetInitialWidth();
+            AddQuad( pVertices + vertexCount, v, pTrail->GetColor(), a1, a2 );
 
-    if ( g_pGame->GetCurrentSector()->GetShipTweaks()->GetDrawTrails() )
-    {
-        size_t l = posData.size();
-        for ( size_t i = 0; i < l - 1; ++i )
-        {
-            if ( l > 2 )
+            if ( drawDebugLines )
             {
-                Genesis::FrameWork::GetDebugRender()->DrawLine(
-                    posData[ i ],
-                    posData[ i + 1 ],
-                    glm::vec3( 1.0f, 0.0f, 0.0f ) );
+                for ( Uint32 i = 0; i < sNumBaseIndices; ++i )
+                {
+                    const glm::vec3& position = v[ sBaseIndices[ i ] ];
+                    if ( vertexCount + i > 0 )
+                    {
+                        Genesis::FrameWork::GetDebugRender()->DrawLine( lastPosition, position, glm::vec3( 1.0f, 0.0f, 0.0f ) );
+                    }
+                    lastPosition = position;
+                }
             }
+
+            vertexCount += sNumBaseIndices;
+            useLast = true;
         }
     }
 
-    if ( posData.empty() == false )
-    {
-        m_pVertexBuffer->CopyPositions( posData );
-        m_pVertexBuffer->CopyUVs( uvData );
-        m_pVertexBuffer->CopyColors( colorData );
-
-        m_NumVertices = posData.size();
-    }
+    m_pVertexBuffer->Unmap( vertexCount );
+    m_NumVertices = vertexCount;
 }
 
-void TrailManagerRep::PushBackUVs( Genesis::UVData& uvData )
+void TrailManagerRep::AddQuad( Genesis::StreamingVertex* pVertices, const glm::vec3* pPositions, const Genesis::Color& color, float alpha1, float alpha2 )
 {
-    using namespace Genesis;
     static const glm::vec2 uvs[ 4 ] = {
         glm::vec2( 0.0f, 0.0f ),
         glm::vec2( 1.0f, 0.0f ),
@@ -161,29 +176,20 @@ void TrailManagerRep::PushBackUVs( Genesis::UVData& uvData )
         glm::vec2( 0.0f, 1.0f )
     };
 
-    for ( Uint32 i = 0; i < sNumBaseIndices; ++i )
-    {
-        uvData.push_back( uvs[ sBaseIndices[ i ] ] );
-    }
-}
-
-void TrailManagerRep::PushBackColors( Genesis::ColorData& colorData, const Genesis::Color& color, float initialWidth, float currentWidth, float nextWidth )
-{
-    using namespace Genesis;
-    const float r = color.r;
-    const float g = color.g;
-    const float b = color.b;
-    const float a1 = currentWidth / initialWidth;
-    const float a2 = nextWidth / initialWidth;
     const glm::vec4 colors[ 4 ] = {
-        glm::vec4( r, g, b, a1 ),
-        glm::vec4( r, g, b, a2 ),
-        glm::vec4( r, g, b, a2 ),
-        glm::vec4( r, g, b, a1 )
+        glm::vec4( color.r, color.g, color.b, alpha1 ),
+        glm::vec4( color.r, color.g, color.b, alpha2 ),
+        glm::vec4( color.r, color.g, color.b, alpha2 ),
+        glm::vec4( color.r, color.g, color.b, alpha1 )
     };
 
     for ( Uint32 i = 0; i < sNumBaseIndices; ++i )
-        colorData.push_back( colors[ sBaseIndices[ i ] ] );
+    {
+        const Uint32 index = sBaseIndices[ i ];
+        pVertices[ i ].position = pPositions[ index ];
+        pVertices[ i ].uv = uvs[ index ];
+        pVertices[ i ].color = colors[ index ];
+    }
 }
 
 void TrailManagerRep::Render()
@@ -200,9 +206,9 @@ void TrailManagerRep::Render()
         m_pShader->Use();
 
         pRenderSystem->SetRenderTarget( RenderTargetId::Glow );
-        m_pVertexBuffer->Draw( static_cast<uint32_t>( m_NumVertices ) );
+        m_pVertexBuffer->Draw( m_FirstVertex, m_NumVertices );
         pRenderSystem->SetRenderTarget( RenderTargetId::Default );
-        m_pVertexBuffer->Draw( static_cast<uint32_t>( m_NumVertices ) );
+        m_pVertexBuffer->Draw( m_FirstVertex, m_NumVertices );
 
         pRenderSystem->SetBlendMode( BlendMode::Disabled );
     }
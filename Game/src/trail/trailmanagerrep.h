@@ -19,7 +19,7 @@
 
 #include <rendersystem.h>
 #include <scene/sceneobject.h>
-#include <vertexbuffer.h>
+#include <streamingvertexbuffer.h>
 
 namespace Genesis
 {
@@ -34,6 +34,8 @@ namespace Hexterminate
 class TrailManager;
 class Trail;
 
+static const uint32_t sTrailMaxVertices = 64 * 1024;
+
 class TrailManagerRep : public Genesis::SceneObject
 {
 public:
@@ -43,13 +45,13 @@ public:
     virtual void Render() override;
 
 private:
-    void PushBackUVs( Genesis::UVData& uvData );
-    void PushBackColors( Genesis::ColorData& colorData, const Genesis::Color& color, float initialWidth, float currentWidth, float nextWidth );
+    void AddQuad( Genesis::StreamingVertex* pVertices, const glm::vec3* pPositions, const Genesis::Color& color, float alpha1, float alpha2 );
 
     TrailManager* m_pTrailManager;
     Genesis::Shader* m_pShader;
-    Genesis::VertexBuffer* m_pVertexBuffer;
-    size_t m_NumVertices;
+    Genesis::StreamingVertexBuffer* m_pVertexBuffer;
+    uint32_t m_FirstVertex;
+    uint32_t m_NumVertices;
 };
 
 } // namespace Hexterminate
\ No newline at end of file
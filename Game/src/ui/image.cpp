@@ -75,7 +75,7 @@ void Image::SetPath( const std::string& filename )
 
 void Image::SetShader( const std::string& shaderName )
 {
-    m_pImage->SetShader( Genesis::FrameWork::GetRenderSystem()->GetShaderCache()->Load( shaderName ) );
+    m_pImage->SetShader( shaderName.empty() ? nullptr : Genesis::FrameWork::GetRenderSystem()->GetShaderCache()->Load( shaderName ) );
 }
 
 void Image::LoadResources()
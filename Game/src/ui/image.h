@@ -60,7 +60,7 @@ public:
     void SetColor( const Genesis::Color& color );
     void SetColor( float r, float g, float b, float a );
     void SetPath( const std::string& filename );
-    void SetShader( const std::string& shaderName );
+    void SetShader( const std::string& shaderName ); // An empty name goes back to the batched GUI shader.
 
 protected:
     virtual void SaveProperties( json& properties ) override;
@@ -62,6 +62,19 @@ if [ $1 == "steam" ]; then
     cp $PROJECT_ROOT/Genesis/libs/steamworks/sdk/redistributable_bin/linux64/libsteam_api.so $INTERMEDIATES_GAME_DIR
 fi
 
+echo === Cooking data.pak ===
+
+# The pack is written straight into the intermediates, as a data.pak left in bin would be mounted by every later dev run.
+pushd $HEXTERMINATE_DIR
+./Hexterminate --cook $INTERMEDIATES_GAME_DIR/data.pak
+COOK_RESULT=$?
+popd
+
+if [ $COOK_RESULT != 0 ]; then
+    echo Cooking failed.
+    exit $COOK_RESULT
+fi
+
 OUTPUT_DIR=$PROJECT_ROOT/Game/tools/publish/output
 mkdir $OUTPUT_DIR 2>/dev/null
 
@@ -63,6 +63,18 @@ copy %HEXTERMINATE_DIR%\crashhandler\crashpad_handler.exe %INTERMEDIATES_GAME_DI
 xcopy %HEXTERMINATE_DIR%\data %INTERMEDIATES_GAME_DIR%\data /s /i
 if "%1"=="steam" copy %HEXTERMINATE_DIR%\steam_api64.dll %INTERMEDIATES_GAME_DIR%
 
+echo === Cooking data.pak ===
+
+rem The pack is written straight into the intermediates, as a data.pak left in bin would be mounted by every later dev run.
+pushd %HEXTERMINATE_DIR%
+Hexterminate.exe --cook %INTERMEDIATES_GAME_DIR%\data.pak
+set COOK_RESULT=%errorlevel%
+popd
+if not %COOK_RESULT%==0 (
+    echo Cooking failed.
+    exit /b %COOK_RESULT%
+)
+
 set "OUTPUT_DIR=%PROJECT_ROOT%\Game\tools\publish\output"
 mkdir %OUTPUT_DIR% 2>NUL
 
@@ -32,8 +32,14 @@ from bpy_extras.image_utils import load_image
 # TMF exporter
 ###############################################################################
 
-def getVersion():
-    return 91
+# Version 91 stores positions and UVs in separate lists which the game has to
+# expand into vertices when loading. Version 200 stores the vertices already
+# interleaved (position, UV, normal) and deduplicated, followed by the indices.
+def getVersion(use_indexed):
+    if use_indexed:
+        return 200
+    else:
+        return 91
 
 
 def getHelperCount():
@@ -138,6 +144,47 @@ def writeTriangles(file, bm):
         file.write(normals)
 
 
+# Builds the interleaved vertices and indices for a version 200 object.
+# Corners are shared whenever they use the same vertex and the same UV. The UVs
+# are flipped here, the same way the game flips them when loading version 91.
+def buildIndexedVertices(bm):
+    uv_lay = bm.loops.layers.uv.active
+    vertex_map = {}
+    vertex_data = array.array("f")
+    indices = array.array("I")
+    for face in bm.faces:
+        for loop in face.loops:
+            vert = loop.vert
+            uv = loop[uv_lay].uv
+            key = (vert.index, uv.x, uv.y)
+            index = vertex_map.get(key)
+            if index is None:
+                index = len(vertex_map)
+                vertex_map[key] = index
+                vertex_data.extend((vert.co.x, vert.co.y, vert.co.z,
+                                    uv.x, 1.0 - uv.y,
+                                    vert.normal.x, vert.normal.y, vert.normal.z))
+            indices.append(index)
+    return vertex_data, indices
+
+
+def writeIndexedObject(file, object, bm):
+    material_index = getMaterialIndex(object)
+    vertex_data, indices = buildIndexedVertices(bm)
+    num_vertices = len(vertex_data) // 8
+
+    print("Header:")
+    print("- Material index:", material_index)
+    print("- Vertices:", num_vertices)
+    print("- Indices:", len(indices))
+
+    assert indices.itemsize == 4
+    header = struct.pack("=III", material_index, num_vertices, len(indices))
+    file.write(header)
+    vertex_data.tofile(file)
+    indices.tofile(file)
+
+
 def writeHelper(file, helper):
     print("=== Writing helper", helper.name, "===")
     nameLength = struct.pack("=I", len(helper.name))
@@ -146,7 +193,7 @@ def writeHelper(file, helper):
     file.write(nameLength + name + location)
 
 
-def writeObject(file, object_id, object):
+def writeObject(file, object_id, object, use_indexed):
     print("=== Writing object", object.name, "===")
     print("ID:", object_id)
     
@@ -155,14 +202,19 @@ def writeObject(file, object_id, object):
     bm.from_object(object, depsgraph=bpy.context.evaluated_depsgraph_get())
     bmesh.ops.triangulate(bm, faces=bm.faces[:], quad_method="BEAUTY", ngon_method="BEAUTY")
     
-    writeObjectHeader(file, object, bm)
-    writeVertices(file, bm)
-    writeUVs(file, bm)
-    writeTriangles(file, bm)
+    if use_indexed:
+        writeIndexedObject(file, object, bm)
+    else:
+        writeObjectHeader(file, object, bm)
+        writeVertices(file, bm)
+        writeUVs(file, bm)
+        writeTriangles(file, bm)
+
+    bm.free()
 
 
-def writeHeader(file):
-    header = struct.pack("=cccHHH", b"T", b"M", b"F", getVersion(), getObjectCount(), getHelperCount())
+def writeHeader(file, use_indexed):
+    header = struct.pack("=cccHHH", b"T", b"M", b"F", getVersion(use_indexed), getObjectCount(), getHelperCount())
     file.write(header)
 
 
@@ -172,11 +224,11 @@ def writeHelpers(file):
             writeHelper(file, element)
 
 
-def writeObjects(file):
+def writeObjects(file, use_indexed):
     id = 0
     for element in bpy.context.scene.objects:
         if element.type == "MESH":
-              writeObject(file, id, element)
+              writeObject(file, id, element, use_indexed)
               id = id + 1          
 
 
@@ -184,7 +236,8 @@ def saveTMF(context,
          filepath,
          *,
          global_matrix=None,
-         path_mode="AUTO"
+         path_mode="AUTO",
+         use_indexed=True
          ):
        
     global current_material_index
@@ -194,9 +247,9 @@ def saveTMF(context,
     materials.clear()
 
     with open(filepath, "wb") as file:
-        writeHeader(file)
+        writeHeader(file, use_indexed)
         writeHelpers(file)
-        writeObjects(file)
+        writeObjects(file, use_indexed)
         file.close()
 
     print("Export finished.")
@@ -308,6 +361,39 @@ def loadObject(file, object_index):
     #    ob.data.materials.append(loadedMaterials[material_index])
     
     
+def loadIndexedObject(file, object_index):
+    print("Loading indexed object", object_index, "...")
+
+    material_index = int.from_bytes(file.read(4), byteorder="little") - 1
+    vertex_count = int.from_bytes(file.read(4), byteorder="little")
+    index_count = int.from_bytes(file.read(4), byteorder="little")
+
+    print("- Material index:", material_index)
+    print("- Vertex count:", vertex_count)
+    print("- Index count:", index_count)
+
+    vertex_data = array.array("f")
+    vertex_data.fromfile(file, vertex_count * 8)
+    indices = array.array("I")
+    indices.fromfile(file, index_count)
+
+    # Every vertex has its own UV, so the UV indices are the same as the vertex indices.
+    vertices = []
+    uvs = []
+    for vertex in range(0, vertex_count):
+        offset = vertex * 8
+        vertices.append(mathutils.Vector(vertex_data[offset:offset + 3]))
+        uvs.append(UV((vertex_data[offset + 3], 1.0 - vertex_data[offset + 4])))
+
+    triangles = []
+    for index in range(0, index_count, 3):
+        triangle_indices = tuple(indices[index:index + 3])
+        triangles.append(Triangle(triangle_indices + triangle_indices + (0.0,) * 9))
+
+    origin = mathutils.Vector((0,0,0))
+    createMeshFromData("Object{0}".format(object_index + 1), origin, triangles, vertices, uvs)
+
+
 def loadMaterials(filepath):
     materialFilepath = os.path.splitext(filepath)[0]+".tml"
     with open(materialFilepath, "r") as file:
@@ -378,7 +464,10 @@ def loadTMF(context,
             loadHelper(file)
             
         for object_index in range(0, object_count):
-            loadObject(file, object_index)
+            if version == 200:
+                loadIndexedObject(file, object_index)
+            else:
+                loadObject(file, object_index)
 
     return {'FINISHED'}
 
@@ -528,6 +617,8 @@ class TMF_PT_export_include(bpy.types.Panel):
         sfile = context.space_data
         operator = sfile.active_operator
 
+        layout.prop(operator, 'use_indexed')
+
 
 class TMF_PT_export_transform(bpy.types.Panel):
     bl_space_type = 'FILE_BROWSER'
@@ -607,6 +698,12 @@ class ExportTMF(bpy.types.Operator, ExportHelper):
 
     path_mode: path_reference_mode
 
+    use_indexed: BoolProperty(
+            name="Indexed Vertices",
+            description="Write version 200 of the format, with deduplicated vertices and indices",
+            default=True,
+            )
+
     check_extension = True
 
     def execute(self, context):
@@ -0,0 +1,75 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Genesis.
+//
+// Genesis is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Genesis is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Genesis. If not, see <http://www.gnu.org/licenses/>.
+
+#include "frameuniformbuffer.h"
+
+#include <cstring>
+
+#include <glm/matrix.hpp>
+
+namespace Genesis
+{
+
+FrameUniformBuffer::FrameUniformBuffer()
+    : m_Buffer( 0 )
+{
+    memset( &m_Data, 0, sizeof( Data ) );
+
+    glGenBuffers( 1, &m_Buffer );
+    glBindBuffer( GL_UNIFORM_BUFFER, m_Buffer );
+    glBufferData( GL_UNIFORM_BUFFER, sizeof( Data ), &m_Data, GL_DYNAMIC_DRAW );
+    glBindBuffer( GL_UNIFORM_BUFFER, 0 );
+    glBindBufferBase( GL_UNIFORM_BUFFER, sFrameUniformsBinding, m_Buffer );
+}
+
+FrameUniformBuffer::~FrameUniformBuffer()
+{
+    glDeleteBuffers( 1, &m_Buffer );
+}
+
+void FrameUniformBuffer::Update( const glm::mat4& view, const glm::mat4& projection, const glm::vec2& resolution, float time )
+{
+    if ( view != m_Data.view )
+    {
+        m_Data.view = view;
+        m_Data.viewInverse = glm::inverse( view );
+    }
+
+    m_Data.projection = projection;
+    m_Data.viewProjection = projection * view;
+    m_Data.resolution = resolution;
+    m_Data.time = time;
+
+    glBindBuffer( GL_UNIFORM_BUFFER, m_Buffer );
+    glBufferSubData( GL_UNIFORM_BUFFER, 0, sizeof( Data ), &m_Data );
+    glBindBuffer( GL_UNIFORM_BUFFER, 0 );
+}
+
+const char* FrameUniformBuffer::GetBlockDeclaration()
+{
+    return "layout(std140) uniform FrameUniforms\n"
+           "{\n"
+           "    mat4 k_view;\n"
+           "    mat4 k_projection;\n"
+           "    mat4 k_viewProjection;\n"
+           "    mat4 k_viewInverse;\n"
+           "    vec2 k_resolution;\n"
+           "    float k_time;\n"
+           "};";
+}
+
+} // namespace Genesis
@@ -0,0 +1,71 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Genesis.
+//
+// Genesis is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Genesis is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Genesis. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+
+#include "rendersystem.fwd.h"
+#include "coredefines.h"
+
+namespace Genesis
+{
+
+// Uniform buffer binding point reserved for the FrameUniforms block.
+static const GLuint sFrameUniformsBinding = 0;
+
+///////////////////////////////////////////////////////////////////////////////
+// FrameUniformBuffer
+// A std140 uniform buffer holding the data shared by every draw in a view:
+// the view and projection matrices, the shader timer and the resolution.
+// It is updated by the RenderSystem whenever the view changes, rather than
+// every shader uploading the same values on each Use(). The ShaderCache
+// adds the block's declaration to every shader, so the members can be used
+// as if they were regular uniforms.
+///////////////////////////////////////////////////////////////////////////////
+
+class FrameUniformBuffer
+{
+public:
+    FrameUniformBuffer();
+    ~FrameUniformBuffer();
+
+    void Update( const glm::mat4& view, const glm::mat4& projection, const glm::vec2& resolution, float time );
+
+    static const char* GetBlockDeclaration();
+
+private:
+    // Must match the layout of the block returned by GetBlockDeclaration().
+    struct Data
+    {
+        glm::mat4 view;
+        glm::mat4 projection;
+        glm::mat4 viewProjection;
+        glm::mat4 viewInverse;
+        glm::vec2 resolution;
+        float time;
+        float padding;
+    };
+    static_assert( sizeof( Data ) == 4 * 64 + 16 );
+
+    GLuint m_Buffer;
+    Data m_Data;
+};
+GENESIS_DECLARE_SMART_PTR( FrameUniformBuffer );
+
+} // namespace Genesis
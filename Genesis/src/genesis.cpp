@@ -26,6 +26,7 @@
 #include "imgui/imgui_impl.h"
 #include "inputmanager.h"
 #include "memory.h"
+#include "profiling/profiler.h"
 #include "render/debugrender.h"
 #include "rendersystem.h"
 #include "resourcemanager.h"
@@ -56,23 +57,35 @@ Gui::GuiManager* gGuiManager = nullptr;
 Sound::SoundManager* gSoundManager = nullptr;
 VideoPlayer* gVideoPlayer = nullptr;
 Render::DebugRender* gDebugRender = nullptr;
+Profiling::Profiler* gProfiler = nullptr;
 
 CommandLineParameters* FrameWork::m_pCommandLineParameters = nullptr;
+bool FrameWork::m_Headless = false;
 
 //-------------------------------------------------------------------
 // FrameWork
 //-------------------------------------------------------------------
 
-bool FrameWork::Initialize()
+bool FrameWork::Initialize( bool headless /* = false */ )
 {
+    m_Headless = headless;
+
     // Initialize the Logger
     // We also create a FileLogger to start logging to "log.txt" and
     // a MessageBoxLogger that creates a message box if the log is
-    // a warning or an error.
+    // a warning or an error. Nobody is around to dismiss message boxes
+    // when running headless, so the log goes to the console instead.
     gLogger = new Logger();
 
     gLogger->AddLogTarget( new FileLogger( "log.txt" ) );
-    gLogger->AddLogTarget( new MessageBoxLogger() );
+    if ( headless )
+    {
+        gLogger->AddLogTarget( new ConsoleLogger() );
+    }
+    else
+    {
+        gLogger->AddLogTarget( new MessageBoxLogger() );
+    }
 #ifdef _WIN32
 #ifdef _DEBUG
     gLogger->AddLogTarget( new VisualStudioLogger() );
@@ -96,7 +109,8 @@ bool FrameWork::Initialize()
     // Initialize SDL
     // Needs to be done before InputManager() is created,
     // otherwise key repetition won't work.
-    if ( SDL_Init( SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_EVENTS ) < 0 )
+    const Uint32 sdlFlags = headless ? ( SDL_INIT_TIMER | SDL_INIT_EVENTS ) : ( SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_EVENTS );
+    if ( SDL_Init( sdlFlags ) < 0 )
     {
         gLogger->LogError( "%s", SDL_GetError() );
     }
@@ -122,10 +136,20 @@ bool FrameWork::Initialize()
     gEventHandler = new EventHandler();
     gResourceManager = new ResourceManager();
 
+    // A cooked pack takes the place of the loose files in data/, unless we're about to cook a new one from them.
+    if ( m_pCommandLineParameters == nullptr || ( m_pCommandLineParameters->HasParameter( "--cook" ) == false && m_pCommandLineParameters->HasParameter( "--no-pack" ) == false ) )
+    {
+        gResourceManager->MountPack( "data.pak" );
+    }
+
+    // The profiler is created before the task manager so every task can be timed from the first frame.
+    gProfiler = new Profiling::Profiler();
+
     // Initialize the task manager, as well as all the related tasks
     gTaskManager = new TaskManager( gLogger );
 
     gTaskManager->AddTask( "InputManager", gInputManager, (TaskFunc)&InputManager::Update, TaskPriority::System );
+    gTaskManager->AddTask( "InputManagerHeld", gInputManager, (TaskFunc)&InputManager::UpdateHeldCallbacks, TaskPriority::System, TaskAccess(), TaskRate::Fixed );
     gTaskManager->AddTask( "EventHandler", gEventHandler, (TaskFunc)&EventHandler::Update, TaskPriority::System );
 
     gRenderSystem = new RenderSystem();
@@ -136,9 +160,21 @@ bool FrameWork::Initialize()
 
     gScene = new Scene();
     gTaskManager->AddTask( "Scene", gScene, (TaskFunc)&Scene::Update, TaskPriority::GameLogic );
+    gTaskManager->AddTask( "SceneFixed", gScene, (TaskFunc)&Scene::FixedUpdate, TaskPriority::GameLogic, TaskAccess(), TaskRate::Fixed );
 
     gSoundManager = new Sound::SoundManager();
-    gTaskManager->AddTask( "SoundManager", gSoundManager, (TaskFunc)&Sound::SoundManager::Update, TaskPriority::System );
+    gTaskManager->AddTask( "SoundManager", gSoundManager, (TaskFunc)&Sound::SoundManager::Update, TaskPriority::System,
+        TaskAccess( TaskResource::Sound | TaskResource::ImGui, TaskResource::Sound | TaskResource::ImGui, TaskAffinity::AnyThread ) );
+
+    gTaskManager->AddTask( "Profiler", gProfiler, (TaskFunc)&Profiling::Profiler::Update, TaskPriority::GameLogic );
+
+    // Headless runs get everything CreateWindowGL() would have set up, minus the window, ImGui and the video player.
+    if ( headless )
+    {
+        gRenderSystem->InitializeHeadless( Configuration::GetScreenWidth(), Configuration::GetScreenHeight() );
+        gGuiManager->Initialize();
+        gDebugRender = new Render::DebugRender();
+    }
 
     return true;
 }
@@ -163,6 +199,9 @@ void FrameWork::Shutdown()
     delete gTaskManager;
     gTaskManager = nullptr;
 
+    delete gProfiler;
+    gProfiler = nullptr;
+
     delete gRenderSystem;
     gRenderSystem = nullptr;
 
@@ -184,6 +223,8 @@ void FrameWork::Shutdown()
 
 bool FrameWork::CreateWindowGL( const std::string& name, uint32_t width, uint32_t height, uint32_t multiSampleSamples /* = 0 */ )
 {
+    SDL_assert( IsHeadless() == false );
+
     // Set OpenGL version to 3.3.
     SDL_GL_SetAttribute( SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE ); // OpenGL core profile
     SDL_GL_SetAttribute( SDL_GL_CONTEXT_MAJOR_VERSION, 3 ); // OpenGL 3+
@@ -207,13 +248,19 @@ bool FrameWork::CreateWindowGL( const std::string& name, uint32_t width, uint32_
     ImGuiImpl::Initialise();
 
     gVideoPlayer = new VideoPlayer();
-    gTaskManager->AddTask( "VideoPlayer", gVideoPlayer, (TaskFunc)&VideoPlayer::Update, TaskPriority::System );
+    gTaskManager->AddTask( "VideoPlayer", gVideoPlayer, (TaskFunc)&VideoPlayer::Update, TaskPriority::System,
+        TaskAccess( TaskResource::Video, TaskResource::Video, TaskAffinity::AnyThread ) );
 
     gDebugRender = new Render::DebugRender();
 
     return true;
 }
 
+bool FrameWork::IsHeadless()
+{
+    return m_Headless;
+}
+
 CommandLineParameters* FrameWork::CreateCommandLineParameters( const char* parameterStr )
 {
     m_pCommandLineParameters = new CommandLineParameters( parameterStr );
@@ -241,6 +288,11 @@ TaskManager* FrameWork::GetTaskManager()
     return gTaskManager;
 }
 
+JobSystem* FrameWork::GetJobSystem()
+{
+    return ( gTaskManager == nullptr ) ? nullptr : gTaskManager->GetJobSystem();
+}
+
 InputManager* FrameWork::GetInputManager()
 {
     return gInputManager;
@@ -286,6 +338,11 @@ Render::DebugRender* FrameWork::GetDebugRender()
     return gDebugRender;
 }
 
+Profiling::Profiler* FrameWork::GetProfiler()
+{
+    return gProfiler;
+}
+
 //---------------------------------------------------------------
 // CommandLineParameters
 //---------------------------------------------------------------
@@ -339,4 +396,19 @@ bool CommandLineParameters::HasParameter( const std::string& name ) const
 
     return false;
 }
+
+bool CommandLineParameters::GetParameterValue( const std::string& name, std::string& value ) const
+{
+    for ( size_t i = 0; i + 1 < mParameters.size(); i++ )
+    {
+        if ( mParameters[ i ] == name )
+        {
+            value = mParameters[ i + 1 ];
+            return true;
+        }
+    }
+
+    return false;
+}
+
 } // namespace Genesis
\ No newline at end of file
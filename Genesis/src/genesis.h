@@ -29,6 +29,7 @@ class CrashHandler;
 class TaskManager;
 class Timer;
 class InputManager;
+class JobSystem;
 class RenderSystem;
 class ResourceManager;
 class Scene;
@@ -41,6 +42,11 @@ namespace Gui
     class GuiManager;
 }
 
+namespace Profiling
+{
+    class Profiler;
+}
+
 namespace Render
 {
 	class DebugRender;
@@ -54,9 +60,12 @@ namespace Sound
 class FrameWork
 {
 public:
-    static bool Initialize();
+    // When headless, no window, GL context or audio device is created: GPU resources and sounds are
+    // stubbed out so the simulation can run on machines without a GPU. CreateWindowGL() must not be called.
+    static bool Initialize( bool headless = false );
     static void Shutdown();
     static bool CreateWindowGL( const std::string& name, uint32_t width, uint32_t height, uint32_t multiSampleSamples = 0 );
+    static bool IsHeadless();
 
     static CommandLineParameters* CreateCommandLineParameters( const char* parameterStr );
     static CommandLineParameters* CreateCommandLineParameters( const char** parameters, uint32_t numParameters );
@@ -64,6 +73,7 @@ public:
 
     static CrashHandler* GetCrashHandler();
     static TaskManager* GetTaskManager();
+    static JobSystem* GetJobSystem();
     static Logger* GetLogger();
     static InputManager* GetInputManager();
     static Window* GetWindow();
@@ -74,9 +84,11 @@ public:
     static Sound::SoundManager* GetSoundManager();
     static VideoPlayer* GetVideoPlayer();
 	static Render::DebugRender* GetDebugRender();
+    static Profiling::Profiler* GetProfiler();
 
 private:
     static CommandLineParameters* m_pCommandLineParameters;
+    static bool m_Headless;
 };
 
 class CommandLineParameters
@@ -88,6 +100,9 @@ public:
     const std::string& GetParameter( uint32_t n ) const;
     bool HasParameter( const std::string& name ) const;
 
+    // Retrieves the parameter following "name", e.g. "--ticks 600". Returns false if there isn't one.
+    bool GetParameterValue( const std::string& name, std::string& value ) const;
+
 private:
     typedef std::vector<std::string> CommandLineParameter;
     CommandLineParameter mParameters;
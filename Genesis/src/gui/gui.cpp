@@ -65,12 +65,8 @@ namespace Gui
     // GuiManager
     ///////////////////////////////////////////////////////////////////////////
 
-    Shader* GuiManager::m_pUntexturedShader = nullptr;
-    ShaderUniform* GuiManager::m_pUntexturedColorUniform = nullptr;
-    Shader* GuiManager::m_pTexturedShader = nullptr;
-    ShaderUniform* GuiManager::m_pTexturedSamplerUniform = nullptr;
-    ShaderUniform* GuiManager::m_pTexturedColorUniform = nullptr;
     Shader* GuiManager::m_pHighlightShader = nullptr;
+    GuiDrawList* GuiManager::m_pDrawList = nullptr;
 
     GuiManager::GuiManager()
         : m_pHighlighted( nullptr )
@@ -87,19 +83,18 @@ namespace Gui
         }
 
         delete m_pCursor;
+
+        delete m_pDrawList;
+        m_pDrawList = nullptr;
     }
 
     void GuiManager::Initialize()
     {
         ShaderCache* pShaderCache = FrameWork::GetRenderSystem()->GetShaderCache();
-        m_pUntexturedShader = pShaderCache->Load( "gui_untextured" );
-        m_pUntexturedColorUniform = m_pUntexturedShader->RegisterUniform( "k_color", ShaderUniformType::FloatVector4 );
-        m_pTexturedShader = pShaderCache->Load( "gui_textured" );
-        m_pTexturedColorUniform = m_pTexturedShader->RegisterUniform( "k_color", ShaderUniformType::FloatVector4 );
-        m_pTexturedSamplerUniform = m_pTexturedShader->RegisterUniform( "k_sampler0", ShaderUniformType::Texture );
         m_pHighlightShader = pShaderCache->Load( "gui_highlight" );
 
         m_pHighlightedVB = std::make_unique<VertexBuffer>( GeometryType::Triangle, VBO_POSITION );
+        m_pDrawList = new GuiDrawList();
 
         m_pCursor = new Cursor();
     }
@@ -166,19 +161,22 @@ namespace Gui
             if ( pChildElement->IsVisible() == false )
                 continue;
 
-            renderSystem->SetBlendMode( pChildElement->GetBlendMode() );
+            m_pDrawList->SetBlendMode( pChildElement->GetBlendMode() );
             pChildElement->UpdateClipRectangle();
             pChildElement->Render();
         }
 
+        m_pDrawList->Flush();
+
         RenderHighlight();
 
         // The cursor should be rendered after everything else
         if ( m_pCursor->IsVisible() && ImGuiImpl::IsEnabled() == false )
         {
-            renderSystem->SetBlendMode( BlendMode::Blend );
+            m_pDrawList->SetBlendMode( BlendMode::Blend );
             m_pCursor->UpdateClipRectangle();
             m_pCursor->Render();
+            m_pDrawList->Flush();
         }
 
         renderSystem->ViewPerspective();
@@ -246,8 +244,9 @@ namespace Gui
     {
         if ( m_pHighlighted )
         {
-            FrameWork::GetRenderSystem()->SetBlendMode( BlendMode::Disabled );
+            m_pDrawList->SetBlendMode( BlendMode::Disabled );
             m_pHighlighted->UpdateClipRectangle();
+            m_pDrawList->Flush(); // Applies the blend mode and the clip rectangle.
             GetHighlightShader()->Use();
             m_pHighlightedVB->Draw();
         }
@@ -379,7 +378,7 @@ namespace Gui
             if ( ( *it )->IsVisible() == false )
                 continue;
 
-            FrameWork::GetRenderSystem()->SetBlendMode( ( *it )->GetBlendMode() );
+            GuiManager::GetDrawList()->SetBlendMode( ( *it )->GetBlendMode() );
             ( *it )->UpdateClipRectangle();
             ( *it )->Render();
         }
@@ -413,11 +412,11 @@ namespace Gui
         // glScissor origin is on the bottom left corner of the screen...
         const int width = std::max( 0, static_cast<int>( mClipRectangle.max.x - mClipRectangle.min.x ) );
         const int height = std::max( 0, static_cast<int>( mClipRectangle.max.y - mClipRectangle.min.y ) );
-        glScissor(
+        GuiManager::GetDrawList()->SetScissor( {
             static_cast<int>( mClipRectangle.min.x ),
             static_cast<int>( Configuration::GetScreenHeight() ) - static_cast<int>( mClipRectangle.max.y ),
             width,
-            height );
+            height } );
     }
 
     void GuiElement::SetPosition( const glm::vec2& position )
@@ -495,29 +494,18 @@ namespace Gui
         : m_Color( 1.0f, 1.0f, 1.0f, 1.0 )
         , m_BorderColor( 1.0f, 1.0f, 1.0f, 1.0f )
         , m_BorderMode( PANEL_BORDER_NONE )
-        , m_pBackgroundVertexBuffer( nullptr )
-        , m_pBorderVertexBuffer( nullptr )
     {
-        m_pBackgroundVertexBuffer = new VertexBuffer( GeometryType::Triangle, VBO_POSITION );
-        m_pBorderVertexBuffer = new VertexBuffer( GeometryType::Line, VBO_POSITION );
     }
 
     Panel::~Panel()
     {
-        delete m_pBackgroundVertexBuffer;
-        delete m_pBorderVertexBuffer;
     }
 
     void Panel::Render()
     {
         if ( m_Color.a > 0.001f )
         {
-            const glm::vec2 pos = GetPositionAbsolute();
-            m_pBackgroundVertexBuffer->CreateUntexturedQuad( pos.x, pos.y, mSize.x, mSize.y );
-            glm::vec4 color( m_Color.r, m_Color.g, m_Color.b, m_Color.a );
-            GuiManager::GetUntexturedShaderColorUniform()->Set( color );
-            GuiManager::GetUntexturedShader()->Use();
-            m_pBackgroundVertexBuffer->Draw();
+            GuiManager::GetDrawList()->AddQuad( GetPositionAbsolute(), mSize, m_Color.glm() );
         }
 
         DrawBorder();
@@ -561,11 +549,7 @@ namespace Gui
             posData.push_back( glm::vec3( pos.x + mSize.x - 1.0f, pos.y + mSize.y - 1.0f, 0.0f ) );
         }
 
-        m_pBorderVertexBuffer->CopyPositions( posData );
-        glm::vec4 color( m_BorderColor.r, m_BorderColor.g, m_BorderColor.b, m_BorderColor.a );
-        GuiManager::GetUntexturedShaderColorUniform()->Set( glm::vec4( color ) );
-        GuiManager::GetUntexturedShader()->Use();
-        m_pBorderVertexBuffer->Draw();
+        GuiManager::GetDrawList()->AddLines( posData.data(), posData.size(), m_BorderColor.glm() );
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -618,7 +602,6 @@ namespace Gui
         , m_pOverrideShaderColorUniform( nullptr )
         , m_pOverrideShaderSamplerUniform( nullptr )
     {
-        m_pImageVertexBuffer = new VertexBuffer( GeometryType::Triangle, VBO_POSITION | VBO_UV );
     }
 
     Image::~Image()
@@ -629,10 +612,13 @@ namespace Gui
     void Image::Render()
     {
         const glm::vec2 pos = GetPositionAbsolute();
-        m_pImageVertexBuffer->CreateTexturedQuad( pos.x, pos.y, mSize.x, mSize.y );
 
+        // Override shaders can't be batched, so anything added to the draw list so far needs to be drawn first.
         if ( m_pOverrideShader != nullptr )
         {
+            GuiManager::GetDrawList()->Flush();
+            m_pImageVertexBuffer->CreateTexturedQuad( pos.x, pos.y, mSize.x, mSize.y );
+
             if ( m_pOverrideShaderColorUniform != nullptr )
             {
                 m_pOverrideShaderColorUniform->Set( m_Color.glm() );
@@ -644,21 +630,17 @@ namespace Gui
             }
 
             m_pOverrideShader->Use();
+            m_pImageVertexBuffer->Draw();
+        }
+        else if ( m_pImage != nullptr )
+        {
+            GuiManager::GetDrawList()->AddTexturedQuad( pos, mSize, m_Color.glm(), m_pImage->GetTexture() );
         }
         else
         {
-            GuiManager::GetTexturedShaderColorUniform()->Set( m_Color.glm() );
-
-            if ( m_pImage != nullptr )
-            {
-                GuiManager::GetTexturedSamplerUniform()->Set( m_pImage, GL_TEXTURE0 );
-            }
-
-            GuiManager::GetTexturedShader()->Use();
+            GuiManager::GetDrawList()->AddQuad( pos, mSize, m_Color.glm() );
         }
 
-        m_pImageVertexBuffer->Draw();
-
         DrawBorder();
 
         GuiElement::Render();
@@ -670,6 +652,11 @@ namespace Gui
 
         if ( m_pOverrideShader != nullptr )
         {
+            if ( m_pImageVertexBuffer == nullptr )
+            {
+                m_pImageVertexBuffer = new VertexBuffer( GeometryType::Triangle, VBO_POSITION | VBO_UV );
+            }
+
             m_pOverrideShaderColorUniform = m_pOverrideShader->RegisterUniform( "k_color", ShaderUniformType::FloatVector4 );
             m_pOverrideShaderSamplerUniform = m_pOverrideShader->RegisterUniform( "k_sampler0", ShaderUniformType::Texture );
         }
@@ -722,15 +709,15 @@ namespace Gui
         , m_Text( "" )
         , m_ProcessedText( "" )
         , m_Color( 1.0f, 1.0f, 1.0f, 1.0f )
-        , m_pVertexBuffer( nullptr )
         , m_LineSpacing( 1.0f )
+        , m_VerticesOrigin( 0.0f, 0.0f )
+        , m_VerticesColor( 0.0f, 0.0f, 0.0f, 0.0f )
+        , m_VerticesDirty( true )
     {
-        m_pVertexBuffer = new VertexBuffer( GeometryType::Triangle, VBO_POSITION | VBO_UV );
     }
 
     Text::~Text()
     {
-        delete m_pVertexBuffer;
     }
 
     void Text::OnSizeChanged()
@@ -745,20 +732,49 @@ namespace Gui
             return;
         }
 
+        if ( m_pGlyphRun == nullptr )
+        {
+            m_pGlyphRun = m_pFont->GetGlyphRun( m_ProcessedText, m_LineSpacing );
+            m_VerticesDirty = true;
+        }
+
         const glm::vec2& pos = GetPositionAbsolute();
-        const unsigned int vertexCount = m_pFont->PopulateVertexBuffer( *m_pVertexBuffer, floorf( pos.x ), floorf( pos.y ), m_ProcessedText, m_LineSpacing );
-        GuiManager::GetTexturedShaderColorUniform()->Set( glm::vec4( m_Color.r, m_Color.g, m_Color.b, m_Color.a ) );
-        GuiManager::GetTexturedSamplerUniform()->Set( m_pFont->GetPage(), GL_TEXTURE0 );
-        GuiManager::GetTexturedShader()->Use();
-        m_pVertexBuffer->Draw( vertexCount );
+        const glm::vec2 origin( floorf( pos.x ), floorf( pos.y ) );
+        const glm::vec4 color = m_Color.glm();
+        if ( m_VerticesDirty || origin != m_VerticesOrigin || color != m_VerticesColor )
+        {
+            RebuildVertices( origin, color );
+        }
+
+        GuiManager::GetDrawList()->AddTriangles( m_pFont->GetPage()->GetTexture(), m_Vertices, m_pGlyphRun->boundsMin + origin, m_pGlyphRun->boundsMax + origin );
 
         GuiElement::Render();
     }
 
+    // Moves and tints the font's shared glyph run into this element's own vertices.
+    void Text::RebuildVertices( const glm::vec2& origin, const glm::vec4& color )
+    {
+        const std::vector<StreamingVertex>& runVertices = m_pGlyphRun->vertices;
+        const glm::vec3 translation( origin, 0.0f );
+        m_Vertices.resize( runVertices.size() );
+        for ( size_t i = 0, c = runVertices.size(); i < c; ++i )
+        {
+            m_Vertices[ i ].position = runVertices[ i ].position + translation;
+            m_Vertices[ i ].uv = runVertices[ i ].uv;
+            m_Vertices[ i ].color = color;
+        }
+
+        m_VerticesOrigin = origin;
+        m_VerticesColor = color;
+        m_VerticesDirty = false;
+    }
+
     // Breaks down the text into multiple lines so that they fit this element's size.
     // The result is cached to avoid unnecessary processing.
     void Text::ProcessText()
     {
+        m_pGlyphRun = nullptr;
+
         if ( m_pFont == nullptr )
         {
             return;
@@ -844,7 +860,6 @@ namespace Gui
         , m_IconHoverColor( 1.0f, 1.0f, 1.0f, 1.0f )
         , mIsEnabled( true )
         , m_pIcon( nullptr )
-        , m_pIconVertexBuffer( nullptr )
     {
         m_MousePressedToken = FrameWork::GetInputManager()->AddMouseCallback( std::bind( &Button::OnMousePressedCallback, this ), MouseButton::Left, ButtonState::Pressed );
         m_MouseReleasedToken = FrameWork::GetInputManager()->AddMouseCallback( std::bind( &Button::OnMouseReleasedCallback, this ), MouseButton::Left, ButtonState::Released );
@@ -862,18 +877,11 @@ namespace Gui
     {
         FrameWork::GetInputManager()->RemoveMouseCallback( m_MousePressedToken );
         FrameWork::GetInputManager()->RemoveMouseCallback( m_MouseReleasedToken );
-
-        delete m_pIconVertexBuffer;
     }
 
     void Button::SetIcon( const std::string& filename )
     {
         m_pIcon = (ResourceImage*)FrameWork::GetResourceManager()->GetResource( filename );
-
-        if ( m_pIconVertexBuffer == nullptr )
-        {
-            m_pIconVertexBuffer = new VertexBuffer( GeometryType::Triangle, VBO_POSITION | VBO_UV | VBO_COLOR );
-        }
     }
 
     void Button::Render()
@@ -888,21 +896,15 @@ namespace Gui
         }
 
         const glm::vec2 pos = GetPositionAbsolute();
-        m_pBackgroundVertexBuffer->CreateUntexturedQuad( pos.x, pos.y, mSize.x, mSize.y );
-        GuiManager::GetUntexturedShaderColorUniform()->Set( color );
-        GuiManager::GetUntexturedShader()->Use();
-        m_pBackgroundVertexBuffer->Draw();
+        GuiDrawList* pDrawList = GuiManager::GetDrawList();
+        pDrawList->AddQuad( pos, mSize, color );
 
         if ( m_pIcon != nullptr )
         {
             const glm::vec2 iconSize( (float)m_pIcon->GetWidth(), (float)m_pIcon->GetHeight() );
             const glm::vec2 iconPos( pos.x + 2.0f, pos.y );
             const glm::vec4 iconColor = buttonHovered ? m_IconHoverColor.glm() : m_IconColor.glm();
-            m_pIconVertexBuffer->CreateTexturedQuad( iconPos.x, iconPos.y, iconSize.x, iconSize.y, iconColor );
-            GuiManager::GetTexturedSamplerUniform()->Set( m_pIcon, GL_TEXTURE0 );
-            GuiManager::GetTexturedShaderColorUniform()->Set( iconColor );
-            GuiManager::GetTexturedShader()->Use();
-            m_pIconVertexBuffer->Draw();
+            pDrawList->AddTexturedQuad( iconPos, iconSize, iconColor, m_pIcon->GetTexture() );
         }
 
         DrawBorder();
@@ -960,8 +962,6 @@ namespace Gui
     Checkbox::Checkbox( int x, int y, ResourceFont* font, const std::string& text, bool checked /* = false */, CheckboxCallback pCallback /* = nullptr */ )
         : m_Checked( checked )
         , m_BulletColor( 1.0f, 1.0f, 1.0f, 1.0f )
-        , m_pCheckboxBulletVertexBuffer( nullptr )
-        , m_pCheckboxBorderVertexBuffer( nullptr )
         , m_pCheckboxCallback( pCallback )
     {
         SetPosition( glm::vec2( x, y ) );
@@ -969,51 +969,34 @@ namespace Gui
         SetFont( font );
         SetText( text );
         m_pText->SetPosition( CheckboxSquareSize + 8.0f, 0.0f );
-
-        m_pCheckboxBulletVertexBuffer = new VertexBuffer( GeometryType::Triangle, VBO_POSITION );
-        m_pCheckboxBorderVertexBuffer = new VertexBuffer( GeometryType::LineStrip, VBO_POSITION );
     }
 
     Checkbox::~Checkbox()
     {
-        delete m_pCheckboxBulletVertexBuffer;
-        delete m_pCheckboxBorderVertexBuffer;
     }
 
     void Checkbox::Render()
     {
         const glm::vec2& pos = GetPositionAbsolute();
+        GuiDrawList* pDrawList = GuiManager::GetDrawList();
 
-        m_pBackgroundVertexBuffer->CreateUntexturedQuad( pos.x, pos.y, CheckboxSquareSize, CheckboxSquareSize );
-        GuiManager::GetUntexturedShaderColorUniform()->Set( glm::vec4( m_Color.r, m_Color.g, m_Color.b, m_Color.a ) );
-        GuiManager::GetUntexturedShader()->Use();
-        m_pBackgroundVertexBuffer->Draw();
+        pDrawList->AddQuad( pos, glm::vec2( CheckboxSquareSize, CheckboxSquareSize ), m_Color.glm() );
 
         // Bullet
         if ( m_Checked )
         {
             const float offset = 3.0f;
-            m_pCheckboxBulletVertexBuffer->CreateUntexturedQuad( pos.x + offset, pos.y + offset, CheckboxSquareSize - offset * 2.0f, CheckboxSquareSize - offset * 2.0f - 1.0f );
-            GuiManager::GetUntexturedShaderColorUniform()->Set( glm::vec4( m_BulletColor.r, m_BulletColor.g, m_BulletColor.b, m_BulletColor.a ) );
-            GuiManager::GetUntexturedShader()->Use();
-            m_pCheckboxBulletVertexBuffer->Draw();
+            pDrawList->AddQuad( pos + offset, glm::vec2( CheckboxSquareSize - offset * 2.0f, CheckboxSquareSize - offset * 2.0f - 1.0f ), m_BulletColor.glm() );
         }
 
         // Border around the square
         const float offset = 1.5f;
-
-        PositionData posData;
-        posData.push_back( glm::vec3( pos.x + offset, pos.y + offset, 0.0f ) );
-        posData.push_back( glm::vec3( pos.x + CheckboxSquareSize - offset, pos.y + offset, 0.0f ) );
-        posData.push_back( glm::vec3( pos.x + CheckboxSquareSize - offset, pos.y + CheckboxSquareSize - offset - 1.0f, 0.0f ) );
-        posData.push_back( glm::vec3( pos.x + offset, pos.y + CheckboxSquareSize - offset - 1.0f, 0.0f ) );
-        posData.push_back( glm::vec3( pos.x + offset, pos.y + offset, 0.0f ) );
-        m_pCheckboxBorderVertexBuffer->CopyPositions( posData );
-
-        // m_pCheckboxBorderVertexBuffer->CreateUntexturedQuad( pos.x + offset, pos.y + offset, CheckboxSquareSize - offset * 2.0f, 8.0f );
-        GuiManager::GetUntexturedShaderColorUniform()->Set( glm::vec4( m_BorderColor.r, m_BorderColor.g, m_BorderColor.b, m_BorderColor.a ) );
-        GuiManager::GetUntexturedShader()->Use();
-        m_pCheckboxBorderVertexBuffer->Draw();
+        const glm::vec3 topLeft( pos.x + offset, pos.y + offset, 0.0f );
+        const glm::vec3 topRight( pos.x + CheckboxSquareSize - offset, pos.y + offset, 0.0f );
+        const glm::vec3 bottomRight( pos.x + CheckboxSquareSize - offset, pos.y + CheckboxSquareSize - offset - 1.0f, 0.0f );
+        const glm::vec3 bottomLeft( pos.x + offset, pos.y + CheckboxSquareSize - offset - 1.0f, 0.0f );
+        const glm::vec3 border[ 8 ] = { topLeft, topRight, topRight, bottomRight, bottomRight, bottomLeft, bottomLeft, topLeft };
+        pDrawList->AddLines( border, 8, m_BorderColor.glm() );
 
         GuiElement::Render();
     }
@@ -1050,9 +1033,6 @@ namespace Gui
         SetText( text );
         m_pText->SetPosition( RadioButtonSquareSize + 8.0f, 0.0f );
 
-        m_pRadioButtonBulletVertexBuffer = std::make_unique<VertexBuffer>( GeometryType::Triangle, VBO_POSITION );
-        m_pRadioButtonBorderVertexBuffer = std::make_unique<VertexBuffer>( GeometryType::Line, VBO_POSITION );
-
         AddToGroup();
     }
 
@@ -1064,38 +1044,23 @@ namespace Gui
     void RadioButton::Render()
     {
         const glm::vec2& pos = GetPositionAbsolute();
+        GuiDrawList* pDrawList = GuiManager::GetDrawList();
 
-        m_pBackgroundVertexBuffer->CreateUntexturedQuad( pos.x, pos.y, RadioButtonSquareSize, RadioButtonSquareSize );
-        GuiManager::GetUntexturedShaderColorUniform()->Set( glm::vec4( m_Color.r, m_Color.g, m_Color.b, m_Color.a ) );
-        GuiManager::GetUntexturedShader()->Use();
-        m_pBackgroundVertexBuffer->Draw();
+        pDrawList->AddQuad( pos, glm::vec2( RadioButtonSquareSize, RadioButtonSquareSize ), m_Color.glm() );
 
         // Bullet
         float offset = m_Checked ? 4.0f : 6.0f;
-        m_pRadioButtonBulletVertexBuffer->CreateUntexturedQuad( pos.x + offset, pos.y + offset, RadioButtonSquareSize - offset * 2.0f, RadioButtonSquareSize - offset * 2.0f - 1.0f );
-        glm::vec4 color = m_Checked ? glm::vec4( m_BulletColor.r, m_BulletColor.g, m_BulletColor.b, m_BulletColor.a ) : glm::vec4( 0.5f, 0.5f, 0.5f, 0.5f );
-        GuiManager::GetUntexturedShaderColorUniform()->Set( color );
-        GuiManager::GetUntexturedShader()->Use();
-        m_pRadioButtonBulletVertexBuffer->Draw();
+        glm::vec4 color = m_Checked ? m_BulletColor.glm() : glm::vec4( 0.5f, 0.5f, 0.5f, 0.5f );
+        pDrawList->AddQuad( pos + offset, glm::vec2( RadioButtonSquareSize - offset * 2.0f, RadioButtonSquareSize - offset * 2.0f - 1.0f ), color );
 
         // Border around the square
         offset = 1.5f;
-
-        PositionData posData( 8 );
-        posData.emplace_back( pos.x + offset, pos.y + offset, 0.0f );
-        posData.emplace_back( pos.x + RadioButtonSquareSize - offset, pos.y + offset, 0.0f );
-        posData.emplace_back( pos.x + RadioButtonSquareSize - offset, pos.y + offset, 0.0f );
-        posData.emplace_back( pos.x + RadioButtonSquareSize - offset, pos.y + RadioButtonSquareSize - offset - 1.0f, 0.0f );
-        posData.emplace_back( pos.x + RadioButtonSquareSize - offset, pos.y + RadioButtonSquareSize - offset - 1.0f, 0.0f );
-        posData.emplace_back( pos.x + offset, pos.y + RadioButtonSquareSize - offset - 1.0f, 0.0f );
-        posData.emplace_back( pos.x + offset, pos.y + RadioButtonSquareSize - offset - 1.0f, 0.0f );
-        posData.emplace_back( pos.x + offset, pos.y + offset, 0.0f );
-
-        m_pRadioButtonBorderVertexBuffer->CopyPositions( posData );
-
-        GuiManager::GetUntexturedShaderColorUniform()->Set( glm::vec4( m_BorderColor.r, m_BorderColor.g, m_BorderColor.b, m_BorderColor.a ) );
-        GuiManager::GetUntexturedShader()->Use();
-        m_pRadioButtonBorderVertexBuffer->Draw();
+        const glm::vec3 topLeft( pos.x + offset, pos.y + offset, 0.0f );
+        const glm::vec3 topRight( pos.x + RadioButtonSquareSize - offset, pos.y + offset, 0.0f );
+        const glm::vec3 bottomRight( pos.x + RadioButtonSquareSize - offset, pos.y + RadioButtonSquareSize - offset - 1.0f, 0.0f );
+        const glm::vec3 bottomLeft( pos.x + offset, pos.y + RadioButtonSquareSize - offset - 1.0f, 0.0f );
+        const glm::vec3 border[ 8 ] = { topLeft, topRight, topRight, bottomRight, bottomRight, bottomLeft, bottomLeft, topLeft };
+        pDrawList->AddLines( border, 8, m_BorderColor.glm() );
 
         GuiElement::Render();
     }
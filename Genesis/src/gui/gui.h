@@ -25,6 +25,7 @@
 #include "../resources/resourceimage.h"
 #include "../taskmanager.h"
 #include "../vertexbuffer.h"
+#include "guidrawlist.h"
 #include <list>
 
 namespace Genesis
@@ -72,13 +73,11 @@ namespace Gui
 
         void SetHighlightedElement( GuiElement* pElement );
 
-        static Shader* GetUntexturedShader();
-        static ShaderUniform* GetUntexturedShaderColorUniform();
-        static Shader* GetTexturedShader();
-        static ShaderUniform* GetTexturedShaderColorUniform();
-        static ShaderUniform* GetTexturedSamplerUniform();
         static Shader* GetHighlightShader();
 
+        // Elements add their geometry to the draw list while being rendered, rather than drawing it themselves.
+        static GuiDrawList* GetDrawList();
+
         Cursor* GetCursor() const;
 
     private:
@@ -97,12 +96,8 @@ namespace Gui
         // will be redirected to this element.
         InputArea* m_FocusedInputArea;
 
-        static Shader* m_pUntexturedShader;
-        static ShaderUniform* m_pUntexturedColorUniform;
-        static Shader* m_pTexturedShader;
-        static ShaderUniform* m_pTexturedSamplerUniform;
-        static ShaderUniform* m_pTexturedColorUniform;
         static Shader* m_pHighlightShader;
+        static GuiDrawList* m_pDrawList;
     };
 
 
@@ -227,9 +222,6 @@ namespace Gui
         Color m_Color;
         Color m_BorderColor;
         char m_BorderMode;
-
-        VertexBuffer* m_pBackgroundVertexBuffer;
-        VertexBuffer* m_pBorderVertexBuffer;
     };
 
 
@@ -249,7 +241,7 @@ namespace Gui
         Shader* GetShader() const;
 
     private:
-        VertexBuffer* m_pImageVertexBuffer;
+        VertexBuffer* m_pImageVertexBuffer; // Only needed when drawing with an override shader.
         ResourceImage* m_pImage;
         Shader* m_pOverrideShader;
         ShaderUniform* m_pOverrideShaderColorUniform;
@@ -317,14 +309,22 @@ namespace Gui
         virtual void OnSizeChanged() override;
 
         void ProcessText();
+        void RebuildVertices( const glm::vec2& origin, const glm::vec4& color );
 
         bool m_MultiLine;
         ResourceFont* m_pFont;
         std::string m_Text;
         std::string m_ProcessedText;
         Color m_Color;
-        VertexBuffer* m_pVertexBuffer;
         float m_LineSpacing;
+
+        // The laid out text is retained between frames and only rebuilt when the
+        // processed text, line spacing, position or colour change.
+        GlyphRunSharedPtr m_pGlyphRun;
+        std::vector<StreamingVertex> m_Vertices;
+        glm::vec2 m_VerticesOrigin;
+        glm::vec4 m_VerticesColor;
+        bool m_VerticesDirty;
     };
 
 
@@ -372,8 +372,6 @@ namespace Gui
 
         InputCallbackToken m_MousePressedToken;
         InputCallbackToken m_MouseReleasedToken;
-
-        VertexBuffer* m_pIconVertexBuffer;
     };
 
 
@@ -401,8 +399,6 @@ namespace Gui
     private:
         Color m_BulletColor;
         bool m_Checked;
-        VertexBuffer* m_pCheckboxBulletVertexBuffer;
-        VertexBuffer* m_pCheckboxBorderVertexBuffer;
 		CheckboxCallback m_pCheckboxCallback;
     };
 
@@ -438,8 +434,6 @@ namespace Gui
 
 		Color m_BulletColor;
 		bool m_Checked;
-		VertexBufferUniquePtr m_pRadioButtonBulletVertexBuffer;
-		VertexBufferUniquePtr m_pRadioButtonBorderVertexBuffer;
 		RadioButtonCallback m_pCallback;
 		std::string m_Group;
 	};
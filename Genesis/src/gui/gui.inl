@@ -53,34 +53,14 @@ namespace Genesis::Gui
         }
     }
 
-    inline Shader* GuiManager::GetUntexturedShader()
-    {
-        return m_pUntexturedShader;
-    }
-
-    inline ShaderUniform* GuiManager::GetUntexturedShaderColorUniform()
-    {
-        return m_pUntexturedColorUniform;
-    }
-
-    inline Shader* GuiManager::GetTexturedShader()
-    {
-        return m_pTexturedShader;
-    }
-
-    inline ShaderUniform* GuiManager::GetTexturedShaderColorUniform()
+    inline Shader* GuiManager::GetHighlightShader()
     {
-        return m_pTexturedColorUniform;
+        return m_pHighlightShader;
     }
 
-    inline ShaderUniform* GuiManager::GetTexturedSamplerUniform()
+    inline GuiDrawList* GuiManager::GetDrawList()
     {
-        return m_pTexturedSamplerUniform;
-    }
-
-    inline Shader* GuiManager::GetHighlightShader()
-    {
-        return m_pHighlightShader;
+        return m_pDrawList;
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -293,7 +273,11 @@ namespace Genesis::Gui
 
     inline void Text::SetLineSpacing( float value )
     {
-        m_LineSpacing = value;
+        if ( m_LineSpacing != value )
+        {
+            m_LineSpacing = value;
+            m_pGlyphRun = nullptr;
+        }
     }
 
     inline float Text::GetLineSpacing() const
@@ -0,0 +1,258 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Genesis.
+//
+// Genesis is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Genesis is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Genesis. If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cstring>
+
+#include <glm/common.hpp>
+
+#include "guidrawlist.h"
+#include "../genesis.h"
+#include "../rendersystem.h"
+#include "../shader.h"
+#include "../shadercache.h"
+#include "../shaderuniform.h"
+
+namespace Genesis
+{
+namespace Gui
+{
+
+    // How many batches are checked for one which new geometry can be added to.
+    static const size_t sMaxBatchLookback = 16;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // GuiDrawList
+    ///////////////////////////////////////////////////////////////////////////
+
+    bool GuiDrawList::BatchKey::operator==( const BatchKey& other ) const
+    {
+        return texture == other.texture && blendMode == other.blendMode && scissor == other.scissor && type == other.type;
+    }
+
+    GuiDrawList::GuiDrawList()
+        : m_BatchCount( 0 )
+        , m_BlendMode( BlendMode::Blend )
+        , m_Scissor{ 0, 0, 0, 0 }
+        , m_pShader( nullptr )
+        , m_pSamplerUniform( nullptr )
+        , m_WhiteTexture( 0 )
+    {
+        m_pTriangleBuffer = std::make_unique<StreamingVertexBuffer>( GeometryType::Triangle, VBO_POSITION | VBO_UV | VBO_COLOR, sGuiDrawListMaxTriangleVertices );
+        m_pLineBuffer = std::make_unique<StreamingVertexBuffer>( GeometryType::Line, VBO_POSITION | VBO_UV | VBO_COLOR, sGuiDrawListMaxLineVertices );
+
+        m_pShader = FrameWork::GetRenderSystem()->GetShaderCache()->Load( "gui_batched" );
+        m_pSamplerUniform = m_pShader->RegisterUniform( "k_sampler0", ShaderUniformType::Texture );
+
+        if ( FrameWork::IsHeadless() == false )
+        {
+            const uint32_t white = 0xFFFFFFFF;
+            glGenTextures( 1, &m_WhiteTexture );
+            glBindTexture( GL_TEXTURE_2D, m_WhiteTexture );
+            glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, &white );
+            glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+            glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+            glBindTexture( GL_TEXTURE_2D, 0 );
+        }
+    }
+
+    GuiDrawList::~GuiDrawList()
+    {
+        if ( m_WhiteTexture != 0 )
+        {
+            glDeleteTextures( 1, &m_WhiteTexture );
+        }
+    }
+
+    void GuiDrawList::AddQuad( const glm::vec2& position, const glm::vec2& size, const glm::vec4& color )
+    {
+        AddTexturedQuad( position, size, color, m_WhiteTexture );
+    }
+
+    void GuiDrawList::AddTexturedQuad( const glm::vec2& position, const glm::vec2& size, const glm::vec4& color, GLuint texture, const glm::vec2& uv1 /* = glm::vec2( 0.0f, 0.0f ) */, const glm::vec2& uv2 /* = glm::vec2( 1.0f, 1.0f ) */ )
+    {
+        std::vector<StreamingVertex>& vertices = GetBatchVertices( texture, GeometryType::Triangle, position, position + size );
+        AddQuadVertices( vertices, position, size, color, uv1, uv2 );
+    }
+
+    // Adds geometry which has already been built by the caller, such as the retained glyphs of a text element.
+    void GuiDrawList::AddTriangles( GLuint texture, const std::vector<StreamingVertex>& vertices, const glm::vec2& boundsMin, const glm::vec2& boundsMax )
+    {
+        if ( vertices.empty() )
+        {
+            return;
+        }
+
+        std::vector<StreamingVertex>& batchVertices = GetBatchVertices( texture, GeometryType::Triangle, boundsMin, boundsMax );
+        batchVertices.insert( batchVertices.end(), vertices.begin(), vertices.end() );
+    }
+
+    void GuiDrawList::AddLines( const glm::vec3* pPositions, size_t positionCount, const glm::vec4& color )
+    {
+        SDL_assert( positionCount % 2 == 0 );
+        if ( positionCount == 0 )
+        {
+            return;
+        }
+
+        glm::vec2 boundsMin( pPositions[ 0 ] );
+        glm::vec2 boundsMax( boundsMin );
+        for ( size_t i = 1; i < positionCount; ++i )
+        {
+            boundsMin = glm::min( boundsMin, glm::vec2( pPositions[ i ] ) );
+            boundsMax = glm::max( boundsMax, glm::vec2( pPositions[ i ] ) );
+        }
+
+        std::vector<StreamingVertex>& vertices = GetBatchVertices( m_WhiteTexture, GeometryType::Line, boundsMin, boundsMax );
+        for ( size_t i = 0; i < positionCount; ++i )
+        {
+            vertices.push_back( { pPositions[ i ], glm::vec2( 0.0f, 0.0f ), color } );
+        }
+    }
+
+    std::vector<StreamingVertex>& GuiDrawList::GetBatchVertices( GLuint texture, GeometryType type, const glm::vec2& boundsMin, const glm::vec2& boundsMax )
+    {
+        const BatchKey key{ texture, m_BlendMode, m_Scissor, type };
+
+        // Going backwards, the geometry can join a compatible batch as long as nothing drawn after that batch overlaps it.
+        const size_t lookbackEnd = ( m_BatchCount > sMaxBatchLookback ) ? m_BatchCount - sMaxBatchLookback : 0;
+        for ( size_t i = m_BatchCount; i > lookbackEnd; --i )
+        {
+            Batch& batch = m_Batches[ i - 1 ];
+            if ( batch.key == key )
+            {
+                batch.boundsMin = glm::min( batch.boundsMin, boundsMin );
+                batch.boundsMax = glm::max( batch.boundsMax, boundsMax );
+                return batch.vertices;
+            }
+
+            const bool overlaps = boundsMin.x < batch.boundsMax.x && boundsMax.x > batch.boundsMin.x && boundsMin.y < batch.boundsMax.y && boundsMax.y > batch.boundsMin.y;
+            if ( overlaps )
+            {
+                break;
+            }
+        }
+
+        if ( m_BatchCount == m_Batches.size() )
+        {
+            m_Batches.emplace_back();
+        }
+
+        Batch& batch = m_Batches[ m_BatchCount++ ];
+        batch.key = key;
+        batch.boundsMin = boundsMin;
+        batch.boundsMax = boundsMax;
+        batch.vertices.clear();
+        batch.firstVertex = 0;
+        return batch.vertices;
+    }
+
+    void GuiDrawList::AddQuadVertices( std::vector<StreamingVertex>& vertices, const glm::vec2& position, const glm::vec2& size, const glm::vec4& color, const glm::vec2& uv1, const glm::vec2& uv2 )
+    {
+        const float x1 = position.x;
+        const float x2 = position.x + size.x;
+        const float y1 = position.y;
+        const float y2 = position.y + size.y;
+
+        vertices.push_back( { glm::vec3( x1, y2, 0.0f ), glm::vec2( uv1.x, uv2.y ), color } );
+        vertices.push_back( { glm::vec3( x1, y1, 0.0f ), glm::vec2( uv1.x, uv1.y ), color } );
+        vertices.push_back( { glm::vec3( x2, y1, 0.0f ), glm::vec2( uv2.x, uv1.y ), color } );
+        vertices.push_back( { glm::vec3( x1, y2, 0.0f ), glm::vec2( uv1.x, uv2.y ), color } );
+        vertices.push_back( { glm::vec3( x2, y1, 0.0f ), glm::vec2( uv2.x, uv1.y ), color } );
+        vertices.push_back( { glm::vec3( x2, y2, 0.0f ), glm::vec2( uv2.x, uv2.y ), color } );
+    }
+
+    // Writes every batch of the given type into the streaming buffer with a single mapping.
+    bool GuiDrawList::Upload( StreamingVertexBuffer* pBuffer, GeometryType type )
+    {
+        uint32_t vertexCount = 0;
+        for ( size_t i = 0; i < m_BatchCount; ++i )
+        {
+            if ( m_Batches[ i ].key.type == type )
+            {
+                vertexCount += static_cast<uint32_t>( m_Batches[ i ].vertices.size() );
+            }
+        }
+
+        if ( vertexCount == 0 )
+        {
+            return true;
+        }
+
+        uint32_t firstVertex = 0;
+        StreamingVertex* pVertices = pBuffer->Map( vertexCount, firstVertex );
+        if ( pVertices == nullptr )
+        {
+            return false;
+        }
+
+        for ( size_t i = 0; i < m_BatchCount; ++i )
+        {
+            Batch& batch = m_Batches[ i ];
+            if ( batch.key.type == type )
+            {
+                memcpy( pVertices, batch.vertices.data(), batch.vertices.size() * sizeof( StreamingVertex ) );
+                pVertices += batch.vertices.size();
+                batch.firstVertex = firstVertex;
+                firstVertex += static_cast<uint32_t>( batch.vertices.size() );
+            }
+        }
+
+        pBuffer->Unmap( vertexCount );
+        return true;
+    }
+
+    void GuiDrawList::Flush()
+    {
+        if ( FrameWork::IsHeadless() )
+        {
+            m_BatchCount = 0;
+            return;
+        }
+
+        const bool trianglesUploaded = Upload( m_pTriangleBuffer.get(), GeometryType::Triangle );
+        const bool linesUploaded = Upload( m_pLineBuffer.get(), GeometryType::Line );
+
+        RenderSystem* pRenderSystem = FrameWork::GetRenderSystem();
+        for ( size_t i = 0; i < m_BatchCount; ++i )
+        {
+            const Batch& batch = m_Batches[ i ];
+            const bool isTriangles = ( batch.key.type == GeometryType::Triangle );
+            if ( batch.vertices.empty() || ( isTriangles ? trianglesUploaded : linesUploaded ) == false )
+            {
+                continue;
+            }
+
+            const GuiScissor& scissor = batch.key.scissor;
+            glScissor( scissor.x, scissor.y, scissor.width, scissor.height );
+            pRenderSystem->SetBlendMode( batch.key.blendMode );
+            m_pSamplerUniform->Set( batch.key.texture, GL_TEXTURE0 );
+            m_pShader->Use();
+
+            StreamingVertexBuffer* pBuffer = isTriangles ? m_pTriangleBuffer.get() : m_pLineBuffer.get();
+            pBuffer->Draw( batch.firstVertex, static_cast<uint32_t>( batch.vertices.size() ) );
+        }
+
+        m_BatchCount = 0;
+
+        // Whatever is drawn directly after this should be clipped to the current element.
+        glScissor( m_Scissor.x, m_Scissor.y, m_Scissor.width, m_Scissor.height );
+        pRenderSystem->SetBlendMode( m_BlendMode );
+    }
+
+} // namespace Gui
+} // namespace Genesis
@@ -0,0 +1,140 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Genesis.
+//
+// Genesis is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Genesis is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Genesis. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include "../coredefines.h"
+#include "../rendersystem.fwd.h"
+#include "../streamingvertexbuffer.h"
+
+namespace Genesis
+{
+
+class Shader;
+class ShaderUniform;
+
+namespace Gui
+{
+
+    // Vertices available to the draw list each frame.
+    static const uint32_t sGuiDrawListMaxTriangleVertices = 128 * 1024;
+    static const uint32_t sGuiDrawListMaxLineVertices = 16 * 1024;
+
+    struct GuiScissor
+    {
+        int x;
+        int y;
+        int width;
+        int height;
+
+        bool operator==( const GuiScissor& other ) const;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // GuiDrawList
+    // Collects the geometry of every GUI element during GuiManager::Render()
+    // and submits it with as few draw calls as possible. Geometry is grouped
+    // into batches which share a texture, blend mode, scissor rectangle and
+    // primitive type. New geometry joins the most recent compatible batch as
+    // long as none of the batches after it overlap the geometry, so elements
+    // still appear to be drawn in order.
+    // Untextured geometry samples a white texture, which lets it share
+    // batches with other untextured geometry regardless of its colour.
+    // Anything drawing directly with OpenGL during the GUI pass must call
+    // Flush() first. Flush() leaves the scissor rectangle set to the current
+    // element's clip rectangle.
+    ///////////////////////////////////////////////////////////////////////////
+
+    class GuiDrawList
+    {
+    public:
+        GuiDrawList();
+        ~GuiDrawList();
+
+        void SetBlendMode( BlendMode blendMode );
+        void SetScissor( const GuiScissor& scissor );
+
+        void AddQuad( const glm::vec2& position, const glm::vec2& size, const glm::vec4& color );
+        void AddTexturedQuad( const glm::vec2& position, const glm::vec2& size, const glm::vec4& color, GLuint texture, const glm::vec2& uv1 = glm::vec2( 0.0f, 0.0f ), const glm::vec2& uv2 = glm::vec2( 1.0f, 1.0f ) );
+        void AddTriangles( GLuint texture, const std::vector<StreamingVertex>& vertices, const glm::vec2& boundsMin, const glm::vec2& boundsMax );
+        void AddLines( const glm::vec3* pPositions, size_t positionCount, const glm::vec4& color ); // Every two positions form a line.
+
+        void Flush();
+
+    private:
+        struct BatchKey
+        {
+            GLuint texture;
+            BlendMode blendMode;
+            GuiScissor scissor;
+            GeometryType type;
+
+            bool operator==( const BatchKey& other ) const;
+        };
+
+        struct Batch
+        {
+            BatchKey key;
+            glm::vec2 boundsMin;
+            glm::vec2 boundsMax;
+            std::vector<StreamingVertex> vertices;
+            uint32_t firstVertex;
+        };
+
+        std::vector<StreamingVertex>& GetBatchVertices( GLuint texture, GeometryType type, const glm::vec2& boundsMin, const glm::vec2& boundsMax );
+        void AddQuadVertices( std::vector<StreamingVertex>& vertices, const glm::vec2& position, const glm::vec2& size, const glm::vec4& color, const glm::vec2& uv1, const glm::vec2& uv2 );
+        bool Upload( StreamingVertexBuffer* pBuffer, GeometryType type );
+
+        // Batches are kept between flushes so their vertex vectors don't need to be reallocated.
+        std::vector<Batch> m_Batches;
+        size_t m_BatchCount;
+
+        BlendMode m_BlendMode;
+        GuiScissor m_Scissor;
+
+        StreamingVertexBufferUniquePtr m_pTriangleBuffer;
+        StreamingVertexBufferUniquePtr m_pLineBuffer;
+        Shader* m_pShader;
+        ShaderUniform* m_pSamplerUniform;
+        GLuint m_WhiteTexture;
+    };
+    GENESIS_DECLARE_SMART_PTR( GuiDrawList );
+
+    inline bool GuiScissor::operator==( const GuiScissor& other ) const
+    {
+        return x == other.x && y == other.y && width == other.width && height == other.height;
+    }
+
+    inline void GuiDrawList::SetBlendMode( BlendMode blendMode )
+    {
+        m_BlendMode = blendMode;
+    }
+
+    inline void GuiDrawList::SetScissor( const GuiScissor& scissor )
+    {
+        m_Scissor = scissor;
+    }
+
+} // namespace Gui
+} // namespace Genesis
@@ -17,8 +17,6 @@
 
 #include "video.h"
 #include "../resources/resourcevideo.h"
-#include "../shaderuniform.h"
-#include "../vertexbuffer.h"
 #include "../videoplayer.h"
 
 #include "../genesis.h"
@@ -35,14 +33,11 @@ namespace Gui
     ///////////////////////////////////////////////////////////////////////////
 
     Video::Video()
-        : m_pImageVertexBuffer( nullptr )
     {
-        m_pImageVertexBuffer = new VertexBuffer( GeometryType::Triangle, VBO_POSITION | VBO_UV );
     }
 
     Video::~Video()
     {
-        delete m_pImageVertexBuffer;
     }
 
     void Video::Render()
@@ -55,14 +50,7 @@ namespace Gui
 
             if ( texture > 0 )
             {
-                const glm::vec2& pos = GetPositionAbsolute();
-                m_pImageVertexBuffer->CreateTexturedQuad( pos.x, pos.y, mSize.x, mSize.y );
-
-                GuiManager::GetTexturedShaderColorUniform()->Set( m_Color.glm() );
-                GuiManager::GetTexturedSamplerUniform()->Set( texture, GL_TEXTURE0 );
-                GuiManager::GetTexturedShader()->Use();
-
-                m_pImageVertexBuffer->Draw();
+                GuiManager::GetDrawList()->AddTexturedQuad( GetPositionAbsolute(), mSize, m_Color.glm(), texture );
             }
         }
 
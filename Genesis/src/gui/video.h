@@ -37,9 +37,6 @@ namespace Gui
         Video();
         virtual ~Video();
         virtual void Render();
-
-    private:
-        VertexBuffer* m_pImageVertexBuffer;
     };
 }
 }
\ No newline at end of file
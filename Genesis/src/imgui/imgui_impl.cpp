@@ -110,6 +110,12 @@ void ImGuiImpl::CreateFontsTexture()
 
 void ImGuiImpl::Shutdown()
 {
+    // Headless runs never create the ImGui context.
+    if ( ImGui::GetCurrentContext() == nullptr )
+    {
+        return;
+    }
+
     if ( g_ClipboardTextData )
     {
         SDL_free( g_ClipboardTextData );
@@ -123,6 +129,11 @@ void ImGuiImpl::Shutdown()
 
 void ImGuiImpl::NewFrame( float delta )
 {
+    if ( ImGui::GetCurrentContext() == nullptr )
+    {
+        return;
+    }
+
     ImGuiIO& io = ImGui::GetIO();
 
     // Setup display size (every frame to accommodate for window resizing)
@@ -45,6 +45,11 @@ TaskStatus InputManager::Update( float delta )
         }
     }
 
+    return TaskStatus::Continue;
+}
+
+TaskStatus InputManager::UpdateHeldCallbacks( float delta )
+{
     // Notifies any callbacks which are listening to ButtonState::Held
     for ( auto& callbackInfo : m_KeyboardCallbacks )
     {
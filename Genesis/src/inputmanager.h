@@ -35,6 +35,7 @@ public:
     InputManager();
     virtual ~InputManager() override {}
     TaskStatus Update( float delta );
+    TaskStatus UpdateHeldCallbacks( float delta ); // Fixed rate, so held buttons affect every tick of the simulation.
     bool IsButtonPressed( SDL_Scancode button ) const;
     bool IsMouseButtonPressed( MouseButton button ) const;
     const glm::vec2& GetMousePosition() const;
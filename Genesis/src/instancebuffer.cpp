@@ -0,0 +1,99 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Genesis.
+//
+// Genesis is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Genesis is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Genesis. If not, see <http://www.gnu.org/licenses/>.
+
+#include "instancebuffer.h"
+#include "genesis.h"
+
+namespace Genesis
+{
+
+///////////////////////////////////////////////////////////////////////////////
+// InstanceBuffer
+///////////////////////////////////////////////////////////////////////////////
+
+InstanceBuffer::InstanceBuffer( unsigned int firstAttribute, unsigned int vectorsPerInstance )
+    : m_Buffer( 0 )
+    , m_FirstAttribute( firstAttribute )
+    , m_VectorsPerInstance( vectorsPerInstance )
+    , m_Size( 0 )
+    , m_InstanceCount( 0 )
+{
+    SDL_assert( vectorsPerInstance > 0 );
+
+    if ( FrameWork::IsHeadless() == false )
+    {
+        glGenBuffers( 1, &m_Buffer );
+    }
+}
+
+InstanceBuffer::~InstanceBuffer()
+{
+    if ( m_Buffer != 0 )
+    {
+        glDeleteBuffers( 1, &m_Buffer );
+    }
+}
+
+void InstanceBuffer::CopyData( const float* pData, size_t instanceCount )
+{
+    m_InstanceCount = instanceCount;
+    if ( instanceCount == 0 || m_Buffer == 0 )
+    {
+        return;
+    }
+
+    const size_t size = instanceCount * m_VectorsPerInstance * 4 * sizeof( float );
+    glBindBuffer( GL_ARRAY_BUFFER, m_Buffer );
+    if ( size <= m_Size )
+    {
+        glBufferSubData( GL_ARRAY_BUFFER, 0, size, pData );
+    }
+    else
+    {
+        glBufferData( GL_ARRAY_BUFFER, size, pData, GL_DYNAMIC_DRAW );
+        m_Size = size;
+    }
+}
+
+void InstanceBuffer::EnableAttributes( uint32_t firstInstance ) const
+{
+    SDL_assert( firstInstance < m_InstanceCount );
+
+    const GLsizei stride = static_cast<GLsizei>( m_VectorsPerInstance * 4 * sizeof( float ) );
+    const size_t baseOffset = static_cast<size_t>( firstInstance ) * stride;
+
+    glBindBuffer( GL_ARRAY_BUFFER, m_Buffer );
+    for ( unsigned int i = 0; i < m_VectorsPerInstance; ++i )
+    {
+        const GLuint attribute = m_FirstAttribute + i;
+        glEnableVertexAttribArray( attribute );
+        glVertexAttribPointer( attribute, 4, GL_FLOAT, GL_FALSE, stride, (void*)( baseOffset + i * 4 * sizeof( float ) ) );
+        glVertexAttribDivisor( attribute, 1 );
+    }
+}
+
+void InstanceBuffer::DisableAttributes() const
+{
+    for ( unsigned int i = 0; i < m_VectorsPerInstance; ++i )
+    {
+        const GLuint attribute = m_FirstAttribute + i;
+        glVertexAttribDivisor( attribute, 0 );
+        glDisableVertexAttribArray( attribute );
+    }
+}
+
+} // namespace Genesis
@@ -0,0 +1,65 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Genesis.
+//
+// Genesis is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Genesis is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Genesis. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "rendersystem.fwd.h"
+#include "coredefines.h"
+
+namespace Genesis
+{
+
+///////////////////////////////////////////////////////////////////////////////
+// InstanceBuffer
+// Per-instance data for instanced draws. Each instance is made of a fixed
+// number of vec4s, which are fed to consecutive vertex attributes starting
+// at firstAttribute (a mat4 takes four of them). The attributes are only
+// enabled for the duration of VertexBuffer::DrawInstanced(), so a vertex
+// buffer can be drawn both with and without instance data.
+///////////////////////////////////////////////////////////////////////////////
+
+class InstanceBuffer
+{
+public:
+    InstanceBuffer( unsigned int firstAttribute, unsigned int vectorsPerInstance );
+    ~InstanceBuffer();
+
+    void CopyData( const float* pData, size_t instanceCount );
+    size_t GetInstanceCount() const;
+
+    // Sets up the instance attributes on the currently bound VAO, with firstInstance being the first instance used by the draw.
+    void EnableAttributes( uint32_t firstInstance ) const;
+    void DisableAttributes() const;
+
+private:
+    GLuint m_Buffer;
+    unsigned int m_FirstAttribute;
+    unsigned int m_VectorsPerInstance;
+    size_t m_Size;
+    size_t m_InstanceCount;
+};
+GENESIS_DECLARE_SMART_PTR( InstanceBuffer );
+
+inline size_t InstanceBuffer::GetInstanceCount() const
+{
+    return m_InstanceCount;
+}
+
+} // namespace Genesis
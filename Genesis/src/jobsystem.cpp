@@ -0,0 +1,230 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Genesis.
+//
+// Genesis is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Genesis is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Genesis. If not, see <http://www.gnu.org/licenses/>.
+
+#include "jobsystem.h"
+
+#include <algorithm>
+
+#include <SDL.h>
+
+namespace Genesis
+{
+
+// Each worker thread knows which JobSystem it belongs to and which queue it owns.
+// Any other thread submitting or waiting on jobs uses queue 0, shared with the owner thread.
+static thread_local const JobSystem* t_pJobSystem = nullptr;
+static thread_local unsigned int t_QueueIndex = 0;
+
+//-------------------------------------------------------------------
+// JobCounter
+//-------------------------------------------------------------------
+
+JobCounter::JobCounter()
+    : m_Pending( 0 )
+{
+}
+
+//-------------------------------------------------------------------
+// JobSystem
+//-------------------------------------------------------------------
+
+JobSystem::JobSystem( unsigned int workerCount /* = 0 */ )
+    : m_Running( true )
+    , m_QueuedJobs( 0 )
+    , m_NextQueue( 0 )
+{
+    if ( workerCount == 0 )
+    {
+        const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    // Queue 0 belongs to the thread which owns the JobSystem.
+    for ( unsigned int i = 0; i <= workerCount; ++i )
+    {
+        m_Queues.push_back( std::make_unique<WorkQueue>() );
+    }
+
+    for ( unsigned int i = 1; i <= workerCount; ++i )
+    {
+        m_Workers.emplace_back( &JobSystem::WorkerThreadMain, this, i );
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock( m_WakeMutex );
+        m_Running = false;
+    }
+    m_WakeCondition.notify_all();
+
+    for ( auto& worker : m_Workers )
+    {
+        worker.join();
+    }
+}
+
+void JobSystem::Submit( Job job, JobCounter* pCounter /* = nullptr */ )
+{
+    if ( pCounter != nullptr )
+    {
+        pCounter->m_Pending.fetch_add( 1, std::memory_order_relaxed );
+    }
+
+    // Workers push into their own queue so the jobs they spawn stay local to them. Everyone else
+    // distributes jobs across all the queues, which gives the workers something to take immediately.
+    unsigned int queueIndex = GetCurrentQueueIndex();
+    if ( queueIndex == 0 )
+    {
+        queueIndex = m_NextQueue.fetch_add( 1, std::memory_order_relaxed ) % static_cast<unsigned int>( m_Queues.size() );
+    }
+
+    {
+        WorkQueue& queue = *m_Queues[ queueIndex ];
+        std::lock_guard<std::mutex> lock( queue.mutex );
+        queue.jobs.push_back( { std::move( job ), pCounter } );
+    }
+
+    m_QueuedJobs.fetch_add( 1, std::memory_order_release );
+
+    // Taking the lock guarantees that a worker can't be between checking for jobs and going to sleep.
+    {
+        std::lock_guard<std::mutex> lock( m_WakeMutex );
+    }
+    m_WakeCondition.notify_one();
+}
+
+void JobSystem::Wait( JobCounter& counter )
+{
+    while ( counter.IsDone() == false )
+    {
+        if ( RunPendingJob() == false )
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::ParallelFor( size_t count, size_t batchSize, const ParallelForFunc& func )
+{
+    if ( count == 0 )
+    {
+        return;
+    }
+
+    batchSize = std::max<size_t>( batchSize, 1 );
+    if ( count <= batchSize || m_Workers.empty() )
+    {
+        func( 0, count );
+        return;
+    }
+
+    JobCounter counter;
+    for ( size_t begin = 0; begin < count; begin += batchSize )
+    {
+        const size_t end = std::min( begin + batchSize, count );
+        Submit( [ &func, begin, end ]() { func( begin, end ); }, &counter );
+    }
+    Wait( counter );
+}
+
+bool JobSystem::RunPendingJob()
+{
+    const unsigned int queueIndex = GetCurrentQueueIndex();
+    JobEntry entry;
+    if ( PopJob( queueIndex, entry ) || StealJob( queueIndex, entry ) )
+    {
+        Execute( entry );
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::WorkerThreadMain( unsigned int queueIndex )
+{
+    t_pJobSystem = this;
+    t_QueueIndex = queueIndex;
+
+    while ( true )
+    {
+        JobEntry entry;
+        if ( PopJob( queueIndex, entry ) || StealJob( queueIndex, entry ) )
+        {
+            Execute( entry );
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock( m_WakeMutex );
+        m_WakeCondition.wait( lock, [ this ]() { return m_Running == false || m_QueuedJobs.load( std::memory_order_acquire ) > 0; } );
+        if ( m_Running == false )
+        {
+            break;
+        }
+    }
+}
+
+bool JobSystem::PopJob( unsigned int queueIndex, JobEntry& entry )
+{
+    WorkQueue& queue = *m_Queues[ queueIndex ];
+    std::lock_guard<std::mutex> lock( queue.mutex );
+    if ( queue.jobs.empty() )
+    {
+        return false;
+    }
+
+    entry = std::move( queue.jobs.back() );
+    queue.jobs.pop_back();
+    m_QueuedJobs.fetch_sub( 1, std::memory_order_relaxed );
+    return true;
+}
+
+bool JobSystem::StealJob( unsigned int queueIndex, JobEntry& entry )
+{
+    const unsigned int queueCount = static_cast<unsigned int>( m_Queues.size() );
+    for ( unsigned int i = 1; i < queueCount; ++i )
+    {
+        WorkQueue& queue = *m_Queues[ ( queueIndex + i ) % queueCount ];
+        std::lock_guard<std::mutex> lock( queue.mutex );
+        if ( queue.jobs.empty() == false )
+        {
+            entry = std::move( queue.jobs.front() );
+            queue.jobs.pop_front();
+            m_QueuedJobs.fetch_sub( 1, std::memory_order_relaxed );
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::Execute( JobEntry& entry )
+{
+    entry.job();
+
+    if ( entry.pCounter != nullptr )
+    {
+        SDL_assert( entry.pCounter->m_Pending.load() > 0 );
+        entry.pCounter->m_Pending.fetch_sub( 1, std::memory_order_release );
+    }
+}
+
+unsigned int JobSystem::GetCurrentQueueIndex() const
+{
+    return ( t_pJobSystem == this ) ? t_QueueIndex : 0;
+}
+
+} // namespace Genesis
@@ -0,0 +1,114 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Genesis.
+//
+// Genesis is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Genesis is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Genesis. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Genesis
+{
+
+using Job = std::function<void()>;
+using ParallelForFunc = std::function<void( size_t begin, size_t end )>;
+
+// A JobCounter tracks how many jobs submitted against it are still outstanding.
+// JobSystem::Wait() blocks until it reaches zero, running other jobs in the meantime.
+class JobCounter
+{
+public:
+    JobCounter();
+    bool IsDone() const;
+
+private:
+    friend class JobSystem;
+    std::atomic_int m_Pending;
+};
+
+inline bool JobCounter::IsDone() const
+{
+    return m_Pending.load( std::memory_order_acquire ) == 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// JobSystem
+// A pool of worker threads, each owning its own queue of jobs. Workers take
+// jobs from the back of their own queue and, once it runs dry, steal from the
+// front of other workers' queues. The thread which created the JobSystem
+// (normally the main thread) owns a queue as well and helps out whenever it
+// is waiting on a JobCounter.
+///////////////////////////////////////////////////////////////////////////////
+
+class JobSystem
+{
+public:
+    // If workerCount is 0, one worker is created per hardware thread, minus one for the main thread.
+    JobSystem( unsigned int workerCount = 0 );
+    ~JobSystem();
+
+    void Submit( Job job, JobCounter* pCounter = nullptr );
+    void Wait( JobCounter& counter );
+
+    // Splits [0, count) into batches of at most batchSize elements, runs them across all threads and
+    // returns once every batch has been processed.
+    void ParallelFor( size_t count, size_t batchSize, const ParallelForFunc& func );
+
+    // Runs a single pending job on the calling thread, if there is one available.
+    bool RunPendingJob();
+
+    unsigned int GetWorkerCount() const;
+
+private:
+    struct JobEntry
+    {
+        Job job;
+        JobCounter* pCounter;
+    };
+
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<JobEntry> jobs;
+    };
+
+    void WorkerThreadMain( unsigned int queueIndex );
+    bool PopJob( unsigned int queueIndex, JobEntry& entry );
+    bool StealJob( unsigned int queueIndex, JobEntry& entry );
+    void Execute( JobEntry& entry );
+    unsigned int GetCurrentQueueIndex() const;
+
+    std::vector<std::unique_ptr<WorkQueue>> m_Queues;
+    std::vector<std::thread> m_Workers;
+    std::atomic_bool m_Running;
+    std::atomic_int m_QueuedJobs;
+    std::atomic_uint m_NextQueue;
+    std::mutex m_WakeMutex;
+    std::condition_variable m_WakeCondition;
+};
+
+inline unsigned int JobSystem::GetWorkerCount() const
+{
+    return static_cast<unsigned int>( m_Workers.size() );
+}
+
+} // namespace Genesis
@@ -19,6 +19,8 @@
 #include "windows.h"
 #endif
 
+#include <chrono>
+
 #include "logger.h"
 #include "memory.h"
 
@@ -36,14 +38,43 @@ static const char* LogMessageText[ LOG_MAX ] = {
 //---------------------------------------------------------------
 
 Logger::Logger()
+    : m_EnqueuePosition( 0 )
+    , m_DequeuePosition( 0 )
+    , m_WrittenPosition( 0 )
+    , m_DroppedMessages( 0 )
+    , m_Running( true )
+    , m_WriterSleeping( false )
 {
-    m_pMutex = SDL_CreateMutex();
+    for ( size_t i = 0; i < sLogQueueCapacity; ++i )
+    {
+        m_Queue[ i ].sequence.store( i, std::memory_order_relaxed );
+    }
+
+    for ( auto& level : m_CategoryLevels )
+    {
+        level.store( LOG_INFO, std::memory_order_relaxed );
+    }
+
+    for ( auto& rateLimit : m_RateLimits )
+    {
+        rateLimit.pFormat.store( nullptr, std::memory_order_relaxed );
+        rateLimit.windowStart.store( 0, std::memory_order_relaxed );
+        rateLimit.count.store( 0, std::memory_order_relaxed );
+        rateLimit.suppressed.store( 0, std::memory_order_relaxed );
+    }
+
+    m_WriterThread = std::thread( &Logger::WriterThreadMain, this );
 }
 
 Logger::~Logger()
 {
-    SDL_DestroyMutex( m_pMutex );
-    m_pMutex = nullptr;
+    m_Running = false;
+    m_WakeCondition.notify_one();
+    m_WriterThread.join();
+
+    // Anything which was logged while the writer thread was shutting down.
+    WriteQueuedMessages();
+    FlushTargets();
 
     for ( auto& pTarget : m_Targets )
     {
@@ -55,6 +86,7 @@ void Logger::AddLogTarget( LogTarget* pLogTarget )
 {
     if ( pLogTarget != nullptr )
     {
+        std::lock_guard<std::mutex> lock( m_TargetsMutex );
         m_Targets.push_back( pLogTarget );
     }
 }
@@ -66,6 +98,7 @@ void Logger::RemoveLogTarget( LogTarget* pLogTarget )
         return;
     }
 
+    std::lock_guard<std::mutex> lock( m_TargetsMutex );
     LogTargetList::iterator it = m_Targets.begin();
     LogTargetList::iterator itEnd = m_Targets.end();
     while ( it != itEnd )
@@ -81,8 +114,8 @@ void Logger::RemoveLogTarget( LogTarget* pLogTarget )
     }
 }
 
-// Internal logging function. Should be called by one of the public functions (LogInfo / LogWarning / LogError).
-// Assumes that m_pMutex is locked at this stage.
+// Internal logging function, sends the text to all targets.
+// Assumes that m_TargetsMutex is locked at this stage.
 void Logger::Log( const char* text, LogMessageType type /* = LOG_INFO */ )
 {
 #ifdef _WIN32
@@ -98,6 +131,11 @@ void Logger::Log( const char* text, LogMessageType type /* = LOG_INFO */ )
 
     if ( type == LOG_ERROR )
     {
+        for ( auto& pTarget : m_Targets )
+        {
+            pTarget->Flush();
+        }
+
 #ifdef _WIN32
         __debugbreak();
 #else
@@ -107,55 +145,226 @@ void Logger::Log( const char* text, LogMessageType type /* = LOG_INFO */ )
     }
 }
 
-void Logger::LogInfo( const char* format, ... )
+// Formats the message straight into a free slot of the queue. Never blocks: if the writer
+// thread has fallen behind and the queue is full, the message is dropped and counted instead.
+void Logger::Enqueue( LogCategory category, LogMessageType type, const char* pFormat, va_list args )
 {
-    SDL_LockMutex( m_pMutex );
+    if ( type < GetCategoryLevel( category ) )
+    {
+        return;
+    }
 
-    va_list args;
-    va_start( args, format );
+    uint32_t suppressed = 0;
+    if ( IsRateLimited( pFormat, suppressed ) )
+    {
+        return;
+    }
+
+    QueuedMessage* pMessage = nullptr;
+    uint64_t position = m_EnqueuePosition.load( std::memory_order_relaxed );
+    while ( true )
+    {
+        pMessage = &m_Queue[ position % sLogQueueCapacity ];
+        const uint64_t sequence = pMessage->sequence.load( std::memory_order_acquire );
+        const int64_t difference = static_cast<int64_t>( sequence ) - static_cast<int64_t>( position );
+        if ( difference == 0 )
+        {
+            if ( m_EnqueuePosition.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) )
+            {
+                break;
+            }
+        }
+        else if ( difference < 0 )
+        {
+            m_DroppedMessages.fetch_add( 1, std::memory_order_relaxed );
+            return;
+        }
+        else
+        {
+            position = m_EnqueuePosition.load( std::memory_order_relaxed );
+        }
+    }
+
+    pMessage->type = type;
+    pMessage->suppressed = suppressed;
 #ifdef _WIN32
-	vsprintf_s( m_VABuffer.data(), LOG_BUFFER_SIZE, format, args );
+    _vsnprintf_s( pMessage->text.data(), sLogMessageMaxLength, _TRUNCATE, pFormat, args );
 #else
-    vsnprintf( m_VABuffer.data(), LOG_BUFFER_SIZE, format, args );
+    vsnprintf( pMessage->text.data(), sLogMessageMaxLength, pFormat, args );
 #endif
-    Log( m_VABuffer.data(), LOG_INFO );
+    pMessage->sequence.store( position + 1, std::memory_order_release );
+
+    if ( m_WriterSleeping.load() )
+    {
+        m_WakeCondition.notify_one();
+    }
+}
+
+// Call sites share a small table of counters, keyed by their format string. The counters are updated without
+// locking, so the limit is approximate when several threads log from the same call site at once.
+bool Logger::IsRateLimited( const char* pFormat, uint32_t& suppressed )
+{
+    RateLimit& rateLimit = m_RateLimits[ ( reinterpret_cast<uintptr_t>( pFormat ) >> 3 ) % sLogRateLimitSlots ];
+    const uint32_t now = static_cast<uint32_t>( std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count() );
+
+    if ( rateLimit.pFormat.exchange( pFormat, std::memory_order_relaxed ) != pFormat )
+    {
+        // The slot belonged to another call site.
+        rateLimit.windowStart.store( now, std::memory_order_relaxed );
+        rateLimit.count.store( 0, std::memory_order_relaxed );
+        rateLimit.suppressed.store( 0, std::memory_order_relaxed );
+    }
+    else if ( now - rateLimit.windowStart.load( std::memory_order_relaxed ) >= 1000 )
+    {
+        rateLimit.windowStart.store( now, std::memory_order_relaxed );
+        rateLimit.count.store( 0, std::memory_order_relaxed );
+        suppressed = rateLimit.suppressed.exchange( 0, std::memory_order_relaxed );
+    }
+
+    if ( rateLimit.count.fetch_add( 1, std::memory_order_relaxed ) < sLogRateLimitPerSecond )
+    {
+        return false;
+    }
+
+    rateLimit.suppressed.fetch_add( 1, std::memory_order_relaxed );
+    return true;
+}
+
+void Logger::WriterThreadMain()
+{
+    while ( m_Running )
+    {
+        if ( WriteQueuedMessages() )
+        {
+            FlushTargets();
+            continue;
+        }
+
+        // Producers only wake us up while we're sleeping, which can race with the check above. The timeout
+        // bounds how long a message can wait in the queue if that happens.
+        std::unique_lock<std::mutex> lock( m_WakeMutex );
+        m_WriterSleeping = true;
+        m_WakeCondition.wait_for( lock, std::chrono::milliseconds( 50 ), [ this ]() {
+            const QueuedMessage& message = m_Queue[ m_DequeuePosition % sLogQueueCapacity ];
+            return m_Running == false || message.sequence.load( std::memory_order_acquire ) == m_DequeuePosition + 1;
+        } );
+        m_WriterSleeping = false;
+    }
+}
+
+// Passes every message which is ready on to the targets. Returns false if there was nothing to write.
+bool Logger::WriteQueuedMessages()
+{
+    std::lock_guard<std::mutex> lock( m_TargetsMutex );
+
+    bool written = false;
+    while ( true )
+    {
+        QueuedMessage& message = m_Queue[ m_DequeuePosition % sLogQueueCapacity ];
+        if ( message.sequence.load( std::memory_order_acquire ) != m_DequeuePosition + 1 )
+        {
+            break;
+        }
+
+        if ( message.suppressed > 0 )
+        {
+            char text[ 128 ];
+            snprintf( text, sizeof( text ), "%u similar messages were suppressed.", message.suppressed );
+            Log( text, message.type );
+        }
+
+        Log( message.text.data(), message.type );
+
+        message.sequence.store( m_DequeuePosition + sLogQueueCapacity, std::memory_order_release );
+        m_DequeuePosition++;
+        written = true;
+    }
+
+    const uint32_t dropped = m_DroppedMessages.exchange( 0, std::memory_order_relaxed );
+    if ( dropped > 0 )
+    {
+        char text[ 128 ];
+        snprintf( text, sizeof( text ), "%u messages were dropped, the log queue was full.", dropped );
+        Log( text, LOG_WARNING );
+        written = true;
+    }
+
+    return written;
+}
+
+void Logger::FlushTargets()
+{
+    {
+        std::lock_guard<std::mutex> lock( m_TargetsMutex );
+        for ( auto& pTarget : m_Targets )
+        {
+            pTarget->Flush();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock( m_WakeMutex );
+    m_WrittenPosition = m_DequeuePosition;
+    m_WrittenCondition.notify_all();
+}
+
+void Logger::Flush()
+{
+    const uint64_t position = m_EnqueuePosition.load();
+    m_WakeCondition.notify_one();
+
+    std::unique_lock<std::mutex> lock( m_WakeMutex );
+    m_WrittenCondition.wait( lock, [ this, position ]() { return m_WrittenPosition >= position || m_Running == false; } );
+}
+
+void Logger::LogInfo( const char* format, ... )
+{
+    va_list args;
+    va_start( args, format );
+    Enqueue( LogCategory::General, LOG_INFO, format, args );
     va_end( args );
+}
 
-    SDL_UnlockMutex( m_pMutex );
+void Logger::LogInfo( LogCategory category, const char* format, ... )
+{
+    va_list args;
+    va_start( args, format );
+    Enqueue( category, LOG_INFO, format, args );
+    va_end( args );
 }
 
 void Logger::LogWarning( const char* format, ... )
 {
-    SDL_LockMutex( m_pMutex );
-
     va_list args;
     va_start( args, format );
-#ifdef _WIN32
-    vsprintf_s( m_VABuffer.data(), LOG_BUFFER_SIZE, format, args );
-#else
-    vsnprintf( m_VABuffer.data(), LOG_BUFFER_SIZE, format, args );
-#endif
-    Log( m_VABuffer.data(), LOG_WARNING );
+    Enqueue( LogCategory::General, LOG_WARNING, format, args );
     va_end( args );
+}
 
-    SDL_UnlockMutex( m_pMutex );
+void Logger::LogWarning( LogCategory category, const char* format, ... )
+{
+    va_list args;
+    va_start( args, format );
+    Enqueue( category, LOG_WARNING, format, args );
+    va_end( args );
 }
 
+// Errors end the process, so everything queued before them is written out first and
+// the error itself is sent to the targets straight away.
 void Logger::LogError( const char* format, ... )
 {
-    SDL_LockMutex( m_pMutex );
+    Flush();
+
+    std::lock_guard<std::mutex> lock( m_TargetsMutex );
 
     va_list args;
     va_start( args, format );
 #ifdef _WIN32
-    vsprintf_s( m_VABuffer.data(), LOG_BUFFER_SIZE, format, args );
+	vsprintf_s( m_VABuffer.data(), LOG_BUFFER_SIZE, format, args );
 #else
     vsnprintf( m_VABuffer.data(), LOG_BUFFER_SIZE, format, args );
 #endif
     Log( m_VABuffer.data(), LOG_ERROR );
     va_end( args );
-
-    SDL_UnlockMutex( m_pMutex );
 }
 
 //---------------------------------------------------------------
@@ -183,7 +392,14 @@ void FileLogger::Log( const char* pText, LogMessageType type )
     }
 
     m_File.write( pText, strlen( pText ) );
-    m_File.flush();
+}
+
+void FileLogger::Flush()
+{
+    if ( m_File.is_open() )
+    {
+        m_File.flush();
+    }
 }
 
 //---------------------------------------------------------------
@@ -198,6 +414,22 @@ void MessageBoxLogger::Log( const char* pText, LogMessageType type )
     }
 }
 
+//---------------------------------------------------------------
+// ConsoleLogger
+//---------------------------------------------------------------
+
+void ConsoleLogger::Log( const char* pText, LogMessageType type )
+{
+    std::ostream& stream = ( type == LOG_INFO ) ? std::cout : std::cerr;
+    stream << pText;
+}
+
+void ConsoleLogger::Flush()
+{
+    std::cout.flush();
+    std::cerr.flush();
+}
+
 //---------------------------------------------------------------
 // VisualStudioLogger
 //---------------------------------------------------------------
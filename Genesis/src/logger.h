@@ -18,10 +18,15 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <list>
+#include <mutex>
 #include <stdarg.h>
+#include <thread>
 
 #include <SDL.h>
 
@@ -32,6 +37,14 @@ namespace Genesis
 
 #define LOG_BUFFER_SIZE 20480
 
+// Number of messages which can be waiting for the writer thread. Messages logged while the queue is full are dropped.
+static const size_t sLogQueueCapacity = 512;
+// Queued messages longer than this are truncated. Errors are written synchronously and aren't affected.
+static const size_t sLogMessageMaxLength = 2048;
+// Each call site (identified by its format string) can log this many messages per second before being rate limited.
+static const uint32_t sLogRateLimitPerSecond = 100;
+static const size_t sLogRateLimitSlots = 128;
+
 class LogTarget;
 
 enum LogMessageType
@@ -42,10 +55,26 @@ enum LogMessageType
     LOG_MAX, // unused, for translation table only
 };
 
+enum class LogCategory
+{
+    General = 0,
+    Rendering,
+    Resources,
+    Sound,
+    Gameplay,
+
+    Count
+};
+
 //////////////////////////////////////////////////////////////////////////
 // Logger
-// A Logger contains any number of LogTargets. When the Log***() functions
-// are called, all the LogTargets are called as well.
+// A Logger contains any number of LogTargets. The Log***() functions
+// format the message on the calling thread and push it into a lock-free
+// queue, from which a background thread passes it on to every LogTarget.
+// Targets are flushed once the queue has been drained rather than after
+// every message.
+// Errors are the exception: the queue is drained and the error is sent to
+// the targets on the calling thread, as the process exits afterwards.
 //////////////////////////////////////////////////////////////////////////
 
 typedef std::list<LogTarget*> LogTargetList;
@@ -60,20 +89,77 @@ public:
     void LogInfo( const char* pFormat, ... );
     void LogWarning( const char* pFormat, ... );
     void LogError( const char* pFormat, ... );
+    void LogInfo( LogCategory category, const char* pFormat, ... );
+    void LogWarning( LogCategory category, const char* pFormat, ... );
+
+    // Messages below the category's level are discarded before being formatted.
+    void SetCategoryLevel( LogCategory category, LogMessageType level );
+    LogMessageType GetCategoryLevel( LogCategory category ) const;
+
+    // Blocks until every message queued so far has been written and the targets have been flushed.
+    void Flush();
 
     // Not thread safe. Call only from the main thread.
     void AddLogTarget( LogTarget* pLogTarget );
     void RemoveLogTarget( LogTarget* pLogTarget );
 
 private:
+    struct QueuedMessage
+    {
+        std::atomic<uint64_t> sequence;
+        LogMessageType type;
+        uint32_t suppressed; // Messages from the same call site which were rate limited before this one.
+        std::array<char, sLogMessageMaxLength> text;
+    };
+
+    struct RateLimit
+    {
+        std::atomic<const char*> pFormat;
+        std::atomic<uint32_t> windowStart;
+        std::atomic<uint32_t> count;
+        std::atomic<uint32_t> suppressed;
+    };
+
+    void Enqueue( LogCategory category, LogMessageType type, const char* pFormat, va_list args );
+    bool IsRateLimited( const char* pFormat, uint32_t& suppressed );
     void Log( const char* pText, LogMessageType type = LOG_INFO );
+    void WriterThreadMain();
+    bool WriteQueuedMessages();
+    void FlushTargets();
 
-    SDL_mutex* m_pMutex;
+    std::mutex m_TargetsMutex;
     LogTargetList m_Targets;
     std::array<char, LOG_BUFFER_SIZE> m_Buffer;
     std::array<char, LOG_BUFFER_SIZE> m_VABuffer;
+
+    // Bounded multiple producer queue, with the writer thread as its only consumer.
+    std::array<QueuedMessage, sLogQueueCapacity> m_Queue;
+    std::atomic<uint64_t> m_EnqueuePosition;
+    uint64_t m_DequeuePosition;
+    uint64_t m_WrittenPosition; // Guarded by m_WakeMutex.
+    std::atomic<uint32_t> m_DroppedMessages;
+
+    std::array<std::atomic<int>, static_cast<size_t>( LogCategory::Count )> m_CategoryLevels;
+    std::array<RateLimit, sLogRateLimitSlots> m_RateLimits;
+
+    std::thread m_WriterThread;
+    std::atomic_bool m_Running;
+    std::atomic_bool m_WriterSleeping;
+    std::mutex m_WakeMutex;
+    std::condition_variable m_WakeCondition;
+    std::condition_variable m_WrittenCondition;
 };
 
+inline void Logger::SetCategoryLevel( LogCategory category, LogMessageType level )
+{
+    m_CategoryLevels[ static_cast<size_t>( category ) ].store( level, std::memory_order_relaxed );
+}
+
+inline LogMessageType Logger::GetCategoryLevel( LogCategory category ) const
+{
+    return static_cast<LogMessageType>( m_CategoryLevels[ static_cast<size_t>( category ) ].load( std::memory_order_relaxed ) );
+}
+
 //////////////////////////////////////////////////////////////////////////
 // LogTarget interface. Any LogTarget must implement Log()
 //////////////////////////////////////////////////////////////////////////
@@ -83,12 +169,14 @@ class LogTarget
 public:
 	virtual ~LogTarget() {}
     virtual void Log( const char* pText, LogMessageType type = LOG_INFO ) = 0;
+    // Called by the Logger after it has written a batch of messages.
+    virtual void Flush() {}
 };
 
 //////////////////////////////////////////////////////////////////////////
 // FileLogger
 // Dumps the logging into file given in "filename". It is flushed
-// after every entry.
+// after every batch of entries.
 //////////////////////////////////////////////////////////////////////////
 
 class FileLogger : public LogTarget
@@ -97,6 +185,7 @@ public:
     FileLogger( const char* pFilename );
     ~FileLogger();
     virtual void Log( const char* pText, LogMessageType type );
+    virtual void Flush() override;
 
 private:
     std::ofstream m_File;
@@ -114,6 +203,18 @@ public:
     virtual void Log( const char* pText, LogMessageType type );
 };
 
+//////////////////////////////////////////////////////////////////////////
+// ConsoleLogger
+// Writes information to stdout, warnings and errors to stderr.
+//////////////////////////////////////////////////////////////////////////
+
+class ConsoleLogger : public LogTarget
+{
+public:
+    virtual void Log( const char* pText, LogMessageType type );
+    virtual void Flush() override;
+};
+
 //////////////////////////////////////////////////////////////////////////
 // VisualStudioLogger
 // Windows only - all the output from the logger goes to the
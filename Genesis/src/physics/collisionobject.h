@@ -39,6 +39,7 @@ public:
 	CollisionObject() {};
 	virtual ~CollisionObject() {};
 	ShapeWeakPtr GetShape() const;
+	Shape* GetShapeRaw() const; // Doesn't touch the reference count, for hot paths.
 
 	enum class Type
 	{
@@ -56,5 +57,10 @@ inline ShapeWeakPtr CollisionObject::GetShape() const
 	return m_pShape;
 }
 
+inline Shape* CollisionObject::GetShapeRaw() const
+{
+	return m_pShape.get();
+}
+
 } // namespace Physics
 } // namespace Genesis
\ No newline at end of file
@@ -0,0 +1,102 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Genesis.
+//
+// Genesis is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Genesis is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Genesis. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "BulletCollision/BroadphaseCollision/btDbvt.h"
+#include "BulletCollision/BroadphaseCollision/btDbvtBroadphase.h"
+#include "BulletCollision/CollisionDispatch/btCollisionWorld.h"
+
+#include "physics/collisionobject.h"
+#include "physics/rayquery.h"
+#include "physics/shape.h"
+
+namespace Genesis
+{
+namespace Physics
+{
+namespace Private
+{
+
+// Appends every hit along a ray straight into a RayQueryHitVector, resolving the shapes
+// without touching any reference counts. Only used by Simulation::RayTestBatch(), which
+// walks the broadphase itself so that several rays can be tested concurrently: unlike
+// btCollisionWorld::rayTest(), nothing here writes to shared state.
+struct RayQueryResultCallback : public btCollisionWorld::RayResultCallback, public btDbvt::ICollide
+{
+	RayQueryResultCallback( const btVector3& rayFromWorld, const btVector3& rayToWorld, RayQueryHitVector& hits ) :
+		m_rayFromTrans( btQuaternion::getIdentity(), rayFromWorld ),
+		m_rayToTrans( btQuaternion::getIdentity(), rayToWorld ),
+		m_hits( hits )
+	{
+	}
+
+	btTransform m_rayFromTrans;
+	btTransform m_rayToTrans;
+	RayQueryHitVector& m_hits;
+
+	using btDbvt::ICollide::Process;
+
+	// Called by btDbvt::rayTest() for every broadphase proxy whose bounds the ray crosses.
+	virtual void Process( const btDbvtNode* pLeaf ) override
+	{
+		btBroadphaseProxy* pProxy = static_cast< btBroadphaseProxy* >( pLeaf->data );
+		if ( needsCollision( pProxy ) )
+		{
+			btCollisionObject* pBtCollisionObject = static_cast< btCollisionObject* >( pProxy->m_clientObject );
+			btCollisionWorld::rayTestSingle(
+				m_rayFromTrans,
+				m_rayToTrans,
+				pBtCollisionObject,
+				pBtCollisionObject->getCollisionShape(),
+				pBtCollisionObject->getWorldTransform(),
+				*this );
+		}
+	}
+
+	virtual	btScalar addSingleResult( btCollisionWorld::LocalRayResult& rayResult, bool normalInWorldSpace ) override
+	{
+		const CollisionObject* pCollisionObject = reinterpret_cast< const CollisionObject* >( rayResult.m_collisionObject->getUserPointer() );
+		Shape* pShape = pCollisionObject->GetShapeRaw();
+		if ( pShape == nullptr )
+		{
+			return m_closestHitFraction;
+		}
+
+		// In a compound shape, the index of the child shape we've hit is stored in m_triangleIndex.
+		Shape* pChildShape = nullptr;
+		if ( pShape->GetType() == Shape::Type::Compound && rayResult.m_localShapeInfo != nullptr )
+		{
+			pChildShape = static_cast< CompoundShape* >( pShape )->GetChildShapeRaw( rayResult.m_localShapeInfo->m_triangleIndex );
+		}
+
+		btVector3 hitNormalWorld = rayResult.m_hitNormalLocal;
+		if ( normalInWorldSpace == false )
+		{
+			hitNormalWorld = rayResult.m_collisionObject->getWorldTransform().getBasis() * rayResult.m_hitNormalLocal;
+		}
+
+		m_hits.push_back( { rayResult.m_hitFraction, glm::vec3( hitNormalWorld.x(), hitNormalWorld.y(), hitNormalWorld.z() ), pShape, pChildShape } );
+
+		// Returning the closest hit fraction rather than this hit's keeps the ray going, so we get every hit.
+		return m_closestHitFraction;
+	}
+};
+
+} // namespace Private
+} // namespace Physics
+} // namespace Genesis
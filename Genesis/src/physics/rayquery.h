@@ -0,0 +1,87 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Genesis.
+//
+// Genesis is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Genesis is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Genesis. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+namespace Genesis
+{
+namespace Physics
+{
+
+class Shape;
+class Simulation;
+
+struct RayQuery
+{
+	glm::vec3 from;
+	glm::vec3 to;
+};
+
+// A single hit from a batched ray test. The shapes are owned by their collision objects
+// and remain valid until the collision object is removed from the simulation.
+struct RayQueryHit
+{
+	float fraction; // Value between 0 and 1, representing how far along the ray the collision has happened.
+	glm::vec3 normal;
+	Shape* pShape; // The shape of the object we've collided with.
+	Shape* pChildShape; // The specific child shape we've hit, or nullptr if the shape isn't a CompoundShape.
+};
+
+using RayQueryVector = std::vector< RayQuery >;
+using RayQueryHitVector = std::vector< RayQueryHit >;
+
+/////////////////////////////////////////////////////////////////////
+// RayQueryResults
+// The hits of every query in a batch, stored contiguously. The hits
+// for each query are ordered by distance from the query's origin.
+/////////////////////////////////////////////////////////////////////
+
+class RayQueryResults
+{
+	friend Simulation;
+public:
+	size_t GetQueryCount() const;
+	size_t GetHitCount( size_t queryIndex ) const;
+	const RayQueryHit* GetHits( size_t queryIndex ) const;
+
+private:
+	RayQueryHitVector m_Hits;
+	std::vector< uint32_t > m_Offsets; // One entry per query, plus a final entry with the total number of hits.
+};
+
+inline size_t RayQueryResults::GetQueryCount() const
+{
+	return m_Offsets.empty() ? 0 : m_Offsets.size() - 1;
+}
+
+inline size_t RayQueryResults::GetHitCount( size_t queryIndex ) const
+{
+	return m_Offsets[ queryIndex + 1 ] - m_Offsets[ queryIndex ];
+}
+
+inline const RayQueryHit* RayQueryResults::GetHits( size_t queryIndex ) const
+{
+	return m_Hits.data() + m_Offsets[ queryIndex ];
+}
+
+} // namespace Physics
+} // namespace Genesis
@@ -152,11 +152,43 @@ void RigidBody::SetMotionType( MotionType motionType )
     }
     else
     {
-        flags &= btCollisionObject::CF_STATIC_OBJECT;
+        flags &= ~btCollisionObject::CF_STATIC_OBJECT;
     }
     m_pRigidBody->setCollisionFlags( flags );
 
+    const bool becameDynamic = ( m_MotionType == MotionType::Static && motionType == MotionType::Dynamic );
     m_MotionType = motionType;
+
+    // Any mass changes made while the body was static haven't reached Bullet yet.
+    if ( becameDynamic && m_Mass > 0 )
+    {
+        ApplyMassProperties();
+    }
+}
+
+void RigidBody::SetMassProperties( int mass, const glm::vec3& centreOfMass )
+{
+    SDL_assert( mass > 0 );
+
+    m_Mass = mass;
+    m_CentreOfMass = centreOfMass;
+
+    // Bullet clears CF_STATIC_OBJECT whenever a body is given a non-zero mass, which would
+    // start simulating bodies such as docked ships.
+    if ( m_MotionType == MotionType::Dynamic )
+    {
+        ApplyMassProperties();
+    }
+}
+
+void RigidBody::ApplyMassProperties()
+{
+    btVector3 localInertia( 0.0f, 0.0f, 0.0f );
+    m_pShape->m_pShape->calculateLocalInertia( static_cast<btScalar>( m_Mass ), localInertia );
+    m_pRigidBody->setMassProps( static_cast<btScalar>( m_Mass ), localInertia );
+    m_pRigidBody->updateInertiaTensor();
+
+    CalculateInvInertiaTensorWorld();
 }
 
 void RigidBody::ApplyAngularForce( const glm::vec3& force )
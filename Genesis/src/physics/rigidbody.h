@@ -117,6 +117,11 @@ public:
     void SetAngularVelocity( const glm::vec3& angularVelocity );
     void SetMotionType( MotionType motionType );
 
+    // Must be called after the body's shape has been changed, as the inertia depends on it.
+    // Changing the centre of mass doesn't move the body: that is up to the caller.
+    // Static bodies only store the new values, which are applied once the body becomes dynamic.
+    void SetMassProperties( int mass, const glm::vec3& centreOfMass );
+
     void ApplyAngularForce( const glm::vec3& force );
     void ApplyLinearForce( const glm::vec3& force );
     void ApplyAngularImpulse( const glm::vec3& impulse );
@@ -128,6 +133,7 @@ public:
     const glm::vec3& GetAngularFactor() const;
 
 private:
+    void ApplyMassProperties();
     void CalculateInvInertiaTensorWorld();
 
     std::unique_ptr<btRigidBody> m_pRigidBody;
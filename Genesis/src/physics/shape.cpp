@@ -35,6 +35,7 @@ namespace Physics
 
 Shape::Shape() :
 m_pShape( nullptr ),
+m_pSharedShape( nullptr ),
 m_pUserData( nullptr )
 {
 	sActiveShapes++;
@@ -43,7 +44,10 @@ m_pUserData( nullptr )
 Shape::~Shape() 
 {
 	SDL_assert( m_pShape != nullptr );
-	delete m_pShape;
+	if ( m_pSharedShape == nullptr )
+	{
+		delete m_pShape;
+	}
 	sActiveShapes--;
 }
 
@@ -132,12 +136,33 @@ ShapeSharedPtr CompoundShape::GetChildShape( unsigned int index ) const
 	return pChildShape;
 }
 
+Shape* CompoundShape::GetChildShapeRaw( unsigned int index ) const
+{
+	return ( index < m_ChildShapes.size() ) ? m_ChildShapes[ index ].first.get() : nullptr;
+}
+
 glm::mat4x4 CompoundShape::GetChildTransform( unsigned int index ) const
 {
 	SDL_assert( index < m_ChildShapes.size() );
 	return m_ChildShapes[ index ].second;
 }
 
+void CompoundShape::TranslateChildren( const glm::vec3& offset )
+{
+	btCompoundShape* pCompoundShape = static_cast< btCompoundShape* >( m_pShape );
+	const int numChildShapes = static_cast< int >( m_ChildShapes.size() );
+	for ( int idx = 0; idx < numChildShapes; ++idx )
+	{
+		glm::mat4x4& localTransform = m_ChildShapes[ idx ].second;
+		localTransform[ 3 ] += glm::vec4( offset, 0.0f );
+
+		// The compound's bounding box only needs to be recalculated once all the children have been moved.
+		btTransform tr;
+		tr.setFromOpenGLMatrix( glm::value_ptr( localTransform ) );
+		pCompoundShape->updateChildTransform( idx, tr, idx == numChildShapes - 1 );
+	}
+}
+
 
 /////////////////////////////////////////////////////////////////////
 // SphereShape
@@ -183,5 +208,12 @@ CylinderShape::CylinderShape( CylinderShapeAxis axis, float width, float height,
 	m_pShape->setUserPointer( this );
 }
 
+CylinderShape::CylinderShape( CylinderShapeSharedPtr pSharedShape )
+{
+	SDL_assert( pSharedShape != nullptr );
+	m_pSharedShape = pSharedShape;
+	m_pShape = pSharedShape->m_pShape;
+}
+
 }
 }
\ No newline at end of file
@@ -73,6 +73,7 @@ public:
 
 protected:
 	btCollisionShape* m_pShape;
+	ShapeSharedPtr m_pSharedShape; // If set, m_pShape belongs to this shape rather than to us.
 	void* m_pUserData;
 };
 
@@ -103,9 +104,13 @@ public:
 	void RemoveChildShape( ShapeSharedPtr pShape );
 	void RemoveChildShape( unsigned int index );
 	ShapeSharedPtr GetChildShape( unsigned int index ) const;
+	Shape* GetChildShapeRaw( unsigned int index ) const; // Doesn't touch the reference count, for hot paths.
 	glm::mat4x4 GetChildTransform( unsigned int index ) const;
 	std::size_t GetChildrenCount() const;
 
+	// Moves every child by the same offset, e.g. when the centre of mass of the body using this shape changes.
+	void TranslateChildren( const glm::vec3& offset );
+
 	virtual Type GetType() const override { return Type::Compound; }
 
 private:
@@ -158,6 +163,10 @@ class CylinderShape : public Shape
 public:
 	CylinderShape( CylinderShapeAxis axis, float width, float height, float depth );
 
+	// Shares the collision geometry of another cylinder, so that many identical children of a compound shape
+	// don't need a collision shape each. Each CylinderShape still has its own user data.
+	CylinderShape( CylinderShapeSharedPtr pSharedShape );
+
 	virtual Type GetType() const override { return Type::Cylinder; }
 };
 
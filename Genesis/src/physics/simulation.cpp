@@ -21,29 +21,104 @@
 #include "endexternalheaders.h"
 #include <btBulletCollisionCommon.h>
 #include <btBulletDynamicsCommon.h>
+#include <LinearMath/btTransformUtil.h>
 #include <glm/gtc/matrix_access.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
 #include "physics/debugrender.h"
 #include "physics/ghost.h"
 #include "physics/private/customrayresultcallback.h"
+#include "physics/private/rayqueryresultcallback.h"
 #include "physics/rigidbody.h"
 #include "physics/shape.h"
 #include "physics/simulation.h"
 #include "physics/window.h"
+#include "profiling/profiler.h"
 #include "render/debugrender.h"
+#include "genesis.h"
+#include "jobsystem.h"
 
 namespace Genesis::Physics
 {
+
+//-------------------------------------------------------------------
+// CollisionBuffer
+//-------------------------------------------------------------------
+
+void CollisionBuffer::Clear()
+{
+    m_Contacts.clear();
+    m_Pairs.clear();
+}
+
+void CollisionBuffer::Finalise()
+{
+    // Compound shapes can generate several manifolds for the same pair of bodies, one per pair of child shapes,
+    // so the contacts are sorted to bring each pair's contacts together.
+    std::sort( m_Contacts.begin(), m_Contacts.end(), []( const CollisionContact& a, const CollisionContact& b ) { return a.pairKey < b.pairKey; } );
+
+    // Duplicate contacts share the same position on the XY plane. A pair only has a handful of contacts, so a
+    // linear search through the pair is cheaper than hashing them.
+    size_t count = 0;
+    for ( const CollisionContact& contact : m_Contacts )
+    {
+        if ( m_Pairs.empty() || m_Contacts[ m_Pairs.back().firstContact ].pairKey != contact.pairKey )
+        {
+            m_Pairs.push_back( { contact.pRigidBodyA, contact.pRigidBodyB, count, 0 } );
+        }
+
+        CollisionPair& pair = m_Pairs.back();
+        bool duplicate = false;
+        for ( size_t i = pair.firstContact; i < count; ++i )
+        {
+            if ( m_Contacts[ i ].position.x == contact.position.x && m_Contacts[ i ].position.y == contact.position.y )
+            {
+                duplicate = true;
+                break;
+            }
+        }
+
+        if ( duplicate == false )
+        {
+            m_Contacts[ count++ ] = contact;
+            pair.contactCount++;
+        }
+    }
+    m_Contacts.resize( count );
+}
+
+//-------------------------------------------------------------------
+// Simulation
+//-------------------------------------------------------------------
+
+// Returns the shape hit by a contact: either the rigid body's own shape or, for compound shapes, the child at the
+// given index. Goes through the raw pointers, as this is called for every contact point.
+static Shape* ResolveContactShape( const RigidBody* pRigidBody, int childIndex )
+{
+    Shape* pShape = pRigidBody->GetShapeRaw();
+    if ( pShape == nullptr || childIndex < 0 )
+    {
+        return pShape;
+    }
+
+    SDL_assert( pShape->GetType() == Shape::Type::Compound );
+    return static_cast<CompoundShape*>( pShape )->GetChildShapeRaw( static_cast<unsigned int>( childIndex ) );
+}
+
 void InternalTickCallback( btDynamicsWorld* pDynamicsWorld, btScalar timeStep )
 {
-    CollisionDataSet& collisionDataSet = *reinterpret_cast<CollisionDataSet*>( pDynamicsWorld->getWorldUserInfo() );
-    collisionDataSet.clear();
+    CollisionBuffer& collisionBuffer = *reinterpret_cast<CollisionBuffer*>( pDynamicsWorld->getWorldUserInfo() );
+    collisionBuffer.Clear();
 
     const int numManifolds = pDynamicsWorld->getDispatcher()->getNumManifolds();
     for ( int i = 0; i < numManifolds; i++ )
     {
         btPersistentManifold* pContactManifold = pDynamicsWorld->getDispatcher()->getManifoldByIndexInternal( i );
+        const int numContacts = pContactManifold->getNumContacts();
+        if ( numContacts == 0 )
+        {
+            continue;
+        }
 
         const btCollisionObject* pObjA = pContactManifold->getBody0();
         const btCollisionObject* pObjB = pContactManifold->getBody1();
@@ -59,56 +134,31 @@ void InternalTickCallback( btDynamicsWorld* pDynamicsWorld, btScalar timeStep )
 
         RigidBody* pRigidBodyA = static_cast<RigidBody*>( pCollisionObjectA );
         RigidBody* pRigidBodyB = static_cast<RigidBody*>( pCollisionObjectB );
-        auto extractShapeFn = []( RigidBody* pRigidBody, int shapeIndex ) -> ShapeWeakPtr {
-            if ( pRigidBody->GetShape().expired() )
-            {
-                return ShapeWeakPtr();
-            }
-            else
-            {
-                ShapeSharedPtr pShape = pRigidBody->GetShape().lock();
-                if ( shapeIndex >= 0 )
-                {
-                    SDL_assert( pShape->GetType() == Shape::Type::Compound );
-                    CompoundShapeSharedPtr pCompoundShape = std::static_pointer_cast<CompoundShape>( pShape );
-                    return pCompoundShape->GetChildShape( shapeIndex );
-                }
-                else
-                {
-                    return pShape;
-                }
-            }
-        };
+        const uint64_t pairKey = ( static_cast<uint64_t>( pObjA->getWorldArrayIndex() ) << 32 ) | static_cast<uint32_t>( pObjB->getWorldArrayIndex() );
 
-        const int numContacts = pContactManifold->getNumContacts();
         for ( int j = 0; j < numContacts; j++ )
         {
             btManifoldPoint& pt = pContactManifold->getContactPoint( j );
-            const btVector3& ptA = pt.getPositionWorldOnA();
-            const btVector3& ptB = pt.getPositionWorldOnB();
-            const glm::vec3 gptA( ptA.x(), ptA.y(), ptA.z() );
-            const glm::vec3 gptB( ptB.x(), ptB.y(), ptB.z() );
 
-            // extractShapeFn shouldn't ever return nullptr, but there is an
-            // issue with the index potentially pointing to an already-removed
-            // shape, with the Genesis::Physics::Shape and the underlying btShape
-            // not agreeing as to how many shapes they have.
-            // This only appears to happen during this internal tick callback.
-            ShapeWeakPtr pShapeA = extractShapeFn( pRigidBodyA, pt.m_index0 );
-            ShapeWeakPtr pShapeB = extractShapeFn( pRigidBodyB, pt.m_index1 );
-            if ( pShapeA.expired() || pShapeB.expired() )
+            // The child index can point to an already-removed shape, with the Genesis::Physics::Shape and the
+            // underlying btShape not agreeing as to how many shapes they have. This only appears to happen during
+            // this internal tick callback.
+            Shape* pShapeA = ResolveContactShape( pRigidBodyA, pt.m_index0 );
+            Shape* pShapeB = ResolveContactShape( pRigidBodyB, pt.m_index1 );
+            if ( pShapeA == nullptr || pShapeB == nullptr )
             {
                 continue;
             }
 
-            collisionDataSet.emplace(
-                pRigidBodyA,
-                pRigidBodyB,
-                pShapeA,
-                pShapeB,
-                ( gptA + gptB ) / 2.0f );
+            const btVector3& ptA = pt.getPositionWorldOnA();
+            const btVector3& ptB = pt.getPositionWorldOnB();
+            const glm::vec3 gptA( ptA.x(), ptA.y(), ptA.z() );
+            const glm::vec3 gptB( ptB.x(), ptB.y(), ptB.z() );
+            collisionBuffer.Add( { pairKey, pRigidBodyA, pRigidBodyB, pt.m_index0, pt.m_index1, pShapeA, pShapeB, ( gptA + gptB ) / 2.0f } );
         }
     }
+
+    collisionBuffer.Finalise();
 }
 
 Simulation::Simulation()
@@ -118,9 +168,13 @@ Simulation::Simulation()
     m_pBroadphase = new btDbvtBroadphase();
     m_pSolver = new btSequentialImpulseConstraintSolver;
     m_pWorld = new btDiscreteDynamicsWorld( m_pDispatcher, m_pBroadphase, m_pSolver, m_pCollisionConfiguration );
-    m_pWorld->setInternalTickCallback( &InternalTickCallback, &m_CollisionDataSet );
+    m_pWorld->setInternalTickCallback( &InternalTickCallback, &m_CollisionBuffer );
     m_pWorld->setGravity( btVector3( 0, 0, 0 ) );
 
+    // The world is stepped exactly one tick at a time, so during a tick the motion states should hold the
+    // simulated transforms rather than lag a tick behind. Interpolation for rendering is done in Update().
+    m_pWorld->setLatencyMotionStateInterpolation( false );
+
     m_pDebugRender = new DebugRender();
     m_pWorld->setDebugDrawer( m_pDebugRender );
 
@@ -139,14 +193,26 @@ Simulation::~Simulation()
     delete m_pDebugRender;
 }
 
-TaskStatus Simulation::Update( float delta )
+TaskStatus Simulation::Step( float delta )
 {
+    GENESIS_PROFILE_ZONE( "Physics::Simulation::Step" );
+
     if ( m_IsPaused == false )
     {
-        m_pWorld->stepSimulation( delta, 5, GetFixedTimeStep() );
+        m_pWorld->stepSimulation( delta, 1, delta );
         ProcessCollisionCallbacks();
     }
 
+    return TaskStatus::Continue;
+}
+
+TaskStatus Simulation::Update( float delta )
+{
+    if ( m_IsPaused == false )
+    {
+        InterpolateMotionStates( FrameWork::GetTaskManager()->GetFixedStepAlpha() );
+    }
+
     m_pWorld->debugDrawWorld();
     RenderAdditionalInformation();
 
@@ -246,6 +312,111 @@ void Simulation::RayTest( const glm::vec3& from, const glm::vec3& to, RayTestRes
         []( const RayTestResult& resultA, const RayTestResult& resultB ) -> bool { return resultA.GetFraction() < resultB.GetFraction(); } );
 }
 
+void Simulation::RayTestBatch( const RayQueryVector& queries, RayQueryResults& results )
+{
+    static const size_t sQueriesPerBatch = 64;
+
+    const size_t queryCount = queries.size();
+    const size_t batchCount = ( queryCount + sQueriesPerBatch - 1 ) / sQueriesPerBatch;
+    results.m_Hits.clear();
+    results.m_Offsets.assign( queryCount + 1, 0 );
+    if ( queryCount == 0 )
+    {
+        return;
+    }
+
+    // Each batch writes its hits into its own vector, which are kept around between calls to avoid reallocating them.
+    if ( m_RayQueryBatchHits.size() < batchCount )
+    {
+        m_RayQueryBatchHits.resize( batchCount );
+    }
+
+    auto batchFn = [ this, &queries, &results ]( size_t begin, size_t end ) {
+        RayQueryHitVector& hits = m_RayQueryBatchHits[ begin / sQueriesPerBatch ];
+        hits.clear();
+        RayTestBatchRange( queries, begin, end, results, hits );
+    };
+
+    JobSystem* pJobSystem = FrameWork::GetJobSystem();
+    if ( pJobSystem == nullptr )
+    {
+        for ( size_t begin = 0; begin < queryCount; begin += sQueriesPerBatch )
+        {
+            batchFn( begin, std::min( begin + sQueriesPerBatch, queryCount ) );
+        }
+    }
+    else
+    {
+        pJobSystem->ParallelFor( queryCount, sQueriesPerBatch, batchFn );
+    }
+
+    // Each query's hit count was stored in the next query's offset, so a running sum turns them into offsets.
+    for ( size_t i = 1; i <= queryCount; ++i )
+    {
+        results.m_Offsets[ i ] += results.m_Offsets[ i - 1 ];
+    }
+
+    // Batches cover consecutive queries, so appending them in order keeps every query's hits contiguous.
+    results.m_Hits.reserve( results.m_Offsets[ queryCount ] );
+    for ( size_t i = 0; i < batchCount; ++i )
+    {
+        results.m_Hits.insert( results.m_Hits.end(), m_RayQueryBatchHits[ i ].begin(), m_RayQueryBatchHits[ i ].end() );
+    }
+
+    if ( m_pDebugRender->IsEnabled( DebugRender::Mode::RayTests ) )
+    {
+        for ( size_t i = 0; i < queryCount; ++i )
+        {
+            const RayQuery& query = queries[ i ];
+            const btVector3 btFrom( query.from.x, query.from.y, query.from.z );
+            const btVector3 btTo( query.to.x, query.to.y, query.to.z );
+            m_pDebugRender->drawLine( btFrom, btTo, btVector3( 1.0f, 1.0f, 1.0f ) );
+
+            const RayQueryHit* pHits = results.GetHits( i );
+            for ( size_t j = 0; j < results.GetHitCount( i ); ++j )
+            {
+                const btVector3 hitPosition = btFrom + ( btTo - btFrom ) * pHits[ j ].fraction;
+                const btVector3 hitNormal( pHits[ j ].normal.x, pHits[ j ].normal.y, pHits[ j ].normal.z );
+                m_pDebugRender->drawSphere( hitPosition, 5.0f, btVector3( 1.0f, 0.0f, 0.0f ) );
+                m_pDebugRender->drawLine( hitPosition, hitPosition + hitNormal * 10.0f, btVector3( 0.0f, 1.0f, 0.0f ) );
+            }
+        }
+    }
+}
+
+// Can run on any thread: it only reads from the broadphase and the collision objects, and only writes
+// to its own range of results.
+void Simulation::RayTestBatchRange( const RayQueryVector& queries, size_t begin, size_t end, RayQueryResults& results, RayQueryHitVector& hits ) const
+{
+    for ( size_t i = begin; i < end; ++i )
+    {
+        const size_t firstHit = hits.size();
+        const btVector3 btFrom( queries[ i ].from.x, queries[ i ].from.y, queries[ i ].from.z );
+        const btVector3 btTo( queries[ i ].to.x, queries[ i ].to.y, queries[ i ].to.z );
+
+        Private::RayQueryResultCallback rayCallback( btFrom, btTo, hits );
+        for ( int set = 0; set < 2; ++set )
+        {
+            btDbvt::rayTest( m_pBroadphase->m_sets[ set ].m_root, btFrom, btTo, rayCallback );
+        }
+
+        // Rays rarely hit more than a handful of shapes, so an insertion sort is all we need.
+        for ( size_t j = firstHit + 1; j < hits.size(); ++j )
+        {
+            RayQueryHit hit = hits[ j ];
+            size_t k = j;
+            while ( k > firstHit && hits[ k - 1 ].fraction > hit.fraction )
+            {
+                hits[ k ] = hits[ k - 1 ];
+                k--;
+            }
+            hits[ k ] = hit;
+        }
+
+        results.m_Offsets[ i + 1 ] = static_cast<uint32_t>( hits.size() - firstHit );
+    }
+}
+
 void Simulation::RenderAdditionalInformation()
 {
     if ( m_pDebugRender->IsEnabled( DebugRender::Mode::Transforms ) )
@@ -261,9 +432,12 @@ void Simulation::RenderAdditionalInformation()
     if ( m_pDebugRender->IsEnabled( DebugRender::Mode::ContactPoints ) )
     {
         Render::DebugRender* pDebugRender = FrameWork::GetDebugRender();
-        for ( auto& contactPoint : m_CollisionDataSet )
+        for ( const CollisionPair& pair : m_CollisionBuffer.GetPairs() )
         {
-            pDebugRender->DrawCircle( contactPoint.position, 5.0f, glm::vec3( 0.0f, 1.0f, 0.0f ) );
+            for ( size_t i = pair.firstContact; i < pair.firstContact + pair.contactCount; ++i )
+            {
+                pDebugRender->DrawCircle( m_CollisionBuffer.GetContact( i ).position, 5.0f, glm::vec3( 0.0f, 1.0f, 0.0f ) );
+            }
         }
     }
 }
@@ -273,6 +447,36 @@ void Simulation::Pause( bool state )
     m_IsPaused = state;
 }
 
+float Simulation::GetFixedTimeStep() const
+{
+    return FrameWork::GetTaskManager()->GetFixedTimeStep();
+}
+
+// Places each dynamic rigid body's motion state between the previous tick and the current one, by integrating
+// backwards from the current transform. This is the same as what Bullet does itself when left to accumulate time.
+// The next Step() synchronises the motion states with the simulation again.
+void Simulation::InterpolateMotionStates( float alpha )
+{
+    const btScalar timeStep = static_cast<btScalar>( ( alpha - 1.0f ) * GetFixedTimeStep() );
+    for ( RigidBody* pRigidBody : m_RigidBodies )
+    {
+        if ( pRigidBody->GetMotionType() == MotionType::Static )
+        {
+            continue;
+        }
+
+        btRigidBody* pBtRigidBody = pRigidBody->m_pRigidBody.get();
+        btTransform interpolatedTransform;
+        btTransformUtil::integrateTransform(
+            pBtRigidBody->getWorldTransform(),
+            pBtRigidBody->getLinearVelocity(),
+            pBtRigidBody->getAngularVelocity(),
+            timeStep,
+            interpolatedTransform );
+        pRigidBody->m_pMotionState->setWorldTransform( interpolatedTransform );
+    }
+}
+
 float Simulation::GetDampingEffect( float damping ) const
 {
     // This is copied from btRigidBody.cpp, see void btRigidBody::applyDamping(btScalar timeStep).
@@ -280,12 +484,29 @@ float Simulation::GetDampingEffect( float damping ) const
 }
 
 CollisionCallbackHandle Simulation::RegisterCollisionCallback( const CollisionCallback& callbackFn )
+{
+    return RegisterCollisionCallback( nullptr, callbackFn );
+}
+
+CollisionCallbackHandle Simulation::RegisterCollisionCallback( RigidBody* pRigidBody, const CollisionCallback& callbackFn )
 {
     SDL_assert( !m_ProcessingCallbacks );
 
     static CollisionCallbackHandle sHandle = 0UL;
     sHandle++;
-    m_CollisionCallbacks.push_back( std::pair<CollisionCallbackHandle, CollisionCallback>( sHandle, callbackFn ) );
+    m_CollisionCallbacks.push_back( { sHandle, pRigidBody, callbackFn } );
+
+    // The list never moves its elements, so the callbacks can be referred to directly.
+    const CollisionCallback* pCallback = &m_CollisionCallbacks.back().callback;
+    if ( pRigidBody == nullptr )
+    {
+        m_GlobalCollisionCallbacks.push_back( pCallback );
+    }
+    else
+    {
+        m_RigidBodyCollisionCallbacks[ pRigidBody ].push_back( pCallback );
+    }
+
     return sHandle;
 }
 
@@ -295,8 +516,25 @@ void Simulation::UnregisterCollisionCallback( CollisionCallbackHandle handle )
 
     for ( CollisionCallbackList::iterator it = m_CollisionCallbacks.begin(); it != m_CollisionCallbacks.end(); ++it )
     {
-        if ( it->first == handle )
+        if ( it->handle == handle )
         {
+            const CollisionCallback* pCallback = &it->callback;
+            if ( it->pRigidBody == nullptr )
+            {
+                m_GlobalCollisionCallbacks.erase( std::find( m_GlobalCollisionCallbacks.begin(), m_GlobalCollisionCallbacks.end(), pCallback ) );
+            }
+            else
+            {
+                auto callbacksIt = m_RigidBodyCollisionCallbacks.find( it->pRigidBody );
+                SDL_assert( callbacksIt != m_RigidBodyCollisionCallbacks.end() );
+                CollisionCallbackPtrVector& callbacks = callbacksIt->second;
+                callbacks.erase( std::find( callbacks.begin(), callbacks.end(), pCallback ) );
+                if ( callbacks.empty() )
+                {
+                    m_RigidBodyCollisionCallbacks.erase( callbacksIt );
+                }
+            }
+
             m_CollisionCallbacks.erase( it );
             return;
         }
@@ -314,15 +552,45 @@ void Simulation::ProcessCollisionCallbacks()
 
     m_ProcessingCallbacks = true;
 
-    for ( auto& callback : m_CollisionCallbacks )
+    for ( const CollisionPair& pair : m_CollisionBuffer.GetPairs() )
     {
-        for ( auto& collisionData : m_CollisionDataSet )
+        ProcessCollisionCallbacks( pair, m_GlobalCollisionCallbacks );
+
+        // Only the rigid bodies involved in the collision get their callbacks called.
+        auto callbacksItA = m_RigidBodyCollisionCallbacks.find( pair.pRigidBodyA );
+        if ( callbacksItA != m_RigidBodyCollisionCallbacks.end() )
+        {
+            ProcessCollisionCallbacks( pair, callbacksItA->second );
+        }
+
+        auto callbacksItB = m_RigidBodyCollisionCallbacks.find( pair.pRigidBodyB );
+        if ( callbacksItB != m_RigidBodyCollisionCallbacks.end() )
         {
-            callback.second( collisionData.pRigidBodyA, collisionData.pRigidBodyB, collisionData.pShapeA, collisionData.pShapeB, collisionData.position );
+            ProcessCollisionCallbacks( pair, callbacksItB->second );
         }
     }
 
     m_ProcessingCallbacks = false;
 }
 
+void Simulation::ProcessCollisionCallbacks( const CollisionPair& pair, const CollisionCallbackPtrVector& callbacks )
+{
+    for ( const CollisionCallback* pCallback : callbacks )
+    {
+        for ( size_t i = pair.firstContact; i < pair.firstContact + pair.contactCount; ++i )
+        {
+            const CollisionContact& contact = m_CollisionBuffer.GetContact( i );
+
+            // A previous callback might have removed one of the child shapes (e.g. a module being destroyed), which
+            // also moves another child into its index. Such contacts are no longer valid.
+            if ( ResolveContactShape( pair.pRigidBodyA, contact.childIndexA ) != contact.pShapeA || ResolveContactShape( pair.pRigidBodyB, contact.childIndexB ) != contact.pShapeB )
+            {
+                continue;
+            }
+
+            ( *pCallback )( pair.pRigidBodyA, pair.pRigidBodyB, contact.pShapeA, contact.pShapeB, contact.position );
+        }
+    }
+}
+
 } // namespace Genesis::Physics
@@ -17,11 +17,13 @@
 
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <list>
-#include <unordered_set>
+#include <unordered_map>
 #include <vector>
 
+#include "physics/rayquery.h"
 #include "physics/raytestresult.h"
 #include "taskmanager.h"
 
@@ -43,49 +45,85 @@ class Window;
 using RigidBodyList = std::list<RigidBody*>;
 using GhostList = std::list<Ghost*>;
 using RayTestResultVector = std::vector<RayTestResult>;
-using CollisionCallback = std::function<void( RigidBody*, RigidBody*, ShapeWeakPtr, ShapeWeakPtr, const glm::vec3& )>;
+// The shapes are only guaranteed to be valid for the duration of the callback. For compound shapes, they are the
+// specific child shapes which are in contact.
+using CollisionCallback = std::function<void( RigidBody*, RigidBody*, Shape*, Shape*, const glm::vec3& )>;
 using CollisionCallbackHandle = unsigned long;
-using CollisionCallbackList = std::list<std::pair<CollisionCallbackHandle, CollisionCallback>>;
 
 static const CollisionCallbackHandle InvalidCollisionCallbackHandle = ~0UL;
 
-struct CollisionData
+struct CollisionCallbackEntry
 {
-    CollisionData( RigidBody* _pRigidBodyA, RigidBody* _pRigidBodyB, ShapeWeakPtr _pShapeA, ShapeWeakPtr _pShapeB, const glm::vec3& _position )
-        : pRigidBodyA( _pRigidBodyA )
-        , pRigidBodyB( _pRigidBodyB )
-        , pShapeA( _pShapeA )
-        , pShapeB( _pShapeB )
-        , position( _position )
-    {
-    }
+    CollisionCallbackHandle handle;
+    RigidBody* pRigidBody; // If set, the callback only receives contacts involving this rigid body.
+    CollisionCallback callback;
+};
+
+using CollisionCallbackList = std::list<CollisionCallbackEntry>;
+using CollisionCallbackPtrVector = std::vector<const CollisionCallback*>;
 
+struct CollisionContact
+{
+    uint64_t pairKey; // Built from both bodies' indices in the world, so pairs are always processed in the same order.
     RigidBody* pRigidBodyA;
     RigidBody* pRigidBodyB;
-    ShapeWeakPtr pShapeA;
-    ShapeWeakPtr pShapeB;
+    int childIndexA; // Index of the child shape for compound shapes, -1 otherwise.
+    int childIndexB;
+    Shape* pShapeA; // The shapes the indices resolved to when the contact was gathered.
+    Shape* pShapeB;
     glm::vec3 position;
 };
 
-struct CollisionDataHashFn
+using CollisionContactVector = std::vector<CollisionContact>;
+
+// A range of contacts in the CollisionBuffer, all between the same two rigid bodies.
+struct CollisionPair
 {
-    size_t operator()( const CollisionData& cd ) const
-    {
-        size_t h1 = std::hash<float>()( cd.position.x );
-        size_t h2 = std::hash<float>()( cd.position.y );
-        return h1 ^ ( h2 << 1 );
-    }
+    RigidBody* pRigidBodyA;
+    RigidBody* pRigidBodyB;
+    size_t firstContact;
+    size_t contactCount;
 };
 
-struct CollisionDataEqualsFn
+using CollisionPairVector = std::vector<CollisionPair>;
+
+///////////////////////////////////////////////////////////////////////////////
+// CollisionBuffer
+// The contacts gathered during the last simulation substep, in a flat array
+// which is sorted by pair of rigid bodies once all the contacts have been
+// added. Both arrays are reused between substeps, so once the buffer has
+// grown to fit a battle it no longer allocates.
+///////////////////////////////////////////////////////////////////////////////
+
+class CollisionBuffer
 {
-    bool operator()( const CollisionData& lhs, const CollisionData& rhs ) const
-    {
-        return ( lhs.position.x == rhs.position.x ) && ( lhs.position.y == rhs.position.y );
-    }
+public:
+    void Clear();
+    void Add( const CollisionContact& contact );
+    void Finalise(); // Groups the contacts into pairs and removes duplicates.
+
+    const CollisionPairVector& GetPairs() const;
+    const CollisionContact& GetContact( size_t index ) const;
+
+private:
+    CollisionContactVector m_Contacts;
+    CollisionPairVector m_Pairs;
 };
 
-using CollisionDataSet = std::unordered_set<CollisionData, CollisionDataHashFn, CollisionDataEqualsFn>;
+inline void CollisionBuffer::Add( const CollisionContact& contact )
+{
+    m_Contacts.push_back( contact );
+}
+
+inline const CollisionPairVector& CollisionBuffer::GetPairs() const
+{
+    return m_Pairs;
+}
+
+inline const CollisionContact& CollisionBuffer::GetContact( size_t index ) const
+{
+    return m_Contacts[ index ];
+}
 
 class Simulation : public Task
 {
@@ -95,6 +133,9 @@ public:
     Simulation();
     virtual ~Simulation();
 
+    // Step() is a fixed rate task, advancing the world by one tick. Update() runs once per frame afterwards and
+    // moves the rigid bodies' motion states to where they should be rendered, in-between the last two ticks.
+    Genesis::TaskStatus Step( float delta );
     Genesis::TaskStatus Update( float delta );
 
     void Add( RigidBody* pRigidBody );
@@ -106,23 +147,33 @@ public:
     // The collisions are ordered by distance from the starting point.
     void RayTest( const glm::vec3& from, const glm::vec3& to, RayTestResultVector& results );
 
+    // Performs a ray test for every query, spreading them across the JobSystem's threads.
+    // Hits are returned per query, ordered by distance from the query's origin.
+    // Must not be called while the simulation is being stepped.
+    void RayTestBatch( const RayQueryVector& queries, RayQueryResults& results );
+
     // Pauses the simulation from stepping.
     // Objects can still be added and removed from the world and raytests can be performed,
     // but without the simulation being stepped no new callbacks will be issued.
     void Pause( bool state );
 
     // Register or unregister a collision callback.
-    // These are sent to all listeners after the world is stepped.
+    // These are sent to all listeners after the world is stepped. If a rigid body is given, the callback only
+    // receives the contacts that rigid body is involved in, otherwise it receives every contact.
     // Don't register / unregister callbacks from a callback.
     CollisionCallbackHandle RegisterCollisionCallback( const CollisionCallback& callbackFn );
+    CollisionCallbackHandle RegisterCollisionCallback( RigidBody* pRigidBody, const CollisionCallback& callbackFn );
     void UnregisterCollisionCallback( CollisionCallbackHandle handle );
 
-    constexpr float GetFixedTimeStep() const { return 1.0f / 60.0f; }
+    float GetFixedTimeStep() const;
     float GetDampingEffect( float damping ) const;
 
 private:
+    void InterpolateMotionStates( float alpha );
     void RenderAdditionalInformation();
     void ProcessCollisionCallbacks();
+    void ProcessCollisionCallbacks( const CollisionPair& pair, const CollisionCallbackPtrVector& callbacks );
+    void RayTestBatchRange( const RayQueryVector& queries, size_t begin, size_t end, RayQueryResults& results, RayQueryHitVector& hits ) const;
 
     btDefaultCollisionConfiguration* m_pCollisionConfiguration;
     btCollisionDispatcher* m_pDispatcher;
@@ -136,7 +187,10 @@ private:
     bool m_IsPaused;
     bool m_ProcessingCallbacks;
     CollisionCallbackList m_CollisionCallbacks;
-    CollisionDataSet m_CollisionDataSet;
+    CollisionCallbackPtrVector m_GlobalCollisionCallbacks;
+    std::unordered_map<const RigidBody*, CollisionCallbackPtrVector> m_RigidBodyCollisionCallbacks;
+    CollisionBuffer m_CollisionBuffer;
+    std::vector<RayQueryHitVector> m_RayQueryBatchHits;
 };
 
 } // namespace Genesis::Physics
@@ -0,0 +1,249 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Genesis.
+//
+// Genesis is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Genesis is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Genesis. If not, see <http://www.gnu.org/licenses/>.
+
+#include "profiling/profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+
+#include "profiling/window.h"
+#include "genesis.h"
+
+namespace Genesis::Profiling
+{
+
+static std::atomic_uint32_t s_NextThreadId( 0 );
+static thread_local uint32_t t_Depth = 0;
+
+//-------------------------------------------------------------------
+// Profiler
+//-------------------------------------------------------------------
+
+Profiler::Profiler()
+    : m_Epoch( std::chrono::high_resolution_clock::now() )
+    , m_FrameHistoryOffset( 0 )
+    , m_Capturing( false )
+{
+    m_FrameHistory.fill( 0.0f );
+    m_pWindow = std::make_unique<Window>( this );
+}
+
+Profiler::~Profiler()
+{
+}
+
+TaskStatus Profiler::Update( float delta )
+{
+    m_FrameHistory[ m_FrameHistoryOffset ] = delta * 1000.0f;
+    m_FrameHistoryOffset = ( m_FrameHistoryOffset + 1 ) % sProfilerFrameHistory;
+
+    GatherZones();
+    UpdateStats();
+
+    if ( m_Capturing )
+    {
+        m_CaptureZones.insert( m_CaptureZones.end(), m_LastFrameZones.begin(), m_LastFrameZones.end() );
+        if ( m_CaptureZones.size() >= sProfilerMaxCaptureZones )
+        {
+            FrameWork::GetLogger()->LogWarning( "Profiler capture reached %zu zones, stopping.", m_CaptureZones.size() );
+            StopCapture( "profile.json" );
+        }
+    }
+
+    m_pWindow->Update( delta );
+
+    return TaskStatus::Continue;
+}
+
+void Profiler::RecordZone( const char* pName, uint64_t start, uint64_t end, uint32_t depth )
+{
+    ThreadData* pThreadData = GetThreadData();
+    std::lock_guard<std::mutex> lock( pThreadData->mutex );
+    pThreadData->zones.push_back( { pName, start, end - start, pThreadData->threadId, depth } );
+}
+
+uint64_t Profiler::GetTimestamp() const
+{
+    return static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::high_resolution_clock::now() - m_Epoch ).count() );
+}
+
+const char* Profiler::RegisterName( const std::string& name )
+{
+    std::lock_guard<std::mutex> lock( m_NamesMutex );
+    return m_Names.insert( name ).first->c_str();
+}
+
+void Profiler::StartCapture()
+{
+    m_CaptureZones.clear();
+    m_Capturing = true;
+}
+
+bool Profiler::StopCapture( const std::string& filename )
+{
+    if ( m_Capturing == false )
+    {
+        return false;
+    }
+
+    m_Capturing = false;
+    const bool result = WriteTrace( filename );
+    if ( result )
+    {
+        FrameWork::GetLogger()->LogInfo( "Profiler capture with %zu zones saved to '%s'.", m_CaptureZones.size(), filename.c_str() );
+    }
+    else
+    {
+        FrameWork::GetLogger()->LogWarning( "Failed to save profiler capture to '%s'.", filename.c_str() );
+    }
+    m_CaptureZones.clear();
+    return result;
+}
+
+Profiler::ThreadData* Profiler::GetThreadData()
+{
+    static thread_local ThreadData* t_pThreadData = nullptr;
+    if ( t_pThreadData == nullptr )
+    {
+        ThreadDataSharedPtr pThreadData = std::make_shared<ThreadData>();
+        pThreadData->threadId = s_NextThreadId++;
+
+        std::lock_guard<std::mutex> lock( m_ThreadsMutex );
+        m_Threads.push_back( pThreadData );
+        t_pThreadData = pThreadData.get();
+    }
+    return t_pThreadData;
+}
+
+void Profiler::GatherZones()
+{
+    m_LastFrameZones.clear();
+
+    std::lock_guard<std::mutex> threadsLock( m_ThreadsMutex );
+    for ( auto& pThreadData : m_Threads )
+    {
+        std::lock_guard<std::mutex> lock( pThreadData->mutex );
+        m_LastFrameZones.insert( m_LastFrameZones.end(), pThreadData->zones.begin(), pThreadData->zones.end() );
+        pThreadData->zones.clear();
+    }
+
+    // Zones are recorded when they end, so parents come after their children. Sorting by start time
+    // (and by depth for zones starting on the same microsecond) restores the hierarchy.
+    std::sort( m_LastFrameZones.begin(), m_LastFrameZones.end(), []( const Zone& a, const Zone& b ) {
+        if ( a.threadId != b.threadId )
+        {
+            return a.threadId < b.threadId;
+        }
+        else if ( a.start != b.start )
+        {
+            return a.start < b.start;
+        }
+        else
+        {
+            return a.depth < b.depth;
+        }
+    } );
+}
+
+void Profiler::UpdateStats()
+{
+    for ( auto& statsPair : m_ZoneStats )
+    {
+        statsPair.second.lastMs = 0.0f;
+        statsPair.second.callsLastFrame = 0;
+    }
+
+    for ( const Zone& zone : m_LastFrameZones )
+    {
+        auto it = m_ZoneStats.find( zone.pName );
+        if ( it == m_ZoneStats.end() )
+        {
+            it = m_ZoneStats.insert( { zone.pName, { zone.depth, 0.0f, 0.0f, 0.0f, 0 } } ).first;
+        }
+
+        it->second.lastMs += static_cast<float>( zone.duration ) / 1000.0f;
+        it->second.callsLastFrame++;
+    }
+
+    // The maximum decays slowly so that a spike remains visible for a few seconds.
+    for ( auto& statsPair : m_ZoneStats )
+    {
+        ZoneStats& stats = statsPair.second;
+        stats.averageMs = stats.averageMs * 0.95f + stats.lastMs * 0.05f;
+        stats.maximumMs = std::max( stats.lastMs, stats.maximumMs * 0.995f );
+    }
+}
+
+bool Profiler::WriteTrace( const std::string& filename ) const
+{
+    std::ofstream file( filename, std::ofstream::out | std::ofstream::trunc );
+    if ( file.good() == false )
+    {
+        return false;
+    }
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+    for ( const Zone& zone : m_CaptureZones )
+    {
+        file << ( first ? "\n" : ",\n" );
+        first = false;
+
+        file << "{\"name\":\"";
+        for ( const char* pChar = zone.pName; *pChar != '\0'; ++pChar )
+        {
+            if ( *pChar == '"' || *pChar == '\\' )
+            {
+                file << '\\';
+            }
+            file << *pChar;
+        }
+        file << "\",\"cat\":\"genesis\",\"ph\":\"X\",\"pid\":0,\"tid\":" << zone.threadId << ",\"ts\":" << zone.start << ",\"dur\":" << zone.duration << "}";
+    }
+
+    file << "\n]}\n";
+    return file.good();
+}
+
+//-------------------------------------------------------------------
+// ScopedZone
+//-------------------------------------------------------------------
+
+ScopedZone::ScopedZone( const char* pName )
+    : m_pProfiler( FrameWork::GetProfiler() )
+    , m_pName( pName )
+    , m_Start( 0 )
+{
+    if ( m_pProfiler != nullptr )
+    {
+        m_Start = m_pProfiler->GetTimestamp();
+        t_Depth++;
+    }
+}
+
+ScopedZone::~ScopedZone()
+{
+    if ( m_pProfiler != nullptr )
+    {
+        t_Depth--;
+        m_pProfiler->RecordZone( m_pName, m_Start, m_pProfiler->GetTimestamp(), t_Depth );
+    }
+}
+
+} // namespace Genesis::Profiling
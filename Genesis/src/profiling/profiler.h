@@ -0,0 +1,178 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Genesis.
+//
+// Genesis is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Genesis is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Genesis. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "taskmanager.h"
+#include "timer.h"
+
+#define GENESIS_PROFILE_CONCAT_AUX( a, b ) a##b
+#define GENESIS_PROFILE_CONCAT( a, b ) GENESIS_PROFILE_CONCAT_AUX( a, b )
+
+// Times the enclosing scope. The name must outlive the profiler: either a string literal
+// or a pointer returned by Profiler::RegisterName().
+#define GENESIS_PROFILE_ZONE( name ) Genesis::Profiling::ScopedZone GENESIS_PROFILE_CONCAT( profileZone, __LINE__ )( name )
+
+namespace Genesis::Profiling
+{
+
+class Window;
+
+struct Zone
+{
+    const char* pName;
+    uint64_t start; // Microseconds since the profiler was created.
+    uint64_t duration; // Microseconds.
+    uint32_t threadId;
+    uint32_t depth;
+};
+
+using ZoneVector = std::vector<Zone>;
+
+struct ZoneStats
+{
+    uint32_t depth;
+    float lastMs;
+    float averageMs;
+    float maximumMs;
+    uint32_t callsLastFrame;
+};
+
+static const size_t sProfilerFrameHistory = 240;
+static const size_t sProfilerMaxCaptureZones = 4 * 1024 * 1024;
+
+///////////////////////////////////////////////////////////////////////////////
+// Profiler
+// Collects the zones recorded by every thread. Once per frame, the zones
+// are gathered into per-name statistics which are shown in the profiler
+// window, and appended to the capture if one is in progress. A capture can
+// be saved in the Chrome trace event format, to be opened with
+// chrome://tracing or Perfetto.
+///////////////////////////////////////////////////////////////////////////////
+
+class Profiler : public Task
+{
+public:
+    Profiler();
+    virtual ~Profiler();
+
+    TaskStatus Update( float delta );
+
+    void RecordZone( const char* pName, uint64_t start, uint64_t end, uint32_t depth );
+    uint64_t GetTimestamp() const;
+
+    // Returns a pointer to an interned copy of the name, valid for the lifetime of the profiler.
+    const char* RegisterName( const std::string& name );
+
+    void StartCapture();
+    bool StopCapture( const std::string& filename );
+    bool IsCapturing() const;
+    size_t GetCapturedZoneCount() const;
+
+    const ZoneVector& GetLastFrameZones() const;
+    const std::unordered_map<const char*, ZoneStats>& GetZoneStats() const;
+    const std::array<float, sProfilerFrameHistory>& GetFrameHistory() const;
+    size_t GetFrameHistoryOffset() const;
+
+private:
+    struct ThreadData
+    {
+        std::mutex mutex;
+        ZoneVector zones;
+        uint32_t threadId;
+    };
+    using ThreadDataSharedPtr = std::shared_ptr<ThreadData>;
+
+    ThreadData* GetThreadData();
+    void GatherZones();
+    void UpdateStats();
+    bool WriteTrace( const std::string& filename ) const;
+
+    HighResolutionTimePoint m_Epoch;
+    std::mutex m_ThreadsMutex;
+    std::vector<ThreadDataSharedPtr> m_Threads;
+    std::mutex m_NamesMutex;
+    std::unordered_set<std::string> m_Names;
+
+    ZoneVector m_LastFrameZones;
+    std::unordered_map<const char*, ZoneStats> m_ZoneStats;
+    std::array<float, sProfilerFrameHistory> m_FrameHistory;
+    size_t m_FrameHistoryOffset;
+
+    bool m_Capturing;
+    ZoneVector m_CaptureZones;
+
+    std::unique_ptr<Window> m_pWindow;
+};
+
+inline bool Profiler::IsCapturing() const
+{
+    return m_Capturing;
+}
+
+inline size_t Profiler::GetCapturedZoneCount() const
+{
+    return m_CaptureZones.size();
+}
+
+inline const ZoneVector& Profiler::GetLastFrameZones() const
+{
+    return m_LastFrameZones;
+}
+
+inline const std::unordered_map<const char*, ZoneStats>& Profiler::GetZoneStats() const
+{
+    return m_ZoneStats;
+}
+
+inline const std::array<float, sProfilerFrameHistory>& Profiler::GetFrameHistory() const
+{
+    return m_FrameHistory;
+}
+
+inline size_t Profiler::GetFrameHistoryOffset() const
+{
+    return m_FrameHistoryOffset;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// ScopedZone
+// Records a zone spanning its own lifetime. Nesting is tracked per thread.
+///////////////////////////////////////////////////////////////////////////////
+
+class ScopedZone
+{
+public:
+    ScopedZone( const char* pName );
+    ~ScopedZone();
+
+private:
+    Profiler* m_pProfiler;
+    const char* m_pName;
+    uint64_t m_Start;
+};
+
+} // namespace Genesis::Profiling
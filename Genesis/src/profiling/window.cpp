@@ -0,0 +1,144 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Genesis.
+//
+// Genesis is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Genesis is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Genesis. If not, see <http://www.gnu.org/licenses/>.
+
+#include "profiling/window.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "imgui/imgui.h"
+#include "imgui/imgui_impl.h"
+#include "profiling/profiler.h"
+
+namespace Genesis::Profiling
+{
+
+Window::Window( Profiler* pProfiler )
+	: m_pProfiler( pProfiler )
+	, m_Open( false )
+{
+	Genesis::ImGuiImpl::RegisterMenu( "Genesis", "Profiler", &m_Open );
+}
+
+Window::~Window()
+{
+	Genesis::ImGuiImpl::UnregisterMenu( "Genesis", "Profiler" );
+}
+
+void Window::Update( float delta )
+{
+	if ( m_Open == false )
+	{
+		return;
+	}
+
+	ImGui::Begin( "Profiler", &m_Open );
+
+	if ( ImGui::CollapsingHeader( "Overview", ImGuiTreeNodeFlags_DefaultOpen ) )
+	{
+		const auto& frameHistory = m_pProfiler->GetFrameHistory();
+		ImGui::Text( "Frame: %.2fms", delta * 1000.0f );
+		ImGui::PlotLines( "##FrameTimes", frameHistory.data(), static_cast<int>( frameHistory.size() ), static_cast<int>( m_pProfiler->GetFrameHistoryOffset() ), nullptr, 0.0f, 33.3f, ImVec2( 0.0f, 60.0f ) );
+
+		if ( m_pProfiler->IsCapturing() )
+		{
+			if ( ImGui::Button( "Stop capture" ) )
+			{
+				m_pProfiler->StopCapture( "profile.json" );
+			}
+			ImGui::SameLine();
+			ImGui::Text( "Capturing: %zu zones", m_pProfiler->GetCapturedZoneCount() );
+		}
+		else if ( ImGui::Button( "Start capture" ) )
+		{
+			m_pProfiler->StartCapture();
+		}
+	}
+
+	if ( ImGui::CollapsingHeader( "Zones", ImGuiTreeNodeFlags_DefaultOpen ) )
+	{
+		DrawZoneTable();
+	}
+
+	if ( ImGui::CollapsingHeader( "Last frame" ) )
+	{
+		DrawLastFrame();
+	}
+
+	ImGui::End();
+}
+
+void Window::DrawZoneTable()
+{
+	using ZoneStatsEntry = std::pair<const char*, ZoneStats>;
+	std::vector<ZoneStatsEntry> entries( m_pProfiler->GetZoneStats().begin(), m_pProfiler->GetZoneStats().end() );
+	std::sort( entries.begin(), entries.end(), []( const ZoneStatsEntry& a, const ZoneStatsEntry& b ) { return a.second.averageMs > b.second.averageMs; } );
+
+	const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
+	if ( ImGui::BeginTable( "ZoneTable", 5, flags ) )
+	{
+		ImGui::TableSetupColumn( "Zone" );
+		ImGui::TableSetupColumn( "Calls" );
+		ImGui::TableSetupColumn( "Last (ms)" );
+		ImGui::TableSetupColumn( "Average (ms)" );
+		ImGui::TableSetupColumn( "Peak (ms)" );
+		ImGui::TableHeadersRow();
+
+		for ( auto& entry : entries )
+		{
+			const ZoneStats& stats = entry.second;
+			ImGui::TableNextColumn();
+			ImGui::Text( "%s", entry.first );
+			ImGui::TableNextColumn();
+			ImGui::Text( "%u", stats.callsLastFrame );
+			ImGui::TableNextColumn();
+			ImGui::Text( "%.3f", stats.lastMs );
+			ImGui::TableNextColumn();
+			ImGui::Text( "%.3f", stats.averageMs );
+			ImGui::TableNextColumn();
+			ImGui::Text( "%.3f", stats.maximumMs );
+		}
+
+		ImGui::EndTable();
+	}
+}
+
+void Window::DrawLastFrame()
+{
+	const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
+	if ( ImGui::BeginTable( "LastFrameTable", 3, flags ) )
+	{
+		ImGui::TableSetupColumn( "Zone" );
+		ImGui::TableSetupColumn( "Thread" );
+		ImGui::TableSetupColumn( "Duration (ms)" );
+		ImGui::TableHeadersRow();
+
+		for ( const Zone& zone : m_pProfiler->GetLastFrameZones() )
+		{
+			ImGui::TableNextColumn();
+			ImGui::Text( "%*s%s", static_cast<int>( zone.depth * 2 ), "", zone.pName );
+			ImGui::TableNextColumn();
+			ImGui::Text( "%u", zone.threadId );
+			ImGui::TableNextColumn();
+			ImGui::Text( "%.3f", static_cast<float>( zone.duration ) / 1000.0f );
+		}
+
+		ImGui::EndTable();
+	}
+}
+
+} // namespace Genesis::Profiling
@@ -70,6 +70,7 @@ RenderSystem::RenderSystem()
     , m_pGlowShaderDirection( nullptr )
     , m_pGlowVertexBuffer( nullptr )
     , m_ShaderTimer( 0.0f )
+    , m_FrameIndex( 0 )
     , m_DrawCallCount( 0 )
     , m_BlendMode( BlendMode::Disabled )
     , m_InputCallbackScreenshot( InputManager::sInvalidInputCallbackToken )
@@ -84,6 +85,8 @@ RenderSystem::RenderSystem()
     {
         m_PostProcessShaderUniforms[ i ] = nullptr;
     }
+
+    m_FrameFences.fill( nullptr );
 }
 
 RenderSystem::~RenderSystem()
@@ -100,6 +103,14 @@ RenderSystem::~RenderSystem()
     delete m_pShaderCache;
     delete m_pPostProcessVertexBuffer;
 
+    for ( GLsync fence : m_FrameFences )
+    {
+        if ( fence != nullptr )
+        {
+            glDeleteSync( fence );
+        }
+    }
+
 	ImGuiImpl::Shutdown();
 }
 
@@ -143,8 +154,9 @@ void RenderSystem::Initialize( GLuint screenWidth, GLuint screenHeight )
 	SDL_GL_GetAttribute( SDL_GL_CONTEXT_MINOR_VERSION, &minor );
 	pLogger->LogInfo( "Using OpenGL version %d.%d.", major, minor );
 
-    m_ProjectionMatrix = glm::perspective( 45.0f, static_cast<float>( m_ScreenWidth ) / static_cast<float>( m_ScreenHeight ), 1.0f, 2000.0f );
-    m_ViewMatrix = glm::mat4( 1.0f );
+    // The shared uniforms need to exist before any shader is used.
+    m_pFrameUniformBuffer = std::make_unique<FrameUniformBuffer>();
+    SetView( glm::mat4( 1.0f ), glm::perspective( 45.0f, static_cast<float>( m_ScreenWidth ) / static_cast<float>( m_ScreenHeight ), 1.0f, 2000.0f ) );
 
     glClearColor( 0.0f, 0.0f, 0.0f, 1.0f );
     glClearDepth( 1.0f );
@@ -161,6 +173,17 @@ void RenderSystem::Initialize( GLuint screenWidth, GLuint screenHeight )
     m_InputCallbackCapture = FrameWork::GetInputManager()->AddKeyboardCallback( std::bind( &RenderSystem::Capture, this ), SDL_SCANCODE_F8, ButtonState::Pressed );
 }
 
+// Without a GL context, only the state which the rest of the engine queries is set up. Nothing is
+// ever rendered, but the frame index still advances so streaming buffers recycle their regions.
+void RenderSystem::InitializeHeadless( GLuint screenWidth, GLuint screenHeight )
+{
+    FrameWork::GetLogger()->LogInfo( "Running headless, rendering is disabled." );
+
+    m_ScreenWidth = screenWidth;
+    m_ScreenHeight = screenHeight;
+    m_pShaderCache = new ShaderCache();
+}
+
 void RenderSystem::CreateRenderTargets()
 {
 	m_ScreenRenderTarget = RenderTarget::Create( "Internal fullscreen", m_ScreenWidth, m_ScreenHeight, true, true );
@@ -317,13 +340,9 @@ void RenderSystem::InitializePostProcessing()
     ShaderUniform* pGlowSampler = m_pPostProcessShader->RegisterUniform( "k_sampler1", ShaderUniformType::Texture );
     pGlowSampler->Set( GetRenderTarget( RenderTargetId::GlowBlurVertical )->GetColor(), GL_TEXTURE1 );
 
-	ShaderUniform* pResolution = m_pPostProcessShader->RegisterUniform( "k_resolution", ShaderUniformType::FloatVector2 );
+    // k_resolution is part of the FrameUniforms block.
     const float w = (float)m_ScreenRenderTarget->GetWidth();
     const float h = (float)m_ScreenRenderTarget->GetHeight();
-	if ( pResolution != nullptr )
-	{
-		pResolution->Set( glm::vec2( w, h ) );
-	}
 
     auto LinkPostProcessEffect = [this]( const char* pUniformName, PostProcessEffect effect )
     {
@@ -364,13 +383,8 @@ void RenderSystem::InitializeGlowChain()
     // Horizontal (1,0) or vertical (0,1) blur.
     m_pGlowShaderDirection = m_pGlowShader->RegisterUniform( "k_direction", ShaderUniformType::FloatVector2 );
 
-	ShaderUniform* pResolution = m_pGlowShader->RegisterUniform( "k_resolution", ShaderUniformType::FloatVector2 );
     const float w = static_cast<float>( m_pGlowRenderTarget->GetWidth() );
     const float h = static_cast<float>( m_pGlowRenderTarget->GetHeight() );
-	if ( pResolution != nullptr )
-	{
-		pResolution->Set( glm::vec2( w, h ) );
-	}
 
     m_pGlowVertexBuffer = new VertexBuffer( GeometryType::Triangle, VBO_POSITION | VBO_UV );
     m_pGlowVertexBuffer->CreateTexturedQuad( 0.0f, 0.0f, w, h );
@@ -543,8 +557,7 @@ void RenderSystem::RenderScene()
 void RenderSystem::RenderGlow()
 {
     RenderTarget* pGlowRenderTarget = GetRenderTarget( RenderTargetId::Glow );
-    m_ViewMatrix = glm::mat4();
-    m_ProjectionMatrix = glm::ortho( 0.0f, static_cast<float>( pGlowRenderTarget->GetWidth() ), static_cast<float>( pGlowRenderTarget->GetHeight() ), 0.0f, -1.0f, 1.0f );
+    SetView( glm::mat4(), glm::ortho( 0.0f, static_cast<float>( pGlowRenderTarget->GetWidth() ), static_cast<float>( pGlowRenderTarget->GetHeight() ), 0.0f, -1.0f, 1.0f ) );
 
     SetRenderTarget( RenderTargetId::GlowBlurHorizontal );
     m_pGlowShaderSampler->Set( GetRenderTarget( RenderTargetId::Glow )->GetColor(), GL_TEXTURE0 );
@@ -563,6 +576,12 @@ TaskStatus RenderSystem::Update( float delta )
 {
     m_ShaderTimer += delta;
 
+    if ( FrameWork::IsHeadless() )
+    {
+        m_FrameIndex++;
+        return TaskStatus::Continue;
+    }
+
     ClearAll();
     ViewPerspective();
     RenderScene();
@@ -586,13 +605,44 @@ TaskStatus RenderSystem::Update( float delta )
         TakeScreenshotAux( true );
     }
 
+    GLsync& fence = m_FrameFences[ m_FrameIndex % sFrameFenceCount ];
+    if ( fence != nullptr )
+    {
+        glDeleteSync( fence );
+    }
+    fence = glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+    m_FrameIndex++;
+
     return TaskStatus::Continue;
 }
 
+void RenderSystem::WaitForFrame( uint64_t frameIndex )
+{
+    // Frames older than the fences we keep around have necessarily been completed.
+    if ( frameIndex >= m_FrameIndex || m_FrameIndex - frameIndex > sFrameFenceCount )
+    {
+        SDL_assert( frameIndex < m_FrameIndex || frameIndex == 0 );
+        return;
+    }
+
+    GLsync fence = m_FrameFences[ frameIndex % sFrameFenceCount ];
+    if ( fence == nullptr )
+    {
+        return;
+    }
+
+    const GLuint64 timeout = 1000000000; // One second, in nanoseconds.
+    GLenum result = glClientWaitSync( fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout );
+    while ( result == GL_TIMEOUT_EXPIRED )
+    {
+        FrameWork::GetLogger()->LogWarning( "Waited over a second for frame %llu to complete.", static_cast<unsigned long long>( frameIndex ) );
+        result = glClientWaitSync( fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout );
+    }
+}
+
 void RenderSystem::ViewOrtho()
 {
-    m_ViewMatrix = glm::mat4();
-    m_ProjectionMatrix = glm::ortho( 0.0f, static_cast<float>( m_ScreenWidth ), static_cast<float>( m_ScreenHeight ), 0.0f, -1.0f, 1.0f );
+    SetView( glm::mat4(), glm::ortho( 0.0f, static_cast<float>( m_ScreenWidth ), static_cast<float>( m_ScreenHeight ), 0.0f, -1.0f, 1.0f ) );
 }
 
 void RenderSystem::ViewPerspective()
@@ -602,12 +652,24 @@ void RenderSystem::ViewPerspective()
     glm::vec3 cPos = camera->GetPosition();
     glm::vec3 cTgt = camera->GetTargetPosition();
 
-    m_ViewMatrix = glm::lookAt(
+    const glm::mat4 viewMatrix = glm::lookAt(
         glm::vec3( cPos.x, cPos.y, cPos.z ),
         glm::vec3( cTgt.x, cTgt.y, cTgt.z ),
         glm::vec3( 0.0f, 1.0f, 0.0f ) );
 
-    m_ProjectionMatrix = glm::perspective( 45.0f, static_cast<float>( m_ScreenWidth ) / static_cast<float>( m_ScreenHeight ), 1.0f, 2000.0f );
+    SetView( viewMatrix, glm::perspective( 45.0f, static_cast<float>( m_ScreenWidth ) / static_cast<float>( m_ScreenHeight ), 1.0f, 2000.0f ) );
+}
+
+// Every draw until the next call to SetView() shares these matrices, so they are uploaded once into the
+// frame uniform buffer rather than by each shader.
+void RenderSystem::SetView( const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix )
+{
+    m_ViewMatrix = viewMatrix;
+    m_ProjectionMatrix = projectionMatrix;
+    m_ViewProjectionMatrix = projectionMatrix * viewMatrix;
+
+    const glm::vec2 resolution( static_cast<float>( Configuration::GetScreenWidth() ), static_cast<float>( Configuration::GetScreenHeight() ) );
+    m_pFrameUniformBuffer->Update( viewMatrix, projectionMatrix, resolution, m_ShaderTimer );
 }
 
 IntersectionResult RenderSystem::LinePlaneIntersection( const glm::vec3& position, const glm::vec3& direction, const glm::vec3& planePosition, const glm::vec3& planeNormal, glm::vec3& result )
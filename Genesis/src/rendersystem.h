@@ -25,6 +25,7 @@
 #include "glm/gtx/transform.hpp"
 #include "render/rendertarget.h"
 #include "color.h"
+#include "frameuniformbuffer.h"
 #include "inputmanager.h"
 #include "shader.h"
 #include "shaderuniformtype.h"
@@ -47,6 +48,7 @@ public:
     virtual ~RenderSystem();
     TaskStatus Update( float delta );
     void Initialize( GLuint screenWidth, GLuint screenHeight );
+    void InitializeHeadless( GLuint screenWidth, GLuint screenHeight );
     void ViewOrtho();
     void ViewPerspective();
     ShaderCache* GetShaderCache() const;
@@ -63,6 +65,12 @@ public:
 
     const glm::mat4& GetViewMatrix() const;
     const glm::mat4& GetProjectionMatrix() const;
+    const glm::mat4& GetViewProjectionMatrix() const;
+
+    // The index of the frame currently being built, incremented once the frame has been presented.
+    uint64_t GetFrameIndex() const;
+    // Blocks until the GPU has finished processing the given frame.
+    void WaitForFrame( uint64_t frameIndex );
 
     unsigned int GetDrawCallCount() const;
     void IncreaseDrawCallCount();
@@ -92,6 +100,7 @@ private:
     void InitializeGlowChain();
     void RenderScene();
     void RenderGlow();
+    void SetView( const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix );
     RenderTarget* GetRenderTarget( RenderTargetId id );
     void ScreenPosToWorldRay( int mouseX, int mouseY, int screenWidth, int screenHeight, const glm::mat4& ViewMatrix, const glm::mat4& ProjectionMatrix, glm::vec3& out_origin, glm::vec3& out_direction );
     IntersectionResult LinePlaneIntersection( const glm::vec3& position, const glm::vec3& direction, const glm::vec3& planePosition, const glm::vec3& planeNormal, glm::vec3& result );
@@ -138,6 +147,12 @@ private:
     float m_ShaderTimer;
     glm::mat4 m_ViewMatrix;
     glm::mat4 m_ProjectionMatrix;
+    glm::mat4 m_ViewProjectionMatrix;
+    FrameUniformBufferUniquePtr m_pFrameUniformBuffer;
+
+    static const size_t sFrameFenceCount = 4;
+    uint64_t m_FrameIndex;
+    std::array<GLsync, sFrameFenceCount> m_FrameFences;
 
     unsigned int m_DrawCallCount;
     BlendMode m_BlendMode;
@@ -191,6 +206,16 @@ inline const glm::mat4& RenderSystem::GetProjectionMatrix() const
     return m_ProjectionMatrix;
 }
 
+inline const glm::mat4& RenderSystem::GetViewProjectionMatrix() const
+{
+    return m_ViewProjectionMatrix;
+}
+
+inline uint64_t RenderSystem::GetFrameIndex() const
+{
+    return m_FrameIndex;
+}
+
 inline unsigned int RenderSystem::GetDrawCallCount() const
 {
     return m_DrawCallCount;
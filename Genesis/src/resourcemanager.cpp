@@ -17,12 +17,17 @@
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <string>
 
 #include "genesis.h"
+#include "jobsystem.h"
 #include "memory.h"
+#include "profiling/profiler.h"
 #include "resourcemanager.h"
 #include "resources/resourcefont.h"
 #include "resources/resourceimage.h"
@@ -52,9 +57,17 @@ ResourceGeneric::ResourceGeneric( const Filename& filename )
 // Preload(), while Load() itself does run on the main thread and can then
 // be used to deal with systems that do not play well in a multi-threaded
 // environment, such as OpenGL.
+// Asynchronous loads are preloaded in parallel on the JobSystem, and then
+// go through a bounded upload queue which is drained by ProcessUploads()
+// on the thread which owns the upload context.
 //////////////////////////////////////////////////////////////////////////////
 
+// How many preloaded resources can be waiting for their upload, including the ones still being preloaded.
+// This keeps decoded images and models from piling up in memory faster than they can be uploaded.
+static const size_t sMaxQueuedUploads = 64;
+
 ResourceManager::ResourceManager()
+    : m_PreloadsInFlight( 0 )
 {
     ResourceFactoryFunction fCreateResourceImage = []( const Filename& filename ) { return new ResourceImage( filename ); };
     RegisterExtension( "bmp", fCreateResourceImage );
@@ -120,18 +133,313 @@ bool ResourceManager::CanLoadResource( const Filename& filename )
 // it will block the main thread until the resource has finished loading.
 ResourceGeneric* ResourceManager::GetResource( const Filename& filename )
 {
-    // Check if we already have this resource loaded
+    ResourceGeneric* pResource = nullptr;
+    bool isNewResource = false;
+    {
+        std::lock_guard<std::mutex> lock( m_Mutex );
+
+        // Check if we already have this resource loaded
+        ResourceMap::iterator resourceMapIter = mResources.find( filename.GetFullPath() );
+        if ( resourceMapIter == mResources.end() )
+        {
+            pResource = CreateResource( filename );
+            if ( pResource == nullptr )
+            {
+                return nullptr;
+            }
+
+            pResource->SetState( ResourceState::Preloading );
+            isNewResource = true;
+        }
+        else if ( IsReady( resourceMapIter->second ) )
+        {
+            return resourceMapIter->second;
+        }
+        else
+        {
+            pResource = resourceMapIter->second;
+        }
+    }
+
+    if ( isNewResource )
+    {
+        pResource->Preload();
+        LoadResource( pResource );
+        SDL_assert( pResource->GetState() == ResourceState::Loaded );
+
+        // Someone may have asked for this resource asynchronously while we were loading it.
+        CompleteAsyncLoad( pResource );
+    }
+    else
+    {
+        WaitForResource( pResource );
+    }
+
+    return pResource;
+}
+
+ResourceFuture ResourceManager::GetResourceAsync( const Filename& filename )
+{
+    std::lock_guard<std::mutex> lock( m_Mutex );
+
+    AsyncLoadMap::iterator asyncLoadIter = m_AsyncLoads.find( filename.GetFullPath() );
+    if ( asyncLoadIter != m_AsyncLoads.end() )
+    {
+        return asyncLoadIter->second->future;
+    }
+
+    AsyncLoadSharedPtr pLoad = std::make_shared<AsyncLoad>();
+    pLoad->future = pLoad->promise.get_future().share();
+
     ResourceMap::iterator resourceMapIter = mResources.find( filename.GetFullPath() );
-    if ( resourceMapIter != mResources.end() )
+    if ( resourceMapIter == mResources.end() )
     {
-        return resourceMapIter->second;
+        pLoad->pResource = CreateResource( filename );
+        if ( pLoad->pResource == nullptr )
+        {
+            pLoad->promise.set_value( nullptr );
+            return pLoad->future;
+        }
+
+        pLoad->pResource->SetState( ResourceState::PreloadPending );
+        m_AsyncLoads[ filename.GetFullPath() ] = pLoad;
+        m_PreloadQueue.push_back( pLoad );
+        SubmitPreloads();
     }
+    else
+    {
+        pLoad->pResource = resourceMapIter->second;
+        const ResourceState state = pLoad->pResource->GetState();
+        if ( state == ResourceState::Loaded || state == ResourceState::Unloaded )
+        {
+            pLoad->promise.set_value( pLoad->pResource );
+        }
+        else
+        {
+            // Another thread is loading this resource through GetResource() and will complete the future once it is done.
+            m_AsyncLoads[ filename.GetFullPath() ] = pLoad;
+        }
+    }
+
+    return pLoad->future;
+}
+
+bool ResourceManager::ProcessUploads( size_t maxUploads )
+{
+    GENESIS_PROFILE_ZONE( "ResourceManager::ProcessUploads" );
+
+    ResolveUploadBatches( false );
+
+    AsyncLoadVector loads;
+    bool isIdle = false;
+    {
+        std::unique_lock<std::mutex> lock( m_Mutex );
+
+        // Rather than spinning while there is nothing to upload, give the JobSystem a moment to finish some preloads.
+        if ( m_UploadQueue.empty() && m_PreloadsInFlight > 0 )
+        {
+            m_StateChanged.wait_for( lock, std::chrono::milliseconds( 1 ), [ this ]() { return m_UploadQueue.empty() == false || m_PreloadsInFlight == 0; } );
+        }
+
+        // Other threads can't use these resources until ResolveUploadBatches() has seen their fence, as their
+        // contexts could otherwise run ahead of the upload. This thread's context executes the upload in order.
+        const bool isBatched = ( FrameWork::IsHeadless() == false );
+        m_UploadThreadId = std::this_thread::get_id();
+        while ( loads.size() < maxUploads && m_UploadQueue.empty() == false )
+        {
+            loads.push_back( m_UploadQueue.front() );
+            loads.back()->pResource->SetState( ResourceState::Loading );
+            if ( isBatched )
+            {
+                m_PendingUploads.insert( loads.back()->pResource );
+            }
+            m_UploadQueue.pop_front();
+        }
+
+        // Taking resources out of the upload queue has made room for more preloads.
+        SubmitPreloads();
+
+        isIdle = loads.empty() && m_PreloadQueue.empty() && m_UploadQueue.empty() && m_PreloadsInFlight == 0;
+    }
+
+    if ( loads.empty() == false )
+    {
+        for ( auto& pLoad : loads )
+        {
+            LoadResource( pLoad->pResource );
+        }
+
+        if ( FrameWork::IsHeadless() )
+        {
+            for ( auto& pLoad : loads )
+            {
+                CompleteAsyncLoad( pLoad->pResource );
+            }
+        }
+        else
+        {
+            // The fence must be flushed, otherwise it might never be signalled if this context stops submitting commands.
+            UploadBatch batch;
+            batch.fence = glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+            batch.loads = std::move( loads );
+            glFlush();
+            m_UploadBatches.push_back( std::move( batch ) );
+        }
+    }
+
+    // Once everything has been uploaded, wait for the GPU to catch up so other contexts can use the resources.
+    if ( isIdle )
+    {
+        ResolveUploadBatches( true );
+    }
+
+    return isIdle == false || m_UploadBatches.empty() == false;
+}
+
+bool ResourceManager::MountPack( const std::string& filename )
+{
+    std::unique_ptr<ResourcePack> pPack = std::make_unique<ResourcePack>();
+    if ( pPack->Open( filename ) == false )
+    {
+        return false;
+    }
+
+    // A pack which is older than any of the loose files it was cooked from would hide whatever has been edited since.
+    // Falling back to the loose files is always correct, if slower.
+    std::error_code error;
+    const std::filesystem::file_time_type packTime = std::filesystem::last_write_time( filename, error );
+    if ( error )
+    {
+        return false;
+    }
+
+    for ( const auto& entryPair : pPack->GetEntries() )
+    {
+        const std::filesystem::file_time_type looseTime = std::filesystem::last_write_time( entryPair.first, error );
+        if ( !error && looseTime > packTime )
+        {
+            FrameWork::GetLogger()->LogWarning( LogCategory::Resources, "Not mounting '%s', as '%s' has changed since it was cooked. Cook the pack again or delete it.", filename.c_str(), entryPair.first.c_str() );
+            return false;
+        }
+    }
+
+    m_pPack = std::move( pPack );
+    return true;
+}
+
+const ResourcePackEntry* ResourceManager::FindPackEntry( const std::string& path ) const
+{
+    return ( m_pPack == nullptr ) ? nullptr : m_pPack->Find( path );
+}
+
+void ResourceManager::ListFiles( const std::string& directory, bool recursive, std::vector<std::string>& paths ) const
+{
+    if ( m_pPack != nullptr )
+    {
+        m_pPack->List( directory, recursive, paths );
+    }
+
+    // Files which weren't cooked, such as sounds, are still loose.
+    if ( std::filesystem::is_directory( directory ) == false )
+    {
+        return;
+    }
+
+    auto addLooseFile = [ this, &paths ]( const std::filesystem::directory_entry& entry ) {
+        if ( entry.is_regular_file() && FindPackEntry( entry.path().string() ) == nullptr )
+        {
+            paths.push_back( entry.path().string() );
+        }
+    };
 
+    if ( recursive )
+    {
+        for ( const auto& entry : std::filesystem::recursive_directory_iterator( directory ) )
+        {
+            addLooseFile( entry );
+        }
+    }
+    else
+    {
+        for ( const auto& entry : std::filesystem::directory_iterator( directory ) )
+        {
+            addLooseFile( entry );
+        }
+    }
+}
+
+bool ResourceManager::CookPack( const std::string& directory, const std::string& packFilename )
+{
+    Logger* pLogger = FrameWork::GetLogger();
+    ResourcePackWriter writer;
+    size_t cookedSize = 0;
+    size_t cookedCount = 0;
+
+    for ( const auto& entry : std::filesystem::recursive_directory_iterator( directory ) )
+    {
+        if ( entry.is_regular_file() == false )
+        {
+            continue;
+        }
+
+        std::string extension = entry.path().extension().string();
+        std::transform( extension.begin(), extension.end(), extension.begin(), []( char c ) -> char { return static_cast<char>( std::tolower( c ) ); } );
+
+        const std::string path = ResourcePack::NormalisePath( entry.path().string() );
+        std::vector<uint8_t> data;
+        ResourcePackEntryType type = ResourcePackEntryType::File;
+        bool cooked = false;
+        if ( extension == ".bmp" || extension == ".jpg" || extension == ".png" || extension == ".tga" )
+        {
+            type = ResourcePackEntryType::Image;
+            cooked = ResourceImage::Cook( path, data );
+        }
+        else if ( extension == ".tmf" )
+        {
+            type = ResourcePackEntryType::Model;
+            cooked = ResourceModel::Cook( path, data );
+        }
+        else if ( extension == ".fnt" || extension == ".frag" || extension == ".shp" || extension == ".tml" || extension == ".vert" || extension == ".xml" )
+        {
+            std::ifstream file( entry.path(), std::ios::in | std::ios::binary );
+            data.assign( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() );
+            cooked = file.is_open();
+        }
+        else
+        {
+            // Sounds and videos are streamed by their own libraries, which need the loose files.
+            continue;
+        }
+
+        if ( cooked )
+        {
+            cookedSize += data.size();
+            cookedCount++;
+            writer.Add( path, type, std::move( data ) );
+        }
+        else
+        {
+            pLogger->LogWarning( "Couldn't cook '%s'.", path.c_str() );
+        }
+    }
+
+    if ( writer.Write( packFilename ) == false )
+    {
+        return false;
+    }
+
+    pLogger->LogInfo( "Cooked %zu files from '%s' into '%s', %zu bytes.", cookedCount, directory.c_str(), packFilename.c_str(), cookedSize );
+    return true;
+}
+
+// Must be called with m_Mutex locked.
+ResourceGeneric* ResourceManager::CreateResource( const Filename& filename )
+{
     const std::string& extension = filename.GetExtension();
     ExtensionMap::iterator extensionIter = mRegisteredExtensions.find( extension );
     if ( extensionIter == mRegisteredExtensions.end() )
     {
-        FrameWork::GetLogger()->LogWarning( "Trying to load unsupported resource: %s.", filename.GetFullPath().c_str() );
+        FrameWork::GetLogger()->LogWarning( LogCategory::Resources, "Trying to load unsupported resource: %s.", filename.GetFullPath().c_str() );
         return nullptr;
     }
 
@@ -140,12 +448,159 @@ ResourceGeneric* ResourceManager::GetResource( const Filename& filename )
     SDL_assert( pResource != nullptr );
 
     mResources[ filename.GetFullPath() ] = pResource;
+    return pResource;
+}
+
+// Must be called with m_Mutex locked.
+void ResourceManager::SubmitPreloads()
+{
+    JobSystem* pJobSystem = FrameWork::GetJobSystem();
+    SDL_assert( pJobSystem != nullptr );
+
+    while ( m_PreloadQueue.empty() == false && m_PreloadsInFlight + m_UploadQueue.size() < sMaxQueuedUploads )
+    {
+        AsyncLoadSharedPtr pLoad = m_PreloadQueue.front();
+        m_PreloadQueue.pop_front();
+        pLoad->pResource->SetState( ResourceState::Preloading );
+        m_PreloadsInFlight++;
+
+        pJobSystem->Submit(
+            [ this, pLoad ]() {
+                pLoad->pResource->Preload();
+                {
+                    std::lock_guard<std::mutex> lock( m_Mutex );
+                    pLoad->pResource->SetState( ResourceState::Preloaded );
+                    m_UploadQueue.push_back( pLoad );
+                    m_PreloadsInFlight--;
+                }
+                m_StateChanged.notify_all();
+            } );
+    }
+}
+
+void ResourceManager::LoadResource( ResourceGeneric* pResource )
+{
+    {
+        std::lock_guard<std::mutex> lock( m_Mutex );
+        pResource->SetState( ResourceState::Loading );
+    }
 
-    pResource->Preload();
     pResource->Load();
 
-    SDL_assert( pResource->GetState() == ResourceState::Loaded );
-    return pResource;
+    {
+        std::lock_guard<std::mutex> lock( m_Mutex );
+        // Not every resource updates its state when it fails to load.
+        if ( pResource->GetState() == ResourceState::Loading )
+        {
+            pResource->SetState( ResourceState::Unloaded );
+        }
+    }
+    m_StateChanged.notify_all();
+}
+
+// Finishes loading a resource which is already known to the ResourceManager. If it is still waiting in one
+// of the asynchronous queues, it is taken out of it and the rest of the work happens on the calling thread.
+void ResourceManager::WaitForResource( ResourceGeneric* pResource )
+{
+    std::unique_lock<std::mutex> lock( m_Mutex );
+    m_StateChanged.wait( lock, [ this, pResource ]() {
+        const ResourceState state = pResource->GetState();
+        return state != ResourceState::Preloading && state != ResourceState::Loading && ( state != ResourceState::Loaded || IsReady( pResource ) );
+    } );
+
+    const ResourceState state = pResource->GetState();
+    if ( state != ResourceState::PreloadPending && state != ResourceState::Preloaded )
+    {
+        return;
+    }
+
+    AsyncLoadMap::iterator asyncLoadIter = m_AsyncLoads.find( pResource->GetFilename().GetFullPath() );
+    SDL_assert( asyncLoadIter != m_AsyncLoads.end() );
+    AsyncLoadQueue& queue = ( state == ResourceState::PreloadPending ) ? m_PreloadQueue : m_UploadQueue;
+    queue.erase( std::find( queue.begin(), queue.end(), asyncLoadIter->second ) );
+    pResource->SetState( ( state == ResourceState::PreloadPending ) ? ResourceState::Preloading : ResourceState::Loading );
+    lock.unlock();
+
+    if ( state == ResourceState::PreloadPending )
+    {
+        pResource->Preload();
+    }
+    LoadResource( pResource );
+
+    // The resource was loaded in this thread's context, so there is no fence to wait on.
+    CompleteAsyncLoad( pResource );
+}
+
+// Makes the resource's future ready, if it has one. Failed loads still hand out the resource, as GetResource() does.
+void ResourceManager::CompleteAsyncLoad( ResourceGeneric* pResource )
+{
+    AsyncLoadSharedPtr pLoad;
+    {
+        std::lock_guard<std::mutex> lock( m_Mutex );
+        AsyncLoadMap::iterator asyncLoadIter = m_AsyncLoads.find( pResource->GetFilename().GetFullPath() );
+        if ( asyncLoadIter == m_AsyncLoads.end() )
+        {
+            return;
+        }
+
+        pLoad = asyncLoadIter->second;
+        m_AsyncLoads.erase( asyncLoadIter );
+    }
+
+    pLoad->promise.set_value( pResource );
+}
+
+// Completes the batches of uploads which the GPU has finished with, optionally blocking until all of them are done.
+void ResourceManager::ResolveUploadBatches( bool wait )
+{
+    const GLuint64 timeout = wait ? 5000000000 : 0; // 5 second timeout
+    while ( m_UploadBatches.empty() == false )
+    {
+        UploadBatch& batch = m_UploadBatches.front();
+        const GLenum result = glClientWaitSync( batch.fence, 0, timeout );
+        if ( result == GL_WAIT_FAILED )
+        {
+            FrameWork::GetLogger()->LogError( "glClientWaitSync failed: GL_WAIT_FAILED." );
+        }
+        else if ( result == GL_TIMEOUT_EXPIRED )
+        {
+            if ( wait )
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        glDeleteSync( batch.fence );
+        {
+            std::lock_guard<std::mutex> lock( m_Mutex );
+            for ( auto& pLoad : batch.loads )
+            {
+                m_PendingUploads.erase( pLoad->pResource );
+            }
+        }
+        m_StateChanged.notify_all();
+
+        for ( auto& pLoad : batch.loads )
+        {
+            CompleteAsyncLoad( pLoad->pResource );
+        }
+        m_UploadBatches.pop_front();
+    }
+}
+
+// Must be called with m_Mutex locked.
+bool ResourceManager::IsReady( ResourceGeneric* pResource ) const
+{
+    if ( pResource->GetState() != ResourceState::Loaded )
+    {
+        return false;
+    }
+
+    return m_PendingUploads.find( pResource ) == m_PendingUploads.end() || std::this_thread::get_id() == m_UploadThreadId;
 }
 
 }
\ No newline at end of file
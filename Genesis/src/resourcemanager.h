@@ -18,12 +18,22 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <functional>
+#include <future>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
 
 #include "filename.h"
+#include "rendersystem.fwd.h"
+#include "resourcepack.h"
 #include "resources/resourcetypes.h"
 #include "SDL.h"
 
@@ -88,6 +98,7 @@ inline ResourceFactoryFunction ExtensionData::GetFactoryFunction() const { retur
 
 using ExtensionMap = std::unordered_map<std::string, ExtensionData*>;
 using ResourceMap = std::unordered_map<std::string, ResourceGeneric*>;
+using ResourceFuture = std::shared_future<ResourceGeneric*>;
 
 //////////////////////////////////////////////////////////////////////////////
 // ResourceManager
@@ -103,6 +114,7 @@ public:
     bool CanLoadResource( const Filename& filename );
 
     // Retrieves a resource. This is a blocking operation.
+    // If the resource is being loaded asynchronously, whatever work remains is done on the calling thread.
     ResourceGeneric* GetResource( const Filename& filename );
     template <typename T>
     T GetResource( const Filename& filename )
@@ -110,9 +122,69 @@ public:
         return static_cast<T>( GetResource( filename ) );
     }
 
+    // Queues a resource to be preloaded on the JobSystem. Its Load() only happens when the thread which owns
+    // the upload context calls ProcessUploads(), and the future becomes ready once the GPU has finished with it.
+    ResourceFuture GetResourceAsync( const Filename& filename );
+
+    // Loads up to maxUploads preloaded resources. Must be called from a thread with a GL context.
+    // Returns false once there are no asynchronous loads left in flight.
+    bool ProcessUploads( size_t maxUploads );
+
+    // Maps a pack written by CookPack(). From then on, anything in the pack is read from it rather than
+    // from its loose file. A pack which is older than any loose file it contains isn't mounted.
+    bool MountPack( const std::string& filename );
+    const ResourcePackEntry* FindPackEntry( const std::string& path ) const;
+
+    // Lists the files in a directory, including the ones in the pack if one has been mounted.
+    void ListFiles( const std::string& directory, bool recursive, std::vector<std::string>& paths ) const;
+
+    // Cooks the files in a directory into a pack. Images are decoded, models are expanded into the vertex and
+    // index data they are drawn with, and the other files read during loading are stored as they are.
+    bool CookPack( const std::string& directory, const std::string& packFilename );
+
 private:
+    struct AsyncLoad
+    {
+        ResourceGeneric* pResource;
+        std::promise<ResourceGeneric*> promise;
+        ResourceFuture future;
+    };
+
+    using AsyncLoadSharedPtr = std::shared_ptr<AsyncLoad>;
+    using AsyncLoadMap = std::unordered_map<std::string, AsyncLoadSharedPtr>;
+    using AsyncLoadQueue = std::deque<AsyncLoadSharedPtr>;
+    using AsyncLoadVector = std::vector<AsyncLoadSharedPtr>;
+
+    // Resources which have been loaded but can't be handed out until the GPU has processed the upload.
+    struct UploadBatch
+    {
+        GLsync fence;
+        AsyncLoadVector loads;
+    };
+
+    using UploadBatchQueue = std::deque<UploadBatch>;
+
+    ResourceGeneric* CreateResource( const Filename& filename );
+    void SubmitPreloads();
+    void LoadResource( ResourceGeneric* pResource );
+    void WaitForResource( ResourceGeneric* pResource );
+    void CompleteAsyncLoad( ResourceGeneric* pResource );
+    void ResolveUploadBatches( bool wait );
+    bool IsReady( ResourceGeneric* pResource ) const;
+
     ExtensionMap mRegisteredExtensions;
     ResourceMap mResources;
+    std::unique_ptr<ResourcePack> m_pPack;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_StateChanged;
+    AsyncLoadMap m_AsyncLoads;
+    AsyncLoadQueue m_PreloadQueue; // Waiting for a slot in the upload queue.
+    AsyncLoadQueue m_UploadQueue; // Preloaded, waiting for ProcessUploads().
+    UploadBatchQueue m_UploadBatches; // Only accessed by the thread calling ProcessUploads().
+    std::unordered_set<ResourceGeneric*> m_PendingUploads; // Loaded, but their batch's fence hasn't been signalled yet.
+    std::thread::id m_UploadThreadId;
+    size_t m_PreloadsInFlight;
 };
 
 }
@@ -0,0 +1,299 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Genesis.
+//
+// Genesis is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Genesis is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Genesis. If not, see <http://www.gnu.org/licenses/>.
+
+#include "resourcepack.h"
+
+#include <algorithm>
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "genesis.h"
+#include "logger.h"
+
+namespace Genesis
+{
+
+// Entries' data is aligned so the vertex, index and pixel data can be used straight from the mapping.
+static const size_t sResourcePackAlignment = 16;
+
+struct ResourcePackHeader
+{
+    char id[ 4 ]; // "GPAK"
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+    uint64_t indexOffset;
+};
+
+// The index is at the end of the pack. Each entry is followed by its path, without a terminator.
+struct ResourcePackIndexEntry
+{
+    uint64_t offset;
+    uint64_t size;
+    uint32_t type;
+    uint32_t pathLength;
+};
+
+//-------------------------------------------------------------------
+// ResourcePack
+//-------------------------------------------------------------------
+
+ResourcePack::ResourcePack()
+    : m_pData( nullptr )
+    , m_Size( 0 )
+#ifdef _WIN32
+    , m_FileHandle( INVALID_HANDLE_VALUE )
+    , m_MappingHandle( nullptr )
+#else
+    , m_FileDescriptor( -1 )
+#endif
+{
+}
+
+ResourcePack::~ResourcePack()
+{
+    Close();
+}
+
+bool ResourcePack::Open( const std::string& filename )
+{
+    Close();
+
+#ifdef _WIN32
+    m_FileHandle = CreateFileA( filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+    if ( m_FileHandle == INVALID_HANDLE_VALUE )
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx( m_FileHandle, &fileSize );
+    m_Size = static_cast<size_t>( fileSize.QuadPart );
+    m_MappingHandle = CreateFileMappingA( m_FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr );
+    if ( m_MappingHandle != nullptr )
+    {
+        m_pData = reinterpret_cast<const uint8_t*>( MapViewOfFile( m_MappingHandle, FILE_MAP_READ, 0, 0, 0 ) );
+    }
+#else
+    m_FileDescriptor = open( filename.c_str(), O_RDONLY );
+    if ( m_FileDescriptor == -1 )
+    {
+        return false;
+    }
+
+    struct stat fileStat;
+    if ( fstat( m_FileDescriptor, &fileStat ) == 0 && fileStat.st_size > 0 )
+    {
+        m_Size = static_cast<size_t>( fileStat.st_size );
+        void* pMapping = mmap( nullptr, m_Size, PROT_READ, MAP_PRIVATE, m_FileDescriptor, 0 );
+        m_pData = ( pMapping == MAP_FAILED ) ? nullptr : reinterpret_cast<const uint8_t*>( pMapping );
+    }
+#endif
+
+    Logger* pLogger = FrameWork::GetLogger();
+    if ( m_pData == nullptr )
+    {
+        pLogger->LogWarning( "Couldn't map resource pack '%s'.", filename.c_str() );
+        Close();
+        return false;
+    }
+
+    ResourcePackHeader header;
+    if ( m_Size < sizeof( ResourcePackHeader ) )
+    {
+        pLogger->LogWarning( "Resource pack '%s' is truncated.", filename.c_str() );
+        Close();
+        return false;
+    }
+
+    memcpy( &header, m_pData, sizeof( ResourcePackHeader ) );
+    if ( memcmp( header.id, "GPAK", 4 ) != 0 || header.version != ResourcePackVersion )
+    {
+        pLogger->LogWarning( "Resource pack '%s' isn't a version %u pack.", filename.c_str(), ResourcePackVersion );
+        Close();
+        return false;
+    }
+
+    const uint8_t* pCursor = m_pData + header.indexOffset;
+    const uint8_t* pEnd = m_pData + m_Size;
+    m_Entries.reserve( header.entryCount );
+    for ( uint32_t i = 0; i < header.entryCount; ++i )
+    {
+        ResourcePackIndexEntry indexEntry;
+        if ( pCursor + sizeof( ResourcePackIndexEntry ) > pEnd )
+        {
+            break;
+        }
+
+        ResourcePackRead( pCursor, indexEntry );
+        if ( pCursor + indexEntry.pathLength > pEnd || indexEntry.offset + indexEntry.size > m_Size )
+        {
+            break;
+        }
+
+        std::string path( reinterpret_cast<const char*>( pCursor ), indexEntry.pathLength );
+        pCursor += indexEntry.pathLength;
+
+        ResourcePackEntry entry;
+        entry.type = static_cast<ResourcePackEntryType>( indexEntry.type );
+        entry.pData = m_pData + indexEntry.offset;
+        entry.size = static_cast<size_t>( indexEntry.size );
+        m_Entries[ path ] = entry;
+    }
+
+    if ( m_Entries.size() != header.entryCount )
+    {
+        pLogger->LogWarning( "Resource pack '%s' has a corrupted index.", filename.c_str() );
+        Close();
+        return false;
+    }
+
+    pLogger->LogInfo( "Mapped resource pack '%s': %u entries, %zu bytes.", filename.c_str(), header.entryCount, m_Size );
+    return true;
+}
+
+void ResourcePack::Close()
+{
+    m_Entries.clear();
+
+#ifdef _WIN32
+    if ( m_pData != nullptr )
+    {
+        UnmapViewOfFile( m_pData );
+    }
+    if ( m_MappingHandle != nullptr )
+    {
+        CloseHandle( m_MappingHandle );
+        m_MappingHandle = nullptr;
+    }
+    if ( m_FileHandle != INVALID_HANDLE_VALUE )
+    {
+        CloseHandle( m_FileHandle );
+        m_FileHandle = INVALID_HANDLE_VALUE;
+    }
+#else
+    if ( m_pData != nullptr )
+    {
+        munmap( const_cast<uint8_t*>( m_pData ), m_Size );
+    }
+    if ( m_FileDescriptor != -1 )
+    {
+        close( m_FileDescriptor );
+        m_FileDescriptor = -1;
+    }
+#endif
+
+    m_pData = nullptr;
+    m_Size = 0;
+}
+
+const ResourcePackEntry* ResourcePack::Find( const std::string& path ) const
+{
+    ResourcePackEntryMap::const_iterator it = m_Entries.find( NormalisePath( path ) );
+    return ( it == m_Entries.cend() ) ? nullptr : &it->second;
+}
+
+void ResourcePack::List( const std::string& directory, bool recursive, std::vector<std::string>& paths ) const
+{
+    std::string prefix = NormalisePath( directory );
+    if ( prefix.empty() == false && prefix.back() != '/' )
+    {
+        prefix += '/';
+    }
+
+    for ( const auto& entryPair : m_Entries )
+    {
+        const std::string& path = entryPair.first;
+        if ( path.compare( 0, prefix.size(), prefix ) == 0 && ( recursive || path.find( '/', prefix.size() ) == std::string::npos ) )
+        {
+            paths.push_back( path );
+        }
+    }
+
+    // Directory iteration order isn't guaranteed either, but a stable order makes the loading deterministic.
+    std::sort( paths.begin(), paths.end() );
+}
+
+std::string ResourcePack::NormalisePath( const std::string& path )
+{
+    std::string normalisedPath( path );
+    std::replace( normalisedPath.begin(), normalisedPath.end(), '\\', '/' );
+    return normalisedPath;
+}
+
+//-------------------------------------------------------------------
+// ResourcePackWriter
+//-------------------------------------------------------------------
+
+void ResourcePackWriter::Add( const std::string& path, ResourcePackEntryType type, std::vector<uint8_t>&& data )
+{
+    m_Entries.push_back( { ResourcePack::NormalisePath( path ), type, std::move( data ) } );
+}
+
+bool ResourcePackWriter::Write( const std::string& filename ) const
+{
+    std::ofstream file( filename, std::ios::out | std::ios::binary | std::ios::trunc );
+    if ( file.good() == false )
+    {
+        FrameWork::GetLogger()->LogWarning( "Couldn't open '%s' for writing.", filename.c_str() );
+        return false;
+    }
+
+    static const char padding[ sResourcePackAlignment ] = {};
+    uint64_t offset = sizeof( ResourcePackHeader );
+    file.seekp( offset );
+
+    std::vector<ResourcePackIndexEntry> indexEntries;
+    indexEntries.reserve( m_Entries.size() );
+    for ( const PendingEntry& entry : m_Entries )
+    {
+        const uint64_t paddingSize = ( sResourcePackAlignment - offset % sResourcePackAlignment ) % sResourcePackAlignment;
+        file.write( padding, static_cast<std::streamsize>( paddingSize ) );
+        offset += paddingSize;
+
+        indexEntries.push_back( { offset, entry.data.size(), static_cast<uint32_t>( entry.type ), static_cast<uint32_t>( entry.path.size() ) } );
+        file.write( reinterpret_cast<const char*>( entry.data.data() ), static_cast<std::streamsize>( entry.data.size() ) );
+        offset += entry.data.size();
+    }
+
+    ResourcePackHeader header;
+    memcpy( header.id, "GPAK", 4 );
+    header.version = ResourcePackVersion;
+    header.entryCount = static_cast<uint32_t>( m_Entries.size() );
+    header.reserved = 0;
+    header.indexOffset = offset;
+
+    for ( size_t i = 0; i < m_Entries.size(); ++i )
+    {
+        file.write( reinterpret_cast<const char*>( &indexEntries[ i ] ), sizeof( ResourcePackIndexEntry ) );
+        file.write( m_Entries[ i ].path.data(), static_cast<std::streamsize>( m_Entries[ i ].path.size() ) );
+    }
+
+    file.seekp( 0 );
+    file.write( reinterpret_cast<const char*>( &header ), sizeof( ResourcePackHeader ) );
+    return file.good();
+}
+
+} // namespace Genesis
@@ -0,0 +1,141 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Genesis.
+//
+// Genesis is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Genesis is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Genesis. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Genesis
+{
+
+static const uint32_t ResourcePackVersion = 1;
+
+enum class ResourcePackEntryType : uint32_t
+{
+    File, // Copied as-is from the loose file.
+    Image, // ResourcePackImageHeader followed by the pixels, ready for glTexImage2D().
+    Model // Dummies and objects with their vertex and index data, as built by TMFObject.
+};
+
+struct ResourcePackImageHeader
+{
+    uint32_t width;
+    uint32_t height;
+    uint32_t internalFormat;
+    uint32_t format;
+};
+
+struct ResourcePackEntry
+{
+    ResourcePackEntryType type;
+    const uint8_t* pData; // Points into the mapped pack, so it is valid for as long as the pack is open.
+    size_t size;
+};
+
+using ResourcePackEntryMap = std::unordered_map<std::string, ResourcePackEntry>;
+
+///////////////////////////////////////////////////////////////////////////////
+// ResourcePack
+// A single file containing the cooked contents of the data folder, indexed
+// by the path each file had. The file is memory mapped, so resources can
+// read their data from it without any copies or further disk I/O.
+// Paths always use forward slashes, e.g. "data/ui/cursor.png".
+///////////////////////////////////////////////////////////////////////////////
+
+class ResourcePack
+{
+public:
+    ResourcePack();
+    ~ResourcePack();
+
+    bool Open( const std::string& filename );
+    const ResourcePackEntry* Find( const std::string& path ) const;
+
+    // Lists the paths of the entries inside a directory, e.g. "data/xml/modules".
+    void List( const std::string& directory, bool recursive, std::vector<std::string>& paths ) const;
+    const ResourcePackEntryMap& GetEntries() const;
+
+    static std::string NormalisePath( const std::string& path );
+
+private:
+    void Close();
+
+    const uint8_t* m_pData;
+    size_t m_Size;
+#ifdef _WIN32
+    void* m_FileHandle;
+    void* m_MappingHandle;
+#else
+    int m_FileDescriptor;
+#endif
+    ResourcePackEntryMap m_Entries;
+};
+
+inline const ResourcePackEntryMap& ResourcePack::GetEntries() const
+{
+    return m_Entries;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// ResourcePackWriter
+// Collects cooked entries and writes them out as a pack.
+///////////////////////////////////////////////////////////////////////////////
+
+class ResourcePackWriter
+{
+public:
+    void Add( const std::string& path, ResourcePackEntryType type, std::vector<uint8_t>&& data );
+    bool Write( const std::string& filename ) const;
+
+private:
+    struct PendingEntry
+    {
+        std::string path;
+        ResourcePackEntryType type;
+        std::vector<uint8_t> data;
+    };
+
+    std::vector<PendingEntry> m_Entries;
+};
+
+// Appends the raw bytes of a value to a cooked entry.
+template <typename T>
+void ResourcePackWrite( std::vector<uint8_t>& data, const T& value )
+{
+    const uint8_t* pBytes = reinterpret_cast<const uint8_t*>( &value );
+    data.insert( data.end(), pBytes, pBytes + sizeof( T ) );
+}
+
+inline void ResourcePackWrite( std::vector<uint8_t>& data, const void* pSource, size_t size )
+{
+    const uint8_t* pBytes = reinterpret_cast<const uint8_t*>( pSource );
+    data.insert( data.end(), pBytes, pBytes + size );
+}
+
+// Reads a value from a cooked entry, moving the cursor past it.
+template <typename T>
+void ResourcePackRead( const uint8_t*& pCursor, T& value )
+{
+    memcpy( &value, pCursor, sizeof( T ) );
+    pCursor += sizeof( T );
+}
+
+} // namespace Genesis
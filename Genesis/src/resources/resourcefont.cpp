@@ -2,8 +2,10 @@
 #include "../genesis.h"
 #include "../logger.h"
 #include "../rendersystem.h"
-#include "../vertexbuffer.h"
+#include "../streamingvertexbuffer.h"
 #include "resourceimage.h"
+
+#include <glm/common.hpp>
 #include "rendersystem.fwd.h"
 
 #include "beginexternalheaders.h"
@@ -49,7 +51,9 @@ bool ResourceFont::LoadFontFile( const std::string& filename )
 {
     tinyxml2::XMLDocument doc;
 
-    if ( doc.LoadFile( filename.c_str() ) == tinyxml2::XML_SUCCESS )
+    const ResourcePackEntry* pEntry = FrameWork::GetResourceManager()->FindPackEntry( filename );
+    const tinyxml2::XMLError result = ( pEntry != nullptr ) ? doc.Parse( reinterpret_cast<const char*>( pEntry->pData ), pEntry->size ) : doc.LoadFile( filename.c_str() );
+    if ( result == tinyxml2::XML_SUCCESS )
     {
         tinyxml2::XMLElement* elemConfiguration = doc.FirstChildElement();
         for ( tinyxml2::XMLElement* elemEntry = elemConfiguration->FirstChildElement(); elemEntry; elemEntry = elemEntry->NextSiblingElement() )
@@ -125,18 +129,18 @@ void ResourceFont::BuildLists()
     }
 }
 
-unsigned int ResourceFont::PopulateVertexBuffer( VertexBuffer& vertexBuffer, float x, float y, const std::string& text, float lineSpacing )
+unsigned int ResourceFont::PopulateVertices( std::vector<StreamingVertex>& vertices, float x, float y, const std::string& text, float lineSpacing, const glm::vec4& color ) const
 {
     if ( text.empty() )
     {
         return 0;
     }
 
+    // Every character can produce at most one quad, so this is enough to hold the whole string.
     const int textLength = static_cast<int>(text.length());
-    PositionData positionData;
-    UVData uvData;
-    positionData.reserve( textLength * 6 );
-    uvData.reserve( textLength * 6 );
+    const size_t firstVertex = vertices.size();
+    vertices.resize( firstVertex + textLength * 6 );
+    StreamingVertex* pVertices = vertices.data() + firstVertex;
 
     float xtranslate = x;
     float ytranslate = y;
@@ -158,27 +162,70 @@ unsigned int ResourceFont::PopulateVertexBuffer( VertexBuffer& vertexBuffer, flo
         const FontCharRenderData& renderData = mCharRenderDataArray[ fontCharPos ];
 
         const glm::vec3 vtranslate( xtranslate, ytranslate, 0.0f );
-        positionData.push_back( renderData.position[ 0 ] + vtranslate );
-        positionData.push_back( renderData.position[ 1 ] + vtranslate );
-        positionData.push_back( renderData.position[ 2 ] + vtranslate );
-        positionData.push_back( renderData.position[ 0 ] + vtranslate );
-        positionData.push_back( renderData.position[ 2 ] + vtranslate );
-        positionData.push_back( renderData.position[ 3 ] + vtranslate );
-           
-        uvData.push_back( renderData.uv[ 0 ] );
-        uvData.push_back( renderData.uv[ 1 ] );
-        uvData.push_back( renderData.uv[ 2 ] );
-        uvData.push_back( renderData.uv[ 0 ] );
-        uvData.push_back( renderData.uv[ 2 ] );
-        uvData.push_back( renderData.uv[ 3 ] );
+        static const int sQuadIndices[ 6 ] = { 0, 1, 2, 0, 2, 3 };
+        for ( int j = 0; j < 6; ++j )
+        {
+            StreamingVertex& vertex = pVertices[ vertexCount + j ];
+            vertex.position = renderData.position[ sQuadIndices[ j ] ] + vtranslate;
+            vertex.uv = renderData.uv[ sQuadIndices[ j ] ];
+            vertex.color = color;
+        }
 
         vertexCount += 6;
 
         xtranslate += mCharList[ fontCharPos ]->xadvance;
     }
 
-    vertexBuffer.CopyPositions( positionData );
-    vertexBuffer.CopyUVs( uvData );
+    vertices.resize( firstVertex + vertexCount );
     return vertexCount;
 }
+
+GlyphRunSharedPtr ResourceFont::GetGlyphRun( const std::string& text, float lineSpacing )
+{
+    GlyphRunKey key{ text, lineSpacing };
+    auto it = mGlyphRuns.find( key );
+    if ( it != mGlyphRuns.end() )
+    {
+        return it->second;
+    }
+
+    GlyphRunSharedPtr pGlyphRun = std::make_shared<GlyphRun>();
+    pGlyphRun->boundsMin = glm::vec2( 0.0f, 0.0f );
+    pGlyphRun->boundsMax = glm::vec2( 0.0f, 0.0f );
+    if ( PopulateVertices( pGlyphRun->vertices, 0.0f, 0.0f, text, lineSpacing, glm::vec4( 1.0f ) ) > 0 )
+    {
+        pGlyphRun->boundsMin = glm::vec2( pGlyphRun->vertices[ 0 ].position );
+        pGlyphRun->boundsMax = pGlyphRun->boundsMin;
+        for ( const StreamingVertex& vertex : pGlyphRun->vertices )
+        {
+            pGlyphRun->boundsMin = glm::min( pGlyphRun->boundsMin, glm::vec2( vertex.position ) );
+            pGlyphRun->boundsMax = glm::max( pGlyphRun->boundsMax, glm::vec2( vertex.position ) );
+        }
+    }
+
+    if ( mGlyphRuns.size() >= sGlyphRunCacheMaxEntries )
+    {
+        EvictGlyphRuns();
+    }
+
+    mGlyphRuns.emplace( std::move( key ), pGlyphRun );
+    return pGlyphRun;
+}
+
+// Drops every run which is only referenced by the cache itself. Runs still in use by
+// a text element are kept, so the cache can temporarily grow past its budget.
+void ResourceFont::EvictGlyphRuns()
+{
+    for ( auto it = mGlyphRuns.begin(); it != mGlyphRuns.end(); )
+    {
+        if ( it->second.use_count() == 1 )
+        {
+            it = mGlyphRuns.erase( it );
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
 }
\ No newline at end of file
@@ -17,18 +17,37 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include "coredefines.h"
 #include "resourcemanager.h"
 #include "rendersystem.fwd.h"
+#include "streamingvertexbuffer.h"
 
 namespace Genesis
 {
 class ResourceImage;
-class VertexBuffer;
+
+// Upper bound for the number of glyph runs each font keeps around. Runs which are no longer
+// referenced by anything are evicted once the cache grows past this.
+static const size_t sGlyphRunCacheMaxEntries = 512;
+
+// The quads for a string laid out at the origin with a white colour, shared by every
+// user displaying the same string with the same font and line spacing.
+class GlyphRun
+{
+public:
+    std::vector<StreamingVertex> vertices;
+    glm::vec2 boundsMin;
+    glm::vec2 boundsMax;
+};
+GENESIS_DECLARE_SMART_PTR( GlyphRun );
 
 class ResourceFont : public ResourceGeneric
 {
@@ -38,7 +57,10 @@ public:
     virtual ResourceType GetType() const override;
     virtual bool Load() override;
 
-    unsigned int PopulateVertexBuffer( VertexBuffer& vertexBuffer, float x, float y, const std::string& text, float lineSpacing );
+    // Appends the text's quads to the vertices, returning the number of vertices which were added.
+    unsigned int PopulateVertices( std::vector<StreamingVertex>& vertices, float x, float y, const std::string& text, float lineSpacing, const glm::vec4& color ) const;
+    // Returns the cached layout for the text, building it if necessary.
+    GlyphRunSharedPtr GetGlyphRun( const std::string& text, float lineSpacing );
     ResourceImage* GetPage() const;
     float GetTextLength( const std::string& text ) const;
     float GetLineHeight() const;
@@ -46,6 +68,7 @@ public:
 private:
     bool LoadFontFile( const std::string& filename );
     void BuildLists();
+    void EvictGlyphRuns();
 
     struct FontChar
     {
@@ -64,12 +87,28 @@ private:
         glm::vec2 uv[ 4 ];
     };
 
+    // Each font file has a single size, so the font itself is implied by which cache a run lives in.
+    struct GlyphRunKey
+    {
+        std::string text;
+        float lineSpacing;
+
+        bool operator==( const GlyphRunKey& other ) const { return lineSpacing == other.lineSpacing && text == other.text; }
+    };
+
+    struct GlyphRunKeyHash
+    {
+        size_t operator()( const GlyphRunKey& key ) const { return std::hash<std::string>()( key.text ) ^ ( std::hash<float>()( key.lineSpacing ) << 1 ); }
+    };
+
     typedef std::vector<FontChar*> FontCharList;
     typedef std::vector<FontCharRenderData> FontCharRenderDataArray;
     FontCharList mCharList;
     FontCharRenderDataArray mCharRenderDataArray;
     float mLineHeight;
     ResourceImage* mPage;
+
+    std::unordered_map<GlyphRunKey, GlyphRunSharedPtr, GlyphRunKeyHash> mGlyphRuns;
 };
 
 inline float ResourceFont::GetTextLength( const std::string& text ) const
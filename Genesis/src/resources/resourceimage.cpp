@@ -32,55 +32,84 @@ ResourceImage::ResourceImage( const Filename& filename )
     , m_Height( 0u )
     , m_MipMapped( true )
     , m_pTemporarySurface( nullptr )
+    , m_pPackEntry( nullptr )
 {
 }
 
 void ResourceImage::Preload()
 {
     SDL_assert( m_pTemporarySurface == nullptr );
-    m_pTemporarySurface = CreateSurface( GetFilename().GetFullPath() );
+
+    // Cooked images are already decoded, so there is nothing to do until the upload.
+    m_pPackEntry = FrameWork::GetResourceManager()->FindPackEntry( GetFilename().GetFullPath() );
+    if ( m_pPackEntry == nullptr || m_pPackEntry->type != ResourcePackEntryType::Image )
+    {
+        m_pPackEntry = nullptr;
+        m_pTemporarySurface = CreateSurface( GetFilename().GetFullPath() );
+    }
 }
 
 bool ResourceImage::Load()
 {
-    if ( m_pTemporarySurface == nullptr )
+    if ( m_pPackEntry != nullptr )
+    {
+        ResourcePackImageHeader header;
+        const uint8_t* pCursor = m_pPackEntry->pData;
+        ResourcePackRead( pCursor, header );
+        CreateTexture( header.internalFormat, header.format, header.width, header.height, pCursor );
+        m_pPackEntry = nullptr;
+
+        m_State = ResourceState::Loaded;
+        return true;
+    }
+    else if ( m_pTemporarySurface == nullptr )
     {
         m_State = ResourceState::Unloaded;
         return false;
     }
     else
     {
-        const std::string& extension = GetFilename().GetExtension();
-        if ( extension == "jpg" )
-        {
-            CreateTexture( GL_RGB, GL_RGB );
-        }
-        else if ( extension == "png" )
-        {
-            GLenum format = ( m_pTemporarySurface->format->BitsPerPixel == 24 ) ? GL_RGB : GL_RGBA;
-            CreateTexture( format, format );
-        }
-        else if ( extension == "tga" )
-        {
-            CreateTexture( GL_RGBA, GL_BGRA );
-        }
-        else if ( extension == "bmp" )
+        uint32_t internalFormat = 0;
+        uint32_t format = 0;
+        const bool hasFormat = GetTextureFormat( GetFilename(), m_pTemporarySurface, internalFormat, format );
+        if ( hasFormat )
         {
-            CreateTexture( GL_RGB, GL_BGR );
-        }
-        else
-        {
-            Genesis::FrameWork::GetLogger()->LogError( "Don't know how to create texture for extension '%s'", extension.c_str() );
-            SDL_FreeSurface( m_pTemporarySurface );
-            m_State = ResourceState::Unloaded;
-            return false;
+            CreateTexture( internalFormat, format, m_pTemporarySurface->w, m_pTemporarySurface->h, m_pTemporarySurface->pixels );
         }
 
-        m_State = ResourceState::Loaded;
-        return true;
+        SDL_FreeSurface( m_pTemporarySurface );
+        m_pTemporarySurface = nullptr;
+
+        m_State = hasFormat ? ResourceState::Loaded : ResourceState::Unloaded;
+        return hasFormat;
     }
 }
 
+bool ResourceImage::Cook( const Filename& filename, std::vector<uint8_t>& data )
+{
+    SDL_Surface* pSurface = CreateSurface( filename.GetFullPath() );
+    if ( pSurface == nullptr )
+    {
+        return false;
+    }
+
+    ResourcePackImageHeader header;
+    const bool hasFormat = GetTextureFormat( filename, pSurface, header.internalFormat, header.format );
+    if ( hasFormat )
+    {
+        // The rows keep the surface's pitch, which matches OpenGL's default unpack alignment.
+        header.width = static_cast<uint32_t>( pSurface->w );
+        header.height = static_cast<uint32_t>( pSurface->h );
+        const size_t pixelsSize = static_cast<size_t>( pSurface->pitch ) * static_cast<size_t>( pSurface->h );
+        data.reserve( sizeof( ResourcePackImageHeader ) + pixelsSize );
+        ResourcePackWrite( data, header );
+        ResourcePackWrite( data, pSurface->pixels, pixelsSize );
+    }
+
+    SDL_FreeSurface( pSurface );
+    return hasFormat;
+}
+
 SDL_Surface* ResourceImage::CreateSurface( const std::string& filename )
 {
     SDL_Surface* image = IMG_Load( filename.c_str() );
@@ -92,27 +121,67 @@ SDL_Surface* ResourceImage::CreateSurface( const std::string& filename )
     return image;
 }
 
-void ResourceImage::CreateTexture( uint32_t internalFormat, uint32_t format )
+bool ResourceImage::GetTextureFormat( const Filename& filename, const SDL_Surface* pSurface, uint32_t& internalFormat, uint32_t& format )
+{
+    const std::string& extension = filename.GetExtension();
+    if ( extension == "jpg" )
+    {
+        internalFormat = format = GL_RGB;
+    }
+    else if ( extension == "png" )
+    {
+        internalFormat = format = ( pSurface->format->BitsPerPixel == 24 ) ? GL_RGB : GL_RGBA;
+    }
+    else if ( extension == "tga" )
+    {
+        internalFormat = GL_RGBA;
+        format = GL_BGRA;
+    }
+    else if ( extension == "bmp" )
+    {
+        internalFormat = GL_RGB;
+        format = GL_BGR;
+    }
+    else
+    {
+        Genesis::FrameWork::GetLogger()->LogError( "Don't know how to create texture for extension '%s'", extension.c_str() );
+        return false;
+    }
+
+    return true;
+}
+
+void ResourceImage::CreateTexture( uint32_t internalFormat, uint32_t format, uint32_t width, uint32_t height, const void* pPixels )
 {
-    SDL_assert( m_pTemporarySurface != nullptr );
+    SDL_assert( pPixels != nullptr );
+
+    m_Width = width;
+    m_Height = height;
+
+    // Headless runs only need the image's dimensions.
+    if ( FrameWork::IsHeadless() )
+    {
+        return;
+    }
 
     GLuint texture;
     glGenTextures( 1, &texture );
     glBindTexture( GL_TEXTURE_2D, texture );
-    glTexImage2D( GL_TEXTURE_2D, 0, internalFormat, m_pTemporarySurface->w, m_pTemporarySurface->h, 0, format, GL_UNSIGNED_BYTE, m_pTemporarySurface->pixels );
+    glTexImage2D( GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, pPixels );
     glGenerateMipmap( GL_TEXTURE_2D );
     glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR );
     glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
 
-    m_Width = m_pTemporarySurface->w;
-    m_Height = m_pTemporarySurface->h;
     m_TextureSlot = texture;
-
-    SDL_FreeSurface( m_pTemporarySurface );
 }
 
 void ResourceImage::EnableMipMapping( bool state )
 {
+    if ( GetTexture() == 0 )
+    {
+        return;
+    }
+
     glBindTexture( GL_TEXTURE_2D, GetTexture() );
 
     if ( state )
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "../resourcemanager.h"
 #include "SDL.h"
 
@@ -39,14 +41,19 @@ public:
     bool IsMipMapped() const;
     void EnableMipMapping( bool state );
 
+    // Decodes the image into a ResourcePackImageHeader followed by its pixels.
+    static bool Cook( const Filename& filename, std::vector<uint8_t>& data );
+
 private:
-    SDL_Surface* CreateSurface( const std::string& filename );
-    void CreateTexture( uint32_t internalFormat, uint32_t format );
+    static SDL_Surface* CreateSurface( const std::string& filename );
+    static bool GetTextureFormat( const Filename& filename, const SDL_Surface* pSurface, uint32_t& internalFormat, uint32_t& format );
+    void CreateTexture( uint32_t internalFormat, uint32_t format, uint32_t width, uint32_t height, const void* pPixels );
     uint32_t m_Width;
     uint32_t m_Height;
     uint32_t m_TextureSlot;
     bool m_MipMapped;
     SDL_Surface* m_pTemporarySurface; // Set during the async preload
+    const ResourcePackEntry* m_pPackEntry; // Set during the async preload if the image has been cooked
 };
 
 inline ResourceType ResourceImage::GetType() const { return ResourceType::Texture; }
@@ -20,6 +20,7 @@
 #include <iostream>
 #include <sstream>
 #include <stdio.h>
+#include <unordered_map>
 
 #include "resourcemodel.h"
 #include "../genesis.h"
@@ -35,10 +36,43 @@ namespace Genesis
 // TMFObject
 ///////////////////////////////////////////////////////
 
+static const unsigned int sTMFVertexFlags = VBO_POSITION | VBO_UV | VBO_NORMAL | VB_INTERLEAVED;
+static const size_t sTMFVertexFloats = 3 + 2 + 3;
+
+// A triangle corner in the TMF file. Corners which match exactly can share a vertex.
+struct TMFCorner
+{
+    uint32_t vertex;
+    uint32_t uv;
+    glm::vec3 normal;
+
+    bool operator==( const TMFCorner& other ) const
+    {
+        return vertex == other.vertex && uv == other.uv && normal == other.normal;
+    }
+};
+
+struct TMFCornerHash
+{
+    size_t operator()( const TMFCorner& corner ) const
+    {
+        size_t hash = std::hash<uint32_t>()( corner.vertex );
+        hash = hash * 31 + std::hash<uint32_t>()( corner.uv );
+        hash = hash * 31 + std::hash<float>()( corner.normal.x );
+        hash = hash * 31 + std::hash<float>()( corner.normal.y );
+        hash = hash * 31 + std::hash<float>()( corner.normal.z );
+        return hash;
+    }
+};
+
 TMFObject::TMFObject()
     : m_NumVertices( 0 )
     , m_NumUVs( 0 )
     , m_NumTriangles( 0 )
+    , m_pPackedVertices( nullptr )
+    , m_pPackedIndices( nullptr )
+    , m_PackedVertexCount( 0 )
+    , m_PackedIndexCount( 0 )
     , m_pVertexBuffer( nullptr )
     , m_MaterialIndex( 0u )
 {
@@ -52,18 +86,66 @@ TMFObject::~TMFObject()
 // Preload is not called on the main thread, so it can't operate on OpenGL directly.
 // We can load the TMFObject prepare the data for the vertex buffer, but the actual
 // create of the VB / copy can only happen in Load().
-void TMFObject::Preload( FILE* fp )
+bool TMFObject::Preload( FILE* fp, uint16_t version )
+{
+    if ( version == MODEL_VERSION_INDEXED )
+    {
+        return SerialiseIndexed( fp );
+    }
+    else if ( Serialise( fp ) )
+    {
+        BuildVertexBufferData();
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+void TMFObject::Preload( const uint8_t*& pCursor )
 {
-    Serialise( fp );
-    BuildVertexBufferData();
+    ResourcePackRead( pCursor, m_MaterialIndex );
+    ResourcePackRead( pCursor, m_PackedVertexCount );
+    ResourcePackRead( pCursor, m_PackedIndexCount );
+    m_pPackedVertices = reinterpret_cast<const float*>( pCursor );
+    pCursor += m_PackedVertexCount * sTMFVertexFloats * sizeof( float );
+    m_pPackedIndices = reinterpret_cast<const uint32_t*>( pCursor );
+    pCursor += m_PackedIndexCount * sizeof( uint32_t );
 }
 
 void TMFObject::Load()
 {
-    m_pVertexBuffer = new VertexBuffer( GeometryType::Triangle, VBO_POSITION | VBO_UV | VBO_NORMAL );
-    m_pVertexBuffer->CopyPositions( m_VertexBufferPosData );
-    m_pVertexBuffer->CopyNormals( m_VertexBufferNormalData );
-    m_pVertexBuffer->CopyUVs( m_VertexBufferUvData );
+    m_pVertexBuffer = new VertexBuffer( GeometryType::Triangle, sTMFVertexFlags );
+    if ( m_pPackedVertices != nullptr )
+    {
+        m_pVertexBuffer->CopyVertices( m_pPackedVertices, m_PackedVertexCount );
+        m_pVertexBuffer->CopyIndices( m_pPackedIndices, m_PackedIndexCount );
+        return;
+    }
+
+    m_pVertexBuffer->CopyVertices( m_VertexBufferData.data(), m_VertexBufferData.size() / sTMFVertexFloats );
+    m_pVertexBuffer->CopyIndices( m_IndexData );
+
+    // Everything has been uploaded, so the serialisation data is no longer needed.
+    VertexList().swap( m_VertexList );
+    UVList().swap( m_UvList );
+    TriangleList().swap( m_TriangleList );
+    std::vector<float>().swap( m_VertexBufferData );
+    IndexData().swap( m_IndexData );
+}
+
+// Must be called after Preload(), while the vertex buffer data is still around.
+void TMFObject::Cook( std::vector<uint8_t>& data ) const
+{
+    const uint32_t materialIndex = m_MaterialIndex;
+    const uint32_t vertexCount = static_cast<uint32_t>( m_VertexBufferData.size() / sTMFVertexFloats );
+    const uint32_t indexCount = static_cast<uint32_t>( m_IndexData.size() );
+    ResourcePackWrite( data, materialIndex );
+    ResourcePackWrite( data, vertexCount );
+    ResourcePackWrite( data, indexCount );
+    ResourcePackWrite( data, m_VertexBufferData.data(), m_VertexBufferData.size() * sizeof( float ) );
+    ResourcePackWrite( data, m_IndexData.data(), m_IndexData.size() * sizeof( uint32_t ) );
 }
 
 bool TMFObject::Serialise( FILE* fp )
@@ -119,26 +201,76 @@ bool TMFObject::Serialise( FILE* fp )
     return true;
 }
 
-void TMFObject::BuildVertexBufferData()
+// Indexed objects have a header followed by the interleaved vertices and the indices, which are read
+// straight into the buffers Load() uploads. The UVs have already been flipped by the exporter.
+bool TMFObject::SerialiseIndexed( FILE* fp )
 {
-    const unsigned int numVertices = m_NumTriangles * 3;
-    m_VertexBufferPosData.reserve( numVertices );
-    m_VertexBufferNormalData.reserve( numVertices );
-    m_VertexBufferUvData.reserve( numVertices );
+    uint32_t materialIndex = 0;
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+    if ( fread( &materialIndex, sizeof( uint32_t ), 1, fp ) != 1 || fread( &vertexCount, sizeof( uint32_t ), 1, fp ) != 1 || fread( &indexCount, sizeof( uint32_t ), 1, fp ) != 1 )
+    {
+        return false;
+    }
 
-    for ( Uint32 i = 0; i < m_NumTriangles; i++ )
+    // A corrupt header could otherwise ask for gigabytes of vertices which the file doesn't contain.
+    const long dataStart = ftell( fp );
+    fseek( fp, 0, SEEK_END );
+    const long fileEnd = ftell( fp );
+    fseek( fp, dataStart, SEEK_SET );
+    const uint64_t dataSize = static_cast<uint64_t>( vertexCount ) * sTMFVertexFloats * sizeof( float ) + static_cast<uint64_t>( indexCount ) * sizeof( uint32_t );
+    if ( dataStart < 0 || fileEnd < dataStart || dataSize > static_cast<uint64_t>( fileEnd - dataStart ) )
     {
-        m_VertexBufferPosData.push_back( m_VertexList[ m_TriangleList[ i ].vertex.v1 ] );
-        m_VertexBufferPosData.push_back( m_VertexList[ m_TriangleList[ i ].vertex.v2 ] );
-        m_VertexBufferPosData.push_back( m_VertexList[ m_TriangleList[ i ].vertex.v3 ] );
+        return false;
+    }
 
-        m_VertexBufferNormalData.push_back( m_TriangleList[ i ].normal[ 0 ] );
-        m_VertexBufferNormalData.push_back( m_TriangleList[ i ].normal[ 1 ] );
-        m_VertexBufferNormalData.push_back( m_TriangleList[ i ].normal[ 2 ] );
+    m_MaterialIndex = materialIndex - 1;
+    m_NumTriangles = indexCount / 3;
 
-        m_VertexBufferUvData.push_back( m_UvList[ m_TriangleList[ i ].uv.v1 ] );
-        m_VertexBufferUvData.push_back( m_UvList[ m_TriangleList[ i ].uv.v2 ] );
-        m_VertexBufferUvData.push_back( m_UvList[ m_TriangleList[ i ].uv.v3 ] );
+    m_VertexBufferData.resize( static_cast<size_t>( vertexCount ) * sTMFVertexFloats );
+    m_IndexData.resize( indexCount );
+    if ( fread( m_VertexBufferData.data(), sizeof( float ), m_VertexBufferData.size(), fp ) != m_VertexBufferData.size() || fread( m_IndexData.data(), sizeof( uint32_t ), m_IndexData.size(), fp ) != m_IndexData.size() )
+    {
+        std::vector<float>().swap( m_VertexBufferData );
+        IndexData().swap( m_IndexData );
+        return false;
+    }
+
+    return true;
+}
+
+// Builds an indexed, interleaved vertex buffer. The TMF file indexes positions and UVs separately and
+// stores a normal per corner, so a vertex is only shared between corners which agree on all three.
+void TMFObject::BuildVertexBufferData()
+{
+    const unsigned int numCorners = m_NumTriangles * 3;
+    m_VertexBufferData.reserve( numCorners * sTMFVertexFloats );
+    m_IndexData.reserve( numCorners );
+
+    std::unordered_map<TMFCorner, uint32_t, TMFCornerHash> cornerMap;
+    cornerMap.reserve( numCorners );
+
+    for ( Uint32 i = 0; i < m_NumTriangles; i++ )
+    {
+        const Triangle& triangle = m_TriangleList[ i ];
+        const TMFCorner corners[ 3 ] = {
+            { triangle.vertex.v1, triangle.uv.v1, triangle.normal[ 0 ] },
+            { triangle.vertex.v2, triangle.uv.v2, triangle.normal[ 1 ] },
+            { triangle.vertex.v3, triangle.uv.v3, triangle.normal[ 2 ] }
+        };
+
+        for ( const TMFCorner& corner : corners )
+        {
+            const uint32_t nextIndex = static_cast<uint32_t>( cornerMap.size() );
+            auto it = cornerMap.insert( { corner, nextIndex } );
+            if ( it.second )
+            {
+                const glm::vec3& position = m_VertexList[ corner.vertex ];
+                const glm::vec2& uv = m_UvList[ corner.uv ];
+                m_VertexBufferData.insert( m_VertexBufferData.end(), { position.x, position.y, position.z, uv.x, uv.y, corner.normal.x, corner.normal.y, corner.normal.z } );
+            }
+            m_IndexData.push_back( it.first->second );
+        }
     }
 }
 
@@ -155,6 +287,13 @@ void TMFObject::Render( const glm::mat4& modelTransform, Material* pOverrideMate
 	m_pVertexBuffer->Draw();
 }
 
+void TMFObject::RenderInstanced( const MaterialList& materials, const InstanceBuffer& instances, uint32_t firstInstance, uint32_t instanceCount )
+{
+    Material* pMaterial = materials[ m_MaterialIndex ];
+    pMaterial->shader->Use( &pMaterial->uniforms );
+    m_pVertexBuffer->DrawInstanced( instances, firstInstance, instanceCount );
+}
+
 
 ///////////////////////////////////////////////////////
 // ResourceModel
@@ -180,6 +319,19 @@ ResourceModel::~ResourceModel()
 }
 
 void ResourceModel::Preload()
+{
+    const ResourcePackEntry* pEntry = FrameWork::GetResourceManager()->FindPackEntry( GetFilename().GetFullPath() );
+    if ( pEntry != nullptr && pEntry->type == ResourcePackEntryType::Model )
+    {
+        PreloadPacked( pEntry );
+    }
+    else
+    {
+        PreloadTMF();
+    }
+}
+
+bool ResourceModel::PreloadTMF()
 {
     struct TMFHEADER
     {
@@ -198,19 +350,19 @@ void ResourceModel::Preload()
 #endif
     if ( fp == nullptr )
     {
-        return;
+        return false;
     }
 
     // Check if it is a TMF file
     fread( TMFHeader.id, sizeof( uint8_t ), 3, fp );
     if ( TMFHeader.id[ 0 ] != 'T' || TMFHeader.id[ 1 ] != 'M' || TMFHeader.id[ 2 ] != 'F' )
     {
-        return;
+        return false;
     }
 
     fread( &TMFHeader.version, sizeof( uint16_t ), 1, fp );
 
-    SDL_assert( TMFHeader.version == MODEL_VERSION );
+    SDL_assert( TMFHeader.version == MODEL_VERSION || TMFHeader.version == MODEL_VERSION_INDEXED );
 
     fread( &TMFHeader.nobj, sizeof( uint16_t ), 1, fp );
     fread( &TMFHeader.nhelpers, sizeof( uint16_t ), 1, fp );
@@ -222,10 +374,73 @@ void ResourceModel::Preload()
 
     for ( int i = 0; i < TMFHeader.nobj; i++ )
     {
-        AddTMFObject( fp );
+        AddTMFObject( fp, TMFHeader.version );
     }
 
     fclose( fp );
+    return true;
+}
+
+// Cooked models contain the dummies, followed by each object's vertex and index data. Dummy names are
+// padded to 4 bytes, so the vertex and index data is always aligned.
+void ResourceModel::PreloadPacked( const ResourcePackEntry* pEntry )
+{
+    const uint8_t* pCursor = pEntry->pData;
+
+    uint32_t dummyCount = 0;
+    ResourcePackRead( pCursor, dummyCount );
+    for ( uint32_t i = 0; i < dummyCount; i++ )
+    {
+        uint32_t nameLength = 0;
+        ResourcePackRead( pCursor, nameLength );
+        std::string dummyName( reinterpret_cast<const char*>( pCursor ), nameLength );
+        pCursor += ( nameLength + 3 ) & ~3u;
+
+        glm::vec3 pos;
+        ResourcePackRead( pCursor, pos );
+        mDummyMap[ dummyName ] = pos;
+    }
+
+    uint32_t objectCount = 0;
+    ResourcePackRead( pCursor, objectCount );
+    for ( uint32_t i = 0; i < objectCount; i++ )
+    {
+        TMFObject* pObject = new TMFObject();
+        pObject->Preload( pCursor );
+        mObjectList.push_back( pObject );
+    }
+
+    SDL_assert( pCursor == pEntry->pData + pEntry->size );
+}
+
+bool ResourceModel::Cook( const Filename& filename, std::vector<uint8_t>& data )
+{
+    ResourceModel model( filename );
+    if ( model.PreloadTMF() == false )
+    {
+        return false;
+    }
+
+    static const uint8_t padding[ 4 ] = {};
+    const uint32_t dummyCount = static_cast<uint32_t>( model.mDummyMap.size() );
+    ResourcePackWrite( data, dummyCount );
+    for ( const auto& dummyPair : model.mDummyMap )
+    {
+        const uint32_t nameLength = static_cast<uint32_t>( dummyPair.first.size() );
+        ResourcePackWrite( data, nameLength );
+        ResourcePackWrite( data, dummyPair.first.data(), nameLength );
+        ResourcePackWrite( data, padding, ( ( nameLength + 3 ) & ~3u ) - nameLength );
+        ResourcePackWrite( data, dummyPair.second );
+    }
+
+    const uint32_t objectCount = static_cast<uint32_t>( model.mObjectList.size() );
+    ResourcePackWrite( data, objectCount );
+    for ( const TMFObject* pObject : model.mObjectList )
+    {
+        pObject->Cook( data );
+    }
+
+    return true;
 }
 
 bool ResourceModel::Load()
@@ -279,10 +494,13 @@ void ResourceModel::AddTMFDummy( FILE* fp )
     delete[] pBuffer;
 }
 
-void ResourceModel::AddTMFObject( FILE* fp )
+void ResourceModel::AddTMFObject( FILE* fp, uint16_t version )
 {
     TMFObject* pObject = new TMFObject();
-    pObject->Preload( fp );
+    if ( pObject->Preload( fp, version ) == false )
+    {
+        FrameWork::GetLogger()->LogError( "Model '%s' is truncated or corrupt: couldn't read object %zu.", GetFilename().GetFullPath().c_str(), mObjectList.size() );
+    }
     mObjectList.push_back( pObject );
 }
 
@@ -305,6 +523,14 @@ void ResourceModel::Render( const glm::mat4& modelTransform, Material* pOverride
 	}
 }
 
+void ResourceModel::RenderInstanced( const InstanceBuffer& instances, uint32_t firstInstance, uint32_t instanceCount )
+{
+    for ( auto& pObject : mObjectList )
+    {
+        pObject->RenderInstanced( GetMaterials(), instances, firstInstance, instanceCount );
+    }
+}
+
 void ResourceModel::LoadMaterialLibrary( const std::string& filename )
 {
     Logger* pLogger = FrameWork::GetLogger();
@@ -314,14 +540,25 @@ void ResourceModel::LoadMaterialLibrary( const std::string& filename )
     // Replace the last character of the extension - tmf becomes tml
     materialFilename[ filename.size() - 1 ] = 'l';
 
-    std::ifstream fp;
-    fp.open( materialFilename.c_str(), std::ios::in );
-
-    if ( !fp.is_open() )
+    // Material libraries are small, so a cooked one is simply copied into a stream.
+    std::ifstream file;
+    std::istringstream packedFile;
+    const ResourcePackEntry* pEntry = FrameWork::GetResourceManager()->FindPackEntry( materialFilename );
+    if ( pEntry != nullptr )
     {
-        pLogger->LogError( "Couldn't load material library for %s", filename.c_str() );
-        return;
+        packedFile.str( std::string( reinterpret_cast<const char*>( pEntry->pData ), pEntry->size ) );
     }
+    else
+    {
+        file.open( materialFilename.c_str(), std::ios::in );
+        if ( !file.is_open() )
+        {
+            pLogger->LogError( "Couldn't load material library for %s", filename.c_str() );
+            return;
+        }
+    }
+
+    std::istream& fp = ( pEntry != nullptr ) ? static_cast<std::istream&>( packedFile ) : static_cast<std::istream&>( file );
 
     Material* currentMaterial = nullptr;
 
@@ -499,7 +736,5 @@ void ResourceModel::LoadMaterialLibrary( const std::string& filename )
             mMaterialList.push_back( currentMaterial );
         }
     }
-
-    fp.close();
 }
 }
\ No newline at end of file
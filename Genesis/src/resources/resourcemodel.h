@@ -30,6 +30,7 @@
 namespace Genesis
 {
 struct Material;
+class InstanceBuffer;
 class Mesh;
 class ResourceImage;
 class TMFObject;
@@ -37,6 +38,11 @@ class VertexBuffer;
 
 static const short MODEL_VERSION = 91;
 
+// Version 2.00 of the format (stored as 200, as the header holds the version multiplied by 100) stores each object's
+// vertices already interleaved and deduplicated, together with the indices into them, so they can be read in bulk
+// and copied into the vertex buffer as they are.
+static const short MODEL_VERSION_INDEXED = 200;
+
 typedef std::vector<Material*> MaterialList;
 typedef std::map<std::string, glm::vec3> DummyMap;
 typedef std::vector<TMFObject*> TMFObjectList;
@@ -61,10 +67,13 @@ public:
     TMFObject();
     ~TMFObject();
 
-    void Preload( FILE* fp );
+    bool Preload( FILE* fp, uint16_t version );
+    void Preload( const uint8_t*& pCursor ); // Cooked data, used in place from the mapped pack.
     void Load();
+    void Cook( std::vector<uint8_t>& data ) const;
     void Render( const glm::mat4& modelTransform, const MaterialList& materialList );
 	void Render( const glm::mat4& modelTransform, Material* pOverrideMaterial );
+    void RenderInstanced( const MaterialList& materialList, const InstanceBuffer& instances, uint32_t firstInstance, uint32_t instanceCount );
 
 private:
     struct Index3
@@ -80,6 +89,7 @@ private:
     };
 
     bool Serialise( FILE* fp );
+    bool SerialiseIndexed( FILE* fp );
     void BuildVertexBufferData();
 
     typedef std::vector<glm::vec3> VertexList;
@@ -95,9 +105,15 @@ private:
     UVList m_UvList;
     TriangleList m_TriangleList;
 
-    PositionData m_VertexBufferPosData;
-    NormalData m_VertexBufferNormalData;
-    UVData m_VertexBufferUvData;
+    // Interleaved position, UV and normal for every unique corner, plus the indices into it.
+    std::vector<float> m_VertexBufferData;
+    IndexData m_IndexData;
+
+    // Cooked objects point straight into the pack instead.
+    const float* m_pPackedVertices;
+    const uint32_t* m_pPackedIndices;
+    uint32_t m_PackedVertexCount;
+    uint32_t m_PackedIndexCount;
 
     VertexBuffer* m_pVertexBuffer;
 
@@ -118,13 +134,22 @@ public:
     virtual bool Load() override;
 
     void Render( const glm::mat4& modelTransform, Material* pOverrideMaterial = nullptr );
+
+    // Draws the model once per instance, with a single draw call per object. The materials' shaders
+    // are responsible for reading the per-instance data, as the model transform is the identity.
+    void RenderInstanced( const InstanceBuffer& instances, uint32_t firstInstance, uint32_t instanceCount );
     bool GetDummy( const std::string& name, glm::vec3* pPosition ) const;
     MaterialList& GetMaterials();
     void SetFlipAxis( bool value );
 
+    // Expands the model into the dummies, vertices and indices it is drawn with.
+    static bool Cook( const Filename& filename, std::vector<uint8_t>& data );
+
 private:
+    bool PreloadTMF();
+    void PreloadPacked( const ResourcePackEntry* pEntry );
     void AddTMFDummy( FILE* fp );
-    void AddTMFObject( FILE* fp );
+    void AddTMFObject( FILE* fp, uint16_t version );
     void LoadMaterialLibrary( const std::string& filename );
 
     MaterialList mMaterialList;
@@ -55,6 +55,7 @@ bool ResourcePlaylist::Load()
             ResourceSound* pTrack = FrameWork::GetResourceManager()->GetResource<ResourceSound*>( trackPath.str() );
             if ( pTrack )
             {
+                pTrack->Initialise( SOUND_FLAG_STREAM );
                 m_LoadedTracks.push_back( pTrack );
             }
             else
@@ -15,6 +15,7 @@
 // You should have received a copy of the GNU General Public License
 // along with Genesis. If not, see <http://www.gnu.org/licenses/>.
 
+#include "sound/soundcache.h"
 #include "sound/soundmanager.h"
 #include "../genesis.h"
 #include "../logger.h"
@@ -51,6 +52,15 @@ bool ResourceSound::Initialise( int flags /* = 0 */ )
     m_Flags |= flags;
     m_Flags |= SOUND_FLAG_INITIALISED;
 
+    // Only now is it known whether the sound is streamed, so this is the earliest point at which it can be
+    // decoded without a streamed sound (normally music) taking up room in the sound cache.
+    Sound::SoundManager* pSoundManager = FrameWork::GetSoundManager();
+    Sound::SoundCache* pSoundCache = ( pSoundManager != nullptr ) ? pSoundManager->GetSoundCache() : nullptr;
+    if ( pSoundCache != nullptr && IsStreamed() == false )
+    {
+        pSoundCache->Prefetch( GetFilename().GetFullPath() );
+    }
+
     return true;
 }
 
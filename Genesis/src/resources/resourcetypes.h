@@ -18,5 +18,6 @@ enum class ResourceState
 	PreloadPending,
 	Preloading,
 	Preloaded,
+	Loading,
 	Loaded
 };
\ No newline at end of file
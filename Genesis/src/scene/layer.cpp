@@ -43,8 +43,19 @@ Layer::~Layer()
     }
 }
 
-// Update all objects in this layer
+// Update all variable rate objects in this layer
 void Layer::Update( float delta )
+{
+    UpdateObjects( delta, false );
+}
+
+// Update all fixed rate objects in this layer
+void Layer::FixedUpdate( float delta )
+{
+    UpdateObjects( delta, true );
+}
+
+void Layer::UpdateObjects( float delta, bool isFixedRate )
 {
     if ( IsMarkedForDeletion() )
         return;
@@ -53,7 +64,10 @@ void Layer::Update( float delta )
         LayerObjectList::const_iterator itEnd = mObjectList.end();
         for ( LayerObjectList::const_iterator it = mObjectList.begin(); it != itEnd; ++it )
         {
-            it->pSceneObject->Update( delta );
+            if ( it->isFixedRate == isFixedRate )
+            {
+                it->pSceneObject->Update( delta );
+            }
         }
     }
 
@@ -106,7 +120,7 @@ void Layer::Render()
     }
 }
 
-void Layer::AddSceneObject( SceneObject* pObject, bool hasOwnership /* = true */ )
+void Layer::AddSceneObject( SceneObject* pObject, bool hasOwnership /* = true */, bool isFixedRate /* = false */ )
 {
 #ifdef _DEBUG
     for ( auto& pLayerObject : mObjectList )
@@ -121,6 +135,7 @@ void Layer::AddSceneObject( SceneObject* pObject, bool hasOwnership /* = true */
     LayerObject obj;
     obj.pSceneObject = pObject;
     obj.hasOwnership = hasOwnership;
+    obj.isFixedRate = isFixedRate;
     mObjectList.push_back( obj );
 }
 
@@ -32,6 +32,7 @@ struct LayerObject
 {
     SceneObject* pSceneObject;
     bool hasOwnership;
+    bool isFixedRate; // Updated once per simulation tick rather than once per frame.
 };
 
 typedef std::list<LayerObject> LayerObjectList;
@@ -43,8 +44,9 @@ public:
     Layer( uint32_t depth, bool isBackground );
     ~Layer();
     void Update( float delta );
+    void FixedUpdate( float delta );
     void Render();
-    void AddSceneObject( SceneObject* object, bool hasOwnership = true );
+    void AddSceneObject( SceneObject* object, bool hasOwnership = true, bool isFixedRate = false );
     void RemoveSceneObject( SceneObject* object );
     uint32_t GetLayerDepth() const;
     bool IsBackground() const;
@@ -52,6 +54,8 @@ public:
     void MarkForDeletion();
 
 private:
+    void UpdateObjects( float delta, bool isFixedRate );
+
     LayerObjectList mObjectList;
     SceneObjectList mToRemove;
     uint32_t mDepth;
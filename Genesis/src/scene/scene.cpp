@@ -30,6 +30,16 @@ TaskStatus Scene::Update( float delta )
     return TaskStatus::Continue;
 }
 
+TaskStatus Scene::FixedUpdate( float delta )
+{
+    for ( auto& pLayer : mLayerList )
+    {
+        pLayer->FixedUpdate( delta );
+    }
+
+    return TaskStatus::Continue;
+}
+
 void Scene::Render()
 {
     for ( auto& pLayer : mLayerList )
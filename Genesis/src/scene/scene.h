@@ -41,6 +41,7 @@ public:
     Scene();
     virtual ~Scene();
     TaskStatus Update( float delta );
+    TaskStatus FixedUpdate( float delta );
     void Render();
     LayerSharedPtr AddLayer( uint32_t depth, bool isBackground = false );
     void RemoveLayer( uint32_t depth );
@@ -17,7 +17,7 @@
 
 #include <cmath>
 
-#include "configuration.h"
+#include "frameuniformbuffer.h"
 #include "genesis.h"
 #include "memory.h"
 #include "rendersystem.h"
@@ -36,16 +36,28 @@ Shader::Shader( const std::string& programName, GLuint programHandle )
     , m_pModelUniform( nullptr )
     , m_pModelInverseUniform( nullptr )
     , m_pModelInverseTransposeUniform( nullptr )
-    , m_pViewInverseUniform( nullptr )
-    , m_pTimeUniform( nullptr )
-    , m_pResolutionUniform( nullptr )
 {
     RegisterCoreUniforms();
+
+    if ( m_ProgramHandle == 0 )
+    {
+        return;
+    }
+
+    // Shaders which don't use any of the members will have had the block optimised out.
+    const GLuint frameUniformsIndex = glGetUniformBlockIndex( m_ProgramHandle, "FrameUniforms" );
+    if ( frameUniformsIndex != GL_INVALID_INDEX )
+    {
+        glUniformBlockBinding( m_ProgramHandle, frameUniformsIndex, sFrameUniformsBinding );
+    }
 }
 
 Shader::~Shader()
 {
-    glDeleteProgram( m_ProgramHandle );
+    if ( m_ProgramHandle != 0 )
+    {
+        glDeleteProgram( m_ProgramHandle );
+    }
 
     for ( auto& pShaderUniform : m_Uniforms )
     {
@@ -59,14 +71,11 @@ void Shader::RegisterCoreUniforms()
     m_pModelUniform = RegisterUniform( "k_world", ShaderUniformType::FloatMatrix44 );
     m_pModelInverseUniform = RegisterUniform( "k_worldInverse", ShaderUniformType::FloatMatrix44 );
     m_pModelInverseTransposeUniform = RegisterUniform( "k_worldInverseTranspose", ShaderUniformType::FloatMatrix44 );
-    m_pViewInverseUniform = RegisterUniform( "k_viewInverse", ShaderUniformType::FloatMatrix44 );
-    m_pTimeUniform = RegisterUniform( "k_time", ShaderUniformType::Float );
-    m_pResolutionUniform = RegisterUniform( "k_resolution", ShaderUniformType::FloatVector2 );
 }
 
 ShaderUniform* Shader::RegisterUniform( const char* pUniformName, ShaderUniformType type, bool allowInstancingOverride /*= true */ )
 {
-    GLuint handle = glGetUniformLocation( m_ProgramHandle, pUniformName );
+    GLuint handle = GetUniformLocation( pUniformName );
     for ( auto& pUniform : m_Uniforms )
     {
         if ( pUniform->GetHandle() == handle )
@@ -89,6 +98,19 @@ ShaderUniform* Shader::RegisterUniform( const char* pUniformName, ShaderUniformT
     return pUniform;
 }
 
+// Headless shaders have no program, so every uniform is assumed to exist and is given a location of its own.
+// The uniforms can be set as usual, but are never applied.
+GLuint Shader::GetUniformLocation( const char* pUniformName )
+{
+    if ( m_ProgramHandle != 0 )
+    {
+        return glGetUniformLocation( m_ProgramHandle, pUniformName );
+    }
+
+    const GLuint location = static_cast<GLuint>( m_HeadlessLocations.size() );
+    return m_HeadlessLocations.insert( { pUniformName, location } ).first->second;
+}
+
 void Shader::Use( ShaderUniformInstances* pShaderUniformInstances /* = nullptr */ )
 {
     glm::mat4 modelMatrix( 1.0f ); // identity
@@ -108,7 +130,7 @@ void Shader::UpdateParameters( const glm::mat4& modelMatrix, ShaderUniformInstan
 
     if ( m_pModelViewProjectionUniform != nullptr )
     {
-        const glm::mat4 mvp = renderSystem->GetProjectionMatrix() * renderSystem->GetViewMatrix() * modelMatrix;
+        const glm::mat4 mvp = renderSystem->GetViewProjectionMatrix() * modelMatrix;
         m_pModelViewProjectionUniform->Set( mvp );
     }
 
@@ -133,21 +155,6 @@ void Shader::UpdateParameters( const glm::mat4& modelMatrix, ShaderUniformInstan
         m_pModelInverseTransposeUniform->Set( glm::mat4( normalMatrix ) /*glm::transpose( glm::inverse( modelMatrix ) )*/ );
     }
 
-    if ( m_pViewInverseUniform != nullptr )
-    {
-        m_pViewInverseUniform->Set( glm::inverse( renderSystem->GetViewMatrix() ) );
-    }
-
-    if ( m_pTimeUniform != nullptr )
-    {
-        m_pTimeUniform->Set( FrameWork::GetRenderSystem()->GetShaderTimer() );
-    }
-
-    if ( m_pResolutionUniform != nullptr )
-    {
-        m_pResolutionUniform->Set( glm::vec2( (float)Configuration::GetScreenWidth(), (float)Configuration::GetScreenHeight() ) );
-    }
-
     if ( pShaderUniformInstances != nullptr )
     {
         for ( auto& shaderUniformInstance : *pShaderUniformInstances )
@@ -156,6 +163,7 @@ void Shader::UpdateParameters( const glm::mat4& modelMatrix, ShaderUniformInstan
         }
     }
 
+    // Uniforms are part of the program's state, so only the ones which changed since this shader was last used are uploaded.
     for ( auto& pUniform : m_Uniforms )
     {
         pUniform->Apply();
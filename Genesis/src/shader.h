@@ -66,6 +66,7 @@ public:
 
 private:
     void RegisterCoreUniforms();
+    GLuint GetUniformLocation( const char* pUniformName );
 
     void BindTextureMap( TextureMap textureMap, GLuint texture );
     void UpdateParameters( const glm::mat4& modelMatrix, ShaderUniformInstances* pShaderUniformInstances );
@@ -77,11 +78,9 @@ private:
     ShaderUniform* m_pModelUniform;
     ShaderUniform* m_pModelInverseUniform;
     ShaderUniform* m_pModelInverseTransposeUniform;
-    ShaderUniform* m_pViewInverseUniform;
-    ShaderUniform* m_pTimeUniform;
-    ShaderUniform* m_pResolutionUniform;
 
     ShaderUniforms m_Uniforms;
+    std::map<std::string, GLuint> m_HeadlessLocations;
 };
 
 inline const std::string& Shader::GetName() const
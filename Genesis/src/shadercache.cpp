@@ -15,9 +15,17 @@
 // You should have received a copy of the GNU General Public License
 // along with Genesis. If not, see <http://www.gnu.org/licenses/>.
 
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
 #include "shadercache.h"
+#include "frameuniformbuffer.h"
 #include "genesis.h"
 #include "rendersystem.h"
+#include "resourcemanager.h"
 #include "shader.h"
 
 namespace Genesis
@@ -27,8 +35,122 @@ namespace Genesis
 // ShaderCache
 ///////////////////////////////////////////////////////////////////////////////
 
+static const char* sShaderBinaryFolder = "shadercache";
+static const char sShaderBinaryId[ 4 ] = { 'G', 'S', 'H', 'B' };
+static const uint32_t sShaderBinaryVersion = 1;
+static const uint64_t sHashSeed = 14695981039346656037ull;
+
+struct ShaderBinaryHeader
+{
+    char id[ 4 ];
+    uint32_t version;
+    uint32_t binaryFormat;
+    uint32_t binaryLength;
+    uint64_t sourceHash;
+    uint64_t driverHash;
+};
+
+// FNV-1a, which unlike std::hash is guaranteed to give the same result between runs and builds.
+static uint64_t HashString( std::string_view text, uint64_t hash )
+{
+    for ( char c : text )
+    {
+        hash ^= static_cast<uint8_t>( c );
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static std::filesystem::path GetBinaryPath( const std::string& programName )
+{
+    return std::filesystem::path( sShaderBinaryFolder ) / ( programName + ".bin" );
+}
+
+// Declares the FrameUniforms block right after the #version directive. The #line directive keeps the
+// line numbers in compilation errors matching the source file.
+static void AddFrameUniforms( std::string& shaderCode )
+{
+    const size_t versionPosition = shaderCode.find( "#version" );
+    if ( versionPosition == std::string::npos )
+    {
+        return;
+    }
+
+    const size_t lineEnd = shaderCode.find( '\n', versionPosition );
+    if ( lineEnd == std::string::npos )
+    {
+        return;
+    }
+
+    const std::string declaration = std::string( "\n" ) + FrameUniformBuffer::GetBlockDeclaration() + "\n#line 2";
+    shaderCode.insert( lineEnd, declaration );
+}
+
+// Reads a shader's source from the pack if it has been cooked, or from its loose file otherwise.
+// Every line is preceded by a line break, which AddFrameUniforms()'s #line directive accounts for.
+static bool ReadShaderCode( const std::string& filename, std::string& shaderCode )
+{
+    const ResourcePackEntry* pEntry = FrameWork::GetResourceManager()->FindPackEntry( filename );
+    if ( pEntry != nullptr )
+    {
+        std::string_view code( reinterpret_cast<const char*>( pEntry->pData ), pEntry->size );
+        if ( code.empty() == false && code.back() == '\n' )
+        {
+            code.remove_suffix( 1 );
+        }
+
+        shaderCode.reserve( code.size() + 1 );
+        shaderCode = "\n";
+        shaderCode += code;
+        return true;
+    }
+
+    std::ifstream shaderStream( filename, std::ios::in );
+    if ( shaderStream.is_open() == false )
+    {
+        return false;
+    }
+
+    std::string line = "";
+    while ( getline( shaderStream, line ) )
+    {
+        shaderCode += "\n" + line;
+    }
+
+    shaderStream.close();
+    return true;
+}
+
 ShaderCache::ShaderCache()
+    : m_BinariesSupported( false )
+    , m_DriverHash( 0 )
 {
+    if ( FrameWork::IsHeadless() )
+    {
+        return;
+    }
+
+    GLint binaryFormatCount = 0;
+    if ( GLEW_ARB_get_program_binary )
+    {
+        glGetIntegerv( GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormatCount );
+    }
+    m_BinariesSupported = ( binaryFormatCount > 0 );
+
+    // Binaries are only valid for the driver which created them, so a driver update invalidates the whole cache.
+    if ( m_BinariesSupported )
+    {
+        const GLenum driverStrings[] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+        m_DriverHash = sHashSeed;
+        for ( GLenum driverString : driverStrings )
+        {
+            const char* pDriverString = reinterpret_cast<const char*>( glGetString( driverString ) );
+            if ( pDriverString != nullptr )
+            {
+                m_DriverHash = HashString( pDriverString, m_DriverHash );
+            }
+        }
+    }
 }
 
 ShaderCache::~ShaderCache()
@@ -49,26 +171,18 @@ Shader* ShaderCache::Load( const std::string& programName )
         return it->second;
     }
 
-    // Create the shaders
-    GLuint vertexShaderID = glCreateShader( GL_VERTEX_SHADER );
-    GLuint fragmentShaderID = glCreateShader( GL_FRAGMENT_SHADER );
+    // There is nothing to compile without a GL context.
+    if ( FrameWork::IsHeadless() )
+    {
+        Shader* pShader = new Shader( programName, 0 );
+        m_ProgramCache[ programName ] = pShader;
+        return pShader;
+    }
 
     // Read the Vertex Shader code from the file
     std::string vertexFilename = "data/shaders/" + programName + ".vert";
     std::string vertexShaderCode;
-    std::ifstream vertexShaderStream( vertexFilename, std::ios::in );
-
-    if ( vertexShaderStream.is_open() )
-    {
-        std::string line = "";
-        while ( getline( vertexShaderStream, line ) )
-        {
-            vertexShaderCode += "\n" + line;
-        }
-
-        vertexShaderStream.close();
-    }
-    else
+    if ( ReadShaderCode( vertexFilename, vertexShaderCode ) == false )
     {
         pLog->LogError( "Couldn't open '%s'.", vertexFilename.c_str() );
         return nullptr;
@@ -77,20 +191,44 @@ Shader* ShaderCache::Load( const std::string& programName )
     // Read the Fragment Shader code from the file
     std::string fragmentFilename = "data/shaders/" + programName + ".frag";
     std::string fragmentShaderCode;
-    std::ifstream fragmentShaderStream( fragmentFilename, std::ios::in );
+    ReadShaderCode( fragmentFilename, fragmentShaderCode );
 
-    if ( fragmentShaderStream.is_open() )
+    AddFrameUniforms( vertexShaderCode );
+    AddFrameUniforms( fragmentShaderCode );
+
+    GLuint programHandle = 0;
+    uint64_t sourceHash = 0;
+    if ( m_BinariesSupported )
     {
-        std::string line = "";
-        while ( getline( fragmentShaderStream, line ) )
+        sourceHash = HashString( fragmentShaderCode, HashString( vertexShaderCode, sHashSeed ) );
+        programHandle = LoadBinary( programName, sourceHash );
+    }
+
+    if ( programHandle == 0 )
+    {
+        programHandle = Compile( programName, vertexShaderCode, fragmentShaderCode );
+        if ( m_BinariesSupported )
         {
-            fragmentShaderCode += "\n" + line;
+            SaveBinary( programName, sourceHash, programHandle );
         }
-
-        fragmentShaderStream.close();
     }
 
-    pLog->LogInfo( "Compiling shader program: %s", programName.c_str() );
+    Shader* pShader = new Shader( programName, programHandle );
+    m_ProgramCache[ programName ] = pShader;
+
+    pLog->LogInfo( LogCategory::Rendering, "Cached shader program '%s'", programName.c_str() );
+
+    return pShader;
+}
+
+GLuint ShaderCache::Compile( const std::string& programName, const std::string& vertexShaderCode, const std::string& fragmentShaderCode ) const
+{
+    Logger* pLog = FrameWork::GetLogger();
+    pLog->LogInfo( LogCategory::Rendering, "Compiling shader program: %s", programName.c_str() );
+
+    // Create the shaders
+    GLuint vertexShaderID = glCreateShader( GL_VERTEX_SHADER );
+    GLuint fragmentShaderID = glCreateShader( GL_FRAGMENT_SHADER );
 
     GLint compilationSuccessful = GL_FALSE;
     int infoLogLength = 0;
@@ -125,8 +263,12 @@ Shader* ShaderCache::Load( const std::string& programName )
         pLog->LogError( "Compiling fragment shader '%s':\n%s", programName.c_str(), &fragmentShaderErrorMessage[ 0 ] );
     }
 
-    // Link the program
+    // Link the program, letting the driver know we'll want to retrieve its binary.
     GLuint programHandle = glCreateProgram();
+    if ( m_BinariesSupported )
+    {
+        glProgramParameteri( programHandle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE );
+    }
     glAttachShader( programHandle, vertexShaderID );
     glAttachShader( programHandle, fragmentShaderID );
     glLinkProgram( programHandle );
@@ -148,12 +290,80 @@ Shader* ShaderCache::Load( const std::string& programName )
     glDeleteShader( vertexShaderID );
     glDeleteShader( fragmentShaderID );
 
-    Shader* pShader = new Shader( programName, programHandle );
-    m_ProgramCache[ programName ] = pShader;
+    return programHandle;
+}
 
-    pLog->LogInfo( "Cached shader program '%s'", programName.c_str() );
+// Returns 0 if there is no usable binary for this program, in which case it needs to be compiled.
+GLuint ShaderCache::LoadBinary( const std::string& programName, uint64_t sourceHash ) const
+{
+    std::ifstream file( GetBinaryPath( programName ), std::ios::in | std::ios::binary );
+    if ( file.is_open() == false )
+    {
+        return 0;
+    }
 
-    return pShader;
+    ShaderBinaryHeader header;
+    if ( !file.read( reinterpret_cast<char*>( &header ), sizeof( header ) ) || memcmp( header.id, sShaderBinaryId, sizeof( header.id ) ) != 0 || header.version != sShaderBinaryVersion || header.sourceHash != sourceHash || header.driverHash != m_DriverHash )
+    {
+        return 0;
+    }
+
+    std::vector<char> binary( header.binaryLength );
+    if ( !file.read( binary.data(), binary.size() ) )
+    {
+        return 0;
+    }
+
+    // The driver is allowed to reject a binary even if it matches, so the program needs to be checked.
+    GLuint programHandle = glCreateProgram();
+    glProgramBinary( programHandle, static_cast<GLenum>( header.binaryFormat ), binary.data(), static_cast<GLsizei>( binary.size() ) );
+
+    GLint linkSuccessful = GL_FALSE;
+    glGetProgramiv( programHandle, GL_LINK_STATUS, &linkSuccessful );
+    if ( linkSuccessful == GL_FALSE )
+    {
+        FrameWork::GetLogger()->LogWarning( "Cached binary for shader program '%s' was rejected, recompiling.", programName.c_str() );
+        glDeleteProgram( programHandle );
+        return 0;
+    }
+
+    FrameWork::GetLogger()->LogInfo( LogCategory::Rendering, "Loaded shader program '%s' from binary.", programName.c_str() );
+    return programHandle;
+}
+
+void ShaderCache::SaveBinary( const std::string& programName, uint64_t sourceHash, GLuint programHandle ) const
+{
+    GLint binaryLength = 0;
+    glGetProgramiv( programHandle, GL_PROGRAM_BINARY_LENGTH, &binaryLength );
+    if ( binaryLength <= 0 )
+    {
+        return;
+    }
+
+    std::vector<char> binary( static_cast<size_t>( binaryLength ) );
+    GLenum binaryFormat = 0;
+    glGetProgramBinary( programHandle, binaryLength, nullptr, &binaryFormat, binary.data() );
+
+    std::error_code error;
+    std::filesystem::create_directories( sShaderBinaryFolder, error );
+
+    ShaderBinaryHeader header;
+    memcpy( header.id, sShaderBinaryId, sizeof( header.id ) );
+    header.version = sShaderBinaryVersion;
+    header.binaryFormat = binaryFormat;
+    header.sourceHash = sourceHash;
+    header.driverHash = m_DriverHash;
+    header.binaryLength = static_cast<uint32_t>( binary.size() );
+
+    std::ofstream file( GetBinaryPath( programName ), std::ios::out | std::ios::binary | std::ios::trunc );
+    if ( file.is_open() == false )
+    {
+        FrameWork::GetLogger()->LogWarning( "Couldn't write binary for shader program '%s'.", programName.c_str() );
+        return;
+    }
+
+    file.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+    file.write( binary.data(), binary.size() );
 }
 
 }
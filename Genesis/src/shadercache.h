@@ -17,8 +17,9 @@
 
 #pragma once
 
-#include <unordered_map>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 
 namespace Genesis
 {
@@ -30,6 +31,9 @@ class Shader;
 // Caches shader programs. Compiling shader programs is expensive and must be
 // done at load time, so any shader files should be added to this cache before
 // they are referenced for rendering.
+// Linked programs are also stored on disk, keyed by a hash of their source
+// and of the driver they were built with, so later runs can skip compiling
+// them altogether when the driver supports program binaries.
 ///////////////////////////////////////////////////////////////////////////////
 
 class ShaderCache
@@ -43,6 +47,12 @@ public:
 private:
     typedef std::unordered_map<std::string, Shader*> ShaderMap;
 
+    unsigned int Compile( const std::string& programName, const std::string& vertexShaderCode, const std::string& fragmentShaderCode ) const;
+    unsigned int LoadBinary( const std::string& programName, uint64_t sourceHash ) const;
+    void SaveBinary( const std::string& programName, uint64_t sourceHash, unsigned int programHandle ) const;
+
     ShaderMap m_ProgramCache;
+    bool m_BinariesSupported;
+    uint64_t m_DriverHash;
 };
 }
@@ -32,20 +32,21 @@ ShaderUniform::ShaderUniform( GLuint handle, ShaderUniformType type, bool allowI
     , m_pData( nullptr )
     , m_Slot( GL_TEXTURE0 )
     , m_InstancingOverride( allowInstancingOverride )
+    , m_Dirty( true )
 {
     SDL_assert( handle != -1 );
 
 	if ( m_Type == ShaderUniformType::Boolean )
 	{
-		m_pData = new bool;
+		m_pData = new bool();
 	}
     else if ( m_Type == ShaderUniformType::Integer )
     {
-        m_pData = new int;
+        m_pData = new int();
     }
     else if ( m_Type == ShaderUniformType::Float )
     {
-        m_pData = new float;
+        m_pData = new float();
     }
     else if ( m_Type == ShaderUniformType::FloatVector2 )
     {
@@ -65,7 +66,7 @@ ShaderUniform::ShaderUniform( GLuint handle, ShaderUniformType type, bool allowI
     }
     else if ( m_Type == ShaderUniformType::Texture )
     {
-        m_pData = new GLuint;
+        m_pData = new GLuint();
     }
 }
 
@@ -107,6 +108,19 @@ ShaderUniform::~ShaderUniform()
 
 void ShaderUniform::Apply()
 {
+    if ( m_Type == ShaderUniformType::Texture )
+    {
+        glActiveTexture( m_Slot );
+        glBindTexture( GL_TEXTURE_2D, *(GLuint*)m_pData );
+    }
+
+    if ( m_Dirty == false )
+    {
+        return;
+    }
+
+    m_Dirty = false;
+
 	if ( m_Type == ShaderUniformType::Boolean )
 	{
 		const int v = (*(bool*)m_pData) ? 1 : 0;
@@ -138,8 +152,6 @@ void ShaderUniform::Apply()
     }
     else if ( m_Type == ShaderUniformType::Texture )
     {
-        glActiveTexture( m_Slot );
-        glBindTexture( GL_TEXTURE_2D, *(GLuint*)m_pData );
         glUniform1i( m_Handle, (int)( m_Slot - GL_TEXTURE0 ) );
     }
     else
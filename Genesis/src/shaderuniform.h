@@ -29,6 +29,11 @@ namespace Genesis
 
 ///////////////////////////////////////////////////////////////////////////////
 // ShaderUniform
+// Keeps a CPU-side copy of the uniform's value. Setting a uniform only marks
+// it as dirty if the value actually changed, and Apply() only uploads dirty
+// values, as the program retains its uniforms between uses. Textures are
+// the exception: the texture units are shared by all programs, so the
+// texture is bound on every Apply().
 ///////////////////////////////////////////////////////////////////////////////
 
 class ShaderUniform
@@ -38,6 +43,7 @@ public:
     ~ShaderUniform();
 
     void Apply();
+    bool IsDirty() const;
 
 	void Set( bool value );
     void Set( int value );
@@ -69,62 +75,95 @@ private:
     void* m_pData;
     GLenum m_Slot;
     bool m_InstancingOverride;
+    bool m_Dirty;
 };
 
 inline void ShaderUniform::Set( bool value )
 {
 	SDL_assert( m_Type == ShaderUniformType::Boolean );
-	*(bool*)m_pData = value;
+	if ( *(bool*)m_pData != value )
+	{
+		*(bool*)m_pData = value;
+		m_Dirty = true;
+	}
 }
 
 inline void ShaderUniform::Set( int value )
 {
     SDL_assert( m_Type == ShaderUniformType::Integer );
-    *(int*)m_pData = value;
+    if ( *(int*)m_pData != value )
+    {
+        *(int*)m_pData = value;
+        m_Dirty = true;
+    }
 }
 
 inline void ShaderUniform::Set( float value )
 {
     SDL_assert( m_Type == ShaderUniformType::Float );
-    *(float*)m_pData = value;
+    if ( *(float*)m_pData != value )
+    {
+        *(float*)m_pData = value;
+        m_Dirty = true;
+    }
 }
 
 inline void ShaderUniform::Set( const glm::vec2& value )
 {
     SDL_assert( m_Type == ShaderUniformType::FloatVector2 );
-    *(glm::vec2*)m_pData = value;
+    if ( *(glm::vec2*)m_pData != value )
+    {
+        *(glm::vec2*)m_pData = value;
+        m_Dirty = true;
+    }
 }
 
 inline void ShaderUniform::Set( const glm::vec3& value )
 {
     SDL_assert( m_Type == ShaderUniformType::FloatVector3 );
-    *(glm::vec3*)m_pData = value;
+    if ( *(glm::vec3*)m_pData != value )
+    {
+        *(glm::vec3*)m_pData = value;
+        m_Dirty = true;
+    }
 }
 
 inline void ShaderUniform::Set( const glm::vec4& value )
 {
     SDL_assert( m_Type == ShaderUniformType::FloatVector4 );
-    *(glm::vec4*)m_pData = value;
+    if ( *(glm::vec4*)m_pData != value )
+    {
+        *(glm::vec4*)m_pData = value;
+        m_Dirty = true;
+    }
 }
 
 inline void ShaderUniform::Set( const glm::mat4& value )
 {
     SDL_assert( m_Type == ShaderUniformType::FloatMatrix44 );
-    *(glm::mat4*)m_pData = value;
+    if ( *(glm::mat4*)m_pData != value )
+    {
+        *(glm::mat4*)m_pData = value;
+        m_Dirty = true;
+    }
 }
 
 inline void ShaderUniform::Set( ResourceImage* pImage, GLenum textureSlot )
 {
-    SDL_assert( m_Type == ShaderUniformType::Texture );
-    *(GLuint*)m_pData = pImage->GetTexture();
-    m_Slot = textureSlot;
+    Set( pImage->GetTexture(), textureSlot );
 }
 
 inline void ShaderUniform::Set( GLuint textureID, GLenum textureSlot )
 {
     SDL_assert( m_Type == ShaderUniformType::Texture );
     *(GLuint*)m_pData = textureID;
-    m_Slot = textureSlot;
+
+    // Only the slot is stored in the uniform itself.
+    if ( m_Slot != textureSlot )
+    {
+        m_Slot = textureSlot;
+        m_Dirty = true;
+    }
 }
 
 inline void ShaderUniform::Get( bool* pValue ) const
@@ -169,6 +208,11 @@ inline void ShaderUniform::Get( glm::mat4* pValue ) const
     *pValue = *(glm::mat4*)m_pData;
 }
 
+inline bool ShaderUniform::IsDirty() const
+{
+    return m_Dirty;
+}
+
 inline GLuint ShaderUniform::GetHandle() const
 {
     return m_Handle;
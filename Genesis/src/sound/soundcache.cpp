@@ -0,0 +1,174 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Genesis.
+//
+// Genesis is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Genesis is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Genesis. If not, see <http://www.gnu.org/licenses/>.
+
+#include "sound/soundcache.h"
+
+// clang-format off
+#include "beginexternalheaders.h"
+#include <soloud.h>
+#include <soloud_wav.h>
+#include "endexternalheaders.h"
+// clang-format on
+
+#include "genesis.h"
+#include "jobsystem.h"
+
+namespace Genesis::Sound
+{
+
+extern std::unique_ptr<SoLoud::Soloud> g_pSoloud;
+
+SoundCache::SoundCache()
+    : m_MemoryUsage( 0 )
+    , m_DecodingCount( 0 )
+{
+}
+
+SoundCache::~SoundCache()
+{
+}
+
+void SoundCache::Prefetch( const std::string& path )
+{
+    bool isNewEntry = false;
+    {
+        std::lock_guard<std::mutex> lock( m_Mutex );
+        isNewEntry = AddEntry( path );
+    }
+
+    if ( isNewEntry )
+    {
+        FrameWork::GetJobSystem()->Submit( [ this, path ]() { Load( path ); } );
+    }
+}
+
+// Adds the sound in the Decoding state, returning false if it was already known. Assumes m_Mutex is locked.
+bool SoundCache::AddEntry( const std::string& path )
+{
+    if ( m_Entries.find( path ) != m_Entries.end() )
+    {
+        return false;
+    }
+
+    m_Entries[ path ] = { State::Decoding, nullptr, 0, SoLoud::SO_NO_ERROR, m_LRU.end() };
+    m_DecodingCount++;
+    return true;
+}
+
+// Decodes a sound whose entry has already been added in the Decoding state.
+void SoundCache::Load( const std::string& path )
+{
+    WavSharedPtr pWav = std::make_shared<SoLoud::Wav>();
+    const unsigned int result = pWav->load( path.c_str() );
+
+    {
+        std::lock_guard<std::mutex> lock( m_Mutex );
+        Entry& entry = m_Entries[ path ];
+        m_DecodingCount--;
+        if ( result == SoLoud::SO_NO_ERROR )
+        {
+            entry.state = State::Decoded;
+            entry.pWav = pWav;
+            entry.size = static_cast<size_t>( pWav->mSampleCount ) * pWav->mChannels * sizeof( float );
+            m_LRU.push_front( path );
+            entry.lruIt = m_LRU.begin();
+            m_MemoryUsage += entry.size;
+            Evict();
+        }
+        else
+        {
+            entry.state = State::Failed;
+            entry.result = result;
+        }
+    }
+
+    m_Decoded.notify_all();
+}
+
+WavSharedPtr SoundCache::Get( const std::string& path, std::chrono::milliseconds timeout, unsigned int& result )
+{
+    result = SoLoud::SO_NO_ERROR;
+
+    std::unique_lock<std::mutex> lock( m_Mutex );
+    if ( AddEntry( path ) )
+    {
+        lock.unlock();
+        FrameWork::GetJobSystem()->Submit( [ this, path ]() { Load( path ); } );
+        lock.lock();
+    }
+
+    m_Decoded.wait_for( lock, timeout, [ this, &path ]() {
+        auto entryIt = m_Entries.find( path );
+        return entryIt != m_Entries.end() && entryIt->second.state != State::Decoding;
+    } );
+
+    auto it = m_Entries.find( path );
+    if ( it == m_Entries.end() || it->second.state == State::Decoding )
+    {
+        return nullptr;
+    }
+    else if ( it->second.state == State::Failed )
+    {
+        result = it->second.result;
+        return nullptr;
+    }
+
+    m_LRU.splice( m_LRU.begin(), m_LRU, it->second.lruIt );
+    return it->second.pWav;
+}
+
+// Evicts the least recently used sounds until the cache is within budget. A sound can't be evicted while a voice
+// is playing it or while someone else holds a reference to it. Assumes m_Mutex is locked.
+void SoundCache::Evict()
+{
+    auto lruIt = m_LRU.end();
+    while ( m_MemoryUsage > sSoundCacheMaxBytes && lruIt != m_LRU.begin() )
+    {
+        --lruIt;
+        auto it = m_Entries.find( *lruIt );
+        SDL_assert( it != m_Entries.end() );
+        Entry& entry = it->second;
+        if ( entry.pWav.use_count() > 1 || g_pSoloud->countAudioSource( *entry.pWav ) > 0 )
+        {
+            continue;
+        }
+
+        m_MemoryUsage -= entry.size;
+        lruIt = m_LRU.erase( lruIt );
+        m_Entries.erase( it );
+    }
+}
+
+size_t SoundCache::GetMemoryUsage() const
+{
+    std::lock_guard<std::mutex> lock( m_Mutex );
+    return m_MemoryUsage;
+}
+
+size_t SoundCache::GetSoundCount() const
+{
+    std::lock_guard<std::mutex> lock( m_Mutex );
+    return m_LRU.size();
+}
+
+size_t SoundCache::GetDecodingCount() const
+{
+    std::lock_guard<std::mutex> lock( m_Mutex );
+    return m_DecodingCount;
+}
+
+} // namespace Genesis::Sound
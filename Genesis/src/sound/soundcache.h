@@ -0,0 +1,98 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Genesis.
+//
+// Genesis is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Genesis is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Genesis. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace SoLoud
+{
+class Wav;
+} // namespace SoLoud
+
+namespace Genesis::Sound
+{
+
+using WavSharedPtr = std::shared_ptr<::SoLoud::Wav>;
+
+// Budget for decoded samples. Sounds which are still playing are never evicted, so this can be exceeded for a while.
+static const size_t sSoundCacheMaxBytes = 128 * 1024 * 1024;
+
+///////////////////////////////////////////////////////////////////////////////
+// SoundCache
+// Holds the decoded samples of every non-streamed sound, shared by all the
+// instances playing it. Sounds are decoded on the JobSystem as soon as their
+// resource is initialised as a non-streamed sound or, if they have since been
+// evicted, when next requested. The least recently used sounds are evicted
+// once the cache grows past sSoundCacheMaxBytes.
+///////////////////////////////////////////////////////////////////////////////
+
+class SoundCache
+{
+public:
+    SoundCache();
+    ~SoundCache();
+
+    // Queues the sound to be decoded on the JobSystem, unless it has already been decoded or is being decoded. Thread safe.
+    void Prefetch( const std::string& path );
+
+    // Returns the decoded sound, queueing it to be decoded if necessary. If it's still being decoded after waiting
+    // for up to timeout, nullptr is returned with a result of SO_NO_ERROR. Failed decodes return their SoLoud error.
+    WavSharedPtr Get( const std::string& path, std::chrono::milliseconds timeout, unsigned int& result );
+
+    size_t GetMemoryUsage() const;
+    size_t GetSoundCount() const;
+    size_t GetDecodingCount() const;
+
+private:
+    enum class State
+    {
+        Decoding,
+        Decoded,
+        Failed
+    };
+
+    using PathList = std::list<std::string>;
+
+    struct Entry
+    {
+        State state;
+        WavSharedPtr pWav;
+        size_t size;
+        unsigned int result;
+        PathList::iterator lruIt;
+    };
+
+    bool AddEntry( const std::string& path );
+    void Load( const std::string& path );
+    void Evict();
+
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_Decoded;
+    std::unordered_map<std::string, Entry> m_Entries;
+    PathList m_LRU; // Decoded sounds, most recently used first.
+    size_t m_MemoryUsage;
+    size_t m_DecodingCount;
+};
+
+} // namespace Genesis::Sound
@@ -43,6 +43,8 @@ SoundInstance::SoundInstance()
     , m_Position( 0.0f )
     , m_Velocity( 0.0f )
     , m_Volume( 1.0f )
+    , m_MinDistance( 0.0f )
+    , m_MaxDistance( 10000.0f )
 {
 }
 
@@ -56,6 +58,8 @@ void SoundInstance::Initialise( ResourceSound* pResourceSound, SoundBusSharedPtr
     m_pSoundBus = pSoundBus;
     m_MinDistance = minDistance;
     m_MaxDistance = maxDistance;
+    m_Position = position.value_or( glm::vec3( 0.0f ) );
+    m_StartTime = std::chrono::steady_clock::now();
     SoLoud::AudioSource* pAudioSource = reinterpret_cast<::SoLoud::AudioSource*>( pData );
 
     // Set sound properties based on the type of sound we're playing.
@@ -71,13 +75,12 @@ void SoundInstance::Initialise( ResourceSound* pResourceSound, SoundBusSharedPtr
     }
 
     SoLoud::Bus* pSoLoudBus = pSoundBus->m_pBus.get();
-    const float volume = m_Volume * pSoundBus->GetVolume() * ( static_cast<float>( Configuration::GetMasterVolume() ) / 100.0f );
+    const float volume = GetMixVolume();
     if ( pResourceSound->Is3D() )
     {
         SDL_assert( position.has_value() ); // Shouldn't have really got here, this should have been caught by the SoundManager!
-        glm::vec3 pos = position.value_or( glm::vec3( 0.0f ) );
         pAudioSource->set3dMinMaxDistance( minDistance, maxDistance );
-        m_Handle = pSoLoudBus->play3d( *pAudioSource, pos.x, pos.y, pos.z, 0.0f, 0.0f, 0.0f, volume );
+        m_Handle = pSoLoudBus->play3d( *pAudioSource, m_Position.x, m_Position.y, m_Position.z, 0.0f, 0.0f, 0.0f, volume );
     }
     else
     {
@@ -130,6 +133,28 @@ ResourceSound* SoundInstance::GetResource() const
     return m_pResourceSound;
 }
 
+void SoundInstance::SetVolume( float value )
+{
+    m_Volume = value;
+    ApplyVolume();
+}
+
+float SoundInstance::GetAge() const
+{
+    return std::chrono::duration<float>( std::chrono::steady_clock::now() - m_StartTime ).count();
+}
+
+// The instance's own volume, scaled by its bus and the master volume.
+float SoundInstance::GetMixVolume() const
+{
+    return m_Volume * m_pSoundBus->GetVolume() * ( static_cast<float>( Configuration::GetMasterVolume() ) / 100.0f );
+}
+
+void SoundInstance::ApplyVolume()
+{
+    g_pSoloud->setVolume( m_Handle, GetMixVolume() );
+}
+
 void SoundInstance::SetMinimumDistance( float value )
 {
     m_MinDistance = value;
@@ -140,23 +165,10 @@ void SoundInstance::Set3DAttributes( const glm::vec3* pPosition, const glm::vec3
 {
     SDL_assert( GetResource()->Is3D() );
 
-    if ( pPosition != nullptr )
-    {
-        g_pSoloud->set3dSourcePosition( m_Handle, pPosition->x, pPosition->y, pPosition->z );
-    }
-    else
-    {
-        g_pSoloud->set3dSourcePosition( m_Handle, 0.0f, 0.0f, 0.0f );
-    }
-
-    if ( pVelocity != nullptr )
-    {
-        g_pSoloud->set3dSourceVelocity( m_Handle, pVelocity->x, pVelocity->y, pVelocity->z );
-    }
-    else
-    {
-        g_pSoloud->set3dSourceVelocity( m_Handle, 0.0f, 0.0f, 0.0f );
-    }
+    m_Position = ( pPosition != nullptr ) ? *pPosition : glm::vec3( 0.0f );
+    m_Velocity = ( pVelocity != nullptr ) ? *pVelocity : glm::vec3( 0.0f );
+    g_pSoloud->set3dSourcePosition( m_Handle, m_Position.x, m_Position.y, m_Position.z );
+    g_pSoloud->set3dSourceVelocity( m_Handle, m_Velocity.x, m_Velocity.y, m_Velocity.z );
 }
 
 void SoundInstance::Get3DAttributes( glm::vec3* pPosition, glm::vec3* pVelocity )
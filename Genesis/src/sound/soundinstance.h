@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <list>
 #include <memory>
 #include <optional>
@@ -63,7 +64,13 @@ public:
     float GetVolume() const;
     SoundBusSharedPtr& GetSoundBus();
 
+    float GetMinimumDistance() const;
+    float GetAge() const; // Seconds since the sound started playing
+
 private:
+    float GetMixVolume() const;
+    void ApplyVolume();
+
     Genesis::ResourceSound* m_pResourceSound;
     unsigned int m_Handle;
     glm::vec3 m_Position;
@@ -72,6 +79,7 @@ private:
     SoundBusSharedPtr m_pSoundBus;
     float m_MinDistance;
     float m_MaxDistance;
+    std::chrono::steady_clock::time_point m_StartTime;
 };
 
 inline float SoundInstance::GetVolume() const
@@ -79,9 +87,9 @@ inline float SoundInstance::GetVolume() const
     return m_Volume;
 }
 
-inline void SoundInstance::SetVolume( float value )
+inline float SoundInstance::GetMinimumDistance() const
 {
-    m_Volume = value;
+    return m_MinDistance;
 }
 
 inline SoundBusSharedPtr& SoundInstance::GetSoundBus()
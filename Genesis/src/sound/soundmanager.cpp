@@ -17,6 +17,11 @@
 
 #include "sound/soundmanager.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include <glm/geometric.hpp>
+
 // clang-format off
 #include "beginexternalheaders.h"
 #include <soloud.h>
@@ -28,6 +33,7 @@
 #include "resources/resourceplaylist.h"
 #include "resources/resourcesound.h"
 #include "sound/soundbus.h"
+#include "sound/soundcache.h"
 #include "sound/soundinstance.h"
 #include "sound/window.h"
 #include "configuration.h"
@@ -42,14 +48,28 @@ SoundManager::SoundManager()
 : m_Initialized( false )
 , m_ListenerPosition( 0.0f )
 , m_pPlaylist( nullptr )
+, m_pNextTrack( nullptr )
 , m_PlaylistShuffle( false )
+, m_MasterVolume( -1.0f )
+, m_CulledSoundCount( 0 )
+, m_CoalescedSoundCount( 0 )
 {
+    m_pDebugWindow = std::make_unique<Window>(this);
     g_pSoloud = std::make_unique<SoLoud::Soloud>();
+
+    // Headless runs have no audio device. Leaving SoLoud uninitialised turns every sound request into a no-op.
+    if ( FrameWork::IsHeadless() )
+    {
+        Genesis::FrameWork::GetLogger()->LogInfo( "Running headless, audio is disabled." );
+        return;
+    }
+
     int result = g_pSoloud->init();
     if ( result == ::SoLoud::SO_NO_ERROR )
     {
         m_Initialized = true;
         g_pSoloud->setMaxActiveVoiceCount( 64u );
+        m_pSoundCache = std::make_unique<SoundCache>();
 
         for ( size_t i = 0; i < static_cast<size_t>( SoundBus::Type::Count ); ++i )
         {
@@ -60,8 +80,6 @@ SoundManager::SoundManager()
     {
         Genesis::FrameWork::GetLogger()->LogWarning( "Failed to initialize SoLoud audio library: %s [%s]", g_pSoloud->getErrorString( result ), SDL_GetError() );
     }
-
-    m_pDebugWindow = std::make_unique<Window>(this);
 }
 
 SoundManager::~SoundManager()
@@ -80,6 +98,7 @@ TaskStatus SoundManager::Update( float delta )
     {
         g_pSoloud->update3dAudio();
         m_SoundInstances.remove_if( []( const SoundInstanceSharedPtr& pInstance ) { return !pInstance->IsValid(); } );
+        m_FrameSounds.clear();
         UpdatePlaylist();
         UpdateVolumes();
     }
@@ -96,7 +115,13 @@ SoundInstanceSharedPtr SoundManager::CreateSoundInstance( ResourceSound* pResour
     }
     else if ( pResourceSound->Is3D() && position.has_value() == false )
     {
-        FrameWork::GetLogger()->LogWarning( "Attempting to play ResourceSound '%s' has a 3D sound with no position.", pResourceSound->GetFilename().GetFullPath().c_str() );
+        FrameWork::GetLogger()->LogWarning( LogCategory::Sound, "Attempting to play ResourceSound '%s' has a 3D sound with no position.", pResourceSound->GetFilename().GetFullPath().c_str() );
+        return nullptr;
+    }
+    else if ( bus == SoundBus::Type::SFX && Coalesce( pResourceSound, position ) )
+    {
+        // Merged into a voice started earlier this frame which nothing else holds on to. The caller gets no instance,
+        // as it couldn't control the shared voice independently anyway.
         return nullptr;
     }
     else if ( pResourceSound->CanInstance() == false )
@@ -105,55 +130,78 @@ SoundInstanceSharedPtr SoundManager::CreateSoundInstance( ResourceSound* pResour
     }
     else
     {
-        ::SoLoud::AudioSource* pAudioSourceRaw = nullptr;
-        auto audioSourceIt = m_AudioSources.find( pResourceSound->GetFilename().GetFullPath() );
-        if ( audioSourceIt == m_AudioSources.end() )
+        std::shared_ptr<SoLoud::AudioSource> pAudioSource = GetAudioSource( pResourceSound, bus );
+        if ( pAudioSource == nullptr )
         {
-            int result = SoLoud::UNKNOWN_ERROR;
-            std::shared_ptr<SoLoud::AudioSource> pAudioSource;
-            if ( pResourceSound->IsStreamed() )
-            {
-                pAudioSource = std::make_shared<::SoLoud::WavStream>();
-                pAudioSourceRaw = pAudioSource.get();
-                result = reinterpret_cast<::SoLoud::WavStream*>( pAudioSourceRaw )->load( pResourceSound->GetFilename().GetFullPath().c_str() );
-            }
-            else
-            {
-                pAudioSource = std::make_shared<::SoLoud::Wav>();
-                pAudioSourceRaw = pAudioSource.get();
-                result = reinterpret_cast<::SoLoud::Wav*>( pAudioSourceRaw )->load( pResourceSound->GetFilename().GetFullPath().c_str() );
-            }
-
-            if ( result == SoLoud::SO_NO_ERROR )
-            {
-                // The attenuation model has to be explicitly set, as the default is not to attenuate over distance.
-                if ( pResourceSound->Is3D() )
-                {
-                    pAudioSource->set3dAttenuation( SoLoud::AudioSource::INVERSE_DISTANCE, 1.0f );
-                }
-
-                m_AudioSources[ pResourceSound->GetFilename().GetFullPath().c_str() ] = pAudioSource;
-            }
-            else
-            {
-                Genesis::FrameWork::GetLogger()->LogError( "SoundManager::CreateSoundInstance ('%s'): %s", pResourceSound->GetFilename().GetFullPath().c_str(), g_pSoloud->getErrorString( result ) );
-                return nullptr;
-            }
+            return nullptr;
         }
-        else
+        else if ( bus == SoundBus::Type::SFX && ReserveVoice( GetVoiceScore( position, minDistance, 1.0f, 0.0f ) ) == false )
         {
-            pAudioSourceRaw = audioSourceIt->second.get();
+            m_CulledSoundCount++;
+            return nullptr;
         }
 
         SoundInstanceSharedPtr pInstance = std::make_shared<SoundInstance>();
         SoundBusSharedPtr pSoundBus = m_Buses[ static_cast<size_t>( bus ) ];
-        pInstance->Initialise( pResourceSound, pSoundBus, pAudioSourceRaw, position, minDistance, maxDistance );
+        pInstance->Initialise( pResourceSound, pSoundBus, pAudioSource.get(), position, minDistance, maxDistance );
         m_SoundInstances.push_back( pInstance );
         pResourceSound->SetInstancingTimePoint();
+
+        if ( bus == SoundBus::Type::SFX && pResourceSound->IsLooping() == false )
+        {
+            m_FrameSounds.push_back( { pResourceSound, position, minDistance, pInstance, 1u } );
+        }
+
         return pInstance;
     }
 }
 
+// Streamed sounds get their own WavStream, everything else shares the decoded samples in the sound cache.
+// Returns nullptr if the sound is still being decoded.
+std::shared_ptr<SoLoud::AudioSource> SoundManager::GetAudioSource( ResourceSound* pResourceSound, SoundBus::Type bus )
+{
+    const std::string& path = pResourceSound->GetFilename().GetFullPath();
+    unsigned int result = SoLoud::SO_NO_ERROR;
+    std::shared_ptr<SoLoud::AudioSource> pAudioSource;
+    if ( pResourceSound->IsStreamed() )
+    {
+        auto audioSourceIt = m_AudioSources.find( path );
+        if ( audioSourceIt != m_AudioSources.end() )
+        {
+            pAudioSource = audioSourceIt->second;
+        }
+        else
+        {
+            std::shared_ptr<SoLoud::WavStream> pWavStream = std::make_shared<SoLoud::WavStream>();
+            result = pWavStream->load( path.c_str() );
+            if ( result == SoLoud::SO_NO_ERROR )
+            {
+                m_AudioSources[ path ] = pWavStream;
+                pAudioSource = pWavStream;
+            }
+        }
+    }
+    else
+    {
+        // A sound effect is only worth playing straight away, while music is retried every frame until its track has been decoded.
+        const std::chrono::milliseconds timeout = ( bus == SoundBus::Type::SFX ) ? sSoundCacheRequestTimeout : std::chrono::milliseconds( 0 );
+        pAudioSource = m_pSoundCache->Get( path, timeout, result );
+    }
+
+    if ( result != SoLoud::SO_NO_ERROR )
+    {
+        Genesis::FrameWork::GetLogger()->LogError( "SoundManager::CreateSoundInstance ('%s'): %s", path.c_str(), g_pSoloud->getErrorString( result ) );
+        return nullptr;
+    }
+    else if ( pAudioSource != nullptr && pResourceSound->Is3D() )
+    {
+        // The attenuation model has to be explicitly set, as the default is not to attenuate over distance.
+        pAudioSource->set3dAttenuation( SoLoud::AudioSource::INVERSE_DISTANCE, 1.0f );
+    }
+
+    return pAudioSource;
+}
+
 void SoundManager::SetPlaylist( ResourcePlaylist* pResourcePlaylist, bool shuffle )
 {
     if ( pResourcePlaylist == m_pPlaylist )
@@ -165,6 +213,7 @@ void SoundManager::SetPlaylist( ResourcePlaylist* pResourcePlaylist, bool shuffl
     // There's no need to start playing the first track here, that will be handled in the next Update().
     m_pPlaylist = pResourcePlaylist;
     m_PlaylistShuffle = shuffle;
+    m_pNextTrack = nullptr;
 
     if ( m_pCurrentTrack != nullptr && m_pCurrentTrack->IsValid() )
     {
@@ -229,10 +278,19 @@ void SoundManager::UpdatePlaylist()
     {
         if ( m_pCurrentTrack == nullptr || m_pCurrentTrack->IsValid() == false )
         {
-            ResourceSound* pNextTrackResource = pPlaylist->GetNextTrack( m_PlaylistShuffle );
-            if ( pNextTrackResource )
+            // The next track is kept until it can be played, as it might still be being decoded.
+            if ( m_pNextTrack == nullptr )
+            {
+                m_pNextTrack = pPlaylist->GetNextTrack( m_PlaylistShuffle );
+            }
+
+            if ( m_pNextTrack )
             {
-                m_pCurrentTrack = FrameWork::GetSoundManager()->CreateSoundInstance( pNextTrackResource, SoundBus::Type::Music );
+                m_pCurrentTrack = FrameWork::GetSoundManager()->CreateSoundInstance( m_pNextTrack, SoundBus::Type::Music );
+                if ( m_pCurrentTrack != nullptr )
+                {
+                    m_pNextTrack = nullptr;
+                }
             }
         }
     }
@@ -247,19 +305,135 @@ void SoundManager::UpdateVolumes()
 
     const float sfxVolume = static_cast<float>( Configuration::GetSFXVolume() / 100.0f );
     SDL_assert( sfxVolume >= 0.0f && sfxVolume <= 1.0f );
-    m_Buses[ static_cast<size_t>( SoundBus::Type::SFX ) ]->SetVolume( sfxVolume );
-
     const float musicVolume = static_cast<float>( Configuration::GetMusicVolume() / 100.0f );
     SDL_assert( musicVolume >= 0.0f && musicVolume <= 1.0f );
-    m_Buses[ static_cast<size_t>( SoundBus::Type::Music ) ]->SetVolume( musicVolume );
-
     const float masterVolume = static_cast<float>( Configuration::GetMasterVolume() / 100.0f );
 
+    // Instances get the right volume when they start playing, so they only need to be updated when the settings change.
+    SoundBus* pSFXBus = m_Buses[ static_cast<size_t>( SoundBus::Type::SFX ) ].get();
+    SoundBus* pMusicBus = m_Buses[ static_cast<size_t>( SoundBus::Type::Music ) ].get();
+    if ( pSFXBus->GetVolume() == sfxVolume && pMusicBus->GetVolume() == musicVolume && m_MasterVolume == masterVolume )
+    {
+        return;
+    }
+
+    pSFXBus->SetVolume( sfxVolume );
+    pMusicBus->SetVolume( musicVolume );
+    m_MasterVolume = masterVolume;
+
     for ( auto& pSoundInstance : m_SoundInstances )
     {
-        float volume = pSoundInstance->GetVolume() * pSoundInstance->GetSoundBus()->GetVolume() * masterVolume;
-        g_pSoloud->setVolume( pSoundInstance->m_Handle, volume );
+        pSoundInstance->ApplyVolume();
+    }
+}
+
+// How much a voice matters: its volume, attenuated by the distance to the listener in the same way
+// SoLoud's inverse distance model does, and reduced the longer the voice has been playing.
+float SoundManager::GetVoiceScore( const std::optional<glm::vec3>& position, float minDistance, float volume, float age ) const
+{
+    float gain = volume;
+    if ( position.has_value() )
+    {
+        const float distance = glm::distance( position.value(), m_ListenerPosition );
+        const float referenceDistance = std::max( minDistance, 1.0f );
+        if ( distance > referenceDistance )
+        {
+            gain *= referenceDistance / distance;
+        }
+    }
+
+    return gain / ( 1.0f + age );
+}
+
+// Merges the request into a voice for the same sound which was started this frame close enough to sound identical,
+// making that voice louder instead of starting another one. Voices whose instance is held outside the manager are
+// left alone, as their owner controls them.
+bool SoundManager::Coalesce( ResourceSound* pResourceSound, const std::optional<glm::vec3>& position )
+{
+    for ( CoalescedSound& frameSound : m_FrameSounds )
+    {
+        if ( frameSound.pResourceSound != pResourceSound )
+        {
+            continue;
+        }
+
+        if ( position.has_value() && frameSound.position.has_value() && glm::distance( position.value(), frameSound.position.value() ) > frameSound.minDistance )
+        {
+            continue;
+        }
+
+        // Anything which kept the instance (such as a continuous weapon's fire sound) will stop or move it, which would
+        // take the merged requests along with it.
+        SoundInstanceSharedPtr pInstance = frameSound.pInstance.lock();
+        if ( pInstance == nullptr || pInstance.use_count() > 2 )
+        {
+            continue;
+        }
+
+        frameSound.count++;
+        pInstance->SetVolume( std::min( sqrtf( static_cast<float>( frameSound.count ) ), sSoundMaxCoalescedVolume ) );
+        m_CoalescedSoundCount++;
+        return true;
+    }
+
+    return false;
+}
+
+// Makes sure there's room in the voice budget for a sound with the given score, stopping the least important sound
+// effect if needed. Looping sounds (such as engines) and instances held outside the manager (such as a continuous
+// weapon's fire sound) are owned by something which expects them to keep playing, so they're never stopped.
+// Returns false if the new sound is the least important one or is too quiet to be heard.
+bool SoundManager::ReserveVoice( float score )
+{
+    if ( score < sSoundMinimumAudibleGain )
+    {
+        return false;
+    }
+
+    unsigned int voiceCount = 0;
+    float lowestScore = score;
+    SoundInstanceList::iterator lowestIt = m_SoundInstances.end();
+    for ( SoundInstanceList::iterator it = m_SoundInstances.begin(), itEnd = m_SoundInstances.end(); it != itEnd; ++it )
+    {
+        SoundInstance* pInstance = it->get();
+        if ( pInstance->GetSoundBus()->GetType() != SoundBus::Type::SFX )
+        {
+            continue;
+        }
+
+        voiceCount++;
+
+        if ( pInstance->GetResource()->IsLooping() || it->use_count() > 1 )
+        {
+            continue;
+        }
+
+        const std::optional<glm::vec3> position = pInstance->GetResource()->Is3D() ? std::optional<glm::vec3>( pInstance->m_Position ) : std::nullopt;
+        const float instanceScore = GetVoiceScore( position, pInstance->GetMinimumDistance(), pInstance->GetVolume(), pInstance->GetAge() );
+        if ( instanceScore < lowestScore )
+        {
+            lowestScore = instanceScore;
+            lowestIt = it;
+        }
+    }
+
+    if ( voiceCount < sSoundVoiceBudget )
+    {
+        return true;
     }
+    else if ( lowestIt == m_SoundInstances.end() )
+    {
+        return false;
+    }
+
+    // Removed straight away rather than in the next Update(), so it doesn't count towards the budget for the rest of this frame
+    // and no other request this frame gets merged into it.
+    SoundInstance* pEvicted = lowestIt->get();
+    m_FrameSounds.erase( std::remove_if( m_FrameSounds.begin(), m_FrameSounds.end(), [ pEvicted ]( const CoalescedSound& frameSound ) { return frameSound.pInstance.lock().get() == pEvicted; } ), m_FrameSounds.end() );
+    pEvicted->Stop();
+    m_SoundInstances.erase( lowestIt );
+    m_CulledSoundCount++;
+    return true;
 }
 
 } // namespace Genesis::Sound
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <list>
 #include <memory>
 #include <optional>
@@ -27,6 +28,7 @@
 #include <glm/vec3.hpp>
 
 #include "sound/soundbus.h"
+#include "sound/soundcache.h"
 #include "taskmanager.h"
 
 namespace SoLoud
@@ -50,6 +52,16 @@ using SoundInstanceList = std::list<SoundInstanceSharedPtr>;
 using ResourceSoundVector = std::vector<ResourceSound*>;
 class Window;
 
+// Hard limit on the number of SFX voices. Music isn't included, and SoLoud's own limit is kept above this so
+// the music and the buses always have room.
+static const unsigned int sSoundVoiceBudget = 48;
+// 3D sound effects which would be quieter than this at the listener's position aren't played at all.
+static const float sSoundMinimumAudibleGain = 0.02f;
+// Identical sounds requested within the same frame play as one voice, its volume growing with the number of requests up to this.
+static const float sSoundMaxCoalescedVolume = 2.0f;
+// How long a sound effect which is still being decoded is waited for before it is skipped.
+static const std::chrono::milliseconds sSoundCacheRequestTimeout( 2 );
+
 class SoundManager : public Task
 {
 public:
@@ -65,6 +77,7 @@ public:
     SoundInstanceSharedPtr GetCurrentTrack() const;
 
     const SoundInstanceList& GetSoundInstances() const;
+    SoundCache* GetSoundCache() const; // nullptr if audio is disabled.
 
     void SetListener( const glm::vec3& position, const glm::vec3& velocity, const glm::vec3& forward, const glm::vec3& up );
     glm::vec3 GetListenerPosition() const;
@@ -72,22 +85,59 @@ public:
     unsigned int GetActiveSoundCount() const;
     unsigned int GetMaximumSoundCount() const;
     unsigned int GetVirtualSoundCount() const;
+    unsigned int GetCulledSoundCount() const;
+    unsigned int GetCoalescedSoundCount() const;
 
 private:
+    struct CoalescedSound
+    {
+        ResourceSound* pResourceSound;
+        std::optional<glm::vec3> position;
+        float minDistance;
+        SoundInstanceWeakPtr pInstance; // Weak, so only references from outside the manager add to its use count.
+        unsigned int count;
+    };
+
     void UpdatePlaylist();
     void UpdateVolumes();
+    std::shared_ptr<::SoLoud::AudioSource> GetAudioSource( ResourceSound* pResourceSound, SoundBus::Type bus );
+    float GetVoiceScore( const std::optional<glm::vec3>& position, float minDistance, float volume, float age ) const;
+    bool Coalesce( ResourceSound* pResourceSound, const std::optional<glm::vec3>& position );
+    bool ReserveVoice( float score );
 
     bool m_Initialized;
     glm::vec3 m_ListenerPosition;
     SoundInstanceList m_SoundInstances;
     ResourcePlaylist* m_pPlaylist;
+    ResourceSound* m_pNextTrack;
     SoundInstanceSharedPtr m_pCurrentTrack;
     bool m_PlaylistShuffle;
 
     std::unique_ptr<Window> m_pDebugWindow;
     std::array<SoundBusSharedPtr, static_cast<size_t>(SoundBus::Type::Count)> m_Buses;
-    std::unordered_map<std::string, std::shared_ptr<::SoLoud::AudioSource>> m_AudioSources;
+    std::unordered_map<std::string, std::shared_ptr<::SoLoud::AudioSource>> m_AudioSources; // Streamed sounds only.
+    std::unique_ptr<SoundCache> m_pSoundCache;
+
+    std::vector<CoalescedSound> m_FrameSounds; // Sound effects started this frame which other requests can be merged into.
+    float m_MasterVolume;
+    unsigned int m_CulledSoundCount;
+    unsigned int m_CoalescedSoundCount;
 };
 
+inline SoundCache* SoundManager::GetSoundCache() const
+{
+    return m_pSoundCache.get();
+}
+
+inline unsigned int SoundManager::GetCulledSoundCount() const
+{
+    return m_CulledSoundCount;
+}
+
+inline unsigned int SoundManager::GetCoalescedSoundCount() const
+{
+    return m_CoalescedSoundCount;
+}
+
 } // namespace Sound
 } // namespace Genesis
\ No newline at end of file
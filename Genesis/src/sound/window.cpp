@@ -54,6 +54,25 @@ void Window::Update( float delta )
 		{
 			ImGui::Text("Active voices: %u / %u", m_pSoundManager->GetActiveSoundCount(), m_pSoundManager->GetMaximumSoundCount());
 			ImGui::Text("Virtual voices: %u", m_pSoundManager->GetVirtualSoundCount());
+			ImGui::Text("SFX voice budget: %u", sSoundVoiceBudget);
+			ImGui::Text("Culled sounds: %u", m_pSoundManager->GetCulledSoundCount());
+			ImGui::Text("Coalesced sounds: %u", m_pSoundManager->GetCoalescedSoundCount());
+		}
+
+		if (ImGui::CollapsingHeader("Sound cache", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			SoundCache* pSoundCache = m_pSoundManager->GetSoundCache();
+			if ( pSoundCache )
+			{
+				const float toMB = 1.0f / ( 1024.0f * 1024.0f );
+				ImGui::Text( "Decoded memory: %.1f / %.1f MB", pSoundCache->GetMemoryUsage() * toMB, sSoundCacheMaxBytes * toMB );
+				ImGui::Text( "Decoded sounds: %zu", pSoundCache->GetSoundCount() );
+				ImGui::Text( "Decoding: %zu", pSoundCache->GetDecodingCount() );
+			}
+			else
+			{
+				ImGui::TextDisabled( "%s", "Audio is disabled." );
+			}
 		}
 
 		if (ImGui::CollapsingHeader("Playlist", ImGuiTreeNodeFlags_DefaultOpen))
@@ -0,0 +1,205 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Genesis.
+//
+// Genesis is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Genesis is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Genesis. If not, see <http://www.gnu.org/licenses/>.
+
+#include "streamingvertexbuffer.h"
+
+#include <cstddef>
+
+#include "genesis.h"
+#include "rendersystem.h"
+
+namespace Genesis
+{
+
+StreamingVertexBuffer::StreamingVertexBuffer( GeometryType type, unsigned int flags, uint32_t maxVerticesPerFrame )
+    : m_Flags( flags )
+    , m_Mode( GL_TRIANGLES )
+    , m_VAO( 0 )
+    , m_Buffer( 0 )
+    , m_MaxVerticesPerFrame( maxVerticesPerFrame )
+    , m_Persistent( false )
+    , m_pPersistentData( nullptr )
+    , m_Frame( 0 )
+    , m_Region( 0 )
+    , m_RegionUsed( 0 )
+    , m_pMapped( nullptr )
+    , m_MappedFirst( 0 )
+    , m_MappedCount( 0 )
+{
+    SDL_assert( maxVerticesPerFrame > 0 );
+    SDL_assert( ( flags & ( VBO_NORMAL | VB_2D ) ) == 0 );
+
+    if ( type == GeometryType::Line )
+    {
+        m_Mode = GL_LINES;
+    }
+    else if ( type == GeometryType::LineStrip )
+    {
+        m_Mode = GL_LINE_STRIP;
+    }
+
+    m_RegionFrames.fill( 0 );
+
+    // Without a GL context the vertices are written to system memory, which behaves like a persistently
+    // mapped buffer as far as Map() and Unmap() are concerned.
+    if ( FrameWork::IsHeadless() )
+    {
+        m_HostData.resize( static_cast<size_t>( maxVerticesPerFrame ) * sStreamingBufferFrames );
+        m_pPersistentData = m_HostData.data();
+        m_Persistent = true;
+        return;
+    }
+
+    glGenVertexArrays( 1, &m_VAO );
+    glBindVertexArray( m_VAO );
+
+    glGenBuffers( 1, &m_Buffer );
+    glBindBuffer( GL_ARRAY_BUFFER, m_Buffer );
+
+    const GLsizeiptr size = static_cast<GLsizeiptr>( sizeof( StreamingVertex ) ) * maxVerticesPerFrame * sStreamingBufferFrames;
+    if ( GLEW_ARB_buffer_storage )
+    {
+        const GLbitfield mapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage( GL_ARRAY_BUFFER, size, nullptr, mapFlags );
+        m_pPersistentData = static_cast<StreamingVertex*>( glMapBufferRange( GL_ARRAY_BUFFER, 0, size, mapFlags ) );
+        m_Persistent = ( m_pPersistentData != nullptr );
+    }
+
+    if ( m_Persistent == false )
+    {
+        glBufferData( GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW );
+    }
+
+    // The attribute layout never changes, so it is set up once in the VAO.
+    const GLsizei stride = sizeof( StreamingVertex );
+    glEnableVertexAttribArray( 0 );
+    glVertexAttribPointer( 0, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof( StreamingVertex, position ) );
+
+    if ( flags & VBO_UV )
+    {
+        glEnableVertexAttribArray( 1 );
+        glVertexAttribPointer( 1, 2, GL_FLOAT, GL_FALSE, stride, (void*)offsetof( StreamingVertex, uv ) );
+    }
+
+    if ( flags & VBO_COLOR )
+    {
+        glEnableVertexAttribArray( 3 );
+        glVertexAttribPointer( 3, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof( StreamingVertex, color ) );
+    }
+
+    glBindVertexArray( 0 );
+}
+
+StreamingVertexBuffer::~StreamingVertexBuffer()
+{
+    if ( m_VAO == 0 )
+    {
+        return;
+    }
+
+    if ( m_Persistent )
+    {
+        glBindBuffer( GL_ARRAY_BUFFER, m_Buffer );
+        glUnmapBuffer( GL_ARRAY_BUFFER );
+    }
+
+    glDeleteBuffers( 1, &m_Buffer );
+    glDeleteVertexArrays( 1, &m_VAO );
+}
+
+StreamingVertex* StreamingVertexBuffer::Map( uint32_t vertexCount, uint32_t& firstVertex )
+{
+    SDL_assert( m_pMapped == nullptr );
+
+    const uint64_t frame = FrameWork::GetRenderSystem()->GetFrameIndex();
+    if ( frame != m_Frame )
+    {
+        BeginFrame( frame );
+    }
+
+    if ( vertexCount == 0 || m_RegionUsed + vertexCount > m_MaxVerticesPerFrame )
+    {
+        return nullptr;
+    }
+
+    m_MappedFirst = m_Region * m_MaxVerticesPerFrame + m_RegionUsed;
+    m_MappedCount = vertexCount;
+    firstVertex = m_MappedFirst;
+
+    if ( m_Persistent )
+    {
+        m_pMapped = m_pPersistentData + m_MappedFirst;
+    }
+    else
+    {
+        // The fence waited on in BeginFrame() guarantees the GPU is no longer reading from this range.
+        const GLbitfield mapFlags = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+        glBindBuffer( GL_ARRAY_BUFFER, m_Buffer );
+        m_pMapped = static_cast<StreamingVertex*>( glMapBufferRange( GL_ARRAY_BUFFER, m_MappedFirst * sizeof( StreamingVertex ), vertexCount * sizeof( StreamingVertex ), mapFlags ) );
+    }
+
+    return m_pMapped;
+}
+
+void StreamingVertexBuffer::Unmap( uint32_t vertexCount )
+{
+    SDL_assert( m_pMapped != nullptr );
+    SDL_assert( vertexCount <= m_MappedCount );
+
+    if ( m_Persistent == false )
+    {
+        glBindBuffer( GL_ARRAY_BUFFER, m_Buffer );
+        glUnmapBuffer( GL_ARRAY_BUFFER );
+    }
+
+    m_RegionUsed += vertexCount;
+    m_pMapped = nullptr;
+}
+
+void StreamingVertexBuffer::Draw( uint32_t firstVertex, uint32_t vertexCount )
+{
+    SDL_assert( m_pMapped == nullptr );
+
+    if ( vertexCount == 0 )
+    {
+        return;
+    }
+
+    // Vertices are normally drawn in the frame they were written in, but if they are drawn again later
+    // (e.g. while the game is paused) the region must not be reused until those draws are done too.
+    m_RegionFrames[ firstVertex / m_MaxVerticesPerFrame ] = FrameWork::GetRenderSystem()->GetFrameIndex();
+
+    glBindVertexArray( m_VAO );
+    glDrawArrays( m_Mode, firstVertex, vertexCount );
+    glBindVertexArray( 0 );
+
+    FrameWork::GetRenderSystem()->IncreaseDrawCallCount();
+}
+
+void StreamingVertexBuffer::BeginFrame( uint64_t frame )
+{
+    m_Frame = frame;
+    m_Region = static_cast<uint32_t>( frame % sStreamingBufferFrames );
+    m_RegionUsed = 0;
+
+    // Wait until the GPU is done with the last frame which used this region. Normally that frame
+    // finished a while ago and this returns immediately.
+    FrameWork::GetRenderSystem()->WaitForFrame( m_RegionFrames[ m_Region ] );
+    m_RegionFrames[ m_Region ] = frame;
+}
+
+} // namespace Genesis
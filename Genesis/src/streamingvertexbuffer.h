@@ -0,0 +1,105 @@
+// Copyright 2026 Pedro Nunes
+//
+// This file is part of Genesis.
+//
+// Genesis is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Genesis is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Genesis. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include "rendersystem.fwd.h"
+#include "coredefines.h"
+#include "vertexbuffer.h"
+
+namespace Genesis
+{
+
+// Number of frames' worth of vertices kept by each StreamingVertexBuffer. The CPU can be writing one
+// region while the GPU is still reading the previous ones.
+static const unsigned int sStreamingBufferFrames = 3;
+
+struct StreamingVertex
+{
+    glm::vec3 position;
+    glm::vec2 uv;
+    glm::vec4 color;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// StreamingVertexBuffer
+// A vertex buffer for geometry which is rebuilt every frame. The vertices
+// are interleaved and written directly into mapped buffer memory, rather
+// than being gathered into separate vectors and copied into one VBO per
+// attribute.
+// The buffer is split into one region per frame in flight. Before a region
+// is reused, the RenderSystem's fence for the frame which last used it is
+// waited on, so the mapping never needs to synchronise with the driver.
+// When GL_ARB_buffer_storage is available the buffer is persistently mapped,
+// otherwise each Map() maps the requested range unsynchronised.
+///////////////////////////////////////////////////////////////////////////////
+
+class StreamingVertexBuffer
+{
+public:
+    // Flags select which of VBO_UV and VBO_COLOR are fed to the shader. Positions are always used.
+    StreamingVertexBuffer( GeometryType type, unsigned int flags, uint32_t maxVerticesPerFrame );
+    ~StreamingVertexBuffer();
+
+    // Returns space for vertexCount vertices, to be written before calling Unmap(). firstVertex is the
+    // index to pass to Draw(). Returns nullptr if this frame's region is full.
+    StreamingVertex* Map( uint32_t vertexCount, uint32_t& firstVertex );
+    // Unmaps the vertices returned by the last Map(). vertexCount can be lower than the count which was mapped,
+    // in which case the remainder is available to the next Map().
+    void Unmap( uint32_t vertexCount );
+
+    void Draw( uint32_t firstVertex, uint32_t vertexCount );
+
+    uint32_t GetMaxVerticesPerFrame() const;
+
+private:
+    void BeginFrame( uint64_t frame );
+
+    unsigned int m_Flags;
+    GLenum m_Mode;
+    GLuint m_VAO;
+    GLuint m_Buffer;
+    uint32_t m_MaxVerticesPerFrame;
+    bool m_Persistent;
+    StreamingVertex* m_pPersistentData;
+    std::vector<StreamingVertex> m_HostData; // Only used when running headless.
+
+    uint64_t m_Frame;
+    uint32_t m_Region;
+    uint32_t m_RegionUsed;
+    std::array<uint64_t, sStreamingBufferFrames> m_RegionFrames;
+
+    StreamingVertex* m_pMapped;
+    uint32_t m_MappedFirst;
+    uint32_t m_MappedCount;
+};
+GENESIS_DECLARE_SMART_PTR( StreamingVertexBuffer );
+
+inline uint32_t StreamingVertexBuffer::GetMaxVerticesPerFrame() const
+{
+    return m_MaxVerticesPerFrame;
+}
+
+} // namespace Genesis
@@ -1,7 +1,11 @@
+#include <algorithm>
+
 #include "imgui/imgui_impl.h"
 #include "taskmanager.h"
 #include "genesis.h"
+#include "jobsystem.h"
 #include "memory.h"
+#include "profiling/profiler.h"
 #include "timer.h"
 
 namespace Genesis
@@ -13,18 +17,35 @@ namespace Genesis
 TaskManager::TaskManager()
     : mIsRunning( true )
     , mLogger( nullptr )
+    , m_FixedTimeStep( 1.0f / 60.0f )
+    , m_FixedStepAccumulator( 0.0f )
+    , m_FixedTickCount( 0 )
+    , m_GraphDirty( true )
+    , m_TasksRemoved( false )
+    , m_BandTasksRemaining( 0 )
 {
+    m_pJobSystem = std::make_unique<JobSystem>();
 }
 
 // Receives a Logger so we can use PrintTasks()
 TaskManager::TaskManager( Logger* logger )
     : mIsRunning( true )
     , mLogger( logger )
+    , m_FixedTimeStep( 1.0f / 60.0f )
+    , m_FixedStepAccumulator( 0.0f )
+    , m_FixedTickCount( 0 )
+    , m_GraphDirty( true )
+    , m_TasksRemoved( false )
+    , m_BandTasksRemaining( 0 )
 {
+    m_pJobSystem = std::make_unique<JobSystem>();
 }
 
 TaskManager::~TaskManager()
 {
+    // Make sure no worker is still holding on to a task before deleting them.
+    m_pJobSystem = nullptr;
+
     for ( auto& pTask : mTasks )
     {
         delete pTask;
@@ -32,6 +53,16 @@ TaskManager::~TaskManager()
 }
 
 void TaskManager::AddTask( const std::string& name, Task* task, TaskFunc func, TaskPriority priority )
+{
+    AddTask( name, task, func, priority, TaskAccess() );
+}
+
+void TaskManager::AddTask( const std::string& name, Task* task, TaskFunc func, TaskPriority priority, const TaskAccess& access )
+{
+    AddTask( name, task, func, priority, access, TaskRate::Variable );
+}
+
+void TaskManager::AddTask( const std::string& name, Task* task, TaskFunc func, TaskPriority priority, const TaskAccess& access, TaskRate rate )
 {
     if ( task == nullptr )
     {
@@ -40,10 +71,19 @@ void TaskManager::AddTask( const std::string& name, Task* task, TaskFunc func, T
 
     TaskInfo* info = new TaskInfo();
     info->name = name;
+    info->profilerName = ( FrameWork::GetProfiler() == nullptr ) ? nullptr : FrameWork::GetProfiler()->RegisterName( name );
     info->task = task;
     info->func = func;
     info->priority = priority;
+    info->access = access;
+    info->rate = rate;
     info->remove = false;
+    info->dependencyCount = 0;
+    info->pendingDependencies = 0;
+
+    // The bands are only rebuilt at the start of the next Update(), as this
+    // can be called by a task while the current bands are being processed.
+    m_GraphDirty = true;
 
     // The task list is empty - just add it to the list, nothing else is
     // needed.
@@ -76,12 +116,18 @@ void TaskManager::PrintTasks() const
 {
     if ( mLogger != nullptr )
     {
-        mLogger->LogInfo( "Tasks running: " );
+        mLogger->LogInfo( "Tasks running (%u workers): ", m_pJobSystem->GetWorkerCount() );
         TaskInfoList::const_iterator it = mTasks.begin();
         TaskInfoList::const_iterator itEnd = mTasks.end();
         while ( it != itEnd )
         {
-            mLogger->LogInfo( "%d: %s", ( int32_t )( *it )->priority, ( *it )->name.c_str() );
+            const TaskInfo* pInfo = *it;
+            mLogger->LogInfo( "%d: %s (%s, %s, %d dependencies)",
+                ( int32_t )pInfo->priority,
+                pInfo->name.c_str(),
+                pInfo->access.affinity == TaskAffinity::MainThread ? "main thread" : "any thread",
+                pInfo->rate == TaskRate::Fixed ? "fixed rate" : "variable rate",
+                pInfo->dependencyCount );
             it++;
         }
     }
@@ -90,31 +136,214 @@ void TaskManager::PrintTasks() const
 void TaskManager::Update()
 {
     m_Timer.Update();
-    const float delta = m_Timer.GetDelta();
+    Update( m_Timer.GetDelta() );
+}
 
-    bool tasksRemoved = false;
-    TaskInfoList::const_iterator it = mTasks.begin();
-    TaskInfoList::const_iterator itEnd = mTasks.end();
-    while ( it != itEnd )
+void TaskManager::Update( float delta )
+{
+    GENESIS_PROFILE_ZONE( "TaskManager::Update" );
+
+    if ( m_GraphDirty )
     {
-        Task* task = ( *it )->task;
-        TaskFunc func = ( *it )->func;
-        if ( ( *task.*func )( delta ) == TaskStatus::Stop )
+        BuildTaskGraph();
+    }
+
+    m_TasksRemoved = false;
+    bool fixedTicksDone = false;
+    for ( const TaskBand& band : m_Bands )
+    {
+        if ( fixedTicksDone == false && band.priority != TaskPriority::System )
         {
-            tasksRemoved = true;
-            ( *it )->remove = true;
+            UpdateFixedTicks( delta );
+            fixedTicksDone = true;
         }
-        it++;
+        UpdateBand( band.variableRateTasks, delta );
+    }
+
+    if ( fixedTicksDone == false )
+    {
+        UpdateFixedTicks( delta );
     }
 
     // Only call RemoveMarkedTasks if any task has been stopped during
     // this update.
-    if ( tasksRemoved )
+    if ( m_TasksRemoved )
     {
         RemoveMarkedTasks();
     }
 }
 
+void TaskManager::UpdateFixedTicks( float delta )
+{
+    m_FixedStepAccumulator = std::min( m_FixedStepAccumulator + delta, m_FixedTimeStep * sMaxFixedTicksPerUpdate );
+    while ( m_FixedStepAccumulator >= m_FixedTimeStep )
+    {
+        GENESIS_PROFILE_ZONE( "TaskManager::FixedTick" );
+        m_FixedTickCount++;
+        for ( const TaskBand& band : m_Bands )
+        {
+            UpdateBand( band.fixedRateTasks, m_FixedTimeStep );
+        }
+        m_FixedStepAccumulator -= m_FixedTimeStep;
+    }
+}
+
+// Splits the task list into bands of tasks sharing the same priority, with
+// the fixed and variable rate tasks of each band kept apart as they never
+// run at the same time.
+void TaskManager::BuildTaskGraph()
+{
+    m_Bands.clear();
+    for ( TaskInfo* pInfo : mTasks )
+    {
+        if ( m_Bands.empty() || m_Bands.back().priority != pInfo->priority )
+        {
+            m_Bands.push_back( { pInfo->priority, {}, {} } );
+        }
+
+        TaskBand& band = m_Bands.back();
+        ( pInfo->rate == TaskRate::Fixed ? band.fixedRateTasks : band.variableRateTasks ).push_back( pInfo );
+    }
+
+    for ( TaskBand& band : m_Bands )
+    {
+        BuildTaskGraph( band.fixedRateTasks );
+        BuildTaskGraph( band.variableRateTasks );
+    }
+
+    m_GraphDirty = false;
+}
+
+// Makes every task depend on any earlier task it conflicts with. Registration
+// order is therefore always a valid execution order.
+void TaskManager::BuildTaskGraph( TaskInfoVector& tasks )
+{
+    const size_t taskCount = tasks.size();
+    for ( size_t i = 0; i < taskCount; ++i )
+    {
+        tasks[ i ]->dependents.clear();
+        tasks[ i ]->dependencyCount = 0;
+        for ( size_t j = 0; j < i; ++j )
+        {
+            if ( tasks[ j ]->access.ConflictsWith( tasks[ i ]->access ) )
+            {
+                tasks[ j ]->dependents.push_back( tasks[ i ] );
+                tasks[ i ]->dependencyCount++;
+            }
+        }
+    }
+}
+
+void TaskManager::UpdateBand( const TaskInfoVector& band, float delta )
+{
+    // If nothing in this band can leave the main thread, registration order
+    // is all we need and there is no point in going through the scheduler.
+    bool serial = true;
+    for ( TaskInfo* pInfo : band )
+    {
+        if ( pInfo->access.affinity == TaskAffinity::AnyThread )
+        {
+            serial = false;
+            break;
+        }
+    }
+
+    if ( serial )
+    {
+        for ( TaskInfo* pInfo : band )
+        {
+            RunTask( pInfo, delta );
+        }
+        return;
+    }
+
+    m_BandTasksRemaining = static_cast<int>( band.size() );
+    for ( TaskInfo* pInfo : band )
+    {
+        pInfo->pendingDependencies = pInfo->dependencyCount;
+    }
+
+    for ( TaskInfo* pInfo : band )
+    {
+        if ( pInfo->dependencyCount == 0 )
+        {
+            Schedule( pInfo, delta );
+        }
+    }
+
+    // The main thread runs any tasks bound to it as they become ready and
+    // helps the workers with the rest while it waits for the band to finish.
+    while ( m_BandTasksRemaining > 0 )
+    {
+        TaskInfo* pMainThreadTask = nullptr;
+        {
+            std::lock_guard<std::mutex> lock( m_MainThreadQueueMutex );
+            if ( m_MainThreadQueue.empty() == false )
+            {
+                pMainThreadTask = m_MainThreadQueue.front();
+                m_MainThreadQueue.erase( m_MainThreadQueue.begin() );
+            }
+        }
+
+        if ( pMainThreadTask != nullptr )
+        {
+            RunTask( pMainThreadTask, delta );
+            OnTaskFinished( pMainThreadTask, delta );
+        }
+        else if ( m_pJobSystem->RunPendingJob() == false )
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void TaskManager::RunTask( TaskInfo* pInfo, float delta )
+{
+    // A fixed rate task which stopped during an earlier tick of this update must not run again.
+    if ( pInfo->remove )
+    {
+        return;
+    }
+
+    GENESIS_PROFILE_ZONE( pInfo->profilerName != nullptr ? pInfo->profilerName : "Unnamed task" );
+    Task* task = pInfo->task;
+    TaskFunc func = pInfo->func;
+    if ( ( *task.*func )( delta ) == TaskStatus::Stop )
+    {
+        pInfo->remove = true;
+        m_TasksRemoved = true;
+    }
+}
+
+void TaskManager::OnTaskFinished( TaskInfo* pInfo, float delta )
+{
+    for ( TaskInfo* pDependent : pInfo->dependents )
+    {
+        if ( pDependent->pendingDependencies.fetch_sub( 1 ) == 1 )
+        {
+            Schedule( pDependent, delta );
+        }
+    }
+
+    m_BandTasksRemaining--;
+}
+
+void TaskManager::Schedule( TaskInfo* pInfo, float delta )
+{
+    if ( pInfo->access.affinity == TaskAffinity::MainThread )
+    {
+        std::lock_guard<std::mutex> lock( m_MainThreadQueueMutex );
+        m_MainThreadQueue.push_back( pInfo );
+    }
+    else
+    {
+        m_pJobSystem->Submit( [ this, pInfo, delta ]() {
+            RunTask( pInfo, delta );
+            OnTaskFinished( pInfo, delta );
+        } );
+    }
+}
+
 void TaskManager::RemoveMarkedTasks()
 {
     TaskInfoList::iterator it = mTasks.begin();
@@ -131,5 +360,7 @@ void TaskManager::RemoveMarkedTasks()
             it = mTasks.erase( it );
         }
     }
+
+    m_GraphDirty = true;
+}
 }
-}
\ No newline at end of file
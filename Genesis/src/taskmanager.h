@@ -1,8 +1,13 @@
 #ifndef _GENESIS_TASKMANAGER_H_
 #define _GENESIS_TASKMANAGER_H_
 
+#include <atomic>
+#include <cstdint>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "timer.h"
 
@@ -17,7 +22,25 @@ namespace Genesis
 // ordered they were registered. The TaskFunc returns a TaskStatus - the
 // task will keep being updated while it returns TASK_CONTINUE. Once it
 // returns TASK_STOP, the task will be removed from the manager.
-
+//
+// Each priority is a band: every task in a band finishes before the next
+// band starts. Within a band, tasks can declare which TaskResources they
+// read and write through TaskAccess. Tasks whose accesses don't conflict
+// are run concurrently on the JobSystem, while conflicting tasks keep their
+// registration order. Tasks registered without a TaskAccess write every
+// resource and run on the main thread, so they behave exactly as if the
+// whole band ran serially.
+//
+// Tasks also have a TaskRate. Variable rate tasks run once per Update(),
+// with the time since the last one. Fixed rate tasks run once per tick,
+// always with the fixed time step: depending on how much time has been
+// accumulated, an Update() can run several ticks or none at all. The ticks
+// run after the System band, each of them going through every fixed rate
+// task in priority order, after which the variable rate tasks of the
+// remaining bands run. GetFixedStepAlpha() says how far the frame is into
+// the next tick, so anything rendered can interpolate between ticks.
+
+class JobSystem;
 class Task;
 class Logger;
 
@@ -29,12 +52,73 @@ enum class TaskPriority
     Rendering
 };
 
+enum class TaskRate
+{
+    Variable,
+    Fixed
+};
+
+// Past this many ticks in a single Update(), the simulation slows down rather
+// than spending ever longer catching up.
+static const unsigned int sMaxFixedTicksPerUpdate = 5;
+
 enum class TaskStatus
 {
     Continue,
 	Stop
 };
 
+enum class TaskResource : uint32_t
+{
+    None = 0,
+    Input = 1 << 0, // SDL event queue, InputManager state
+    ImGui = 1 << 1, // Dear ImGui frame state
+    Gui = 1 << 2, // Gui::GuiManager element tree
+    Scene = 1 << 3,
+    Sound = 1 << 4,
+    Physics = 1 << 5,
+    Video = 1 << 6,
+    GameState = 1 << 7,
+    All = 0xFFFFFFFF
+};
+
+inline TaskResource operator|( TaskResource a, TaskResource b )
+{
+    return static_cast<TaskResource>( static_cast<uint32_t>( a ) | static_cast<uint32_t>( b ) );
+}
+
+inline TaskResource operator&( TaskResource a, TaskResource b )
+{
+    return static_cast<TaskResource>( static_cast<uint32_t>( a ) & static_cast<uint32_t>( b ) );
+}
+
+enum class TaskAffinity
+{
+    MainThread, // Anything which touches the GL context, SDL's event queue or the window.
+    AnyThread
+};
+
+struct TaskAccess
+{
+    TaskAccess( TaskResource readResources = TaskResource::All, TaskResource writeResources = TaskResource::All, TaskAffinity taskAffinity = TaskAffinity::MainThread )
+        : reads( readResources )
+        , writes( writeResources )
+        , affinity( taskAffinity )
+    {
+    }
+
+    bool ConflictsWith( const TaskAccess& other ) const;
+
+    TaskResource reads;
+    TaskResource writes;
+    TaskAffinity affinity;
+};
+
+inline bool TaskAccess::ConflictsWith( const TaskAccess& other ) const
+{
+    return ( writes & ( other.reads | other.writes ) ) != TaskResource::None || ( other.writes & reads ) != TaskResource::None;
+}
+
 typedef TaskStatus ( Task::*TaskFunc )( float delta );
 
 struct TaskInfo
@@ -42,11 +126,27 @@ struct TaskInfo
     Task* task;
     TaskFunc func;
     std::string name;
+    const char* profilerName;
     TaskPriority priority;
+    TaskAccess access;
+    TaskRate rate;
     bool remove;
+
+    // Dependency graph within this task's band, rebuilt whenever the task list changes.
+    std::vector<TaskInfo*> dependents;
+    int dependencyCount;
+    std::atomic_int pendingDependencies;
 };
 
 typedef std::list<TaskInfo*> TaskInfoList;
+typedef std::vector<TaskInfo*> TaskInfoVector;
+
+struct TaskBand
+{
+    TaskPriority priority;
+    TaskInfoVector fixedRateTasks;
+    TaskInfoVector variableRateTasks;
+};
 
 class TaskManager
 {
@@ -56,22 +156,57 @@ public:
     ~TaskManager();
 
     void AddTask( const std::string& name, Task* pTask, TaskFunc func, TaskPriority priority );
+    void AddTask( const std::string& name, Task* pTask, TaskFunc func, TaskPriority priority, const TaskAccess& access );
+    void AddTask( const std::string& name, Task* pTask, TaskFunc func, TaskPriority priority, const TaskAccess& access, TaskRate rate );
     void PrintTasks() const;
     void Update();
+    void Update( float delta ); // Steps every task by a given delta, rather than by the time since the last update.
     bool IsRunning() const;
     void Stop();
 
+    void SetFixedTimeStep( float value );
+    float GetFixedTimeStep() const;
+    float GetFixedStepAlpha() const; // [0, 1): how far into the next tick the current Update() is.
+    uint64_t GetFixedTickCount() const;
+
+    JobSystem* GetJobSystem() const;
+
 private:
     void RemoveMarkedTasks();
+    void BuildTaskGraph();
+    void BuildTaskGraph( TaskInfoVector& tasks );
+    void UpdateFixedTicks( float delta );
+    void UpdateBand( const TaskInfoVector& band, float delta );
+    void RunTask( TaskInfo* pTaskInfo, float delta );
+    void OnTaskFinished( TaskInfo* pTaskInfo, float delta );
+    void Schedule( TaskInfo* pTaskInfo, float delta );
+
     TaskInfoList mTasks;
     TaskInfoList mTasksToBeRemoved;
     bool mIsRunning;
     Logger* mLogger;
     Timer m_Timer;
+
+    float m_FixedTimeStep;
+    float m_FixedStepAccumulator;
+    uint64_t m_FixedTickCount;
+
+    std::unique_ptr<JobSystem> m_pJobSystem;
+    std::vector<TaskBand> m_Bands;
+    bool m_GraphDirty;
+    std::atomic_bool m_TasksRemoved;
+    std::atomic_int m_BandTasksRemaining;
+    std::mutex m_MainThreadQueueMutex;
+    TaskInfoVector m_MainThreadQueue;
 };
 
 inline bool TaskManager::IsRunning() const { return mIsRunning; }
 inline void TaskManager::Stop() { mIsRunning = false; }
+inline void TaskManager::SetFixedTimeStep( float value ) { m_FixedTimeStep = value; }
+inline float TaskManager::GetFixedTimeStep() const { return m_FixedTimeStep; }
+inline float TaskManager::GetFixedStepAlpha() const { return m_FixedStepAccumulator / m_FixedTimeStep; }
+inline uint64_t TaskManager::GetFixedTickCount() const { return m_FixedTickCount; }
+inline JobSystem* TaskManager::GetJobSystem() const { return m_pJobSystem.get(); }
 
 class Task
 {
@@ -81,4 +216,4 @@ public:
 };
 }
 
-#endif
\ No newline at end of file
+#endif
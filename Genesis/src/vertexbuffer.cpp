@@ -15,8 +15,11 @@
 // You should have received a copy of the GNU General Public License
 // along with Genesis. If not, see <http://www.gnu.org/licenses/>.
 
+#include <algorithm>
+
 #include "vertexbuffer.h"
 #include "genesis.h"
+#include "instancebuffer.h"
 #include "rendersystem.h"
 
 namespace Genesis
@@ -33,37 +36,56 @@ VertexBuffer::VertexBuffer( GeometryType type, unsigned int flags )
     , m_UV( 0 )
     , m_Normal( 0 )
     , m_Color( 0 )
+    , m_Index( 0 )
+    , m_IndexSize( 0 )
+    , m_IndexCount( 0 )
     , m_Mode( GL_TRIANGLES )
 {
     m_Size.fill( 0 );
 
     SDL_assert( flags & VBO_POSITION );
 
-    glGenVertexArrays( 1, &m_VAO );
-    glBindVertexArray( m_VAO );
-
-    glGenBuffers( 1, &m_Position );
+    SetModeFromGeometryType( type );
 
-    if ( flags & VBO_UV )
+    // Without a GL context no GL objects are created and only the buffer sizes are tracked.
+    if ( FrameWork::IsHeadless() )
     {
-        glGenBuffers( 1, &m_UV );
+        return;
     }
 
-    if ( flags & VBO_NORMAL )
-    {
-        glGenBuffers( 1, &m_Normal );
-    }
+    glGenVertexArrays( 1, &m_VAO );
+    glBindVertexArray( m_VAO );
+
+    glGenBuffers( 1, &m_Position );
 
-    if ( flags & VBO_COLOR )
+    if ( ( flags & VB_INTERLEAVED ) == 0 )
     {
-        glGenBuffers( 1, &m_Color );
+        if ( flags & VBO_UV )
+        {
+            glGenBuffers( 1, &m_UV );
+        }
+
+        if ( flags & VBO_NORMAL )
+        {
+            glGenBuffers( 1, &m_Normal );
+        }
+
+        if ( flags & VBO_COLOR )
+        {
+            glGenBuffers( 1, &m_Color );
+        }
     }
 
-    SetModeFromGeometryType( type );
+    SetupAttributes();
 }
 
 VertexBuffer::~VertexBuffer()
 {
+    if ( m_VAO == 0 )
+    {
+        return;
+    }
+
     if ( m_Position != -1 )
     {
         glDeleteBuffers( 1, &m_Position );
@@ -84,6 +106,11 @@ VertexBuffer::~VertexBuffer()
         glDeleteBuffers( 1, &m_Color );
     }
 
+    if ( m_Index != 0 )
+    {
+        glDeleteBuffers( 1, &m_Index );
+    }
+
     glDeleteVertexArrays( 1, &m_VAO );
 }
 
@@ -107,6 +134,42 @@ void VertexBuffer::SetModeFromGeometryType( GeometryType type )
     }
 }
 
+// The VAO keeps track of which buffer and layout each attribute uses, so this only has to be done once
+// rather than on every draw. Reallocating a buffer's storage later on doesn't affect it.
+void VertexBuffer::SetupAttributes()
+{
+    const bool interleaved = ( m_Flags & VB_INTERLEAVED ) != 0;
+    const GLsizei stride = interleaved ? static_cast<GLsizei>( GetStride() ) : 0;
+    size_t offset = 0;
+
+    auto setupAttribute = [ & ]( GLuint attribute, GLuint buffer, GLint components ) {
+        glBindBuffer( GL_ARRAY_BUFFER, interleaved ? m_Position : buffer );
+        glEnableVertexAttribArray( attribute );
+        glVertexAttribPointer( attribute, components, GL_FLOAT, GL_FALSE, stride, (void*)offset );
+        if ( interleaved )
+        {
+            offset += components * sizeof( float );
+        }
+    };
+
+    setupAttribute( 0, m_Position, ( m_Flags & VB_2D ) ? 2 : 3 );
+
+    if ( m_Flags & VBO_UV )
+    {
+        setupAttribute( 1, m_UV, 2 );
+    }
+
+    if ( m_Flags & VBO_NORMAL )
+    {
+        setupAttribute( 2, m_Normal, 3 );
+    }
+
+    if ( m_Flags & VBO_COLOR )
+    {
+        setupAttribute( 3, m_Color, 4 );
+    }
+}
+
 void VertexBuffer::CreateUntexturedQuad( float x, float y, float width, float height )
 {
     const float x1 = x;
@@ -216,38 +279,79 @@ void VertexBuffer::CopyColors( const ColorData& data, size_t count )
 
 void VertexBuffer::CopyData( const float* pData, size_t size, unsigned int destination )
 {
-    size *= sizeof( float );
+    SDL_assert( ( m_Flags & VB_INTERLEAVED ) == 0 );
 
+    GLuint buffer = 0;
     if ( destination == VBO_POSITION )
     {
         SDL_assert( m_Flags & VBO_POSITION );
-        glBindBuffer( GL_ARRAY_BUFFER, m_Position );
+        buffer = m_Position;
     }
     else if ( destination == VBO_UV )
     {
         SDL_assert( m_Flags & VBO_UV );
-        glBindBuffer( GL_ARRAY_BUFFER, m_UV );
+        buffer = m_UV;
     }
     else if ( destination == VBO_NORMAL )
     {
         SDL_assert( m_Flags & VBO_NORMAL );
-        glBindBuffer( GL_ARRAY_BUFFER, m_Normal );
+        buffer = m_Normal;
     }
     else if ( destination == VBO_COLOR )
     {
         SDL_assert( m_Flags & VBO_COLOR );
-        glBindBuffer( GL_ARRAY_BUFFER, m_Color );
+        buffer = m_Color;
+    }
+
+    Upload( GL_ARRAY_BUFFER, buffer, m_Size[ GetSizeIndex( destination ) ], pData, size * sizeof( float ) );
+}
+
+void VertexBuffer::CopyVertices( const float* pData, size_t vertexCount )
+{
+    SDL_assert( m_Flags & VB_INTERLEAVED );
+    Upload( GL_ARRAY_BUFFER, m_Position, m_Size[ GetSizeIndex( VBO_POSITION ) ], pData, vertexCount * GetStride() );
+}
+
+void VertexBuffer::CopyIndices( const IndexData& data )
+{
+    CopyIndices( data.data(), data.size() );
+}
+
+void VertexBuffer::CopyIndices( const uint32_t* pData, size_t count )
+{
+    if ( m_VAO != 0 )
+    {
+        // The element array binding is part of the VAO's state.
+        glBindVertexArray( m_VAO );
+
+        if ( m_Index == 0 )
+        {
+            glGenBuffers( 1, &m_Index );
+        }
+    }
+
+    Upload( GL_ELEMENT_ARRAY_BUFFER, m_Index, m_IndexSize, pData, count * sizeof( uint32_t ) );
+    m_IndexCount = static_cast<uint32_t>( count );
+}
+
+void VertexBuffer::Upload( GLenum target, GLuint buffer, uint32_t& capacity, const void* pData, size_t size )
+{
+    if ( m_VAO == 0 )
+    {
+        capacity = std::max( capacity, static_cast<uint32_t>( size ) );
+        return;
     }
 
-    const unsigned int idx = GetSizeIndex( destination );
-    if ( size <= m_Size[ idx ] )
+    glBindBuffer( target, buffer );
+
+    if ( size <= capacity )
     {
-        glBufferSubData( GL_ARRAY_BUFFER, 0, size, pData );
+        glBufferSubData( target, 0, size, pData );
     }
     else
     {
-        glBufferData( GL_ARRAY_BUFFER, size, pData, GL_DYNAMIC_DRAW );
-        m_Size[ idx ] = static_cast<uint32_t>(size);
+        glBufferData( target, size, pData, GL_DYNAMIC_DRAW );
+        capacity = static_cast<uint32_t>( size );
     }
 }
 
@@ -256,83 +360,97 @@ void VertexBuffer::Draw( uint32_t numVertices /* = 0 */ )
     Draw( 0, numVertices );
 }
 
-void VertexBuffer::Draw( uint32_t startVertex, uint32_t numVertices, void* pIndices /* = nullptr */ )
+void VertexBuffer::Draw( uint32_t startVertex, uint32_t numVertices )
 {
     glBindVertexArray( m_VAO );
 
-	uint32_t maxVertices = m_Size[ GetSizeIndex( VBO_POSITION ) ] / ( (m_Flags & VB_2D) ? 2 : 3) / sizeof( float );
-	SDL_assert( maxVertices > 0 );
-	SDL_assert( startVertex + numVertices <= maxVertices );
-
-	if ( numVertices == 0 )
-	{
-		numVertices = maxVertices;
-	}
+    const uint32_t maxVertices = GetMaxVertices();
+    SDL_assert( maxVertices > 0 );
+    SDL_assert( startVertex + numVertices <= maxVertices );
 
-    if ( m_Flags & VBO_POSITION )
+    if ( numVertices == 0 )
     {
-        glEnableVertexAttribArray( 0 );
-        glBindBuffer( GL_ARRAY_BUFFER, m_Position );
-        glVertexAttribPointer(
-            0, // attribute 0
-			( m_Flags & VB_2D ) ? 2 : 3, // size
-            GL_FLOAT,
-            GL_FALSE, // normalised?
-            0,
-            (void*)0 // array buffer offset
-            );
+        numVertices = maxVertices;
     }
 
-    if ( m_Flags & VBO_UV )
+    if ( m_Index == 0 )
+    {
+        glDrawArrays( m_Mode, startVertex, numVertices );
+    }
+    else
     {
-        glEnableVertexAttribArray( 1 );
-        glBindBuffer( GL_ARRAY_BUFFER, m_UV );
-        glVertexAttribPointer( 1, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 );
+        glDrawElements( m_Mode, numVertices, GL_UNSIGNED_INT, (void*)( startVertex * sizeof( uint32_t ) ) );
     }
 
-    if ( m_Flags & VBO_NORMAL )
+    FrameWork::GetRenderSystem()->IncreaseDrawCallCount();
+}
+
+void VertexBuffer::DrawInstanced( const InstanceBuffer& instances, uint32_t firstInstance, uint32_t instanceCount )
+{
+    if ( instanceCount == 0 )
     {
-        glEnableVertexAttribArray( 2 );
-        glBindBuffer( GL_ARRAY_BUFFER, m_Normal );
-        glVertexAttribPointer( 2, 3, GL_FLOAT, GL_FALSE, 0, (void*)0 );
+        return;
     }
 
-    if ( m_Flags & VBO_COLOR )
+    SDL_assert( firstInstance + instanceCount <= instances.GetInstanceCount() );
+
+    glBindVertexArray( m_VAO );
+
+    const uint32_t maxVertices = GetMaxVertices();
+    SDL_assert( maxVertices > 0 );
+
+    instances.EnableAttributes( firstInstance );
+
+    if ( m_Index == 0 )
     {
-        glEnableVertexAttribArray( 3 );
-        glBindBuffer( GL_ARRAY_BUFFER, m_Color );
-        glVertexAttribPointer( 3, 4, GL_FLOAT, GL_FALSE, 0, (void*)0 );
+        glDrawArraysInstanced( m_Mode, 0, maxVertices, instanceCount );
+    }
+    else
+    {
+        glDrawElementsInstanced( m_Mode, maxVertices, GL_UNSIGNED_INT, nullptr, instanceCount );
     }
 
-	if ( pIndices == nullptr )
-	{
-		glDrawArrays( m_Mode, startVertex, numVertices );
-	}
-	else
-	{
-		glDrawElements( m_Mode, numVertices, GL_UNSIGNED_SHORT, pIndices );
-	}
+    instances.DisableAttributes();
+
+    FrameWork::GetRenderSystem()->IncreaseDrawCallCount();
+}
 
-    if ( m_Flags & VBO_POSITION )
+uint32_t VertexBuffer::GetMaxVertices() const
+{
+    if ( m_Index != 0 )
+    {
+        return m_IndexCount;
+    }
+    else if ( m_Flags & VB_INTERLEAVED )
     {
-        glDisableVertexAttribArray( 0 );
+        return m_Size[ GetSizeIndex( VBO_POSITION ) ] / GetStride();
     }
+    else
+    {
+        return m_Size[ GetSizeIndex( VBO_POSITION ) ] / ( ( m_Flags & VB_2D ) ? 2 : 3 ) / sizeof( float );
+    }
+}
+
+// Size in bytes of a single interleaved vertex.
+uint32_t VertexBuffer::GetStride() const
+{
+    uint32_t components = ( m_Flags & VB_2D ) ? 2 : 3;
 
     if ( m_Flags & VBO_UV )
     {
-        glDisableVertexAttribArray( 1 );
+        components += 2;
     }
 
     if ( m_Flags & VBO_NORMAL )
     {
-        glDisableVertexAttribArray( 2 );
+        components += 3;
     }
 
     if ( m_Flags & VBO_COLOR )
     {
-        glDisableVertexAttribArray( 3 );
+        components += 4;
     }
 
-    FrameWork::GetRenderSystem()->IncreaseDrawCallCount();
+    return components * sizeof( float );
 }
 }
@@ -27,6 +27,8 @@
 namespace Genesis
 {
 
+class InstanceBuffer;
+
 ///////////////////////////////////////////////////////////////////////////////
 // VertexBuffer
 ///////////////////////////////////////////////////////////////////////////////
@@ -36,11 +38,13 @@ static const unsigned int VBO_UV = 1 << 1;
 static const unsigned int VBO_NORMAL = 1 << 2;
 static const unsigned int VBO_COLOR = 1 << 3;
 static const unsigned int VB_2D = 1 << 4;
+static const unsigned int VB_INTERLEAVED = 1 << 5; // All attributes in a single buffer, filled with CopyVertices().
 
 typedef std::vector<glm::vec3> PositionData;
 typedef std::vector<glm::vec2> UVData;
 typedef std::vector<glm::vec3> NormalData;
 typedef std::vector<glm::vec4> ColorData;
+typedef std::vector<uint32_t> IndexData;
 
 enum class GeometryType
 {
@@ -65,8 +69,19 @@ public:
     void CopyColors( const ColorData& data, size_t count );
     void CopyData( const float* pData, size_t count, unsigned int destination );
 
+    // Interleaved buffers only. Each vertex is laid out as position, UV, normal and colour, skipping
+    // whichever attributes the buffer wasn't created with.
+    void CopyVertices( const float* pData, size_t vertexCount );
+
+    // Once a buffer has indices, Draw() counts indices rather than vertices.
+    void CopyIndices( const IndexData& data );
+    void CopyIndices( const uint32_t* pData, size_t count );
+
     void Draw( uint32_t numVertices = 0 ); // Draw the vertex buffer. Passing 0 to this function will draw the entire buffer.
-    void Draw( uint32_t startVertex, uint32_t numVertices, void* pIndices = nullptr );
+    void Draw( uint32_t startVertex, uint32_t numVertices );
+
+    // Draws the entire buffer once for each of the instances in [firstInstance, firstInstance + instanceCount).
+    void DrawInstanced( const InstanceBuffer& instances, uint32_t firstInstance, uint32_t instanceCount );
 
     void CreateUntexturedQuad( float x, float y, float width, float height );
     void CreateUntexturedQuad( float x, float y, float width, float height, const glm::vec4& color );
@@ -75,15 +90,22 @@ public:
 
 private:
     void SetModeFromGeometryType( GeometryType type );
+    void SetupAttributes();
+    void Upload( GLenum target, GLuint buffer, uint32_t& capacity, const void* pData, size_t size );
+    uint32_t GetMaxVertices() const;
+    uint32_t GetStride() const;
     unsigned int GetSizeIndex( unsigned int flag ) const;
 
     unsigned int m_Flags;
     GLuint m_VAO;
-    GLuint m_Position;
+    GLuint m_Position; // Holds every attribute if the buffer is interleaved.
     GLuint m_UV;
     GLuint m_Normal;
     GLuint m_Color;
+    GLuint m_Index;
     std::array<uint32_t, 4> m_Size;
+    uint32_t m_IndexSize;
+    uint32_t m_IndexCount;
     GLenum m_Mode;
 };
 GENESIS_DECLARE_SMART_PTR( VertexBuffer );